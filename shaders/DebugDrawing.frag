@@ -3,10 +3,12 @@ Fragment shader used for debug drawing.
 */
 #version 400
 
-uniform vec3 color;
+in VertexData {
+    vec3 color;
+} vertexIn;
 
 out vec4 fragmentColor;
 
 void main() {
-    fragmentColor = vec4(color, 1.0);
+    fragmentColor = vec4(vertexIn.color, 1.0);
 }
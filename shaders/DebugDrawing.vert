@@ -3,12 +3,18 @@ Vertex shader used for debug drawing.
 */
 #version 400
 layout(location = 0) in vec3 vertexPosition;
+layout(location = 1) in vec3 vertexColor;
 
 uniform mat4 model;
 uniform mat4 viewProjection;
 uniform float size;
 
+out VertexData {
+    vec3 color;
+} vertexOut;
+
 void main () {
     gl_Position = viewProjection * (model * vec4(vertexPosition, 1.0));
     gl_PointSize = size;
+    vertexOut.color = vertexColor;
 }
@@ -0,0 +1,322 @@
+#include <Engine/Animation/Animation.hpp>
+#include <Engine/Animation/AnimationAction.hpp>
+#include <Engine/Animation/AnimationClip.hpp>
+#include <Engine/Animation/AnimationController.hpp>
+#include <Engine/Animation/Bone.hpp>
+#include <Engine/Animation/Skeleton.hpp>
+#include <Engine/Animation/SkeletonBone.hpp>
+#include <Engine/Component/AnimationController.hpp>
+#include <Engine/Component/SuperComponent.hpp>
+#include <Engine/Entity/ComponentContainer.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/Entity/World.hpp>
+#include <Engine/Geometry/AssetFileHandler.hpp>
+#include <Engine/Geometry/MeshData.hpp>
+#include <Engine/Manager/Managers.hpp>
+#include <Engine/Util/RayIntersection.hpp>
+#include <Utility/Log.hpp>
+#include <Utility/Queue.hpp>
+#include <Video/Culling/AxisAlignedBoundingBox.hpp>
+#include <Video/Culling/Frustum.hpp>
+#include <Video/Geometry/VertexType/StaticVertex.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // Results are accumulated here so the compiler can't remove the measured work.
+    volatile float sink = 0.0f;
+
+    std::string filter;
+    unsigned int runCount = 10;
+
+    // Run a benchmark |runCount| times and log the fastest and median time per operation.
+    template<typename Function> void Measure(const std::string& name, unsigned int operations, Function function) {
+        if (name.find(filter) == std::string::npos)
+            return;
+
+        // Warm up caches and lazily allocated state before measuring.
+        function();
+
+        std::vector<double> times;
+        for (unsigned int run = 0; run < runCount; ++run) {
+            auto start = std::chrono::high_resolution_clock::now();
+            function();
+            times.push_back(std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count() / operations);
+        }
+
+        std::sort(times.begin(), times.end());
+        Log() << name << ": " << times.front() << " ns/op (median " << times[times.size() / 2] << " ns/op)\n";
+    }
+
+    glm::vec3 RandomVector(std::mt19937& random, float range) {
+        std::uniform_real_distribution<float> distribution(-range, range);
+        return glm::vec3(distribution(random), distribution(random), distribution(random));
+    }
+
+    void BenchmarkFrustum() {
+        std::mt19937 random(1);
+        const unsigned int boxCount = 10000;
+        std::vector<Video::AxisAlignedBoundingBox> boxes;
+        for (unsigned int i = 0; i < boxCount; ++i) {
+            glm::vec3 origin = RandomVector(random, 200.0f);
+            glm::vec3 dimensions = glm::abs(RandomVector(random, 5.0f));
+            boxes.push_back(Video::AxisAlignedBoundingBox(dimensions, origin, origin - dimensions * 0.5f, origin + dimensions * 0.5f));
+        }
+
+        glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+        Video::Frustum frustum(projection * glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+        Measure("Frustum::Collide", boxCount, [&]() {
+            unsigned int visible = 0;
+            for (const Video::AxisAlignedBoundingBox& box : boxes)
+                visible += frustum.Collide(box) ? 1 : 0;
+            sink = sink + visible;
+        });
+    }
+
+    void BenchmarkModelMatrix(unsigned int depth) {
+        World world;
+        world.CreateRoot();
+
+        // A chain of entities, each rotated and moved relative to its parent.
+        Entity* entity = world.GetRoot();
+        for (unsigned int i = 0; i < depth; ++i) {
+            entity = entity->AddChild("Child");
+            entity->position = glm::vec3(1.0f, 0.5f, 0.0f);
+            entity->scale = glm::vec3(1.01f);
+            entity->RotateYaw(0.1f);
+        }
+
+        const unsigned int callCount = 1000;
+        Measure("Entity::GetModelMatrix (depth " + std::to_string(depth) + ")", callCount, [&]() {
+            for (unsigned int i = 0; i < callCount; ++i)
+                sink = sink + entity->GetModelMatrix()[3][0];
+        });
+    }
+
+    void BenchmarkComponentContainer() {
+        const unsigned int componentCount = 10000;
+        ComponentContainer<Component::SuperComponent>* container = nullptr;
+
+        Measure("ComponentContainer::Create (and destroy)", componentCount, [&]() {
+            delete container;
+            container = new ComponentContainer<Component::SuperComponent>();
+            for (unsigned int i = 0; i < componentCount; ++i)
+                container->Create();
+        });
+
+        Measure("ComponentContainer::GetAll (iterate)", componentCount, [&]() {
+            unsigned int alive = 0;
+            for (Component::SuperComponent* component : container->GetAll())
+                alive += component->IsKilled() ? 0 : 1;
+            sink = sink + alive;
+        });
+
+        // Kill every fourth component and clear them. The removed components are replaced so every run has the same work.
+        Measure("ComponentContainer::ClearKilled", componentCount, [&]() {
+            const std::vector<Component::SuperComponent*>& components = container->GetAll();
+            for (std::size_t i = 0; i < components.size(); i += 4)
+                components[i]->Kill();
+            container->ClearKilled();
+            while (container->GetAll().size() < componentCount)
+                container->Create();
+        });
+
+        delete container;
+    }
+
+    void BenchmarkAnimation() {
+        const unsigned int boneCount = 64;
+        const int32_t keyInterval = 4;
+        const int32_t length = 96;
+        const uint32_t keyCount = length / keyInterval + 1;
+
+        // A chain of bones with a rotation key every few frames.
+        Animation::Skeleton skeleton;
+        for (unsigned int i = 0; i < boneCount; ++i) {
+            Animation::SkeletonBone* skeletonBone = new Animation::SkeletonBone();
+            skeletonBone->localTx = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.1f, 0.0f));
+            skeletonBone->globalTx = glm::mat4(1.0f);
+            skeletonBone->inversed = glm::mat4(1.0f);
+            skeletonBone->parentId = i == 0 ? static_cast<uint32_t>(-1) : i - 1;
+            skeleton.skeletonBones.push_back(skeletonBone);
+        }
+
+        Animation::Animation* animation = new Animation::Animation();
+        animation->length = length;
+        animation->numBones = boneCount;
+        animation->bones = new Animation::Bone[boneCount];
+        for (unsigned int i = 0; i < boneCount; ++i) {
+            Animation::Bone& bone = animation->bones[i];
+            bone.parent = i == 0 ? 0 : i - 1;
+            bone.numRotationKeys = keyCount;
+            bone.rotationKeys = new int32_t[keyCount];
+            bone.rotations = new glm::quat[keyCount];
+            for (uint32_t key = 0; key < keyCount; ++key) {
+                bone.rotationKeys[key] = static_cast<int32_t>(key) * keyInterval;
+                bone.rotations[key] = glm::angleAxis(0.1f * key, glm::vec3(0.0f, 0.0f, 1.0f));
+            }
+        }
+        animation->numRootPositions = keyCount;
+        animation->rootPositionKeys = new int32_t[keyCount];
+        animation->rootPositions = new glm::vec3[keyCount];
+        for (uint32_t key = 0; key < keyCount; ++key) {
+            animation->rootPositionKeys[key] = static_cast<int32_t>(key) * keyInterval;
+            animation->rootPositions[key] = glm::vec3(0.0f, 0.0f, 0.1f * key);
+        }
+
+        Animation::AnimationClip clip;
+        clip.animation = animation;
+
+        Animation::AnimationAction* action = new Animation::AnimationAction();
+        action->animationClip = &clip;
+
+        Animation::AnimationController* controller = new Animation::AnimationController();
+        controller->animationNodes.push_back(action);
+
+        Component::AnimationController* component = new Component::AnimationController();
+        component->skeleton = &skeleton;
+        component->controller = controller;
+
+        const unsigned int updateCount = 100;
+        Measure("AnimationController::UpdateAnimation (" + std::to_string(boneCount) + " bones)", updateCount, [&]() {
+            for (unsigned int i = 0; i < updateCount; ++i)
+                component->UpdateAnimation(1.0f / 60.0f);
+            sink = sink + component->bones.back()[3][1];
+        });
+
+        delete component;
+
+        // The clip isn't owned by the resource manager, so don't let the action free it.
+        action->animationClip = nullptr;
+        delete controller;
+        delete animation;
+        for (Animation::SkeletonBone* skeletonBone : skeleton.skeletonBones)
+            delete skeletonBone;
+    }
+
+    void BenchmarkRayIntersection() {
+        std::mt19937 random(2);
+        const unsigned int rayCount = 10000;
+        std::vector<glm::vec3> directions;
+        for (unsigned int i = 0; i < rayCount; ++i)
+            directions.push_back(glm::normalize(RandomVector(random, 1.0f) + glm::vec3(0.0f, 0.0f, -2.0f)));
+
+        RayIntersection rayIntersection;
+        const glm::vec3 origin(0.0f, 0.0f, 10.0f);
+        const Video::AxisAlignedBoundingBox box(glm::vec3(2.0f), glm::vec3(0.0f), glm::vec3(-1.0f), glm::vec3(1.0f));
+        const glm::mat4 modelMatrix = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(0.5f, 0.0f, 0.0f)), 0.5f, glm::vec3(0.0f, 1.0f, 0.0f));
+
+        Measure("RayIntersection::RayOBBIntersect", rayCount, [&]() {
+            unsigned int hits = 0;
+            float distance;
+            for (const glm::vec3& direction : directions)
+                hits += rayIntersection.RayOBBIntersect(origin, direction, box, modelMatrix, distance) ? 1 : 0;
+            sink = sink + hits;
+        });
+
+        const glm::vec3 p0(-1.0f, -1.0f, 0.0f);
+        const glm::vec3 p1(1.0f, -1.0f, 0.0f);
+        const glm::vec3 p2(0.0f, 1.0f, 0.0f);
+        Measure("RayIntersection::TriangleIntersect", rayCount, [&]() {
+            unsigned int hits = 0;
+            float distance;
+            for (const glm::vec3& direction : directions)
+                hits += rayIntersection.TriangleIntersect(origin, direction, p0, p1, p2, distance) ? 1 : 0;
+            sink = sink + hits;
+        });
+    }
+
+    void BenchmarkQueue() {
+        const unsigned int elementCount = 10000;
+        Utility::Queue<unsigned int> queue;
+
+        Measure("Utility::Queue push/pop", elementCount, [&]() {
+            for (unsigned int i = 0; i < elementCount; ++i)
+                queue.Push(i);
+            unsigned int sum = 0;
+            while (!queue.Empty()) {
+                sum += *queue.Front();
+                queue.Pop();
+            }
+            sink = sink + sum;
+        });
+    }
+
+    void BenchmarkMeshLoading() {
+        // Write a grid mesh to a temporary asset file.
+        const uint32_t gridSize = 128;
+        Geometry::MeshData* meshData = new Geometry::MeshData();
+        meshData->parent = 0;
+        meshData->numVertices = gridSize * gridSize;
+        meshData->numIndices = (gridSize - 1) * (gridSize - 1) * 6;
+        meshData->aabbDim = glm::vec3(gridSize, 0.0f, gridSize);
+        meshData->aabbOrigin = glm::vec3(gridSize * 0.5f, 0.0f, gridSize * 0.5f);
+        meshData->aabbMinpos = glm::vec3(0.0f);
+        meshData->aabbMaxpos = glm::vec3(gridSize, 0.0f, gridSize);
+        meshData->CPU = true;
+        meshData->GPU = false;
+        meshData->staticVertices = new Video::Geometry::VertexType::StaticVertex[meshData->numVertices];
+        for (uint32_t z = 0; z < gridSize; ++z) {
+            for (uint32_t x = 0; x < gridSize; ++x) {
+                Video::Geometry::VertexType::StaticVertex& vertex = meshData->staticVertices[z * gridSize + x];
+                vertex.position = glm::vec3(x, 0.0f, z);
+                vertex.textureCoordinate = glm::vec2(x, z) / static_cast<float>(gridSize);
+                vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+                vertex.tangent = glm::vec3(1.0f, 0.0f, 0.0f);
+            }
+        }
+        meshData->indices = new uint32_t[meshData->numIndices];
+        uint32_t index = 0;
+        for (uint32_t z = 0; z + 1 < gridSize; ++z) {
+            for (uint32_t x = 0; x + 1 < gridSize; ++x) {
+                uint32_t corner = z * gridSize + x;
+                for (uint32_t offset : { 0u, gridSize, 1u, 1u, gridSize, gridSize + 1 })
+                    meshData->indices[index++] = corner + offset;
+            }
+        }
+
+        const std::string filename = "MicroBenchmark.asset";
+        Geometry::AssetFileHandler writer(filename.c_str(), Geometry::AssetFileHandler::WRITE);
+        writer.SaveMesh(meshData);
+        writer.Close();
+        delete meshData;
+
+        Measure("AssetFileHandler::LoadMeshData (" + std::to_string(gridSize * gridSize) + " vertices)", 1, [&]() {
+            Geometry::AssetFileHandler reader(filename.c_str(), Geometry::AssetFileHandler::READ);
+            reader.LoadMeshData(0);
+            sink = sink + reader.GetStaticMeshData()->staticVertices[1].position.x;
+        });
+
+        std::remove(filename.c_str());
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Log().SetupStreams(&std::cout, &std::cout, &std::cout, &std::cerr);
+
+    filter = argc > 1 ? argv[1] : "";
+    runCount = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 10;
+
+    Managers().StartUpHeadless();
+
+    BenchmarkFrustum();
+    BenchmarkModelMatrix(4);
+    BenchmarkModelMatrix(32);
+    BenchmarkComponentContainer();
+    BenchmarkAnimation();
+    BenchmarkRayIntersection();
+    BenchmarkQueue();
+    BenchmarkMeshLoading();
+
+    Managers().ShutDown();
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include <Engine/Particles/CpuParticleSimulator.hpp>
+#include <Utility/Log.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Simulate a number of emitters and return the average time of a step in milliseconds.
+    double Run(unsigned int emitterCount, unsigned int particleCount, unsigned int stepCount, int threadCount) {
+        CpuParticleSimulator simulator(1);
+        simulator.SetThreadCount(threadCount);
+
+        Video::ParticleSystemRenderer::EmitterSettings settings;
+        settings.nr_particles = particleCount;
+        settings.rate = 0.1f;
+
+        std::vector<unsigned int> emitters;
+        for (unsigned int i = 0; i < emitterCount; ++i)
+            emitters.push_back(simulator.AddEmitter(particleCount));
+
+        double totalTime = 0.0;
+        for (unsigned int step = 0; step < stepCount; ++step) {
+            auto start = std::chrono::high_resolution_clock::now();
+            for (unsigned int i = 0; i < emitterCount; ++i) {
+                settings.worldPos = glm::vec3(static_cast<float>(i), 0.0f, 0.0f);
+                simulator.Update(emitters[i], 0.1f, settings);
+            }
+            simulator.Simulate();
+            totalTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        }
+
+        return stepCount > 0 ? totalTime / stepCount : 0.0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Log().SetupStreams(&std::cout, &std::cout, &std::cout, &std::cerr);
+
+    unsigned int emitterCount = argc > 1 ? std::atoi(argv[1]) : 200;
+    unsigned int particleCount = argc > 2 ? std::atoi(argv[2]) : 1024;
+    unsigned int stepCount = argc > 3 ? std::atoi(argv[3]) : 300;
+    int threadCount = argc > 4 ? std::atoi(argv[4]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (threadCount < 1)
+        threadCount = 1;
+
+    double particles = static_cast<double>(emitterCount) * particleCount;
+    double serial = Run(emitterCount, particleCount, stepCount, 1);
+    double parallel = Run(emitterCount, particleCount, stepCount, threadCount);
+
+    Log() << "Emitters: " << emitterCount << " with " << particleCount << " particles, steps: " << stepCount << "\n";
+    Log() << "1 thread: average step " << serial << " ms, " << particles / serial << " particles/ms/core\n";
+    Log() << threadCount << " threads: average step " << parallel << " ms, " << particles / parallel / threadCount << " particles/ms/core\n";
+
+    return 0;
+}
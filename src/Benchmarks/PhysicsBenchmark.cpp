@@ -0,0 +1,92 @@
+#include <Engine/Component/RigidBody.hpp>
+#include <Engine/Component/Shape.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/Manager/Managers.hpp>
+#include <Engine/Manager/PhysicsManager.hpp>
+#include <Engine/Physics/Shape.hpp>
+#include <Utility/Log.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    Log().SetupStreams(&std::cout, &std::cout, &std::cout, &std::cerr);
+
+    unsigned int triggerCount = argc > 1 ? std::atoi(argv[1]) : 256;
+    unsigned int bodyCount = argc > 2 ? std::atoi(argv[2]) : 256;
+    unsigned int stepCount = argc > 3 ? std::atoi(argv[3]) : 600;
+    const float deltaTime = 1.0f / 60.0f;
+    const float spacing = 4.0f;
+
+    Managers().StartUpHeadless();
+    PhysicsManager* physicsManager = Managers().physicsManager;
+
+    // Lay out the triggers in a grid on the ground plane.
+    unsigned int columns = static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<float>(triggerCount))));
+    std::shared_ptr<Physics::Shape> triggerShape(new Physics::Shape(Physics::Shape::Box(2.0f, 2.0f, 2.0f)));
+    std::vector<Utility::LockBox<Physics::Trigger>> triggers;
+    for (unsigned int i = 0; i < triggerCount; ++i) {
+        Utility::LockBox<Physics::Trigger> trigger = physicsManager->CreateTrigger(triggerShape);
+        physicsManager->SetPosition(trigger, glm::vec3((i % columns) * spacing, 0.0f, (i / columns) * spacing));
+        triggers.push_back(trigger);
+    }
+
+    // Drop the bodies over the grid, staggered so they arrive over time.
+    std::vector<std::unique_ptr<Entity>> bodies;
+    for (unsigned int i = 0; i < bodyCount; ++i) {
+        Entity* entity = new Entity(nullptr, "Body");
+        entity->position = glm::vec3((i % columns) * spacing, 5.0f + (i / columns) * 2.0f, ((i * 7) % columns) * spacing);
+        entity->AddComponent<Component::Shape>();
+        Component::RigidBody* rigidBody = entity->AddComponent<Component::RigidBody>();
+        physicsManager->ForceTransformSync(rigidBody);
+        bodies.push_back(std::unique_ptr<Entity>(entity));
+    }
+
+    // Every trigger observes every body.
+    unsigned int enterCount = 0;
+    unsigned int leaveCount = 0;
+    for (Utility::LockBox<Physics::Trigger>& trigger : triggers) {
+        for (std::unique_ptr<Entity>& body : bodies) {
+            Component::RigidBody* rigidBody = body->GetComponent<Component::RigidBody>();
+            physicsManager->OnTriggerEnter(trigger, rigidBody, [&enterCount]() { ++enterCount; });
+            physicsManager->OnTriggerLeave(trigger, rigidBody, [&leaveCount]() { ++leaveCount; });
+        }
+    }
+
+    // Step the simulation.
+    double totalTime = 0.0;
+    double maxTime = 0.0;
+    for (unsigned int step = 0; step < stepCount; ++step) {
+        auto start = std::chrono::high_resolution_clock::now();
+        physicsManager->Update(deltaTime);
+        physicsManager->UpdateEntityTransforms();
+        double time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        totalTime += time;
+        if (time > maxTime)
+            maxTime = time;
+    }
+
+    Log() << "Triggers: " << triggerCount << ", bodies: " << bodyCount << ", observed pairs: " << triggerCount * bodyCount << "\n";
+    Log() << "Steps: " << stepCount << "\n";
+    Log() << "Average step: " << (stepCount > 0 ? totalTime / stepCount : 0.0) << " ms, max step: " << maxTime << " ms\n";
+    Log() << "Enter events: " << enterCount << ", leave events: " << leaveCount << "\n";
+
+    for (Utility::LockBox<Physics::Trigger>& trigger : triggers)
+        physicsManager->ReleaseTriggerVolume(std::move(trigger));
+    triggers.clear();
+
+    for (std::unique_ptr<Entity>& body : bodies) {
+        body->KillComponent<Component::RigidBody>();
+        body->KillComponent<Component::Shape>();
+    }
+    physicsManager->ClearKilledComponents();
+    bodies.clear();
+
+    Managers().ShutDown();
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <Engine/Component/RigidBody.hpp>
+#include <Engine/Component/Shape.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/Manager/Managers.hpp>
+#include <Engine/Manager/PhysicsManager.hpp>
+#include <Engine/Physics/Shape.hpp>
+#include <Utility/Log.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    const unsigned int stackHeight = 10;
+
+    struct Result {
+        double averageTime;
+        double maxTime;
+    };
+
+    // Build a ground plane with stacks of boxes on it and step the simulation.
+    Result Run(unsigned int boxCount, unsigned int stepCount, int threadCount) {
+        PhysicsManager* physicsManager = Managers().physicsManager;
+        physicsManager->SetThreadCount(threadCount);
+        std::vector<std::unique_ptr<Entity>> entities;
+
+        Entity* ground = new Entity(nullptr, "Ground");
+        physicsManager->SetShape(ground->AddComponent<Component::Shape>(), std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Plane(glm::vec3(0.0f, 1.0f, 0.0f), 0.0f))));
+        Component::RigidBody* groundBody = ground->AddComponent<Component::RigidBody>();
+        physicsManager->SetMass(groundBody, 0.0f);
+        entities.push_back(std::unique_ptr<Entity>(ground));
+
+        // Stacks are laid out in a grid, far enough apart not to touch.
+        std::shared_ptr<Physics::Shape> boxShape(new Physics::Shape(Physics::Shape::Box(1.0f, 1.0f, 1.0f)));
+        unsigned int stackCount = (boxCount + stackHeight - 1) / stackHeight;
+        unsigned int columns = static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<float>(stackCount))));
+        for (unsigned int i = 0; i < boxCount; ++i) {
+            unsigned int stack = i / stackHeight;
+            Entity* entity = new Entity(nullptr, "Box");
+            entity->position = glm::vec3((stack % columns) * 3.0f, 0.5f + (i % stackHeight) * 1.0f, (stack / columns) * 3.0f);
+            physicsManager->SetShape(entity->AddComponent<Component::Shape>(), boxShape);
+            Component::RigidBody* rigidBody = entity->AddComponent<Component::RigidBody>();
+            physicsManager->ForceTransformSync(rigidBody);
+            entities.push_back(std::unique_ptr<Entity>(entity));
+        }
+
+        // Step the simulation.
+        const float deltaTime = 1.0f / 60.0f;
+        double totalTime = 0.0;
+        double maxTime = 0.0;
+        for (unsigned int step = 0; step < stepCount; ++step) {
+            auto start = std::chrono::high_resolution_clock::now();
+            physicsManager->Update(deltaTime);
+            physicsManager->UpdateEntityTransforms();
+            double time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+            totalTime += time;
+            if (time > maxTime)
+                maxTime = time;
+        }
+
+        for (std::unique_ptr<Entity>& entity : entities) {
+            entity->KillComponent<Component::RigidBody>();
+            entity->KillComponent<Component::Shape>();
+        }
+        physicsManager->ClearKilledComponents();
+
+        return { stepCount > 0 ? totalTime / stepCount : 0.0, maxTime };
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Log().SetupStreams(&std::cout, &std::cout, &std::cout, &std::cerr);
+
+    unsigned int boxCount = argc > 1 ? std::atoi(argv[1]) : 2000;
+    unsigned int stepCount = argc > 2 ? std::atoi(argv[2]) : 300;
+    int threadCount = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+
+    Managers().StartUpHeadless();
+
+    Result serial = Run(boxCount, stepCount, 1);
+    Result parallel = Run(boxCount, stepCount, threadCount);
+    int usedThreads = Managers().physicsManager->GetThreadCount();
+
+    Log() << "Boxes: " << boxCount << " in stacks of " << stackHeight << ", steps: " << stepCount << "\n";
+    Log() << "1 thread: average step " << serial.averageTime << " ms, max step " << serial.maxTime << " ms\n";
+    Log() << usedThreads << " threads: average step " << parallel.averageTime << " ms, max step " << parallel.maxTime << " ms\n";
+    if (parallel.averageTime > 0.0)
+        Log() << "Speedup: " << serial.averageTime / parallel.averageTime << "x\n";
+
+    Managers().ShutDown();
+
+    return 0;
+}
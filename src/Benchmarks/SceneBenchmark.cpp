@@ -0,0 +1,234 @@
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/Hymn.hpp>
+#include <Engine/Manager/Managers.hpp>
+#include <Engine/Manager/ParticleManager.hpp>
+#include <Engine/Manager/ProfilingManager.hpp>
+#include <Engine/Manager/RenderManager.hpp>
+#include <Engine/Manager/RenderSnapshot.hpp>
+#include <Engine/Manager/ScriptManager.hpp>
+#include <Engine/Util/BinaryScene.hpp>
+#include <Engine/Util/FileSystem.hpp>
+#include <Engine/Util/Json.hpp>
+#include <Utility/Log.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    // Update rate of the simulation.
+    const float deltaTime = 1.0f / 60.0f;
+
+    // Number of times the scene is loaded to compare the scene formats.
+    const unsigned int loadCount = 5;
+
+    // Phases faster than this (in ms) are too noisy to be compared with the baseline.
+    const double noiseFloor = 0.01;
+
+    struct Phase {
+        double average;
+        double percentile;
+        double max;
+    };
+
+    // Summarize the times of a phase.
+    Phase Summarize(std::vector<double>& times) {
+        Phase phase = { 0.0, 0.0, 0.0 };
+        if (times.empty())
+            return phase;
+
+        std::sort(times.begin(), times.end());
+        for (double time : times)
+            phase.average += time;
+        phase.average /= times.size();
+        phase.percentile = times[times.size() * 95 / 100];
+        phase.max = times.back();
+
+        return phase;
+    }
+
+    // Get the time since start in ms.
+    double MillisecondsSince(std::chrono::high_resolution_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    // Get the peak resident set size of the process in MiB.
+    unsigned int MeasurePeakRAM() {
+#ifdef __linux__
+        std::ifstream file("/proc/self/status");
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.compare(0, 6, "VmHWM:") == 0)
+                return static_cast<unsigned int>(std::strtoul(line.c_str() + 6, nullptr, 10) / 1024);
+        }
+#endif
+        return Managers().profilingManager->MeasureRAM();
+    }
+
+    // Compare a value with its baseline and report whether it has regressed.
+    bool Regressed(const std::string& name, double value, double baseline, double threshold, double floor) {
+        if (value <= baseline * (1.0 + threshold) || value - baseline <= floor)
+            return false;
+
+        Log(Log::WARNING) << "Regression in " << name << ": " << value << " (baseline " << baseline << ", +" << (value / baseline - 1.0) * 100.0 << "%)\n";
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Log().SetupStreams(&std::cout, &std::cout, &std::cout, &std::cerr);
+
+    if (argc < 2) {
+        Log() << "Usage: SceneBenchmark hymn [scene] [frames] [baseline] [threshold]\n";
+        return 2;
+    }
+
+    std::string hymnPath = argv[1];
+    std::string scene = argc > 2 ? argv[2] : "";
+    unsigned int frameCount = argc > 3 ? std::atoi(argv[3]) : 600;
+    std::string baselinePath = argc > 4 ? argv[4] : "";
+    double threshold = argc > 5 ? std::atof(argv[5]) : 0.1;
+
+    if (!FileSystem::FileExists((hymnPath + FileSystem::DELIMITER + "Hymn.json").c_str())) {
+        Log(Log::ERR) << "No hymn found in " << hymnPath << "\n";
+        return 2;
+    }
+
+    Managers().StartUpHeadless();
+    ProfilingManager* profilingManager = Managers().profilingManager;
+
+    // Load the hymn and scene. Materials and components that need a window or audio device are skipped.
+    Hymn().Load(hymnPath);
+    if (scene.empty())
+        scene = Hymn().startupScene;
+    std::string sceneFile = BinaryScene::FindSceneFile(Hymn().GetPath() + "/" + scene);
+
+    // Time loading the scene from JSON and from the binary scene format.
+    std::map<std::string, std::vector<double>> times;
+    Json::Value sceneNode;
+    if (BinaryScene::LoadFile(sceneFile, sceneNode)) {
+        std::ostringstream jsonStream;
+        jsonStream << sceneNode;
+        std::string json = jsonStream.str();
+        std::string binary = BinaryScene::Write(sceneNode);
+        Log() << "Scene size: JSON " << static_cast<unsigned int>(json.size()) << " bytes, binary " << static_cast<unsigned int>(binary.size()) << " bytes\n";
+
+        for (unsigned int i = 0; i < loadCount; ++i) {
+            std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+            Json::Value node;
+            std::istringstream stream(json);
+            stream >> node;
+            Hymn().world.Load(node);
+            times["Load (JSON)"].push_back(MillisecondsSince(start));
+
+            start = std::chrono::high_resolution_clock::now();
+            BinaryScene::Reader reader;
+            if (reader.Open(binary.data(), binary.size()))
+                Hymn().world.Load(reader);
+            times["Load (binary)"].push_back(MillisecondsSince(start));
+        }
+    }
+
+    Hymn().world.Load(sceneFile);
+
+    // Compile scripts.
+    Managers().scriptManager->RegisterInput();
+    Managers().scriptManager->BuildAllScripts();
+    unsigned int loadedRAM = profilingManager->MeasureRAM();
+
+    // Cull particles against the scene's camera, if it has one.
+    for (Entity* entity : Hymn().world.GetEntities()) {
+        if (entity->name == "Camera") {
+            glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+            Managers().particleManager->SetCamera(glm::inverse(entity->GetModelMatrix()), projection);
+            break;
+        }
+    }
+
+    // Run the update loop with a fixed time step and time each phase.
+    RenderSnapshot snapshot;
+    profilingManager->SetActive(true);
+    for (unsigned int frame = 0; frame < frameCount; ++frame) {
+        profilingManager->BeginFrame();
+        Hymn().Update(deltaTime);
+
+        // Culls meshes and lights against the camera, as is done before rendering.
+        Managers().renderManager->CreateSnapshot(Hymn().world, snapshot);
+        profilingManager->EndFrame();
+
+        ProfilingManager::Result* result = profilingManager->GetResult(ProfilingManager::CPU_TIME);
+        times["Frame"].push_back(result->value);
+        for (const ProfilingManager::Result& phase : result->children)
+            times[phase.name].push_back(phase.value);
+    }
+    profilingManager->SetActive(false);
+
+    std::map<std::string, Phase> phases;
+    for (auto& it : times)
+        phases[it.first] = Summarize(it.second);
+    unsigned int peakRAM = MeasurePeakRAM();
+
+    Log() << "Scene: " << scene << ", entities: " << static_cast<unsigned int>(Hymn().world.GetEntities().size()) << ", frames: " << frameCount << "\n";
+    for (auto& it : phases)
+        Log() << it.first << ": average " << it.second.average << " ms, 95th percentile " << it.second.percentile << " ms, max " << it.second.max << " ms\n";
+    Log() << "RAM after loading: " << loadedRAM << " MiB, peak: " << peakRAM << " MiB\n";
+
+    Hymn().world.Clear();
+    Managers().ShutDown();
+
+    if (baselinePath.empty())
+        return 0;
+
+    // Store the results as the baseline if there isn't one yet.
+    if (!FileSystem::FileExists(baselinePath.c_str())) {
+        Json::Value root;
+        root["scene"] = scene;
+        root["frames"] = frameCount;
+        root["peakRAM"] = peakRAM;
+        for (auto& it : phases) {
+            Json::Value& phaseNode = root["phases"][it.first];
+            phaseNode["average"] = it.second.average;
+            phaseNode["percentile"] = it.second.percentile;
+            phaseNode["max"] = it.second.max;
+        }
+
+        std::ofstream file(baselinePath);
+        file << root;
+        Log() << "Wrote baseline to " << baselinePath << "\n";
+        return 0;
+    }
+
+    // Compare with the baseline. Phases may override the threshold with their own.
+    Json::Value root;
+    std::ifstream file(baselinePath);
+    file >> root;
+    file.close();
+
+    bool regressed = false;
+    const Json::Value& phasesNode = root["phases"];
+    for (const std::string& name : phasesNode.getMemberNames()) {
+        auto it = phases.find(name);
+        if (it == phases.end()) {
+            Log(Log::WARNING) << "Phase " << name << " from the baseline wasn't measured.\n";
+            continue;
+        }
+
+        const Json::Value& phaseNode = phasesNode[name];
+        double phaseThreshold = phaseNode.get("threshold", threshold).asDouble();
+        regressed |= Regressed(name + " average", it->second.average, phaseNode["average"].asDouble(), phaseThreshold, noiseFloor);
+        regressed |= Regressed(name + " 95th percentile", it->second.percentile, phaseNode["percentile"].asDouble(), phaseThreshold, noiseFloor);
+    }
+
+    if (root.isMember("peakRAM"))
+        regressed |= Regressed("peak RAM", peakRAM, root["peakRAM"].asDouble(), root.get("ramThreshold", threshold).asDouble(), 1.0);
+
+    Log() << (regressed ? "Performance regressed compared to " : "No regressions compared to ") << baselinePath << "\n";
+
+    return regressed ? 1 : 0;
+}
@@ -765,7 +765,7 @@ void Editor::WidgetGizmo(Entity* entity) {
 
 void Editor::Play() {
     Hymn().saveStateHymn = Hymn().ToJson();
-    Hymn().saveStateWorld = Hymn().world.GetSaveJson();
+    Hymn().saveStateWorld.Capture(Hymn().world);
     SetVisible(false);
     resourceView.HideEditors();
 
@@ -775,7 +775,8 @@ void Editor::Play() {
 
 void Editor::LoadSceneState() {
     Hymn().FromJson(Hymn().saveStateHymn);
-    Hymn().world.Load(Hymn().saveStateWorld);
+    Hymn().saveStateWorld.Restore(Hymn().world);
+    Hymn().saveStateWorld.Clear();
 }
 
 void Editor::NewHymn() {
@@ -35,7 +35,7 @@ namespace GUI {
     }
 
     void BoxShapeEditor::Apply(Component::Shape* comp) {
-        Managers().physicsManager->SetShape(comp, std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Box(width, height, depth))));
+        Managers().physicsManager->SetShape(comp, Managers().physicsManager->GetShapeCache().Get(Physics::Shape::Box(width, height, depth)));
     }
 
     bool BoxShapeEditor::SetFromShape(const Physics::Shape& shape) {
@@ -28,7 +28,7 @@ namespace GUI {
     }
 
     void CapsuleShapeEditor::Apply(Component::Shape* comp) {
-        Managers().physicsManager->SetShape(comp, std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Capsule(radius, height))));
+        Managers().physicsManager->SetShape(comp, Managers().physicsManager->GetShapeCache().Get(Physics::Shape::Capsule(radius, height)));
     }
 
     bool CapsuleShapeEditor::SetFromShape(const Physics::Shape& shape) {
@@ -28,7 +28,7 @@ namespace GUI {
     }
 
     void ConeShapeEditor::Apply(Component::Shape* comp) {
-        Managers().physicsManager->SetShape(comp, std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Cone(radius, height))));
+        Managers().physicsManager->SetShape(comp, Managers().physicsManager->GetShapeCache().Get(Physics::Shape::Cone(radius, height)));
     }
 
     bool ConeShapeEditor::SetFromShape(const Physics::Shape& shape) {
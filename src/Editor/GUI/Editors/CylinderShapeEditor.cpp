@@ -28,7 +28,7 @@ namespace GUI {
     }
 
     void CylinderShapeEditor::Apply(Component::Shape* comp) {
-        Managers().physicsManager->SetShape(comp, std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Cylinder(radius, length))));
+        Managers().physicsManager->SetShape(comp, Managers().physicsManager->GetShapeCache().Get(Physics::Shape::Cylinder(radius, length)));
     }
 
     bool CylinderShapeEditor::SetFromShape(const Physics::Shape& shape) {
@@ -139,7 +139,7 @@ void EntityEditor::Show() {
             entity->SetLocalOrientation(glm::quat(glm::radians(eulerAngles)));
 
         ImGui::DraggableVec3("Scale", entity->scale);
-        ImGui::Text("Unique Identifier: %u", entity->GetUniqueIdentifier());
+        ImGui::Text("Unique Identifier: %llu", static_cast<unsigned long long>(entity->GetUniqueIdentifier()));
         ImGui::Checkbox("Is entity static", &entity->isStatic);
         ImGui::Unindent();
         if (!entity->IsScene()) {
@@ -505,12 +505,13 @@ void EntityEditor::ScriptEditor(Component::Script* script) {
 
                     if (propertyName != "self") {
 
-                        unsigned int GUID = *(unsigned int*)script->GetDataFromPropertyMap(propertyName);
+                        uint64_t GUID = *(uint64_t*)script->GetDataFromPropertyMap(propertyName);
+                        Entity* referencedEntity = Hymn().GetEntityByGUID(GUID);
 
-                        if (GUID != 0) {
+                        if (referencedEntity != nullptr) {
 
                             std::string entityGUID = std::to_string(GUID);
-                            std::string entityName = Hymn().GetEntityByGUID(GUID)->name;
+                            std::string entityName = referencedEntity->name;
                             std::string propertyText;
                             propertyText.reserve(propertyName.length() + entityName.length() + entityGUID.length() + 4); // additional `:  ()`
                             propertyText.append(propertyName).append(": ").append(entityName).append("(").append(entityGUID).append(")");
@@ -547,7 +548,7 @@ void EntityEditor::ScriptEditor(Component::Script* script) {
                             ImGui::Separator();
                             for (Entity* entity : Hymn().world.GetEntities()) /// @todo Change into a prettier tree structure or something, later.
                                 if (ImGui::Selectable(entity->name.c_str()))
-                                    *(unsigned int*)script->GetDataFromPropertyMap(propertyName) = entity->GetUniqueIdentifier();
+                                    *(uint64_t*)script->GetDataFromPropertyMap(propertyName) = entity->GetUniqueIdentifier();
 
                             ImGui::EndPopup();
                         }
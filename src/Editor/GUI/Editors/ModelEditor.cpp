@@ -119,11 +119,6 @@ void ModelEditor::Show() {
                     world->CreateRoot();
                     Entity* root = world->GetRoot();
                     
-                    // Unique identifiers are based on the current time.
-                    // Since we're creating two entities at the same time, we fake that
-                    // the root was created one second ago to avoid duplicate UIDs.
-                    root->SetUniqueIdentifier(root->GetUniqueIdentifier() - 1);
-                    
                     Entity* entity = root->AddChild(model->name);
                     
                     Component::Mesh* mesh = entity->AddComponent<Component::Mesh>();
@@ -1,6 +1,7 @@
 #include "SceneEditor.hpp"
 
 #include <Engine/Hymn.hpp>
+#include <Engine/Util/BinaryScene.hpp>
 #include <Engine/Util/FileSystem.hpp>
 #include <Utility/Log.hpp>
 #include <imgui.h>
@@ -26,6 +27,9 @@ void SceneEditor::Show() {
         if (ImGui::InputText("Name", name, 128, ImGuiInputTextFlags_EnterReturnsTrue)) {
             // Rename scene file.
             rename((Hymn().GetPath() + "/" + path + "/" + *scene + ".json").c_str(), (Hymn().GetPath() + "/" + path + "/" + name + ".json").c_str());
+            std::string binaryFilename = Hymn().GetPath() + "/" + path + "/" + *scene + BinaryScene::EXTENSION;
+            if (FileSystem::FileExists(binaryFilename.c_str()))
+                rename(binaryFilename.c_str(), (Hymn().GetPath() + "/" + path + "/" + name + BinaryScene::EXTENSION).c_str());
             
             *scene = name;
             Resources().activeScene = path + "/" + name;
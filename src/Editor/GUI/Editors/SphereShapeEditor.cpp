@@ -21,7 +21,7 @@ namespace GUI {
     }
 
     void SphereShapeEditor::Apply(Component::Shape* comp) {
-        Managers().physicsManager->SetShape(comp, std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Sphere(radius))));
+        Managers().physicsManager->SetShape(comp, Managers().physicsManager->GetShapeCache().Get(Physics::Shape::Sphere(radius)));
     }
 
     bool SphereShapeEditor::SetFromShape(const Physics::Shape& shape) {
@@ -2,6 +2,8 @@
 
 #include <array>
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <Engine/Component/Trigger.hpp>
 #include <Engine/Component/Script.hpp>
 #include <Engine/Component/Shape.hpp>
@@ -191,11 +193,12 @@ namespace GUI {
                             repeat->GetEventVector()->at(i).check[0] = true;
                         }
 
-                        // Subject
+                        // Subject, each event has the collided entity with the same index.
                         ImGui::NextColumn();
-                        int collidedEntityUID = repeat->GetCollidedEntityUID();
-                        if (ImGui::InputInt("Input UID: ", &collidedEntityUID)) {                            
-                            repeat->SetCollidedEntityUID(collidedEntityUID);
+                        char collidedEntityUID[21];
+                        snprintf(collidedEntityUID, sizeof(collidedEntityUID), "%llu", static_cast<unsigned long long>(repeat->GetCollidedEntityUID(i)));
+                        if (ImGui::InputText(labelShape.c_str(), collidedEntityUID, sizeof(collidedEntityUID), ImGuiInputTextFlags_CharsDecimal)) {
+                            repeat->SetCollidedEntityUID(i, std::strtoull(collidedEntityUID, nullptr, 10));
                             repeat->GetEventVector()->at(i).check[1] = true;
                         }
 
@@ -215,7 +218,10 @@ namespace GUI {
                             for (std::size_t j = 0; j < Hymn().world.GetEntities().size(); ++j) {
 
                                 if (Hymn().world.GetEntities().at(j)->name == entityName.at(targetID)) {
-                                    repeat->GetTargetEntity()->push_back(Hymn().world.GetEntities().at(j));
+                                    // Each event has the target entity with the same index.
+                                    if (repeat->GetTargetEntity()->size() <= i)
+                                        repeat->GetTargetEntity()->resize(i + 1, nullptr);
+                                    repeat->GetTargetEntity()->at(i) = Hymn().world.GetEntities().at(j);
                                     repeat->GetEventVector()->at(i).check[2] = true;
                                 }
                             }
@@ -230,7 +236,7 @@ namespace GUI {
                         if (!repeat->GetTargetEntity()->empty()) {
                             for (std::size_t x = 0; x < repeat->GetTargetEntity()->size(); ++x) {
 
-                                if (repeat->GetTargetEntity()->at(x)->GetComponent<Component::Script>() != nullptr && repeat->GetTargetEntity()->at(x)->name == entityName.at(targetID)) {
+                                if (repeat->GetTargetEntity()->at(x) != nullptr && repeat->GetTargetEntity()->at(x)->GetComponent<Component::Script>() != nullptr && repeat->GetTargetEntity()->at(x)->name == entityName.at(targetID)) {
 
                                     for (std::size_t j = 0; j < repeat->GetTargetEntity()->at(x)->GetComponent<Component::Script>()->scriptFile->functionList.size(); ++j) {
 
@@ -244,7 +250,9 @@ namespace GUI {
                         if (!scriptVector.empty()) {
                             if (ImGui::Combo(labelScript.c_str(), &scriptID, scriptVector)) {
                                 repeat->GetEventVector()->at(i).m_scriptID = scriptID;
-                                repeat->GetTargetFunction()->push_back(scriptVector.at(scriptID));
+                                if (repeat->GetTargetFunction()->size() <= i)
+                                    repeat->GetTargetFunction()->resize(i + 1);
+                                repeat->GetTargetFunction()->at(i) = scriptVector.at(scriptID);
                                 repeat->GetEventVector()->at(i).check[3] = true;
                             }
                         }
@@ -60,32 +60,35 @@ void LogView::Show() {
 }
 
 void LogView::UpdateLog() {
-    //Create log output string.
-    std::string output;
-    if (!defaultStringstream.str().empty())
-        output += "[Default] " + defaultStringstream.str();
+    // The streams are written by the logging thread.
+    Log::AccessStreams([this]() {
+        //Create log output string.
+        std::string output;
+        if (!defaultStringstream.str().empty())
+            output += "[Default] " + defaultStringstream.str();
 
-    if (!infoStringstream.str().empty())
-        output += "[Info] " + infoStringstream.str();
+        if (!infoStringstream.str().empty())
+            output += "[Info] " + infoStringstream.str();
 
-    if (!warningStringstream.str().empty())
-        output += "[Warning] " + warningStringstream.str();
+        if (!warningStringstream.str().empty())
+            output += "[Warning] " + warningStringstream.str();
 
-    if (!errorStringstream.str().empty())
-        output += "[Error] " + errorStringstream.str();
+        if (!errorStringstream.str().empty())
+            output += "[Error] " + errorStringstream.str();
 
-    // Add new lines to text buffer.
-    int oldSize = textBuffer.size();
+        // Add new lines to text buffer.
+        int oldSize = textBuffer.size();
 
-    textBuffer.appendv(output.c_str(), nullptr);
+        textBuffer.appendv(output.c_str(), nullptr);
 
-    for (int newSize = textBuffer.size(); oldSize < newSize; oldSize++)
-        if (textBuffer[oldSize] == '\n')
-            lineOffsets.push_back(oldSize);
+        for (int newSize = textBuffer.size(); oldSize < newSize; oldSize++)
+            if (textBuffer[oldSize] == '\n')
+                lineOffsets.push_back(oldSize);
 
-    // Clear streams.
-    defaultStringstream.str(std::string());
-    infoStringstream.str(std::string());
-    warningStringstream.str(std::string());
-    errorStringstream.str(std::string());
+        // Clear streams.
+        defaultStringstream.str(std::string());
+        infoStringstream.str(std::string());
+        warningStringstream.str(std::string());
+        errorStringstream.str(std::string());
+    });
 }
@@ -2,6 +2,7 @@
 
 #include <Engine/Manager/Managers.hpp>
 #include <Engine/Manager/RenderManager.hpp>
+#include <Engine/Hymn.hpp>
 #include <imgui.h>
 #include <Utility/Log.hpp>
 
@@ -47,10 +48,54 @@ void ProfilingWindow::Show() {
        ImGui::Text("Light count: %u", Managers().renderManager->GetLightCount());
     }
     
+    if (ImGui::CollapsingHeader("Capture")) {
+        ProfilingManager* profilingManager = Managers().profilingManager;
+        if (!ProfilingManager::IsCapturing()) {
+            if (ImGui::Button("Start capture"))
+                profilingManager->StartCapture();
+        } else {
+            ImGui::Text("Captured frames: %u", profilingManager->GetCapturedFrameCount());
+            if (ImGui::Button("Stop capture")) {
+                profilingManager->StopCapture();
+                std::string filename = Hymn().GetPath() + "/Trace.json";
+                if (profilingManager->WriteTrace(filename, 0, profilingManager->GetCapturedFrameCount() - 1))
+                    Log() << "Wrote trace to " << filename << "\n";
+            }
+        }
+    }
+
     if (ImGui::CollapsingHeader("Memory")) {
         ImGui::Text("RAM: %u MiB", Managers().profilingManager->MeasureRAM());
         
         ImGui::Text("VRAM: %u MiB", Managers().profilingManager->MeasureVRAM());
+
+        // Memory reported by each subsystem.
+        ImGui::Columns(4, "Memory");
+        ImGui::Text("Subsystem");
+        ImGui::NextColumn();
+        ImGui::Text("Live");
+        ImGui::NextColumn();
+        ImGui::Text("Peak");
+        ImGui::NextColumn();
+        ImGui::Text("Allocations");
+        ImGui::NextColumn();
+        ImGui::Separator();
+        for (int i = 0; i < Utility::MemoryTracker::TAG_COUNT; ++i) {
+            Utility::MemoryTracker::Tag tag = static_cast<Utility::MemoryTracker::Tag>(i);
+            Utility::MemoryTracker::Usage usage = Managers().profilingManager->GetMemoryUsage(tag);
+            ImGui::Text("%s", Utility::MemoryTracker::GetName(tag));
+            ImGui::NextColumn();
+            ImGui::Text("%.2f MiB", usage.liveBytes / 1024.0 / 1024.0);
+            ImGui::NextColumn();
+            ImGui::Text("%.2f MiB", usage.peakBytes / 1024.0 / 1024.0);
+            ImGui::NextColumn();
+            ImGui::Text("%u", static_cast<unsigned int>(usage.liveAllocations));
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+
+        if (ImGui::Button("Reset peaks"))
+            Managers().profilingManager->ResetMemoryPeaks();
     }
 
     /// Update log whether or not we're actually showing it.
@@ -12,6 +12,8 @@ EditorSettings::EditorSettings() {
     AddLongSetting("Width", "Graphics", "Width", 800);
     AddLongSetting("Height", "Graphics", "Height", 600);
     AddStringSetting("Theme", "Graphics", "Theme", "Default");
+
+    AddLongSetting("Physics Threads", "Physics", "Threads", 1);
     
     AddBoolSetting("Sound Source Icons", "View", "Sound Source Icons", true);
     AddBoolSetting("Particle Emitter Icons", "View", "Particle Emitter Icons", true);
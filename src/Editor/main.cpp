@@ -11,6 +11,7 @@
 #include <Engine/Manager/ScriptManager.hpp>
 #include <Engine/Manager/ProfilingManager.hpp>
 #include <Engine/Manager/ParticleManager.hpp>
+#include <Engine/Manager/PhysicsManager.hpp>
 #include <Engine/Manager/DebugDrawingManager.hpp>
 #include <Engine/Manager/RenderManager.hpp>
 #include <Engine/Manager/VRManager.hpp>
@@ -50,6 +51,7 @@ int main() {
     Input::GetInstance().SetWindow(window->GetGLFWWindow());
     
     Managers().StartUp();
+    Managers().physicsManager->SetThreadCount(EditorSettings::GetInstance().GetLong("Physics Threads"));
     
     Editor* editor = new Editor();
     // Setup imgui implementation.
@@ -57,6 +59,7 @@ int main() {
     
     bool profiling = false;
     GUI::ProfilingWindow profilingWindow;
+    ProfilingManager::SetThreadName("Main");
     
     // Main loop.
     double targetFPS = 60.0;
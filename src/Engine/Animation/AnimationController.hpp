@@ -36,7 +36,7 @@ namespace Animation {
             AnimationController() = default;
             
             /// Destructor.
-            ~AnimationController();
+            ENGINE_API ~AnimationController();
 
             /// Save animation controller.
             /**
@@ -7,9 +7,11 @@
 #include "../Util/FileSystem.hpp"
 #include "VorbisFile.hpp"
 #include <Utility/Log.hpp>
+#include <Utility/MemoryTracker.hpp>
 #include "../Audio/SoundStreamer.hpp"
 #include "../Manager/Managers.hpp"
 #include <cstring>
+#include <thread>
 
 #ifdef USINGMEMTRACK
 #include <MemTrackInclude.hpp>
@@ -39,8 +41,11 @@ float* SoundBuffer::GetChunkData(int& samples) {
 
     SoundStreamer::DataHandle* handle = chunkQueue.Front();
     while (handle->abort) {
-        while (!handle->done)
+        if (!handle->done) {
             Log() << "SoundBuffer::GetChunkData(" << soundFile->name << "): Blocking, chunk aborted but not done!\n";
+            while (!handle->done)
+                std::this_thread::yield();
+        }
         chunkQueue.Pop();
         if (chunkQueue.Empty()) {
             samples = 0;
@@ -49,8 +54,11 @@ float* SoundBuffer::GetChunkData(int& samples) {
         handle = chunkQueue.Front();
     }
 
-    while (!handle->done)
+    if (!handle->done) {
         Log() << "SoundBuffer::GetChunkData(" << soundFile->name << "): Blocking, chunk not done!\n";
+        while (!handle->done)
+            std::this_thread::yield();
+    }
     
     samples = handle->samples;
     return handle->data;
@@ -84,6 +92,7 @@ void SoundBuffer::SetSoundFile(SoundFile* soundFile) {
         if (buffer) {
             delete[] buffer;
             buffer = nullptr;
+            Utility::MemoryTracker::Free(Utility::MemoryTracker::AUDIO, sizeof(float) * CHUNK_SIZE * chunkCount);
         }
     }
 
@@ -94,6 +103,7 @@ void SoundBuffer::SetSoundFile(SoundFile* soundFile) {
     if (soundFile) {
         chunkCount = soundFile->IsCached() ? 1 : CHUNK_COUNT;
         buffer = new float[CHUNK_SIZE * chunkCount];
+        Utility::MemoryTracker::Allocate(Utility::MemoryTracker::AUDIO, sizeof(float) * CHUNK_SIZE * chunkCount);
         for (unsigned int i = 0; i < chunkCount; ++i)
             ProduceChunk();
     }
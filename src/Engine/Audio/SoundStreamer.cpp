@@ -3,6 +3,8 @@
 #include "SoundBuffer.hpp"
 #include "SoundFile.hpp"
 #include "../Component/SoundSource.hpp"
+#include "../Manager/ProfilingManager.hpp"
+#include "../Util/Profiling.hpp"
 
 using namespace Audio;
 
@@ -46,6 +48,8 @@ void SoundStreamer::Worker::Start(SoundStreamer* soundStreamer) {
 }
 
 void SoundStreamer::Worker::Execute(SoundStreamer* soundStreamer) {
+    ProfilingManager::SetThreadName("Sound streamer");
+
     while (!soundStreamer->stopWorker) {
         // Pop work from queue while work is available.
         while (!soundStreamer->loadQueue.Empty()) {
@@ -58,6 +62,7 @@ void SoundStreamer::Worker::Execute(SoundStreamer* soundStreamer) {
 
             // Load data from file.
             if (!handle->abort) {
+                PROFILE("Load sound data");
                 std::unique_lock<std::mutex> lock(soundStreamer->flushMutex, std::defer_lock);
                 lock.lock();
                 assert(handle->offset < handle->soundFile->GetSampleCount());
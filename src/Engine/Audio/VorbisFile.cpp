@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <stb_vorbis.c>
 #include <Utility/Log.hpp>
+#include <Utility/MemoryTracker.hpp>
 
 #ifdef USINGMEMTRACK
 #include <MemTrackInclude.hpp>
@@ -18,8 +19,10 @@ VorbisFile::~VorbisFile() {
     if (stbFile)
         stb_vorbis_close(stbFile);
 
-    if (buffer)
+    if (buffer) {
         delete[] buffer;
+        Utility::MemoryTracker::Free(Utility::MemoryTracker::AUDIO, sizeof(float) * sampleCount);
+    }
 }
 
 int VorbisFile::GetData(uint32_t offset, uint32_t samples, float* data) const {
@@ -62,10 +65,12 @@ void VorbisFile::Cache(bool cache) {
     if (buffer) {
         delete[] buffer;
         buffer = nullptr;
+        Utility::MemoryTracker::Free(Utility::MemoryTracker::AUDIO, sizeof(float) * sampleCount);
     }
 
     if (cache) {
         buffer = new float[sampleCount];
+        Utility::MemoryTracker::Allocate(Utility::MemoryTracker::AUDIO, sizeof(float) * sampleCount);
         stb_vorbis_get_samples_float_interleaved(stbFile, channelCount, buffer, sampleCount);
     }
 }
@@ -16,7 +16,7 @@ namespace Component {
     class AnimationController : public SuperComponent {
         public:
             /// Create new animation controller component.
-            AnimationController();
+            ENGINE_API AnimationController();
 
             /// Save the component.
             /**
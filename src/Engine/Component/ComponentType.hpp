@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Component {
+    class AnimationController;
+    class AudioMaterial;
+    class DirectionalLight;
+    class Lens;
+    class Listener;
+    class Material;
+    class Mesh;
+    class ParticleSystemComponent;
+    class PointLight;
+    class RigidBody;
+    class Script;
+    class Shape;
+    class SoundSource;
+    class SpotLight;
+    class VRDevice;
+    class Trigger;
+
+    /// Identifiers of the component types.
+    /**
+     * Used to index the component slots of entities. New component types
+     * need an identifier here and a TypeOf specialization below.
+     */
+    enum Type : unsigned int {
+        ANIMATION_CONTROLLER = 0, ///< AnimationController.
+        AUDIO_MATERIAL, ///< AudioMaterial.
+        DIRECTIONAL_LIGHT, ///< DirectionalLight.
+        LENS, ///< Lens.
+        LISTENER, ///< Listener.
+        MATERIAL, ///< Material.
+        MESH, ///< Mesh.
+        PARTICLE_SYSTEM, ///< ParticleSystemComponent.
+        POINT_LIGHT, ///< PointLight.
+        RIGID_BODY, ///< RigidBody.
+        SCRIPT, ///< Script.
+        SHAPE, ///< Shape.
+        SOUND_SOURCE, ///< SoundSource.
+        SPOT_LIGHT, ///< SpotLight.
+        VR_DEVICE, ///< VRDevice.
+        TRIGGER, ///< Trigger.
+        TYPE_COUNT ///< Number of component types, ensure this is the last element of the enum.
+    };
+
+    /// Bitmask with one bit per component type.
+    typedef uint32_t TypeMask;
+
+    static_assert(TYPE_COUNT <= sizeof(TypeMask) * 8, "TypeMask has too few bits for all component types.");
+
+    /// Get the identifier of a component type at compile time.
+    /**
+     * Usage: TypeOf<Mesh>::type
+     */
+    template<typename T> struct TypeOf;
+
+    /// @cond
+    template<> struct TypeOf<AnimationController> { static const Type type = ANIMATION_CONTROLLER; };
+    template<> struct TypeOf<AudioMaterial> { static const Type type = AUDIO_MATERIAL; };
+    template<> struct TypeOf<DirectionalLight> { static const Type type = DIRECTIONAL_LIGHT; };
+    template<> struct TypeOf<Lens> { static const Type type = LENS; };
+    template<> struct TypeOf<Listener> { static const Type type = LISTENER; };
+    template<> struct TypeOf<Material> { static const Type type = MATERIAL; };
+    template<> struct TypeOf<Mesh> { static const Type type = MESH; };
+    template<> struct TypeOf<ParticleSystemComponent> { static const Type type = PARTICLE_SYSTEM; };
+    template<> struct TypeOf<PointLight> { static const Type type = POINT_LIGHT; };
+    template<> struct TypeOf<RigidBody> { static const Type type = RIGID_BODY; };
+    template<> struct TypeOf<Script> { static const Type type = SCRIPT; };
+    template<> struct TypeOf<Shape> { static const Type type = SHAPE; };
+    template<> struct TypeOf<SoundSource> { static const Type type = SOUND_SOURCE; };
+    template<> struct TypeOf<SpotLight> { static const Type type = SPOT_LIGHT; };
+    template<> struct TypeOf<VRDevice> { static const Type type = VR_DEVICE; };
+    template<> struct TypeOf<Trigger> { static const Type type = TRIGGER; };
+    /// @endcond
+
+    /// Get the mask of a component type.
+    /**
+     * @return The mask with the bit of the component type set.
+     */
+    template<typename T> constexpr TypeMask MaskOf() {
+        return TypeMask(1) << TypeOf<T>::type;
+    }
+
+    /// Get the mask of several component types.
+    /**
+     * Usage: MaskOf<Mesh, Material>()
+     * @return The mask with the bits of all the component types set.
+     */
+    template<typename T, typename U, typename... Rest> constexpr TypeMask MaskOf() {
+        return MaskOf<T>() | MaskOf<U, Rest...>();
+    }
+}
@@ -1,6 +1,7 @@
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 #include "../Physics/GlmConversion.hpp"
+#include "../Physics/MotionState.hpp"
 #include "../Physics/Shape.hpp"
 #include "RigidBody.hpp"
 
@@ -67,14 +68,14 @@ namespace Component {
         return ghost ? ghostObject : static_cast<btCollisionObject*>(rigidBody);
     }
 
-    void RigidBody::NewBulletRigidBody(float mass) {
+    void RigidBody::NewBulletRigidBody(float mass, std::vector<RigidBody*>& movedBodies) {
         Destroy();
 
         this->mass = mass;
 
         // Motion states inform us of movement caused by physics so that we can
         // deal with those changes as needed.
-        btDefaultMotionState* motionState = new btDefaultMotionState(btTransform(btQuaternion(0, 0, 0, 1), btVector3(0, 0, 0)));
+        Physics::MotionState* motionState = new Physics::MotionState(this, movedBodies);
 
         // Bullet treats zero mass as infinite, resulting in immovable objects.
         btRigidBody::btRigidBodyConstructionInfo constructionInfo(mass, motionState, nullptr, btVector3(0, 0, 0));
@@ -84,6 +85,21 @@ namespace Component {
         ghostObject = new btGhostObject();
         ghostObject->setWorldTransform(btTransform(btQuaternion(0, 0, 0, 1), btVector3(0, 0, 0)));
         ghostObject->setCollisionFlags(ghostObject->getCollisionFlags() | btCollisionObject::CF_NO_CONTACT_RESPONSE);
+        ghostObject->setUserPointer(this);
+    }
+
+    void RigidBody::ClearMoved() {
+        static_cast<Physics::MotionState*>(rigidBody->getMotionState())->ClearMoved();
+    }
+
+    bool RigidBody::UpdateSyncedTransform(const glm::vec3& position, const glm::quat& orientation) {
+        if (transformSynced && position == syncedPosition && orientation == syncedOrientation)
+            return false;
+
+        syncedPosition = position;
+        syncedOrientation = orientation;
+        transformSynced = true;
+        return true;
     }
 
     void RigidBody::Destroy() {
@@ -206,16 +222,19 @@ namespace Component {
         rigidBody->setCollisionFlags(rigidBody->getCollisionFlags() | btCollisionObject::CF_KINEMATIC_OBJECT);
         kinematic = true;
         ghost = false;
+        transformSynced = false;
     }
 
     void RigidBody::MakeDynamic() {
         rigidBody->setCollisionFlags(rigidBody->getCollisionFlags() & ~btCollisionObject::CF_KINEMATIC_OBJECT);
         kinematic = false;
         ghost = false;
+        transformSynced = false;
     }
 
     void RigidBody::SetGhost(bool ghost) {
         this->ghost = ghost;
+        transformSynced = false;
     }
 
     bool RigidBody::GetForceTransformSync() const {
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <memory>
+#include <vector>
 #include "SuperComponent.hpp"
 #include "../linking.hpp"
 
@@ -100,8 +102,18 @@ namespace Component {
             btCollisionObject* GetBulletCollisionObject();
 
             // Creates the underlying Bullet rigid body. Mass is provided in
-            // units of kilograms.
-            void NewBulletRigidBody(float mass);
+            // units of kilograms. The component is added to |movedBodies|
+            // whenever Bullet moves the body.
+            void NewBulletRigidBody(float mass, std::vector<RigidBody*>& movedBodies);
+
+            // Allow the component to be added to the list of moved bodies
+            // again, after the move has been handled.
+            void ClearMoved();
+
+            // Record the entity transform pushed to a kinematic or ghost
+            // body. Returns whether it differs from the previously pushed
+            // transform.
+            bool UpdateSyncedTransform(const glm::vec3& position, const glm::quat& orientation);
 
             // Destroy resources completely.
             void Destroy();
@@ -163,5 +175,8 @@ namespace Component {
             float angularDamping = 0.0f;
             bool ghost = false;
             std::shared_ptr<Physics::Shape> shape;
+            glm::vec3 syncedPosition;
+            glm::quat syncedOrientation;
+            bool transformSynced = false;
     };
 }
@@ -17,20 +17,134 @@
 #include "../Component/ParticleSystem.hpp"
 #include "../Component/VRDevice.hpp"
 #include "../Component/Trigger.hpp"
+#include "../Util/BinaryScene.hpp"
 #include "../Util/Json.hpp"
-#include "../Util/FileSystem.hpp"
+#include "../Util/SceneNode.hpp"
 #include <Utility/Log.hpp>
-#include "../Hymn.hpp"
-#include <fstream>
+#include "SceneTemplate.hpp"
 #include "../Manager/Managers.hpp"
+#include "../Manager/AnimationManager.hpp"
 #include "../Manager/ParticleManager.hpp"
 #include "../Manager/PhysicsManager.hpp"
 #include "../Manager/RenderManager.hpp"
+#include "../Manager/ResourceManager.hpp"
 #include "../Manager/ScriptManager.hpp"
 #include "../Manager/SoundManager.hpp"
 #include "../Manager/VRManager.hpp"
 #include "../Manager/TriggerManager.hpp"
 
+namespace {
+    // Saved name of each component type, in the order they are loaded.
+    struct ComponentName {
+        Component::Type type;
+        const char* name;
+    };
+
+    const ComponentName COMPONENT_NAMES[] = {
+        { Component::ANIMATION_CONTROLLER, "AnimationController" },
+        { Component::AUDIO_MATERIAL, "AudioMaterial" },
+        { Component::LENS, "Lens" },
+        { Component::MESH, "Mesh" },
+        { Component::MATERIAL, "Material" },
+        { Component::DIRECTIONAL_LIGHT, "DirectionalLight" },
+        { Component::POINT_LIGHT, "PointLight" },
+        { Component::SPOT_LIGHT, "SpotLight" },
+        { Component::RIGID_BODY, "RigidBody" },
+        { Component::LISTENER, "Listener" },
+        { Component::SCRIPT, "Script" },
+        { Component::SHAPE, "Shape" },
+        { Component::SOUND_SOURCE, "SoundSource" },
+        { Component::PARTICLE_SYSTEM, "ParticleSystem" },
+        { Component::VR_DEVICE, "VRDevice" },
+        { Component::TRIGGER, "Trigger" }
+    };
+
+    const std::size_t COMPONENT_NAME_COUNT = sizeof(COMPONENT_NAMES) / sizeof(COMPONENT_NAMES[0]);
+
+    glm::vec3 LoadVec3(const BinaryScene::Reader& reader, std::size_t value) {
+        glm::vec3 vector;
+        if (!reader.GetVec3(value, vector)) {
+            // Not stored as raw floats, eg. missing or integer coordinates.
+            Json::Value node;
+            reader.Decode(value, node);
+            vector = Json::LoadVec3(node);
+        }
+        return vector;
+    }
+
+    glm::quat LoadQuaternion(const BinaryScene::Reader& reader, std::size_t value) {
+        glm::quat quaternion;
+        if (!reader.GetQuaternion(value, quaternion)) {
+            Json::Value node;
+            reader.Decode(value, node);
+            quaternion = Json::LoadQuaternion(node);
+        }
+        return quaternion;
+    }
+
+    // Whether the manager that creates a type of component has been started.
+    bool IsManagerStarted(Component::Type componentType) {
+        switch (componentType) {
+        case Component::ANIMATION_CONTROLLER:
+            return Managers().animationManager != nullptr;
+        case Component::MATERIAL:
+            // Textures need a graphics context.
+            return Managers().renderManager != nullptr && !Managers().renderManager->IsHeadless();
+        case Component::DIRECTIONAL_LIGHT:
+        case Component::LENS:
+        case Component::MESH:
+        case Component::POINT_LIGHT:
+        case Component::SPOT_LIGHT:
+            return Managers().renderManager != nullptr;
+        case Component::AUDIO_MATERIAL:
+        case Component::LISTENER:
+        case Component::SOUND_SOURCE:
+            return Managers().soundManager != nullptr;
+        case Component::PARTICLE_SYSTEM:
+            return Managers().particleManager != nullptr;
+        case Component::RIGID_BODY:
+        case Component::SHAPE:
+            return Managers().physicsManager != nullptr;
+        case Component::SCRIPT:
+            return Managers().scriptManager != nullptr;
+        case Component::VR_DEVICE:
+            return Managers().vrManager != nullptr;
+        case Component::TRIGGER:
+            return Managers().triggerManager != nullptr;
+        default:
+            return true;
+        }
+    }
+}
+
+// Indices of the keys used by entities in a binary scene's string table.
+struct Entity::BinaryKeys {
+    explicit BinaryKeys(const BinaryScene::Reader& reader) {
+        name = reader.FindString("name");
+        position = reader.FindString("position");
+        scale = reader.FindString("scale");
+        rotation = reader.FindString("rotation");
+        scene = reader.FindString("scene");
+        sceneName = reader.FindString("sceneName");
+        uid = reader.FindString("uid");
+        isStatic = reader.FindString("static");
+        children = reader.FindString("children");
+        for (std::size_t i = 0; i < COMPONENT_NAME_COUNT; ++i)
+            components[i] = reader.FindString(COMPONENT_NAMES[i].name);
+    }
+
+    uint32_t name;
+    uint32_t position;
+    uint32_t scale;
+    uint32_t rotation;
+    uint32_t scene;
+    uint32_t sceneName;
+    uint32_t uid;
+    uint32_t isStatic;
+    uint32_t children;
+    uint32_t components[COMPONENT_NAME_COUNT];
+};
+
 Entity::Entity(World* world, const std::string& name) : name(name) {
     this->world = world;
 }
@@ -50,6 +164,13 @@ Entity* Entity::AddChild(const std::string& name) {
     return child;
 }
 
+Entity* Entity::AddChild(const std::string& name, uint64_t uniqueIdentifier) {
+    Entity* child = world->CreateEntity(name, uniqueIdentifier);
+    child->parent = this;
+    children.push_back(child);
+    return child;
+}
+
 Entity* Entity::SetParent(Entity* newParent) {
     //We make sure we're not trying to put the root as a child.
     if (parent != nullptr) {
@@ -78,57 +199,33 @@ bool Entity::HasChild(const Entity* check_child, bool deep) const {
 }
 
 Entity* Entity::InstantiateScene(const std::string& name, const std::string& originScene) {
-    Json::Value root;
     Entity* child = AddChild();
-    bool error = false;
-    std::string filename = Hymn().GetPath() + "/" + name + ".json";
+    const SceneTemplate* sceneTemplate = Managers().resourceManager->GetSceneTemplate(name);
 
     // Checks if file exists.
-    if (FileSystem::FileExists(filename.c_str())) {
-        std::ifstream file1(filename);
-        file1 >> root;
-
-        CheckIfSceneExists(filename, error, originScene, root);
-
-        if (error == false) {
-            std::ifstream file(filename);
-            file >> root;
-            file.close();
-            child->Load(root);
-            child->scene = true;
-            child->sceneName = name;
-            Managers().triggerManager->InitiateUID();
-            Managers().triggerManager->InitiateVolumes();
-        }
-    } else {
+    if (!sceneTemplate->IsValid()) {
         child->name = "Error loading scene";
         Log() << "Couldn't find scene to load.";
+        return child;
     }
 
-    if (error) {
+    // Check that the scene doesn't (indirectly) contain the scene it's instantiated into.
+    if (name == originScene || sceneTemplate->ReferencesScene(originScene)) {
         child->name = "Error loading scene";
         Log() << "Scene is added in continous loop.";
+        return child;
     }
 
-    return child;
-}
+    child->LoadSceneTemplate(sceneTemplate);
+    child->scene = true;
+    child->sceneName = name;
 
-void Entity::CheckIfSceneExists(const std::string& filename, bool& error, const std::string& originScene, Json::Value root) {
-    // Loops through all the scene names.
-    for (unsigned int i = 0; i < root["children"].size(); ++i) {
-        if (root["children"][i]["scene"].asBool()) {
-            printf("%s", root["children"][i]["sceneName"].asString().c_str());
+    // Only initialize the triggers that were just created.
+    std::map<uint64_t, uint64_t> identifiers;
+    MapSceneIdentifiers(sceneTemplate, child, identifiers);
+    Managers().triggerManager->InitiateTriggers(child, identifiers);
 
-            if (originScene == root["children"][i]["sceneName"].asString())
-                error = true;
-
-            if (error)
-                break;
-        }
-
-        if (!error)
-            CheckIfSceneExists(filename, error, originScene, root["children"][i]);
-    }
+    return child;
 }
 
 const std::vector<Entity*>& Entity::GetChildren() const {
@@ -189,29 +286,17 @@ Json::Value Entity::Save() const {
     entity["scale"] = Json::SaveVec3(scale);
     entity["rotation"] = Json::SaveQuaternion(rotation);
     entity["scene"] = scene;
-    entity["uid"] = uniqueIdentifier;
+    entity["uid"] = static_cast<Json::UInt64>(uniqueIdentifier);
     entity["static"] = isStatic;
 
     if (scene) {
         entity["sceneName"] = sceneName;
     } else {
         // Save components.
-        Save<Component::AnimationController>(entity, "AnimationController");
-        Save<Component::AudioMaterial>(entity, "AudioMaterial");
-        Save<Component::Lens>(entity, "Lens");
-        Save<Component::Mesh>(entity, "Mesh");
-        Save<Component::Material>(entity, "Material");
-        Save<Component::DirectionalLight>(entity, "DirectionalLight");
-        Save<Component::PointLight>(entity, "PointLight");
-        Save<Component::SpotLight>(entity, "SpotLight");
-        Save<Component::RigidBody>(entity, "RigidBody");
-        Save<Component::Listener>(entity, "Listener");
-        Save<Component::Script>(entity, "Script");
-        Save<Component::Shape>(entity, "Shape");
-        Save<Component::SoundSource>(entity, "SoundSource");
-        Save<Component::ParticleSystemComponent>(entity, "ParticleSystem");
-        Save<Component::VRDevice>(entity, "VRDevice");
-        Save<Component::Trigger>(entity, "Trigger");
+        for (const ComponentName& component : COMPONENT_NAMES) {
+            if (components[component.type] != nullptr)
+                entity[component.name] = components[component.type]->Save();
+        }
 
         // Save children.
         Json::Value childNodes;
@@ -230,36 +315,25 @@ void Entity::Load(const Json::Value& node) {
         sceneName = node["sceneName"].asString();
 
         // Load scene.
-        std::string filename = Hymn().GetPath() + "/" + sceneName + ".json";
-        Json::Value root;
-        std::ifstream file(filename);
-        file >> root;
-        file.close();
-        Load(root);
+        const SceneTemplate* sceneTemplate = Managers().resourceManager->GetSceneTemplate(sceneName);
+        if (sceneTemplate->IsValid() && !sceneTemplate->ReferencesScene(sceneName))
+            LoadSceneTemplate(sceneTemplate);
+        else
+            Log() << "Couldn't load scene " << sceneName << ".\n";
 
         scene = true;
     } else {
         // Load components.
-        Load<Component::AnimationController>(node, "AnimationController");
-        Load<Component::AudioMaterial>(node, "AudioMaterial");
-        Load<Component::Lens>(node, "Lens");
-        Load<Component::Mesh>(node, "Mesh");
-        Load<Component::Material>(node, "Material");
-        Load<Component::DirectionalLight>(node, "DirectionalLight");
-        Load<Component::PointLight>(node, "PointLight");
-        Load<Component::SpotLight>(node, "SpotLight");
-        Load<Component::RigidBody>(node, "RigidBody");
-        Load<Component::Listener>(node, "Listener");
-        Load<Component::Script>(node, "Script");
-        Load<Component::Shape>(node, "Shape");
-        Load<Component::SoundSource>(node, "SoundSource");
-        Load<Component::ParticleSystemComponent>(node, "ParticleSystem");
-        Load<Component::VRDevice>(node, "VRDevice");
-        Load<Component::Trigger>(node, "Trigger");
+        for (const ComponentName& component : COMPONENT_NAMES) {
+            const Json::Value& componentNode = node[component.name];
+            if (!componentNode.isNull())
+                LoadComponent(component.type, componentNode);
+        }
 
         // Load children.
+        // Children claim their saved UIDs as they are created, so they keep them.
         for (unsigned int i = 0; i < node["children"].size(); ++i) {
-            Entity* entity = AddChild("");
+            Entity* entity = AddChild("", node["children"][i].get("uid", 0).asUInt64());
             entity->Load(node["children"][i]);
         }
     }
@@ -268,10 +342,13 @@ void Entity::Load(const Json::Value& node) {
     position = Json::LoadVec3(node["position"]);
     scale = Json::LoadVec3(node["scale"]);
     rotation = Json::LoadQuaternion(node["rotation"]);
-    uniqueIdentifier = node.get("uid", 0).asUInt();
     isStatic = node["static"].asBool();
 }
 
+void Entity::Load(const BinaryScene::Reader& reader, std::size_t node) {
+    Load(reader, node, BinaryKeys(reader));
+}
+
 glm::mat4 Entity::GetModelMatrix() const {
     glm::mat4 matrix = GetLocalMatrix();
 
@@ -363,136 +440,318 @@ bool Entity::IsEnabled() const {
     return enabled;
 }
 
-unsigned int Entity::GetUniqueIdentifier() const {
+uint64_t Entity::GetUniqueIdentifier() const {
     return uniqueIdentifier;
 }
 
-void Entity::SetUniqueIdentifier(unsigned int UID) {
-    uniqueIdentifier = UID;
+void Entity::SetUniqueIdentifier(uint64_t UID) {
+    if (world == nullptr) {
+        uniqueIdentifier = UID;
+        return;
+    }
+
+    // Freeing our own identifier would bump its generation and lose it.
+    if (UID == uniqueIdentifier)
+        return;
+
+    world->uniqueIdentifiers.Free(uniqueIdentifier);
+    uniqueIdentifier = world->uniqueIdentifiers.Reserve(UID, this);
 }
 
-Component::SuperComponent* Entity::AddComponent(std::type_index componentType) {
+Component::SuperComponent* Entity::AddComponent(Component::Type componentType) {
     // Check if component already exists.
-    if (components.find(componentType) != components.end())
+    if (components[componentType] != nullptr || !IsManagerStarted(componentType))
         return nullptr;
 
     Component::SuperComponent* component;
 
     // Create a component in the correct manager.
-    if (componentType == typeid(Component::AnimationController*))
-        component = Managers().renderManager->CreateAnimation();
-    else if (componentType == typeid(Component::AudioMaterial*))
+    switch (componentType) {
+    case Component::ANIMATION_CONTROLLER:
+        component = Managers().animationManager->CreateAnimation();
+        break;
+    case Component::AUDIO_MATERIAL:
         component = Managers().soundManager->CreateAudioMaterial();
-    else if (componentType == typeid(Component::DirectionalLight*))
+        break;
+    case Component::DIRECTIONAL_LIGHT:
         component = Managers().renderManager->CreateDirectionalLight();
-    else if (componentType == typeid(Component::Lens*))
+        break;
+    case Component::LENS:
         component = Managers().renderManager->CreateLens();
-    else if (componentType == typeid(Component::Listener*))
+        break;
+    case Component::LISTENER:
         component = Managers().soundManager->CreateListener();
-    else if (componentType == typeid(Component::Material*))
+        break;
+    case Component::MATERIAL:
         component = Managers().renderManager->CreateMaterial();
-    else if (componentType == typeid(Component::Mesh*))
+        break;
+    case Component::MESH:
         component = Managers().renderManager->CreateMesh();
-    else if (componentType == typeid(Component::ParticleSystemComponent*))
+        break;
+    case Component::PARTICLE_SYSTEM:
         component = Managers().particleManager->CreateAParticleSystem();
-    else if (componentType == typeid(Component::PointLight*))
+        break;
+    case Component::POINT_LIGHT:
         component = Managers().renderManager->CreatePointLight();
-    else if (componentType == typeid(Component::RigidBody*))
+        break;
+    case Component::RIGID_BODY:
         component = Managers().physicsManager->CreateRigidBody(this);
-    else if (componentType == typeid(Component::Script*))
+        break;
+    case Component::SCRIPT:
         component = Managers().scriptManager->CreateScript();
-    else if (componentType == typeid(Component::Shape*))
+        break;
+    case Component::SHAPE:
         component = Managers().physicsManager->CreateShape(this);
-    else if (componentType == typeid(Component::SoundSource*))
+        break;
+    case Component::SOUND_SOURCE:
         component = Managers().soundManager->CreateSoundSource();
-    else if (componentType == typeid(Component::SpotLight*))
+        break;
+    case Component::SPOT_LIGHT:
         component = Managers().renderManager->CreateSpotLight();
-    else if (componentType == typeid(Component::VRDevice*))
+        break;
+    case Component::VR_DEVICE:
         component = Managers().vrManager->CreateVRDevice();
-    else if (componentType == typeid(Component::Trigger*))
+        break;
+    case Component::TRIGGER:
         component = Managers().triggerManager->CreateTrigger();
-    else {
-        Log() << componentType.name() << " not assigned to a manager!" << "\n";
+        break;
+    default:
+        Log() << "Component type " << componentType << " not assigned to a manager!" << "\n";
         return nullptr;
     }
 
-    // Add component to our map.
-    components[componentType] = component;
-
-    // Set ourselves as the owner.
-    component->entity = this;
+    SetComponent(componentType, component);
 
     return component;
 }
 
-Component::SuperComponent* Entity::GetComponent(std::type_index componentType) const {
-    auto it = components.find(componentType);
-    if (it != components.end())
-        return it->second;
-    else
-        return nullptr;
-}
-
-void Entity::KillComponent(std::type_index componentType) {
-    if (components.find(componentType) != components.end()) {
+void Entity::KillComponent(Component::Type componentType) {
+    if (components[componentType] != nullptr) {
         components[componentType]->Kill();
-        components.erase(componentType);
+        components[componentType] = nullptr;
+        componentMask &= ~(Component::TypeMask(1) << componentType);
     }
 }
 
-void Entity::LoadComponent(std::type_index componentType, const Json::Value& node) {
+void Entity::LoadComponent(Component::Type componentType, const SceneNode& node) {
+    if (!IsManagerStarted(componentType))
+        return;
+
     Component::SuperComponent* component;
 
     // Create a component in the correct manager.
-    if (componentType == typeid(Component::AnimationController*))
-        component = Managers().renderManager->CreateAnimation(node);
-    else if (componentType == typeid(Component::AudioMaterial*))
+    switch (componentType) {
+    case Component::ANIMATION_CONTROLLER:
+        component = Managers().animationManager->CreateAnimation(node);
+        break;
+    case Component::AUDIO_MATERIAL:
         component = Managers().soundManager->CreateAudioMaterial(node);
-    else if (componentType == typeid(Component::DirectionalLight*))
+        break;
+    case Component::DIRECTIONAL_LIGHT:
         component = Managers().renderManager->CreateDirectionalLight(node);
-    else if (componentType == typeid(Component::Lens*))
+        break;
+    case Component::LENS:
         component = Managers().renderManager->CreateLens(node);
-    else if (componentType == typeid(Component::Listener*))
+        break;
+    case Component::LISTENER:
         component = Managers().soundManager->CreateListener(node);
-    else if (componentType == typeid(Component::Material*))
+        break;
+    case Component::MATERIAL:
         component = Managers().renderManager->CreateMaterial(node);
-    else if (componentType == typeid(Component::Mesh*))
+        break;
+    case Component::MESH:
         component = Managers().renderManager->CreateMesh(node);
-    else if (componentType == typeid(Component::ParticleSystemComponent*))
+        break;
+    case Component::PARTICLE_SYSTEM:
         component = Managers().particleManager->CreateParticleSystem(node);
-    else if (componentType == typeid(Component::PointLight*))
+        break;
+    case Component::POINT_LIGHT:
         component = Managers().renderManager->CreatePointLight(node);
-    else if (componentType == typeid(Component::RigidBody*))
+        break;
+    case Component::RIGID_BODY:
         component = Managers().physicsManager->CreateRigidBody(this, node);
-    else if (componentType == typeid(Component::Script*))
+        break;
+    case Component::SCRIPT:
         component = Managers().scriptManager->CreateScript(node);
-    else if (componentType == typeid(Component::Shape*))
+        break;
+    case Component::SHAPE:
         component = Managers().physicsManager->CreateShape(this, node);
-    else if (componentType == typeid(Component::SoundSource*))
+        break;
+    case Component::SOUND_SOURCE:
         component = Managers().soundManager->CreateSoundSource(node);
-    else if (componentType == typeid(Component::SpotLight*))
+        break;
+    case Component::SPOT_LIGHT:
         component = Managers().renderManager->CreateSpotLight(node);
-    else if (componentType == typeid(Component::VRDevice*))
+        break;
+    case Component::VR_DEVICE:
         component = Managers().vrManager->CreateVRDevice(node);
-    else if (componentType == typeid(Component::Trigger*))
+        break;
+    case Component::TRIGGER:
         component = Managers().triggerManager->CreateTrigger(node);
-    else {
-        Log() << componentType.name() << " not assigned to a manager!" << "\n";
+        break;
+    default:
+        Log() << "Component type " << componentType << " not assigned to a manager!" << "\n";
         return;
     }
 
-    // Add component to our map.
+    SetComponent(componentType, component);
+}
+
+void Entity::SetComponent(Component::Type componentType, Component::SuperComponent* component) {
+    // Add component to our slots.
     components[componentType] = component;
+    componentMask |= Component::TypeMask(1) << componentType;
 
     // Set ourselves as the owner.
     component->entity = this;
 }
 
+void Entity::Load(const BinaryScene::Reader& reader, std::size_t node, const BinaryKeys& keys) {
+    // Find the saved fields in a single pass over the entity's members.
+    std::size_t nameValue = BinaryScene::Reader::NO_VALUE;
+    std::size_t positionValue = BinaryScene::Reader::NO_VALUE;
+    std::size_t scaleValue = BinaryScene::Reader::NO_VALUE;
+    std::size_t rotationValue = BinaryScene::Reader::NO_VALUE;
+    std::size_t sceneValue = BinaryScene::Reader::NO_VALUE;
+    std::size_t sceneNameValue = BinaryScene::Reader::NO_VALUE;
+    std::size_t staticValue = BinaryScene::Reader::NO_VALUE;
+    std::size_t childrenValue = BinaryScene::Reader::NO_VALUE;
+    std::size_t componentValues[COMPONENT_NAME_COUNT];
+    for (std::size_t& componentValue : componentValues)
+        componentValue = BinaryScene::Reader::NO_VALUE;
+
+    uint32_t memberCount = reader.IsObject(node) ? reader.GetCount(node) : 0;
+    std::size_t memberPosition = memberCount > 0 ? reader.GetFirst(node) : 0;
+    for (uint32_t i = 0; i < memberCount; ++i) {
+        BinaryScene::Reader::Member member = reader.GetMember(memberPosition);
+        if (member.key == keys.name) {
+            nameValue = member.value;
+        } else if (member.key == keys.position) {
+            positionValue = member.value;
+        } else if (member.key == keys.scale) {
+            scaleValue = member.value;
+        } else if (member.key == keys.rotation) {
+            rotationValue = member.value;
+        } else if (member.key == keys.scene) {
+            sceneValue = member.value;
+        } else if (member.key == keys.sceneName) {
+            sceneNameValue = member.value;
+        } else if (member.key == keys.isStatic) {
+            staticValue = member.value;
+        } else if (member.key == keys.children) {
+            childrenValue = member.value;
+        } else {
+            for (std::size_t j = 0; j < COMPONENT_NAME_COUNT; ++j) {
+                if (member.key == keys.components[j])
+                    componentValues[j] = member.value;
+            }
+        }
+        memberPosition = reader.GetNext(member.value);
+    }
+
+    scene = reader.GetBool(sceneValue);
+
+    if (scene) {
+        const std::string* savedSceneName = reader.GetStringValue(sceneNameValue);
+        sceneName = savedSceneName != nullptr ? *savedSceneName : "";
+
+        // Load scene.
+        const SceneTemplate* sceneTemplate = Managers().resourceManager->GetSceneTemplate(sceneName);
+        if (sceneTemplate->IsValid() && !sceneTemplate->ReferencesScene(sceneName))
+            LoadSceneTemplate(sceneTemplate);
+        else
+            Log() << "Couldn't load scene " << sceneName << ".\n";
+
+        scene = true;
+    } else {
+        // Load components. The component loaders read their settings in place.
+        for (std::size_t i = 0; i < COMPONENT_NAME_COUNT; ++i) {
+            SceneNode componentNode(reader, componentValues[i]);
+            if (!componentNode.IsNull())
+                LoadComponent(COMPONENT_NAMES[i].type, componentNode);
+        }
+
+        // Load children.
+        uint32_t childCount = reader.IsArray(childrenValue) ? reader.GetCount(childrenValue) : 0;
+        std::size_t childValue = childCount > 0 ? reader.GetFirst(childrenValue) : 0;
+        for (uint32_t i = 0; i < childCount; ++i) {
+            Entity* entity = AddChild("", reader.GetUInt64(reader.FindMember(childValue, keys.uid)));
+            entity->Load(reader, childValue, keys);
+            childValue = reader.GetNext(childValue);
+        }
+    }
+
+    const std::string* savedName = reader.GetStringValue(nameValue);
+    name = savedName != nullptr ? *savedName : "";
+    position = LoadVec3(reader, positionValue);
+    scale = LoadVec3(reader, scaleValue);
+    rotation = LoadQuaternion(reader, rotationValue);
+    isStatic = reader.GetBool(staticValue);
+}
+
+void Entity::LoadSceneTemplate(const SceneTemplate* sceneTemplate) {
+    if (sceneTemplate->IsBinary())
+        Load(sceneTemplate->GetReader(), sceneTemplate->GetReader().GetRoot());
+    else
+        Load(sceneTemplate->GetRoot());
+}
+
+void Entity::MapSceneIdentifiers(const SceneTemplate* sceneTemplate, const Entity* entity, std::map<uint64_t, uint64_t>& identifiers) {
+    if (sceneTemplate->IsBinary())
+        MapSceneIdentifiers(sceneTemplate->GetReader(), sceneTemplate->GetReader().GetRoot(), entity, identifiers);
+    else
+        MapSceneIdentifiers(sceneTemplate->GetRoot(), entity, identifiers);
+}
+
+void Entity::MapSceneIdentifiers(const Json::Value& node, const Entity* entity, std::map<uint64_t, uint64_t>& identifiers) {
+    uint64_t savedUniqueIdentifier = node.get("uid", 0).asUInt64();
+    if (savedUniqueIdentifier != 0)
+        identifiers[savedUniqueIdentifier] = entity->uniqueIdentifier;
+
+    // The children of an instantiated scene come from its template.
+    if (node["scene"].asBool()) {
+        const SceneTemplate* sceneTemplate = Managers().resourceManager->GetSceneTemplate(node["sceneName"].asString());
+        if (sceneTemplate->IsValid() && !sceneTemplate->ReferencesScene(node["sceneName"].asString()))
+            MapSceneIdentifiers(sceneTemplate, entity, identifiers);
+        return;
+    }
+
+    const Json::Value& childNodes = node["children"];
+    for (unsigned int i = 0; i < childNodes.size() && i < entity->children.size(); ++i)
+        MapSceneIdentifiers(childNodes[i], entity->children[i], identifiers);
+}
+
+void Entity::MapSceneIdentifiers(const BinaryScene::Reader& reader, std::size_t node, const Entity* entity, std::map<uint64_t, uint64_t>& identifiers) {
+    uint64_t savedUniqueIdentifier = reader.GetUInt64(reader.FindMember(node, reader.FindString("uid")));
+    if (savedUniqueIdentifier != 0)
+        identifiers[savedUniqueIdentifier] = entity->uniqueIdentifier;
+
+    // The children of an instantiated scene come from its template.
+    if (reader.GetBool(reader.FindMember(node, reader.FindString("scene")))) {
+        const std::string* savedSceneName = reader.GetStringValue(reader.FindMember(node, reader.FindString("sceneName")));
+        std::string sceneName = savedSceneName != nullptr ? *savedSceneName : "";
+        const SceneTemplate* sceneTemplate = Managers().resourceManager->GetSceneTemplate(sceneName);
+        if (sceneTemplate->IsValid() && !sceneTemplate->ReferencesScene(sceneName))
+            MapSceneIdentifiers(sceneTemplate, entity, identifiers);
+        return;
+    }
+
+    std::size_t childNodes = reader.FindMember(node, reader.FindString("children"));
+    uint32_t childCount = reader.IsArray(childNodes) ? reader.GetCount(childNodes) : 0;
+    std::size_t childNode = childCount > 0 ? reader.GetFirst(childNodes) : 0;
+    for (uint32_t i = 0; i < childCount && i < entity->children.size(); ++i) {
+        MapSceneIdentifiers(reader, childNode, entity->children[i], identifiers);
+        childNode = reader.GetNext(childNode);
+    }
+}
+
 void Entity::KillHelper() {
     killed = true;
 
-    for (auto& it : components)
-        it.second->Kill();
+    for (Component::SuperComponent* component : components) {
+        if (component != nullptr)
+            component->Kill();
+    }
 
     for (Entity* child : children) {
         child->KillHelper();
@@ -2,18 +2,26 @@
 
 #include <map>
 #include <vector>
-#include <typeindex>
+#include <cstdint>
 #include <json/json.h>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include "../Component/SuperComponent.hpp"
+#include "../Component/ComponentType.hpp"
 #include <fstream>
 #include "../linking.hpp"
 
 class World;
+class SceneTemplate;
+class SceneNode;
+namespace BinaryScene {
+    class Reader;
+}
 
 /// %Entity containing various components.
 class Entity {
+    friend class World;
+
     public:
         /// Create new entity.
         /**
@@ -62,19 +70,13 @@ class Entity {
 
         /// Instantiate a scene as a child to this entity.
         /**
+         * The scene is parsed once and cached as a %SceneTemplate, so
+         * instantiating it again doesn't read the scene file.
          * @param name The name of the scene to instantiate.
+         * @param originScene The name of the scene being instantiated into, which may not be contained in the instantiated scene.
          * @return The created root entity of the scene.
          */
         ENGINE_API Entity* InstantiateScene(const std::string& name, const std::string& originScene);
-        
-        /// Check if scene already exists in any of json files.
-        /**
-         * @param filename The name of the scene to check.
-         * @param error Set to true inside the function if it allready exists.
-         * @param originScene Name of scene you want to check.
-         * @param root The json value of root scene.
-         */
-        ENGINE_API void CheckIfSceneExists(const std::string& filename, bool & error, const std::string& originScene, Json::Value root);
 
         /// Get all of the entity's children.
         /**
@@ -110,7 +112,7 @@ class Entity {
         
         /// Adds component with type T.
         /**
-         * @return The created component.
+         * @return The created component, or nullptr if the entity already has one or the manager of the component hasn't been started.
          */
         template<typename T> T* AddComponent();
         
@@ -122,6 +124,24 @@ class Entity {
         
         /// Kill component of type T.
         template <typename T> void KillComponent();
+
+        /// Get the mask of the component types the entity has.
+        /**
+         * @return The component mask.
+         */
+        Component::TypeMask GetComponentMask() const {
+            return componentMask;
+        }
+
+        /// Check whether the entity has all of a set of component types.
+        /**
+         * Usage: HasComponents(Component::MaskOf<Component::Mesh, Component::Material>())
+         * @param mask The mask of the component types to check for.
+         * @return Whether the entity has all of the component types.
+         */
+        bool HasComponents(Component::TypeMask mask) const {
+            return (componentMask & mask) == mask;
+        }
         
         /// Kill the entity, will be removed at the end of the frame.
         ENGINE_API void Kill();
@@ -140,9 +160,22 @@ class Entity {
         
         /// Load entity from JSON node.
         /**
+         * The entity keeps its unique identifier. Children are created with
+         * the identifiers saved in the node.
+         * Components of managers that haven't been started (see Hub::StartUpHeadless) are skipped.
          * @param node JSON node to load from.
          */
         ENGINE_API void Load(const Json::Value& node);
+
+        /// Load entity from a binary scene.
+        /**
+         * Identifiers are handled as when loading from a JSON node.
+         * The entity tree and the component settings are read directly from
+         * the binary scene, without decoding them into JSON nodes.
+         * @param reader Reader of the binary scene.
+         * @param node Offset of the entity's value in the scene.
+         */
+        ENGINE_API void Load(const BinaryScene::Reader& reader, std::size_t node);
         
         /// Get the model matrix.
         /**
@@ -261,13 +294,15 @@ class Entity {
         /**
          * @return The entity's UID
          */
-        ENGINE_API unsigned int GetUniqueIdentifier() const;
+        ENGINE_API uint64_t GetUniqueIdentifier() const;
            
         /// Set the entity's UID
         /**
+         * If the UID is already taken in the world, a new one is allocated and
+         * the requested UID is kept as an alias for the entity.
          * @param UID the entity's unique identifier to be set
          */
-        ENGINE_API void SetUniqueIdentifier(unsigned int UID);
+        ENGINE_API void SetUniqueIdentifier(uint64_t UID);
 
         /// Whether the entity is static.
         bool isStatic = false;
@@ -281,12 +316,18 @@ class Entity {
 
         
     private:
-        template<typename T> void Save(Json::Value& node, const std::string& name) const;
-        template<typename T> void Load(const Json::Value& node, const std::string& name);
-        ENGINE_API Component::SuperComponent* AddComponent(std::type_index componentType);
-        ENGINE_API Component::SuperComponent* GetComponent(std::type_index componentType) const;
-        ENGINE_API void KillComponent(std::type_index componentType);
-        ENGINE_API void LoadComponent(std::type_index componentType, const Json::Value& node);
+        struct BinaryKeys;
+
+        Entity* AddChild(const std::string& name, uint64_t uniqueIdentifier);
+        void Load(const BinaryScene::Reader& reader, std::size_t node, const BinaryKeys& keys);
+        void LoadSceneTemplate(const SceneTemplate* sceneTemplate);
+        ENGINE_API Component::SuperComponent* AddComponent(Component::Type componentType);
+        ENGINE_API void KillComponent(Component::Type componentType);
+        ENGINE_API void LoadComponent(Component::Type componentType, const SceneNode& node);
+        void SetComponent(Component::Type componentType, Component::SuperComponent* component);
+        static void MapSceneIdentifiers(const SceneTemplate* sceneTemplate, const Entity* entity, std::map<uint64_t, uint64_t>& identifiers);
+        static void MapSceneIdentifiers(const Json::Value& node, const Entity* entity, std::map<uint64_t, uint64_t>& identifiers);
+        static void MapSceneIdentifiers(const BinaryScene::Reader& reader, std::size_t node, const Entity* entity, std::map<uint64_t, uint64_t>& identifiers);
         void KillHelper();
         
         World* world;
@@ -295,36 +336,23 @@ class Entity {
         bool scene = false;
         std::string sceneName;
 
-        std::map<std::type_index, Component::SuperComponent*> components;
+        // Components indexed by their type identifier.
+        Component::SuperComponent* components[Component::TYPE_COUNT] = {};
+        Component::TypeMask componentMask = 0;
         
         bool killed = false;
         bool enabled = true;
-        unsigned int uniqueIdentifier = 0;
+        uint64_t uniqueIdentifier = 0;
 };
 
 template<typename T> T* Entity::AddComponent() {
-    std::type_index componentType = std::type_index(typeid(T*));
-    return static_cast<T*>(AddComponent(componentType));
+    return static_cast<T*>(AddComponent(Component::TypeOf<T>::type));
 }
 
 template<typename T> T* Entity::GetComponent() const {
-    return static_cast<T*>(GetComponent(std::type_index(typeid(T*))));
+    return static_cast<T*>(components[Component::TypeOf<T>::type]);
 }
 
 template <typename T> void Entity::KillComponent() {
-    KillComponent(typeid(T*));
-}
-
-template<typename T> void Entity::Save(Json::Value& node, const std::string& name) const {
-    Component::SuperComponent* component = GetComponent(std::type_index(typeid(T*)));
-    if (component != nullptr)
-        node[name] = component->Save();
-}
-
-template<typename T> void Entity::Load(const Json::Value& node, const std::string& name) {
-    Json::Value componentNode = node[name];
-    if (!componentNode.isNull()) {
-        std::type_index componentType = std::type_index(typeid(T*));
-        LoadComponent(componentType, componentNode);
-    }
+    KillComponent(Component::TypeOf<T>::type);
 }
@@ -0,0 +1,78 @@
+#include "SceneTemplate.hpp"
+
+#include "../Hymn.hpp"
+
+SceneTemplate::SceneTemplate(const std::string& name) : name(name) {
+    std::string filename = BinaryScene::FindSceneFile(Hymn().GetPath() + "/" + name);
+    if (!BinaryScene::ReadFile(filename, data))
+        return;
+
+    if (BinaryScene::IsBinary(data.data(), data.size())) {
+        if (!reader.Open(data.data(), data.size()))
+            return;
+        binary = true;
+        valid = true;
+
+        FindScenes(reader.GetRoot());
+    } else {
+        bool parsed = BinaryScene::Parse(data, root);
+        data.clear();
+        data.shrink_to_fit();
+        if (!parsed)
+            return;
+        valid = true;
+
+        FindScenes(root);
+    }
+
+    referencedScenes = directScenes;
+}
+
+const std::string& SceneTemplate::GetName() const {
+    return name;
+}
+
+bool SceneTemplate::IsValid() const {
+    return valid;
+}
+
+bool SceneTemplate::IsBinary() const {
+    return binary;
+}
+
+const Json::Value& SceneTemplate::GetRoot() const {
+    return root;
+}
+
+const BinaryScene::Reader& SceneTemplate::GetReader() const {
+    return reader;
+}
+
+bool SceneTemplate::ReferencesScene(const std::string& name) const {
+    return referencedScenes.find(name) != referencedScenes.end();
+}
+
+void SceneTemplate::FindScenes(const Json::Value& node) {
+    const Json::Value& children = node["children"];
+    for (unsigned int i = 0; i < children.size(); ++i) {
+        if (children[i]["scene"].asBool())
+            directScenes.insert(children[i]["sceneName"].asString());
+        else
+            FindScenes(children[i]);
+    }
+}
+
+void SceneTemplate::FindScenes(std::size_t node) {
+    std::size_t children = reader.FindMember(node, reader.FindString("children"));
+    uint32_t childCount = reader.IsArray(children) ? reader.GetCount(children) : 0;
+    std::size_t child = childCount > 0 ? reader.GetFirst(children) : 0;
+    for (uint32_t i = 0; i < childCount; ++i) {
+        if (reader.GetBool(reader.FindMember(child, reader.FindString("scene")))) {
+            const std::string* sceneName = reader.GetStringValue(reader.FindMember(child, reader.FindString("sceneName")));
+            directScenes.insert(sceneName != nullptr ? *sceneName : "");
+        } else {
+            FindScenes(child);
+        }
+        child = reader.GetNext(child);
+    }
+}
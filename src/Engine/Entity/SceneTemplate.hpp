@@ -0,0 +1,85 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <json/json.h>
+#include "../Util/BinaryScene.hpp"
+#include "../linking.hpp"
+
+class ResourceManager;
+
+/// Parsed scene file that entities can be instantiated from.
+/**
+ * Templates are created and cached by the %ResourceManager, so each scene file
+ * is only read and parsed once. They are immutable once created. Binary scenes
+ * (see BinaryScene::FindSceneFile) are kept encoded and read in place, JSON
+ * scenes are parsed into a value tree.
+ */
+class SceneTemplate {
+    friend class ResourceManager;
+
+    public:
+        /// Load a scene template from file.
+        /**
+         * @param name Name of the scene (relative to the hymn, without extension).
+         */
+        ENGINE_API explicit SceneTemplate(const std::string& name);
+
+        /// Get the name of the scene.
+        /**
+         * @return The name of the scene.
+         */
+        ENGINE_API const std::string& GetName() const;
+
+        /// Get whether the scene file could be loaded.
+        /**
+         * @return Whether the scene file was found.
+         */
+        ENGINE_API bool IsValid() const;
+
+        /// Get whether the scene was loaded from a binary scene.
+        /**
+         * @return Whether to use GetReader rather than GetRoot.
+         */
+        ENGINE_API bool IsBinary() const;
+
+        /// Get the root node of the scene.
+        /**
+         * @return The JSON node of the scene's root entity, null for binary scenes.
+         */
+        ENGINE_API const Json::Value& GetRoot() const;
+
+        /// Get the reader of a binary scene.
+        /**
+         * @return The reader, whose root is the scene's root entity.
+         */
+        ENGINE_API const BinaryScene::Reader& GetReader() const;
+
+        /// Get whether the scene instantiates another scene, directly or via
+        /// nested scenes.
+        /**
+         * @param name Name of the other scene.
+         * @return Whether the scene is referenced.
+         */
+        ENGINE_API bool ReferencesScene(const std::string& name) const;
+
+    private:
+        SceneTemplate(const SceneTemplate&) = delete;
+        void operator=(const SceneTemplate&) = delete;
+
+        void FindScenes(const Json::Value& node);
+        void FindScenes(std::size_t node);
+
+        std::string name;
+        bool valid = false;
+        bool binary = false;
+        Json::Value root;
+        std::string data;
+        BinaryScene::Reader reader;
+
+        // Scenes instantiated directly in this scene.
+        std::set<std::string> directScenes;
+
+        // Scenes instantiated directly or via nested scenes.
+        std::set<std::string> referencedScenes;
+};
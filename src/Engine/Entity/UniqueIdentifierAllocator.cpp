@@ -0,0 +1,128 @@
+#include "UniqueIdentifierAllocator.hpp"
+
+const uint64_t UniqueIdentifierAllocator::INVALID;
+const uint32_t UniqueIdentifierAllocator::MAX_RESERVED_INDEX;
+
+UniqueIdentifierAllocator::UniqueIdentifierAllocator() {
+
+}
+
+uint64_t UniqueIdentifierAllocator::Allocate(Entity* entity) {
+    // Reuse a free slot if there is one. Slots in the free list may have been
+    // claimed by Reserve since they were freed, so skip those.
+    while (!freeSlots.empty()) {
+        uint32_t index = freeSlots.back();
+        freeSlots.pop_back();
+
+        Slot& slot = slots[index];
+        if (slot.entity == nullptr) {
+            slot.entity = entity;
+            return MakeIdentifier(index, slot.generation);
+        }
+    }
+
+    // Otherwise add a new slot.
+    Slot slot;
+    slot.entity = entity;
+    slots.push_back(slot);
+    return MakeIdentifier(static_cast<uint32_t>(slots.size() - 1), slot.generation);
+}
+
+uint64_t UniqueIdentifierAllocator::Reserve(uint64_t identifier, Entity* entity) {
+    uint32_t index = GetIndex(identifier);
+    uint32_t generation = GetGeneration(identifier);
+
+    // Legacy identifiers don't map to a slot.
+    if (generation == 0) {
+        uint64_t allocated = Allocate(entity);
+        if (identifier != INVALID)
+            AddAlias(identifier, allocated);
+        return allocated;
+    }
+
+    // Don't trust indices from disk to size the slot array.
+    if (index > MAX_RESERVED_INDEX) {
+        uint64_t allocated = Allocate(entity);
+        AddAlias(identifier, allocated);
+        return allocated;
+    }
+
+    // Grow the slot array, marking the skipped slots as free.
+    if (index >= slots.size()) {
+        uint32_t oldSize = static_cast<uint32_t>(slots.size());
+        slots.resize(static_cast<std::size_t>(index) + 1);
+        for (uint32_t i = oldSize; i < index; ++i)
+            freeSlots.push_back(i);
+    }
+
+    Slot& slot = slots[index];
+    if (slot.entity != nullptr || generation < slot.generation) {
+        // The identifier is taken, eg. by another instance of the same scene,
+        // or its generation has been used already, so stale identifiers could
+        // resolve to the entity.
+        uint64_t allocated = Allocate(entity);
+        AddAlias(identifier, allocated);
+        return allocated;
+    }
+
+    slot.entity = entity;
+    slot.generation = generation;
+    return identifier;
+}
+
+void UniqueIdentifierAllocator::Free(uint64_t identifier) {
+    if (!IsValid(identifier))
+        return;
+
+    uint32_t index = GetIndex(identifier);
+    Slot& slot = slots[index];
+    slot.entity = nullptr;
+
+    for (uint64_t alias : slot.aliases)
+        aliases.erase(alias);
+    slot.aliases.clear();
+
+    // Generation 0 is reserved for legacy identifiers.
+    if (++slot.generation == 0)
+        slot.generation = 1;
+
+    freeSlots.push_back(index);
+}
+
+Entity* UniqueIdentifierAllocator::Get(uint64_t identifier) const {
+    uint32_t index = GetIndex(identifier);
+    if (index < slots.size() && slots[index].generation == GetGeneration(identifier))
+        return slots[index].entity;
+
+    auto it = aliases.find(identifier);
+    if (it != aliases.end()) {
+        index = GetIndex(it->second);
+        if (index < slots.size() && slots[index].generation == GetGeneration(it->second))
+            return slots[index].entity;
+    }
+
+    return nullptr;
+}
+
+bool UniqueIdentifierAllocator::IsValid(uint64_t identifier) const {
+    uint32_t index = GetIndex(identifier);
+    return index < slots.size() && slots[index].entity != nullptr && slots[index].generation == GetGeneration(identifier);
+}
+
+void UniqueIdentifierAllocator::Clear() {
+    // Nothing refers to the cleared entities anymore, so start over. Saved
+    // identifiers can then be reserved again when a world is reloaded.
+    slots.clear();
+    freeSlots.clear();
+    aliases.clear();
+}
+
+uint32_t UniqueIdentifierAllocator::GetSlotCount() const {
+    return static_cast<uint32_t>(slots.size());
+}
+
+void UniqueIdentifierAllocator::AddAlias(uint64_t alias, uint64_t identifier) {
+    // The first entity loaded with a duplicated identifier keeps it.
+    if (aliases.insert(std::make_pair(alias, identifier)).second)
+        slots[GetIndex(identifier)].aliases.push_back(alias);
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "../linking.hpp"
+
+class Entity;
+
+/// Hands out generational 64-bit unique identifiers for entities.
+/**
+ * The lower 32 bits of an identifier hold the index of a slot and the upper
+ * 32 bits hold the generation of that slot. When an identifier is freed its
+ * slot is reused with a bumped generation, so stale identifiers never resolve
+ * to a newer entity. Looking up or validating an identifier is O(1).
+ *
+ * Identifiers saved by older versions of the engine (32-bit timestamps) have a
+ * generation of 0. They can be registered as aliases of a real identifier so
+ * references stored in old scenes keep resolving.
+ */
+class UniqueIdentifierAllocator {
+    public:
+        /// Identifier that never refers to an entity.
+        static const uint64_t INVALID = 0;
+
+        /// Highest slot index Reserve will grow the slot array to.
+        /**
+         * Guards against corrupt identifiers allocating huge slot arrays.
+         */
+        static const uint32_t MAX_RESERVED_INDEX = 1u << 20;
+
+        /// Create new allocator.
+        ENGINE_API UniqueIdentifierAllocator();
+
+        /// Allocate a new identifier.
+        /**
+         * @param entity The entity the identifier refers to.
+         * @return The new identifier.
+         */
+        ENGINE_API uint64_t Allocate(Entity* entity);
+
+        /// Try to allocate a specific identifier, eg. one loaded from disk.
+        /**
+         * If the identifier is a legacy identifier, its slot is already in
+         * use, its generation is older than the slot's or its index is out of
+         * range, a new identifier is allocated instead and the requested one
+         * is registered as an alias of it.
+         * @param identifier The requested identifier.
+         * @param entity The entity the identifier refers to.
+         * @return The identifier that was allocated.
+         */
+        ENGINE_API uint64_t Reserve(uint64_t identifier, Entity* entity);
+
+        /// Free an identifier so its slot can be reused.
+        /**
+         * Aliases of the identifier are removed as well.
+         * @param identifier The identifier to free.
+         */
+        ENGINE_API void Free(uint64_t identifier);
+
+        /// Get the entity an identifier refers to.
+        /**
+         * @param identifier The identifier (or an alias) to look up.
+         * @return The entity or nullptr if the identifier is not valid.
+         */
+        ENGINE_API Entity* Get(uint64_t identifier) const;
+
+        /// Check whether an identifier refers to a live entity.
+        /**
+         * @param identifier The identifier to check.
+         * @return Whether the identifier is valid.
+         */
+        ENGINE_API bool IsValid(uint64_t identifier) const;
+
+        /// Free all identifiers and aliases.
+        /**
+         * Slots start over at their first generation, so the identifiers of a
+         * saved world can be reserved again when it's reloaded.
+         */
+        ENGINE_API void Clear();
+
+        /// Get the number of slots, live or free.
+        /**
+         * Can be used to size dense arrays indexed by GetIndex.
+         * @return The number of slots.
+         */
+        ENGINE_API uint32_t GetSlotCount() const;
+
+        /// Get the slot index of an identifier.
+        /**
+         * @param identifier The identifier.
+         * @return The slot index.
+         */
+        static uint32_t GetIndex(uint64_t identifier) {
+            return static_cast<uint32_t>(identifier & 0xFFFFFFFFu);
+        }
+
+        /// Get the generation of an identifier.
+        /**
+         * @param identifier The identifier.
+         * @return The generation.
+         */
+        static uint32_t GetGeneration(uint64_t identifier) {
+            return static_cast<uint32_t>(identifier >> 32);
+        }
+
+        /// Compose an identifier from a slot index and generation.
+        /**
+         * @param index The slot index.
+         * @param generation The generation.
+         * @return The identifier.
+         */
+        static uint64_t MakeIdentifier(uint32_t index, uint32_t generation) {
+            return (static_cast<uint64_t>(generation) << 32) | index;
+        }
+
+    private:
+        struct Slot {
+            Entity* entity = nullptr;
+            uint32_t generation = 1;
+            std::vector<uint64_t> aliases;
+        };
+
+        void AddAlias(uint64_t alias, uint64_t identifier);
+
+        std::vector<Slot> slots;
+        std::vector<uint32_t> freeSlots;
+        std::map<uint64_t, uint64_t> aliases;
+};
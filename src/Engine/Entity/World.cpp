@@ -4,11 +4,11 @@
 #include "../Component/SuperComponent.hpp"
 #include "../Manager/Managers.hpp"
 #include "../Manager/ParticleManager.hpp"
+#include "../Manager/ResourceManager.hpp"
 #include "../Manager/TriggerManager.hpp"
+#include "../Util/BinaryScene.hpp"
 #include "../Util/FileSystem.hpp"
 #include "../Hymn.hpp"
-#include <fstream>
-#include <ctime>
 
 #ifdef USINGMEMTRACK
 #include <MemTrackInclude.hpp>
@@ -25,7 +25,14 @@ World::~World() {
 Entity* World::CreateEntity(const std::string& name) {
     Entity* entity = new Entity(this, name);
     entities.push_back(entity);
-    entity->SetUniqueIdentifier(std::time(nullptr));
+    entity->uniqueIdentifier = uniqueIdentifiers.Allocate(entity);
+    return entity;
+}
+
+Entity* World::CreateEntity(const std::string& name, uint64_t uniqueIdentifier) {
+    Entity* entity = new Entity(this, name);
+    entities.push_back(entity);
+    entity->uniqueIdentifier = uniqueIdentifiers.Reserve(uniqueIdentifier, entity);
     return entity;
 }
 
@@ -33,6 +40,13 @@ const std::vector<Entity*>& World::GetEntities() const {
     return entities;
 }
 
+void World::GetEntitiesWith(Component::TypeMask mask, std::vector<Entity*>& result) const {
+    for (Entity* entity : entities) {
+        if (!entity->IsKilled() && entity->HasComponents(mask))
+            result.push_back(entity);
+    }
+}
+
 void World::CreateRoot() {
     root = CreateEntity("Root");
 }
@@ -41,6 +55,14 @@ Entity* World::GetRoot() const {
     return root;
 }
 
+Entity* World::GetEntityByUniqueIdentifier(uint64_t uniqueIdentifier) const {
+    return uniqueIdentifiers.Get(uniqueIdentifier);
+}
+
+const UniqueIdentifierAllocator& World::GetUniqueIdentifiers() const {
+    return uniqueIdentifiers;
+}
+
 void World::RegisterUpdate(Entity* entity) {
     updateEntities.push_back(entity);
 }
@@ -61,9 +83,15 @@ void World::Clear() {
     for (Entity* entity : entities)
         delete entity;
     entities.clear();
+    uniqueIdentifiers.Clear();
     root = nullptr;
 
     updateEntities.clear();
+    ++clearCount;
+}
+
+unsigned int World::GetClearCount() const {
+    return clearCount;
 }
 
 void World::ClearKilled() {
@@ -74,6 +102,7 @@ void World::ClearKilled() {
     std::size_t i = 0;
     while (i < entities.size()) {
         if (entities[i]->IsKilled()) {
+            uniqueIdentifiers.Free(entities[i]->GetUniqueIdentifier());
             delete entities[i];
             entities[i] = entities[entities.size() - 1];
             entities.pop_back();
@@ -83,12 +112,19 @@ void World::ClearKilled() {
     }
 }
 
-void World::Save(const std::string& filename) const {
+void World::Save(const std::string& filename, bool binary) const {
     Json::Value rootNode = root->Save();
+    BinaryScene::SaveFile(filename, rootNode, binary);
 
-    std::ofstream file(filename);
-    file << rootNode;
-    file.close();
+    // Binary scenes are loaded in favor of JSON scenes, so keep them up to date.
+    if (!binary && FileSystem::GetExtension(filename) == "json") {
+        std::string binaryFilename = filename.substr(0, filename.size() - 5) + BinaryScene::EXTENSION;
+        if (FileSystem::FileExists(binaryFilename.c_str()))
+            BinaryScene::SaveFile(binaryFilename, rootNode, true);
+    }
+
+    // Scenes instantiating this scene need to see the changes.
+    Managers().resourceManager->ClearSceneTemplates();
 }
 
 Json::Value World::GetSaveJson() const {
@@ -98,28 +134,48 @@ Json::Value World::GetSaveJson() const {
 void World::Load(const std::string& filename) {
     Clear();
 
-    CreateRoot();
+    // Binary scenes are read in place, JSON scenes are parsed first.
+    std::string data;
+    if (BinaryScene::ReadFile(filename, data)) {
+        if (BinaryScene::IsBinary(data.data(), data.size())) {
+            BinaryScene::Reader reader;
+            if (reader.Open(data.data(), data.size()))
+                LoadRoot(reader);
+        } else {
+            Json::Value rootNode;
+            if (BinaryScene::Parse(data, rootNode))
+                LoadRoot(rootNode);
+        }
+    }
 
-    // Load Json document from file.
-    if (FileSystem::FileExists(filename.c_str())) {
-        Json::Value rootNode;
-        std::ifstream file(filename);
-        file >> rootNode;
-        file.close();
+    if (root == nullptr)
+        CreateRoot();
 
-        root->Load(rootNode);
-       
-    }
         Managers().triggerManager->InitiateUID();
         Managers().triggerManager->InitiateVolumes();
 }
 
 void World::Load(const Json::Value& node) {
+    Clear();
+    LoadRoot(node);
+    Managers().triggerManager->InitiateUID();
+    Managers().triggerManager->InitiateVolumes();
+}
 
+void World::Load(const BinaryScene::Reader& reader) {
     Clear();
-    CreateRoot();
-    root->Load(node);
+    LoadRoot(reader);
     Managers().triggerManager->InitiateUID();
     Managers().triggerManager->InitiateVolumes();
 }
 
+void World::LoadRoot(const Json::Value& node) {
+    // Claim the saved UID directly, so it survives saving and loading.
+    root = CreateEntity("Root", node.get("uid", 0).asUInt64());
+    root->Load(node);
+}
+
+void World::LoadRoot(const BinaryScene::Reader& reader) {
+    root = CreateEntity("Root", reader.GetUInt64(reader.FindMember(reader.GetRoot(), reader.FindString("uid"))));
+    root->Load(reader, reader.GetRoot());
+}
@@ -3,12 +3,18 @@
 #include <vector>
 #include <map>
 #include <typeinfo>
+#include <cstdint>
+#include "UniqueIdentifierAllocator.hpp"
+#include "../Component/ComponentType.hpp"
 #include "../linking.hpp"
 
 class Entity;
 namespace Json {
     class Value;
 }
+namespace BinaryScene {
+    class Reader;
+}
 
 /// The game world containing all entities.
 class World {
@@ -33,6 +39,13 @@ class World {
          * @return The entities in the world.
          */
         ENGINE_API const std::vector<Entity*>& GetEntities() const;
+
+        /// Get all the entities that have a set of component types.
+        /**
+         * @param mask Mask of the component types, eg. Component::MaskOf<Component::Mesh, Component::Material>().
+         * @param result Vector to add the matching entities to.
+         */
+        ENGINE_API void GetEntitiesWith(Component::TypeMask mask, std::vector<Entity*>& result) const;
         
         /// Create root entity.
         ENGINE_API void CreateRoot();
@@ -42,6 +55,19 @@ class World {
          * @return The root entity.
          */
         ENGINE_API Entity* GetRoot() const;
+
+        /// Find an entity by its unique identifier.
+        /**
+         * @param uniqueIdentifier The unique identifier of the entity.
+         * @return The entity or nullptr if no live entity has the identifier.
+         */
+        ENGINE_API Entity* GetEntityByUniqueIdentifier(uint64_t uniqueIdentifier) const;
+
+        /// Get the allocator handing out unique identifiers in the world.
+        /**
+         * @return The unique identifier allocator.
+         */
+        ENGINE_API const UniqueIdentifierAllocator& GetUniqueIdentifiers() const;
         
         /// Register an entity to receive update events.
         /**
@@ -57,6 +83,14 @@ class World {
         
         /// Clear the world of all entities.
         ENGINE_API void Clear();
+
+        /// Get the number of times the world has been cleared.
+        /**
+         * Loading a world clears it first. Anything referring to the world's
+         * resources, eg. a render snapshot, is stale once the count changes.
+         * @return The number of times the world has been cleared.
+         */
+        ENGINE_API unsigned int GetClearCount() const;
         
         /// Removes all killed entities and components in the world.
         ENGINE_API void ClearKilled();
@@ -75,9 +109,13 @@ class World {
         
         /// Save the world to file.
         /**
+         * When saving a JSON scene that has a binary scene next to it, the
+         * binary scene is rewritten as well, since it is loaded in favor of
+         * the JSON scene.
          * @param filename The name of the file.
+         * @param binary Whether to save in the binary scene format instead of JSON.
          */
-        ENGINE_API void Save(const std::string& filename) const;
+        ENGINE_API void Save(const std::string& filename, bool binary = false) const;
 
         /// Get a json file representing the root.
         /**
@@ -87,6 +125,8 @@ class World {
 
         /// Load the world from file.
         /**
+         * The file may be either a JSON or a binary scene. Binary scenes are
+         * read in place, without parsing them into a JSON tree.
          * @param filename The name of the file.
          */
         ENGINE_API void Load(const std::string& filename);
@@ -97,14 +137,32 @@ class World {
          */
         ENGINE_API void Load(const Json::Value& node);
 
+        /// Load the world from a binary scene.
+        /**
+         * @param reader Reader of the binary scene to load.
+         */
+        ENGINE_API void Load(const BinaryScene::Reader& reader);
+
     private:
         // Copy constructor.
         World(World& world) = delete;
+
+        // Create an entity with a saved unique identifier, allocating a new one if it's taken.
+        Entity* CreateEntity(const std::string& name, uint64_t uniqueIdentifier);
+
+        // Create the root entity and load the scene into it.
+        void LoadRoot(const Json::Value& node);
+        void LoadRoot(const BinaryScene::Reader& reader);
         
         // List of all entities in this world.
         std::vector<Entity*> entities;
         Entity* root = nullptr;
+
+        // Unique identifiers of the entities.
+        UniqueIdentifierAllocator uniqueIdentifiers;
         
         // Entities registered for update event.
         std::vector<Entity*> updateEntities;
+
+        unsigned int clearCount = 0;
 };
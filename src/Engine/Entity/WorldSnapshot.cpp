@@ -0,0 +1,54 @@
+#include "WorldSnapshot.hpp"
+
+#include <json/json.h>
+#include "World.hpp"
+#include "../Manager/Managers.hpp"
+#include "../Manager/ResourceManager.hpp"
+#include "../Util/BinaryScene.hpp"
+
+WorldSnapshot::WorldSnapshot() {
+
+}
+
+WorldSnapshot::~WorldSnapshot() {
+
+}
+
+void WorldSnapshot::Capture(const World& world) {
+    Clear();
+
+    data = BinaryScene::Write(world.GetSaveJson());
+
+    Managers().resourceManager->RetainResources();
+    retainingResources = true;
+}
+
+bool WorldSnapshot::Restore(World& world) const {
+    if (data.empty())
+        return false;
+
+    BinaryScene::Reader reader;
+    if (!reader.Open(data.data(), data.size()))
+        return false;
+
+    world.Load(reader);
+    return true;
+}
+
+void WorldSnapshot::Clear() {
+    data.clear();
+    data.shrink_to_fit();
+
+    if (retainingResources) {
+        Managers().resourceManager->ReleaseResources();
+        retainingResources = false;
+    }
+}
+
+bool WorldSnapshot::IsEmpty() const {
+    return data.empty();
+}
+
+std::size_t WorldSnapshot::GetSize() const {
+    return data.size();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "../linking.hpp"
+
+class World;
+
+/// In-memory snapshot of a world, eg. the editor state while playing.
+/**
+ * The world is stored as a binary scene buffer. While a snapshot is held,
+ * all resources that were loaded when it was captured are kept alive, so
+ * restoring it doesn't have to load models, textures or sounds again.
+ *
+ * Restoring still rebuilds the world: all entities and components are
+ * destroyed and created again from the buffer. Only the resource loading
+ * and the parsing of a JSON scene are avoided.
+ */
+class WorldSnapshot {
+    public:
+        /// Create new empty snapshot.
+        ENGINE_API WorldSnapshot();
+
+        /// Destructor.
+        /**
+         * Does not release the retained resources, since the resource
+         * manager may already be shut down. Call Clear first.
+         */
+        ENGINE_API ~WorldSnapshot();
+
+        /// Capture the state of a world, replacing any previous state.
+        /**
+         * @param world The world to capture.
+         */
+        ENGINE_API void Capture(const World& world);
+
+        /// Restore the captured state into a world.
+        /**
+         * The world is cleared and loaded from the snapshot, see
+         * World::Load. The snapshot is kept, so it can be restored again.
+         * @param world The world to restore into.
+         * @return Whether a state was restored.
+         */
+        ENGINE_API bool Restore(World& world) const;
+
+        /// Discard the captured state and release the retained resources.
+        ENGINE_API void Clear();
+
+        /// Get whether the snapshot holds a captured state.
+        /**
+         * @return Whether the snapshot is empty.
+         */
+        ENGINE_API bool IsEmpty() const;
+
+        /// Get the size of the captured state.
+        /**
+         * @return The size in bytes.
+         */
+        ENGINE_API std::size_t GetSize() const;
+
+    private:
+        WorldSnapshot(const WorldSnapshot& other) = delete;
+        void operator=(const WorldSnapshot&) = delete;
+
+        std::string data;
+        bool retainingResources = false;
+};
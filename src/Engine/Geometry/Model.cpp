@@ -3,7 +3,9 @@
 #include <cstring>
 #include "../Hymn.hpp"
 #include <Utility/Log.hpp>
+#include <Utility/MemoryTracker.hpp>
 #include "MeshData.hpp"
+#include <GLFW/glfw3.h> // Must be included at the end to make sure gl.h is included AFTER glew.h
 
 using namespace Geometry;
 
@@ -12,7 +14,8 @@ Model::Model() {
 }
 
 Model::~Model() {
-
+    if (memoryUsage > 0)
+        Utility::MemoryTracker::Free(Utility::MemoryTracker::MESHES, memoryUsage);
 }
 
 Json::Value Model::Save() const {
@@ -30,6 +33,11 @@ void Model::Load(const std::string& name) {
 }
 
 void Model::Load(const char* filename) {
+    // A re-import replaces the previous data, so stop tracking it.
+    if (memoryUsage > 0)
+        Utility::MemoryTracker::Free(Utility::MemoryTracker::MESHES, memoryUsage);
+    memoryUsage = 0;
+    
     if (assetFile.Open(filename, AssetFileHandler::READ)) {
         assetFile.LoadMeshData(0);
         MeshData * meshData = assetFile.GetStaticMeshData();
@@ -46,9 +54,12 @@ void Model::Load(const char* filename) {
 
             vertexIndexData.resize(meshData->numIndices);
             std::memcpy(vertexIndexData.data(), meshData->indices, sizeof(uint32_t) * meshData->numIndices);
+
+            memoryUsage += sizeof(glm::vec3) * meshData->numVertices + sizeof(uint32_t) * meshData->numIndices;
         }
 
-        if (meshData->GPU) {
+        // Headless runs have no graphics context and only use the bounding box.
+        if (meshData->GPU && glfwGetCurrentContext() != nullptr) {
             if (meshData->isSkinned) {
                 GenerateVertexBuffer(vertexBuffer, meshData->skinnedVertices, meshData->numVertices);
                 GenerateIndexBuffer(meshData->indices, meshData->numIndices, indexBuffer);
@@ -58,8 +69,14 @@ void Model::Load(const char* filename) {
                 GenerateIndexBuffer(meshData->indices, meshData->numIndices, indexBuffer);
                 GenerateStaticVertexArray(vertexBuffer, indexBuffer, vertexArray);
             }
+
+            std::size_t vertexSize = meshData->isSkinned ? sizeof(Video::Geometry::VertexType::SkinVertex) : sizeof(Video::Geometry::VertexType::StaticVertex);
+            memoryUsage += vertexSize * meshData->numVertices + sizeof(uint32_t) * meshData->numIndices;
         }
 
+        if (memoryUsage > 0)
+            Utility::MemoryTracker::Allocate(Utility::MemoryTracker::MESHES, memoryUsage);
+
         CreateAxisAlignedBoundingBox(meshData->aabbDim, meshData->aabbOrigin, meshData->aabbMinpos, meshData->aabbMaxpos);
         assetFile.Close();
     }
@@ -58,5 +58,6 @@ namespace Geometry {
 
             AssetFileHandler assetFile;
             Type type;
+            std::size_t memoryUsage = 0;
     };
 }
@@ -2,6 +2,7 @@
 
 #include "Util/FileSystem.hpp"
 #include "Manager/Managers.hpp"
+#include "Manager/AnimationManager.hpp"
 #include "Manager/PhysicsManager.hpp"
 #include "Manager/ParticleManager.hpp"
 #include "Manager/ScriptManager.hpp"
@@ -10,6 +11,7 @@
 #include "Manager/TriggerManager.hpp"
 #include "Manager/DebugDrawingManager.hpp"
 #include "Manager/ResourceManager.hpp"
+#include "Manager/RenderSnapshot.hpp"
 #include "Manager/VRManager.hpp"
 #include "DefaultAlbedo.png.hpp"
 #include "DefaultNormal.png.hpp"
@@ -22,9 +24,12 @@
 #include "Script/ScriptFile.hpp"
 #include "Util/Json.hpp"
 #include <fstream>
+#include <GLFW/glfw3.h>
 #include "Util/Profiling.hpp"
 #include "Util/GPUProfiling.hpp"
 #include "Entity/Entity.hpp"
+#include <Utility/Log.hpp>
+#include <Utility/Worker.hpp>
 
 #ifdef USINGMEMTRACK
 #include <MemTrackInclude.hpp>
@@ -33,10 +38,18 @@
 using namespace std;
 
 ActiveHymn::ActiveHymn() {
-    defaultAlbedo = new TextureAsset(DEFAULTALBEDO_PNG, DEFAULTALBEDO_PNG_LENGTH);
-    defaultNormal = new TextureAsset(DEFAULTNORMAL_PNG, DEFAULTNORMAL_PNG_LENGTH);
-    defaultMetallic= new TextureAsset(DEFAULTMETALLIC_PNG, DEFAULTMETALLIC_PNG_LENGTH);
-    defaultRoughness = new TextureAsset(DEFAULTROUGHNESS_PNG, DEFAULTROUGHNESS_PNG_LENGTH);
+    // Textures need a graphics context, which headless runs don't have. They don't have materials either.
+    if (glfwGetCurrentContext() != nullptr) {
+        defaultAlbedo = new TextureAsset(DEFAULTALBEDO_PNG, DEFAULTALBEDO_PNG_LENGTH);
+        defaultNormal = new TextureAsset(DEFAULTNORMAL_PNG, DEFAULTNORMAL_PNG_LENGTH);
+        defaultMetallic= new TextureAsset(DEFAULTMETALLIC_PNG, DEFAULTMETALLIC_PNG_LENGTH);
+        defaultRoughness = new TextureAsset(DEFAULTROUGHNESS_PNG, DEFAULTROUGHNESS_PNG_LENGTH);
+    } else {
+        defaultAlbedo = nullptr;
+        defaultNormal = nullptr;
+        defaultMetallic = nullptr;
+        defaultRoughness = nullptr;
+    }
     
     Clear();
 }
@@ -52,6 +65,8 @@ void ActiveHymn::Clear() {
     startupScene = "";
     name = "";
     world.Clear();
+    saveStateWorld.Clear();
+    ResetPipeline();
     
     entityNumber = 1U;
     
@@ -120,6 +135,13 @@ Json::Value ActiveHymn::ToJson() const {
     filtersNode["dither"] = filterSettings.ditherApply;
     filtersNode["fxaa"] = filterSettings.fxaa;
     root["filters"] = filtersNode;
+
+    // Physics settings.
+    Json::Value physicsNode;
+    physicsNode["timeStep"] = physicsSettings.timeStep;
+    physicsNode["maxSubSteps"] = physicsSettings.maxSubSteps;
+    physicsNode["interpolate"] = physicsSettings.interpolate;
+    root["physics"] = physicsNode;
     
     // Save scripts.
     Json::Value scriptNode;
@@ -149,6 +171,12 @@ void ActiveHymn::FromJson(Json::Value root) {
     filterSettings.fogColor = Json::LoadVec3(filtersNode["fogColor"]);
     filterSettings.ditherApply = filtersNode["dither"].asBool();
     filterSettings.fxaa = filtersNode["fxaa"].asBool();
+
+    // Load physics settings.
+    Json::Value physicsNode = root["physics"];
+    physicsSettings.timeStep = physicsNode.get("timeStep", 1.0f / 60.0f).asFloat();
+    physicsSettings.maxSubSteps = physicsNode.get("maxSubSteps", 4).asInt();
+    physicsSettings.interpolate = physicsNode.get("interpolate", true).asBool();
     
     // Load scripts.
     scripts.clear();
@@ -159,12 +187,19 @@ void ActiveHymn::FromJson(Json::Value root) {
     scriptNumber = static_cast<unsigned int>(scripts.size());
 
     vrScale = root["vrScale"].asFloat();
-    Managers().vrManager->SetScale(vrScale);
+    if (Managers().vrManager != nullptr)
+        Managers().vrManager->SetScale(vrScale);
     startupScene = root["startupScene"].asString();
     name = root["name"].asString();
 }
 
 void ActiveHymn::Update(float deltaTime) {
+    UpdateScripts(deltaTime);
+    UpdateSimulation(deltaTime);
+    UpdateWorld(deltaTime);
+}
+
+void ActiveHymn::UpdateScripts(float deltaTime) {
     { PROFILE("Run scripts.");
         Managers().scriptManager->Update(world, deltaTime);
     }
@@ -173,23 +208,32 @@ void ActiveHymn::Update(float deltaTime) {
         Managers().triggerManager->SynchronizeTriggers();    
     }
     
-    { PROFILE("Update VR devices");
+    // Managers that weren't started by a headless run are skipped.
+    if (Managers().vrManager != nullptr) {
+        PROFILE("Update VR devices");
         Managers().vrManager->Update();
     }
-    
+}
+
+void ActiveHymn::UpdateSimulation(float deltaTime) {
     { PROFILE("Update physics");
+        Managers().physicsManager->SetTimeStep(physicsSettings.timeStep, physicsSettings.maxSubSteps);
+        Managers().physicsManager->SetInterpolation(physicsSettings.interpolate);
         Managers().physicsManager->Update(deltaTime);
     }
     
     { PROFILE("Update animations");
-        Managers().renderManager->UpdateAnimations(deltaTime);
+        Managers().animationManager->UpdateAnimations(deltaTime);
     }
-    
+}
+
+void ActiveHymn::UpdateWorld(float deltaTime) {
     { PROFILE("Update particles");
         Managers().particleManager->Update(world, deltaTime);
     }
     
-    { PROFILE("Update debug drawing");
+    if (Managers().debugDrawingManager != nullptr) {
+        PROFILE("Update debug drawing");
         Managers().debugDrawingManager->Update(deltaTime);
     }
 
@@ -208,7 +252,7 @@ void ActiveHymn::Update(float deltaTime) {
     if (restart) {
         restart = false;
         FromJson(saveStateHymn);
-        world.Load(saveStateWorld);
+        saveStateWorld.Restore(world);
         Managers().scriptManager->RegisterInput();
         Managers().scriptManager->BuildAllScripts();
     }
@@ -222,13 +266,90 @@ void ActiveHymn::Render(RenderManager::DISPLAY targetDisplay, Entity* camera, bo
     }
 }
 
-Entity* ActiveHymn::GetEntityByGUID(unsigned int GUID) {
-    const vector<Entity*>& entities = Hymn().world.GetEntities();
-    for (size_t i = 0; i < entities.size(); ++i) {
-        if (entities[i]->GetUniqueIdentifier() == GUID)
-            return entities[i];        
+void ActiveHymn::SetPipelined(bool pipelined) {
+    if (pipelined == GetPipelined())
+        return;
+
+    if (pipelined) {
+        // Bullet's task scheduler can't be used from the worker thread.
+        if (Managers().physicsManager != nullptr && Managers().physicsManager->GetThreadCount() > 1) {
+            Log(Log::WARNING) << "ActiveHymn::SetPipelined: Physics can only use one thread when pipelined.\n";
+            Managers().physicsManager->SetThreadCount(1);
+        }
+
+        worker = new Utility::Worker();
+        renderSnapshot = new RenderSnapshot();
+    } else {
+        delete worker;
+        delete renderSnapshot;
+        worker = nullptr;
+        renderSnapshot = nullptr;
     }
-    return nullptr;
+    snapshotValid = false;
+}
+
+bool ActiveHymn::GetPipelined() const {
+    return worker != nullptr;
+}
+
+void ActiveHymn::UpdateAndRender(float deltaTime, RenderManager::DISPLAY targetDisplay) {
+    if (!GetPipelined()) {
+        Update(deltaTime);
+        Render(targetDisplay);
+        return;
+    }
+
+    UpdateScripts(deltaTime);
+
+    // Simulate this frame while the last one is rendered.
+    worker->Start([this, deltaTime]() {
+        ProfilingManager::SetThreadName("Simulation");
+        UpdateSimulation(deltaTime);
+    });
+
+    // The world may have been loaded or restored since the snapshot was created, freeing its resources.
+    snapshotValid = HasRenderSnapshot();
+
+    const bool render = !Managers().renderManager->IsHeadless();
+    if (snapshotValid && render) {
+        PROFILE("Render world");
+        GPUPROFILE("Render world", Video::Query::Type::TIME_ELAPSED);
+        Managers().renderManager->Render(*renderSnapshot, targetDisplay);
+    }
+
+    { PROFILE("Wait for simulation");
+        worker->Wait();
+    }
+
+    UpdateWorld(deltaTime);
+
+    { PROFILE("Create render snapshot");
+        Managers().renderManager->CreateSnapshot(world, *renderSnapshot);
+        snapshotClearCount = world.GetClearCount();
+    }
+
+    // Without a snapshot of the last frame, show this one right away rather than nothing.
+    if (!snapshotValid) {
+        snapshotValid = true;
+        if (!render)
+            return;
+
+        PROFILE("Render world");
+        GPUPROFILE("Render world", Video::Query::Type::TIME_ELAPSED);
+        Managers().renderManager->Render(*renderSnapshot, targetDisplay);
+    }
+}
+
+void ActiveHymn::ResetPipeline() {
+    snapshotValid = false;
+}
+
+bool ActiveHymn::HasRenderSnapshot() const {
+    return snapshotValid && snapshotClearCount == world.GetClearCount();
+}
+
+Entity* ActiveHymn::GetEntityByGUID(uint64_t GUID) {
+    return Hymn().world.GetEntityByUniqueIdentifier(GUID);
 }
 
 ActiveHymn& Hymn() {
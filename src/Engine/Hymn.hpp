@@ -6,10 +6,15 @@
 #include <glm/glm.hpp>
 #include "Manager/RenderManager.hpp"
 #include "Entity/World.hpp"
+#include "Entity/WorldSnapshot.hpp"
 #include "linking.hpp"
 
 class TextureAsset;
 class ScriptFile;
+struct RenderSnapshot;
+namespace Utility {
+    class Worker;
+}
 
 /// A hymn to beauty.
 class ActiveHymn {
@@ -60,6 +65,7 @@ class ActiveHymn {
 
         /// Update the world.
         /**
+         * Managers that haven't been started (see Hub::StartUpHeadless) are skipped.
          * @param deltaTime Time since last frame (in seconds).
          */
         ENGINE_API void Update(float deltaTime);
@@ -77,13 +83,52 @@ class ActiveHymn {
          * @param lightVolumes Whether to show light culling volumes.
          */
         ENGINE_API void Render(RenderManager::DISPLAY targetDisplay, Entity* camera = nullptr, bool soundSources = false, bool particleEmitters = false, bool lightSources = false, bool cameras = false, bool physics = false, bool lighting = true, bool lightVolumes = false);
+
+        /// Set whether to pipeline updating and rendering.
+        /**
+         * When pipelined, physics and animations are simulated on a worker thread while
+         * the last frame is rendered from a snapshot, so what's shown lags one frame behind.
+         * Scripts, particles and rendering stay on the calling thread, which owns the graphics context.
+         * Physics is limited to one thread (see PhysicsManager::SetThreadCount), since Bullet's task scheduler can only be used from the thread that installed it.
+         * The profiling zones of physics and animations are recorded on the worker thread, so they show up in captured traces but not in the profiling tree.
+         * @param pipelined Whether to pipeline updating and rendering.
+         */
+        ENGINE_API void SetPipelined(bool pipelined);
+
+        /// Get whether updating and rendering are pipelined.
+        /**
+         * @return Whether updating and rendering are pipelined.
+         */
+        ENGINE_API bool GetPipelined() const;
+
+        /// Update the world and render it.
+        /**
+         * Same as Update followed by Render, unless pipelined (see SetPipelined).
+         * @param deltaTime Time since last frame (in seconds).
+         * @param targetDisplay Display type to render.
+         */
+        ENGINE_API void UpdateAndRender(float deltaTime, RenderManager::DISPLAY targetDisplay);
+
+        /// Discard the snapshot of the last frame.
+        /**
+         * The snapshot is discarded automatically when the world is cleared, which loading and
+         * restoring it does. Call after freeing other resources the snapshot may refer to. The
+         * next pipelined frame renders the world as it is after that frame's update instead.
+         */
+        ENGINE_API void ResetPipeline();
+
+        /// Get whether the next pipelined frame will render a snapshot of the last frame.
+        /**
+         * @return Whether there is a valid snapshot of the last frame.
+         */
+        ENGINE_API bool HasRenderSnapshot() const;
         
         /// Find entity via GUID.
         /**
          * @param GUID The Unique Identifier for what entity you want to find.
          * @return Entity found or nullptr if entity with this param does not exist.
          */
-        ENGINE_API static Entity* GetEntityByGUID(unsigned int GUID);
+        ENGINE_API static Entity* GetEntityByGUID(uint64_t GUID);
 
         /// Scene to start when playing the hymn.
         std::string startupScene;
@@ -101,6 +146,9 @@ class ActiveHymn {
         unsigned int scriptNumber = 0U;
 
         /// Default albedo texture.
+        /**
+         * The default textures are nullptr if there was no graphics context when the hymn was created.
+         */
         TextureAsset* defaultAlbedo;
         
         /// Default normal texture.
@@ -142,11 +190,26 @@ class ActiveHymn {
         /// Filter settings.
         FilterSettings filterSettings;
 
+        /// Physics settings.
+        struct PhysicsSettings {
+            /// Length of a simulation step in seconds.
+            float timeStep = 1.0f / 60.0f;
+
+            /// Maximum number of simulation steps per frame.
+            int maxSubSteps = 4;
+
+            /// Whether to interpolate entity transforms between steps.
+            bool interpolate = true;
+        };
+
+        /// Physics settings.
+        PhysicsSettings physicsSettings;
+
         /// Whether to restart the hymn
         bool restart = false;
 
         /// Recently saved state of the world.
-        Json::Value saveStateWorld;
+        WorldSnapshot saveStateWorld;
 
         /// Recently saved state of the hymn.
         Json::Value saveStateHymn;
@@ -163,8 +226,18 @@ class ActiveHymn {
         ActiveHymn();
         ActiveHymn(ActiveHymn const&) = delete;
         void operator=(ActiveHymn const&) = delete;
+
+        void UpdateScripts(float deltaTime);
+        void UpdateSimulation(float deltaTime);
+        void UpdateWorld(float deltaTime);
         
         std::string path = "";
+
+        // Pipelining.
+        Utility::Worker* worker = nullptr;
+        RenderSnapshot* renderSnapshot = nullptr;
+        bool snapshotValid = false;
+        unsigned int snapshotClearCount = 0;
 };
 
 /// Get the active hymn.
@@ -0,0 +1,51 @@
+#include "AnimationManager.hpp"
+
+#include "Managers.hpp"
+#include "ResourceManager.hpp"
+#include "../Component/AnimationController.hpp"
+#include "../Entity/Entity.hpp"
+#include "../Util/SceneNode.hpp"
+
+AnimationManager::AnimationManager() {
+
+}
+
+AnimationManager::~AnimationManager() {
+
+}
+
+void AnimationManager::UpdateAnimations(float deltaTime) {
+    // Update all enabled animation controllers.
+    for (Component::AnimationController* animationController : animationControllers.GetAll()) {
+        if (animationController->IsKilled() || !animationController->entity->IsEnabled())
+            continue;
+
+        animationController->UpdateAnimation(deltaTime);
+    }
+}
+
+Component::AnimationController* AnimationManager::CreateAnimation() {
+    return animationControllers.Create();
+}
+
+Component::AnimationController* AnimationManager::CreateAnimation(const SceneNode& node) {
+    Component::AnimationController* animationController = animationControllers.Create();
+
+    std::string skeletonName = node.GetString("skeleton", "");
+    if (!skeletonName.empty())
+        animationController->skeleton = Managers().resourceManager->CreateSkeleton(skeletonName);
+
+    std::string controllerName = node.GetString("animationController", "");
+    if (!controllerName.empty())
+        animationController->controller = Managers().resourceManager->CreateAnimationController(controllerName);
+
+    return animationController;
+}
+
+const std::vector<Component::AnimationController*>& AnimationManager::GetAnimations() const {
+    return animationControllers.GetAll();
+}
+
+void AnimationManager::ClearKilledComponents() {
+    animationControllers.ClearKilled();
+}
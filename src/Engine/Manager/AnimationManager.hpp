@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include "../Entity/ComponentContainer.hpp"
+#include "../linking.hpp"
+
+namespace Component {
+    class AnimationController;
+}
+
+class SceneNode;
+
+/// Updates skeletal animations.
+/**
+ * Animating only computes the bone matrices on the CPU, so it is kept apart
+ * from the render manager and also runs when no graphics context exists.
+ */
+class AnimationManager {
+    friend class Hub;
+
+    public:
+        /// Update all the animations in the scene.
+        /**
+         * @param deltaTime Time between frames.
+         */
+        ENGINE_API void UpdateAnimations(float deltaTime);
+
+        /// Create animation component.
+        /**
+         * @return The created component.
+         */
+        ENGINE_API Component::AnimationController* CreateAnimation();
+
+        /// Create animation component.
+        /**
+         * @param node Scene node to load the component from.
+         * @return The created component.
+         */
+        ENGINE_API Component::AnimationController* CreateAnimation(const SceneNode& node);
+
+        /// Get all animation controller components.
+        /**
+         * @return All animation controller components.
+         */
+        ENGINE_API const std::vector<Component::AnimationController*>& GetAnimations() const;
+
+        /// Remove all killed components.
+        void ClearKilledComponents();
+
+    private:
+        AnimationManager();
+        ~AnimationManager();
+        AnimationManager(const AnimationManager&) = delete;
+        void operator=(const AnimationManager&) = delete;
+
+        ComponentContainer<Component::AnimationController> animationControllers;
+};
@@ -114,7 +114,7 @@ void DebugDrawingManager::AddCone(float radius, float height, const glm::mat4& m
     cones.push_back(cone);
 }
 
-void DebugDrawingManager::AddMesh(unsigned int id, Component::Mesh* meshComponent, const glm::mat4& matrix, const glm::vec3& color, bool wireFrame, float duration, bool depthTesting) {
+void DebugDrawingManager::AddMesh(uint64_t id, Component::Mesh* meshComponent, const glm::mat4& matrix, const glm::vec3& color, bool wireFrame, float duration, bool depthTesting) {
     assert(meshComponent);
     assert(meshComponent->geometry);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <map>
 #include <vector>
 #include <Video/DebugDrawing.hpp>
@@ -120,7 +121,7 @@ class DebugDrawingManager {
          * @param duration How long the mesh should stay in the world (in seconds).
          * @param depthTesting Whether to enable depth testing.
          */
-        ENGINE_API void AddMesh(unsigned int id, Component::Mesh* meshComponent, const glm::mat4& matrix, const glm::vec3& color, bool wireFrame = true, float duration = 0.f, bool depthTesting = true);
+        ENGINE_API void AddMesh(uint64_t id, Component::Mesh* meshComponent, const glm::mat4& matrix, const glm::vec3& color, bool wireFrame = true, float duration = 0.f, bool depthTesting = true);
 
         /// Update the debug geometry.
         /**
@@ -150,7 +151,7 @@ class DebugDrawingManager {
         std::vector<Video::DebugDrawing::Sphere> spheres;
         std::vector<Video::DebugDrawing::Cylinder> cylinders;
         std::vector<Video::DebugDrawing::Cone> cones;
-        std::map<unsigned int, Video::DebugDrawing::Mesh> meshMap;
+        std::map<uint64_t, Video::DebugDrawing::Mesh> meshMap;
         
         Video::DebugDrawing* debugDrawing;
 };
@@ -2,6 +2,7 @@
 
 #include "ResourceManager.hpp"
 #include "RenderManager.hpp"
+#include "AnimationManager.hpp"
 #include "ParticleManager.hpp"
 #include "PhysicsManager.hpp"
 #include "SoundManager.hpp"
@@ -30,9 +31,13 @@ Hub& Managers() {
 }
 
 void Hub::StartUp() {
+    // The hub may be started again after being shut down.
+    shutdown = false;
+
     resourceManager = new ResourceManager();
     vrManager = new VRManager();
     renderManager = new RenderManager();
+    animationManager = new AnimationManager();
     particleManager = new ParticleManager();
     physicsManager = new PhysicsManager();
     soundManager = new SoundManager();
@@ -42,29 +47,58 @@ void Hub::StartUp() {
     triggerManager = new TriggerManager();
 }
 
+void Hub::StartUpHeadless() {
+    shutdown = false;
+
+    resourceManager = new ResourceManager();
+    vrManager = nullptr;
+    renderManager = new RenderManager(true);
+    animationManager = new AnimationManager();
+    particleManager = new ParticleManager(true);
+    physicsManager = new PhysicsManager();
+    soundManager = nullptr;
+    scriptManager = new ScriptManager();
+    debugDrawingManager = nullptr;
+    profilingManager = new ProfilingManager(false);
+    triggerManager = new TriggerManager();
+}
+
 void Hub::ShutDown() {
     delete triggerManager;
-    delete profilingManager;
     delete debugDrawingManager;
     delete scriptManager;
     delete soundManager;
+    delete animationManager;
     delete renderManager;
     delete vrManager;
     delete particleManager;
     delete physicsManager;
     delete resourceManager;
+
+    // Deleted last since the audio thread may still be profiling until the sound manager is deleted.
+    delete profilingManager;
     
     shutdown = true;
 }
 
 void Hub::ClearKilledComponents() {
     if (!shutdown) {
-        triggerManager->ClearKilledComponents();
-        renderManager->ClearKilledComponents();
-        particleManager->ClearKilledComponents();
-        physicsManager->ClearKilledComponents();
-        soundManager->ClearKilledComponents();
-        scriptManager->ClearKilledComponents();
-        vrManager->ClearKilledComponents();
+        // Headless runs only start some of the managers.
+        if (triggerManager != nullptr)
+            triggerManager->ClearKilledComponents();
+        if (renderManager != nullptr)
+            renderManager->ClearKilledComponents();
+        if (animationManager != nullptr)
+            animationManager->ClearKilledComponents();
+        if (particleManager != nullptr)
+            particleManager->ClearKilledComponents();
+        if (physicsManager != nullptr)
+            physicsManager->ClearKilledComponents();
+        if (soundManager != nullptr)
+            soundManager->ClearKilledComponents();
+        if (scriptManager != nullptr)
+            scriptManager->ClearKilledComponents();
+        if (vrManager != nullptr)
+            vrManager->ClearKilledComponents();
     }
 }
@@ -3,6 +3,7 @@
 #include "../linking.hpp"
 
 class ResourceManager;
+class AnimationManager;
 class RenderManager;
 class ParticleManager;
 class PhysicsManager;
@@ -24,6 +25,9 @@ class Hub {
         /// The render manager instance.
         RenderManager* renderManager;
 
+        /// The animation manager instance.
+        AnimationManager* animationManager;
+
         /// The particle manager instance.
         ParticleManager* particleManager;
 
@@ -51,6 +55,19 @@ class Hub {
         /// Initialize all subsystems.
         ENGINE_API void StartUp();
 
+        /// Initialize only the subsystems that don't need a window, graphics
+        /// context or audio device.
+        /**
+         * Used by headless tools such as benchmarks. The resource, render,
+         * animation, particle, physics, script, trigger and profiling managers
+         * are created and the others are left as nullptr. The render manager
+         * only keeps its components and creates snapshots, particles are
+         * simulated on the CPU and the profiling manager only measures CPU
+         * time. Materials and the components of the managers that aren't
+         * created are skipped when entities are loaded.
+         */
+        ENGINE_API void StartUpHeadless();
+
         /// Deinitialize all subsystems.
         ENGINE_API void ShutDown();
 
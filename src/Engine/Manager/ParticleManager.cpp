@@ -9,8 +9,10 @@
 #include "../Manager/ResourceManager.hpp"
 #include <Video/Texture/TexturePNG.hpp>
 #include "ParticleAtlas.png.hpp"
-#include "../Util/Json.hpp"
+#include "../Util/SceneNode.hpp"
+#include <Video/Culling/Frustum.hpp>
 #include <Utility/Log.hpp>
+#include <algorithm>
 
 #ifdef USINGMEMTRACK
 #include <MemTrackInclude.hpp>
@@ -18,40 +20,113 @@
 
 using namespace Video;
 
-ParticleManager::ParticleManager() {
+namespace {
+    // Smallest fraction of the particles a visible emitter is simulated with.
+    const float MINIMUM_LOD = 0.125f;
+
+    // Distance from a point to the closest point in a box.
+    float DistanceToBox(const glm::vec3& point, const AxisAlignedBoundingBox& box) {
+        return glm::distance(point, glm::clamp(point, box.minVertex, box.maxVertex));
+    }
+}
+
+ParticleManager::ParticleManager(bool headless) {
     randomEngine.seed(randomDevice());
-    textureAtlas = Managers().resourceManager->CreateTexturePNG(PARTICLEATLAS_PNG, PARTICLEATLAS_PNG_LENGTH);
+    if (headless) {
+        cpuSimulator = new CpuParticleSimulator();
+    } else {
+        textureAtlas = Managers().resourceManager->CreateTexturePNG(PARTICLEATLAS_PNG, PARTICLEATLAS_PNG_LENGTH);
+        particleRenderer = new ParticleSystemRenderer();
+    }
 }
 
 ParticleManager::~ParticleManager() {
-    Managers().resourceManager->FreeTexturePNG(textureAtlas);
+    // Components that are deleted after this no longer have emitters to remove.
+    emitters.clear();
+    delete particleRenderer;
+    delete cpuSimulator;
+
+    if (textureAtlas != nullptr)
+        Managers().resourceManager->FreeTexturePNG(textureAtlas);
 }
 
 void ParticleManager::Update(World& world, float time, bool preview) {
+    const Frustum frustum(cameraViewProjection);
+
     for (Component::ParticleSystemComponent* comp : particleSystems.GetAll()) {
         if (comp->IsKilled() || !comp->entity->IsEnabled())
             continue;
         
         emitterSettings[comp] = comp->particleType;
         emitterSettings[comp].worldPos = comp->entity->GetWorldPosition();
-        particleSystemRenderers[comp]->Update(0.1f, emitterSettings[comp]);
+
+        // Cull and pick level of detail based on where the particles were last seen from.
+        float lod = 1.0f;
+        if (hasCamera) {
+            const AxisAlignedBoundingBox bounds = ParticleSystemRenderer::GetBounds(emitterSettings[comp]);
+            float distance = DistanceToBox(cameraPosition, bounds);
+            if (distance > cullDistance || !frustum.Collide(bounds))
+                continue;
+
+            if (distance > lodDistance)
+                lod = std::max(lodDistance / distance, MINIMUM_LOD);
+        }
+
+        // The CPU simulator always simulates all particles.
+        if (particleRenderer != nullptr)
+            particleRenderer->Update(emitters[comp], 0.1f, emitterSettings[comp], lod);
+        else
+            cpuSimulator->Update(emitters[comp], 0.1f, emitterSettings[comp]);
     }
+
+    if (particleRenderer != nullptr)
+        particleRenderer->Simulate();
+    else
+        cpuSimulator->Simulate();
 }
 
 void ParticleManager::RenderParticleSystem(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
-    for (Component::ParticleSystemComponent* comp : particleSystems.GetAll()) {
-        if (comp->IsKilled() || !comp->entity->IsEnabled())
-            continue;
-        
-        particleSystemRenderers[comp]->Draw(textureAtlas, textureAtlasRowNumber, viewMatrix, projectionMatrix, emitterSettings[comp]);
-    }
+    SetCamera(viewMatrix, projectionMatrix);
+
+    if (particleRenderer != nullptr)
+        particleRenderer->Draw(textureAtlas, textureAtlasRowNumber, viewMatrix, projectionMatrix);
+}
+
+void ParticleManager::SetCamera(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
+    hasCamera = true;
+    cameraViewProjection = projectionMatrix * viewMatrix;
+    cameraPosition = glm::vec3(glm::inverse(viewMatrix)[3]);
+}
+
+
+void ParticleManager::SetCullDistance(float distance) {
+    cullDistance = distance;
+}
+
+float ParticleManager::GetCullDistance() const {
+    return cullDistance;
+}
+
+void ParticleManager::SetLodDistance(float distance) {
+    lodDistance = distance;
 }
 
+float ParticleManager::GetLodDistance() const {
+    return lodDistance;
+}
 
 const Texture2D* ParticleManager::GetTextureAtlas() const {
     return textureAtlas;
 }
 
+const CpuParticleSimulator::Particles* ParticleManager::GetSimulatedParticles(const Component::ParticleSystemComponent* component) const {
+    if (cpuSimulator == nullptr)
+        return nullptr;
+
+    auto it = emitters.find(const_cast<Component::ParticleSystemComponent*>(component));
+    return it != emitters.end() ? &cpuSimulator->GetParticles(it->second) : nullptr;
+}
+
 int ParticleManager::GetTextureAtlasRows() const {
     return textureAtlasRowNumber;
 }
@@ -61,29 +136,37 @@ Component::ParticleSystemComponent* ParticleManager::CreateAParticleSystem() {
     return InitParticleSystem(particleSystems.Create());
 }
 
-Component::ParticleSystemComponent* ParticleManager::CreateParticleSystem(const Json::Value& node) {
+Component::ParticleSystemComponent* ParticleManager::CreateParticleSystem(const SceneNode& node) {
 
     Component::ParticleSystemComponent* particleSystem = InitParticleSystem(particleSystems.Create());
-    // Load values from Json node.
-    particleSystem->particleType.textureIndex = node.get("textureIndex", 0).asInt();
-    particleSystem->particleType.nr_new_particles = node.get("emitAmount", 8).asInt();
-    particleSystem->particleType.rate = node.get("rate", 0.3).asFloat();
-    particleSystem->particleType.lifetime = node.get("lifetime", 10.0).asFloat();
-    particleSystem->particleType.scale = node.get("scale", 10.0).asFloat();
-    particleSystem->particleType.velocity = Json::LoadVec3(node["velocity"]);
-    particleSystem->particleType.alpha_control = node.get("alphaControl", 10.0).asFloat();
-    particleSystem->particleType.mass = node.get("mass", 1.0).asFloat();
-    particleSystem->particleType.spread = node.get("spread", 1.0).asInt();
-    particleSystem->particleType.randomVec = Json::LoadVec3(node["randomVelocity"]);
-    particleSystem->particleType.velocityMultiplier = node.get("speed", 10.0).asFloat();
-    particleSystem->particleType.nr_particles = node.get("NrOfParticles", 1024).asInt();
+    // Load values from scene node.
+    particleSystem->particleType.textureIndex = node.GetInt("textureIndex", 0);
+    particleSystem->particleType.nr_new_particles = node.GetInt("emitAmount", 8);
+    particleSystem->particleType.rate = node.GetFloat("rate", 0.3f);
+    particleSystem->particleType.lifetime = node.GetFloat("lifetime", 10.0f);
+    particleSystem->particleType.scale = node.GetFloat("scale", 10.0f);
+    particleSystem->particleType.velocity = node.GetVec3("velocity");
+    particleSystem->particleType.alpha_control = node.GetFloat("alphaControl", 10.0f);
+    particleSystem->particleType.mass = node.GetFloat("mass", 1.0f);
+    particleSystem->particleType.spread = node.GetInt("spread", 1);
+    particleSystem->particleType.randomVec = node.GetVec3("randomVelocity");
+    particleSystem->particleType.velocityMultiplier = node.GetFloat("speed", 10.0f);
+    particleSystem->particleType.nr_particles = node.GetInt("NrOfParticles", 1024);
 
     return particleSystem;
 }
 
 void ParticleManager::RemoveParticleRenderer(Component::ParticleSystemComponent * component) {
-    delete particleSystemRenderers[component];
-    particleSystemRenderers.erase(component);
+    auto it = emitters.find(component);
+    if (it == emitters.end())
+        return;
+
+    if (particleRenderer != nullptr)
+        particleRenderer->RemoveEmitter(it->second);
+    else
+        cpuSimulator->RemoveEmitter(it->second);
+    emitters.erase(it);
+    emitterSettings.erase(component);
 }
 
 void ParticleManager::ClearKilledComponents() {
@@ -91,12 +174,12 @@ void ParticleManager::ClearKilledComponents() {
 }
 
 Component::ParticleSystemComponent* ParticleManager::InitParticleSystem(Component::ParticleSystemComponent* component) {
-    ParticleSystemRenderer* PS_Renderer = new ParticleSystemRenderer();
-    PS_Renderer->Init();
-    PS_Renderer->CreateStorageBuffers();
     ParticleSystemRenderer::EmitterSettings setting;
     emitterSettings[component] = setting;
-    particleSystemRenderers[component] = PS_Renderer;
+    if (particleRenderer != nullptr)
+        emitters[component] = particleRenderer->AddEmitter(setting.nr_particles);
+    else
+        emitters[component] = cpuSimulator->AddEmitter(setting.nr_particles);
 
     return component;
 }
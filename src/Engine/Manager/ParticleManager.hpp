@@ -6,6 +6,7 @@
 #include <map>
 #include <Video/ParticleSystemRenderer.hpp>
 #include "../Entity/ComponentContainer.hpp"
+#include "../Particles/CpuParticleSimulator.hpp"
 #include "../linking.hpp"
 
 class World;
@@ -18,11 +19,13 @@ namespace Video {
 namespace Component {
     class ParticleSystemComponent;
 }
-namespace Json {
-    class Value;
-}
+class SceneNode;
 
 /// Handles particles.
+/**
+ * Particles are simulated with compute shaders, or on the CPU with
+ * CpuParticleSimulator when the manager is started headless.
+ */
 class ParticleManager {
     friend class Hub;
     
@@ -30,6 +33,8 @@ class ParticleManager {
         
         /// Update all the system's particles, spawn new particles etc.
         /**
+         * Emitters that were outside the view frustum or further away than the cull distance the last time particles
+         * were rendered are not simulated. Emitters further away than the LOD distance are simulated with fewer particles.
          * @param world World to update.
          * @param time Time since last frame (in seconds).
          * @param preview Whether to only update particle emitters that are being previewed.
@@ -47,23 +52,64 @@ class ParticleManager {
 
         /// Renders particlesystem.
         /**
+         * Emitters outside the view frustum are skipped. Only sets the camera when headless.
          * @param viewMatrix The view matrix from the camera.
          * @param projectionMatrix The projection matrix from the camera.
          */
         ENGINE_API void RenderParticleSystem(const glm::mat4& viewMatrix, const glm::mat4&  projectionMatrix);
+
+        /// Set the camera emitters are culled against the next time they're updated.
+        /**
+         * @param viewMatrix The view matrix from the camera.
+         * @param projectionMatrix The projection matrix from the camera.
+         */
+        ENGINE_API void SetCamera(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
         
         /// Get the texture atlas.
         /**
-         * @return The particle texture atlas.
+         * @return The particle texture atlas, or nullptr when headless.
          */
         ENGINE_API const Video::Texture2D* GetTextureAtlas() const;
         
+        /// Get the particles simulated on the CPU for an emitter.
+        /**
+         * @param component Component whose particles to get.
+         * @return The particle state, or nullptr when not headless.
+         */
+        ENGINE_API const CpuParticleSimulator::Particles* GetSimulatedParticles(const Component::ParticleSystemComponent* component) const;
+        
         /// Get the number of rows in the texture atlas.
         /**
          * @return The number of rows in the texture atlas.
          */
         ENGINE_API int GetTextureAtlasRows() const;
 
+        /// Set the distance after which emitters are neither simulated nor rendered.
+        /**
+         * @param distance The cull distance.
+         */
+        ENGINE_API void SetCullDistance(float distance);
+
+        /// Get the distance after which emitters are neither simulated nor rendered.
+        /**
+         * @return The cull distance.
+         */
+        ENGINE_API float GetCullDistance() const;
+
+        /// Set the distance after which emitters start using fewer particles.
+        /**
+         * Beyond this distance the number of particles and the emission rate fall off with the inverse of the distance,
+         * like the emitter's size on screen.
+         * @param distance The LOD distance.
+         */
+        ENGINE_API void SetLodDistance(float distance);
+
+        /// Get the distance after which emitters start using fewer particles.
+        /**
+         * @return The LOD distance.
+         */
+        ENGINE_API float GetLodDistance() const;
+
         /// Create particle emitter component.
         /**
          * @return The created component.
@@ -72,10 +118,10 @@ class ParticleManager {
 
         /// Create particle System component.
         /**
-         * @param node Json node to load the component from.
+         * @param node Scene node to load the component from.
          * @return The created component.
          */
-        ENGINE_API Component::ParticleSystemComponent* CreateParticleSystem(const Json::Value& node);
+        ENGINE_API Component::ParticleSystemComponent* CreateParticleSystem(const SceneNode& node);
 
         /// Remove a component.
         /**
@@ -87,7 +133,7 @@ class ParticleManager {
         ENGINE_API void ClearKilledComponents();
         
     private:
-        ParticleManager();
+        explicit ParticleManager(bool headless = false);
         ~ParticleManager();
         ParticleManager(ParticleManager const&) = delete;
         void operator=(ParticleManager const&) = delete;
@@ -98,15 +144,30 @@ class ParticleManager {
         std::random_device randomDevice;
         std::mt19937 randomEngine;
 
-        std::map<Component::ParticleSystemComponent*, Video::ParticleSystemRenderer*> particleSystemRenderers;
+        // Shared renderer that simulates and draws the particles of all emitters.
+        Video::ParticleSystemRenderer* particleRenderer = nullptr;
+
+        // Simulates the particles instead of the renderer when headless.
+        CpuParticleSimulator* cpuSimulator = nullptr;
+
+        // Handles of the emitters in the particle renderer or CPU simulator.
+        std::map<Component::ParticleSystemComponent*, unsigned int> emitters;
 
         std::map<Component::ParticleSystemComponent*, Video::ParticleSystemRenderer::EmitterSettings> emitterSettings;
 
+        // Camera the particles were last rendered from, used to cull emitters before simulating them.
+        bool hasCamera = false;
+        glm::mat4 cameraViewProjection;
+        glm::vec3 cameraPosition;
+
+        float cullDistance = 250.0f;
+        float lodDistance = 25.0f;
+
         // The number of rows in the texture atlas.
         int textureAtlasRowNumber = 4;
 
         // Texture atlas containing the particle textures.
-        Video::TexturePNG* textureAtlas;
+        Video::TexturePNG* textureAtlas = nullptr;
         
         ComponentContainer<Component::ParticleSystemComponent> particleSystems;
 };
@@ -11,13 +11,141 @@
 #include "../Physics/Shape.hpp"
 #include "../Physics/Trigger.hpp"
 #include "../Physics/TriggerObserver.hpp"
-#include "../Util/Json.hpp"
+#include "../Util/SceneNode.hpp"
+#include "../Hymn.hpp"
+#include <Utility/Log.hpp>
+#include <Utility/MemoryTracker.hpp>
+
+// Bullet's multithreaded world is only available when Bullet has been built
+// with BULLET2_MULTITHREADING (see UsePhysicsMultithreading).
+#ifdef USINGPHYSICSMULTITHREADING
+#if !BT_THREADSAFE || BT_BULLET_VERSION < 288
+#error "Physics multithreading was requested, but Bullet isn't thread safe or is older than 2.88."
+#endif
+#define PHYSICS_MULTITHREADING
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <LinearMath/btThreads.h>
+#endif
 
 #ifdef USINGMEMTRACK
 #include <MemTrackInclude.hpp>
 #endif
 
+namespace {
+    void* AllocatePhysicsMemory(size_t size) {
+        return Utility::MemoryTracker::TaggedMalloc(Utility::MemoryTracker::PHYSICS, size);
+    }
+
+    void FreePhysicsMemory(void* memory) {
+        Utility::MemoryTracker::TaggedFree(Utility::MemoryTracker::PHYSICS, memory);
+    }
+
+    // Get the entity owning a collision object, if it's a live rigid body.
+    Entity* GetEntity(const btCollisionObject* object) {
+        Component::RigidBody* body = static_cast<Component::RigidBody*>(object->getUserPointer());
+        if (body == nullptr || body->IsKilled() || !body->entity->IsEnabled())
+            return nullptr;
+
+        return body->entity;
+    }
+
+    // Queries are in every group so that only their mask decides what they hit.
+    template<typename Callback> void SetQueryFilter(Callback& callback, int mask) {
+        callback.m_collisionFilterGroup = btBroadphaseProxy::AllFilter;
+        callback.m_collisionFilterMask = mask;
+    }
+
+    class ClosestRayCallback : public btCollisionWorld::ClosestRayResultCallback {
+        public:
+            ClosestRayCallback(const btVector3& from, const btVector3& to, int mask) : ClosestRayResultCallback(from, to) {
+                SetQueryFilter(*this, mask);
+            }
+
+            bool needsCollision(btBroadphaseProxy* proxy) const override {
+                return ClosestRayResultCallback::needsCollision(proxy) && GetEntity(static_cast<btCollisionObject*>(proxy->m_clientObject)) != nullptr;
+            }
+    };
+
+    class ClosestSweepCallback : public btCollisionWorld::ClosestConvexResultCallback {
+        public:
+            ClosestSweepCallback(const btVector3& from, const btVector3& to, int mask) : ClosestConvexResultCallback(from, to) {
+                SetQueryFilter(*this, mask);
+            }
+
+            bool needsCollision(btBroadphaseProxy* proxy) const override {
+                return ClosestConvexResultCallback::needsCollision(proxy) && GetEntity(static_cast<btCollisionObject*>(proxy->m_clientObject)) != nullptr;
+            }
+    };
+
+    class OverlapCallback : public btCollisionWorld::ContactResultCallback {
+        public:
+            OverlapCallback(std::vector<Entity*>& entities, int mask) : entities(entities) {
+                SetQueryFilter(*this, mask);
+            }
+
+            bool needsCollision(btBroadphaseProxy* proxy) const override {
+                return ContactResultCallback::needsCollision(proxy) && GetEntity(static_cast<btCollisionObject*>(proxy->m_clientObject)) != nullptr;
+            }
+
+            btScalar addSingleResult(btManifoldPoint& cp, const btCollisionObjectWrapper* colObj0Wrap, int partId0, int index0, const btCollisionObjectWrapper* colObj1Wrap, int partId1, int index1) override {
+                // The query object is always the first object.
+                Entity* entity = GetEntity(colObj1Wrap->getCollisionObject());
+                if (entity != nullptr && std::find(entities.begin(), entities.end(), entity) == entities.end())
+                    entities.push_back(entity);
+
+                return 0;
+            }
+
+        private:
+            std::vector<Entity*>& entities;
+    };
+
+    bool CastRay(const btCollisionWorld& world, const Physics::Ray& ray, Physics::QueryHit& hit, int mask) {
+        hit = Physics::QueryHit();
+
+        float length = glm::length(ray.direction);
+        if (length <= 0.0f)
+            return false;
+
+        btVector3 from = Physics::glmToBt(ray.origin);
+        btVector3 to = Physics::glmToBt(ray.origin + ray.direction * (ray.maxDistance / length));
+        ClosestRayCallback callback(from, to, mask);
+        world.rayTest(from, to, callback);
+        if (!callback.hasHit())
+            return false;
+
+        hit.entity = GetEntity(callback.m_collisionObject);
+        hit.point = Physics::btToGlm(callback.m_hitPointWorld);
+        hit.normal = Physics::btToGlm(callback.m_hitNormalWorld);
+        hit.distance = callback.m_closestHitFraction * ray.maxDistance;
+        return true;
+    }
+
+#ifdef PHYSICS_MULTITHREADING
+    class RaycastBody : public btIParallelForBody {
+        public:
+            RaycastBody(const btCollisionWorld& world, const std::vector<Physics::Ray>& rays, std::vector<Physics::QueryHit>& hits, int mask) : world(world), rays(rays), hits(hits), mask(mask) {}
+
+            void forLoop(int begin, int end) const override {
+                for (int i = begin; i < end; ++i)
+                    CastRay(world, rays[i], hits[i], mask);
+            }
+
+        private:
+            const btCollisionWorld& world;
+            const std::vector<Physics::Ray>& rays;
+            std::vector<Physics::QueryHit>& hits;
+            int mask;
+    };
+#endif
+}
+
 PhysicsManager::PhysicsManager() {
+    // Report Bullet's memory to the memory tracker. Has to be set before
+    // Bullet allocates anything, since the memory is freed by the same functions.
+    btAlignedAllocSetCustom(AllocatePhysicsMemory, FreePhysicsMemory);
+
     // The broadphase is used to quickly cull bodies that will not collide with
     // each other, normally by leveraging some simpler (and rough) test such as
     // bounding boxes.
@@ -26,31 +154,35 @@ PhysicsManager::PhysicsManager() {
     // With the collision configuration one can configure collision detection
     // algorithms.
     collisionConfiguration = new btDefaultCollisionConfiguration;
-    dispatcher = new btCollisionDispatcher(collisionConfiguration);
 
-    // The solver makes objects interact by making use of gravity, collisions,
-    // game logic supplied forces, and constraints.
-    solver = new btSequentialImpulseConstraintSolver;
+    // Let ghost objects (trigger volumes) keep track of the bodies overlapping
+    // them in the broadphase.
+    ghostPairCallback = new btGhostPairCallback();
+    broadphase->getOverlappingPairCache()->setInternalGhostPairCallback(ghostPairCallback);
 
-    // The dynamics world encompasses objects included in the simulation.
-    dynamicsWorld = new btDiscreteDynamicsWorld(dispatcher, broadphase, solver, collisionConfiguration);
-
-    // Y axis up
-    dynamicsWorld->setGravity(btVector3(0.f, -9.82f, 0.f));
+    CreateWorld();
 
     // Set the lockbox key we will use for lockboxes created in here.
     triggerLockBoxKey.reset(new Utility::LockBox<Physics::Trigger>::Key());
 }
 
 PhysicsManager::~PhysicsManager() {
-    delete dynamicsWorld;
-    delete solver;
-    delete dispatcher;
+    for (auto t : triggers) {
+        dynamicsWorld->removeCollisionObject(t->GetCollisionObject());
+        delete t;
+    }
+
+    DestroyWorld();
     delete collisionConfiguration;
     delete broadphase;
+    delete ghostPairCallback;
 
-    for (auto t : triggers)
-        delete t;
+#ifdef PHYSICS_MULTITHREADING
+    if (taskScheduler != nullptr) {
+        btSetTaskScheduler(btGetSequentialTaskScheduler());
+        delete taskScheduler;
+    }
+#endif
 }
 
 void PhysicsManager::Update(float deltaTime) {
@@ -59,39 +191,52 @@ void PhysicsManager::Update(float deltaTime) {
             continue;
         }
 
-        auto worldPos = rigidBodyComp->entity->GetWorldPosition();
-        auto worldOrientation = rigidBodyComp->entity->GetWorldOrientation();
-        if (rigidBodyComp->ghost) {
-            rigidBodyComp->SetPosition(worldPos);
-            rigidBodyComp->SetOrientation(worldOrientation);
-            rigidBodyComp->ghostObject->activate(true);
-        }
-        else if (rigidBodyComp->IsKinematic()) {
-            rigidBodyComp->SetPosition(worldPos);
-            rigidBodyComp->SetOrientation(worldOrientation);
-            // Wake up from sleeping state. Apparently kinematic objects also
-            // goes inactive, but are not woken up when we set position.
-            rigidBodyComp->GetBulletRigidBody()->activate(true);
-
-            if (rigidBodyComp->GetHaltMovement()) {
-                btTransform trans;
-                rigidBodyComp->GetBulletRigidBody()->getMotionState()->getWorldTransform(trans);
-                // Proceed twice to prevent interpolation of velocities.
-                rigidBodyComp->GetBulletRigidBody()->proceedToTransform(trans);
-                rigidBodyComp->GetBulletRigidBody()->proceedToTransform(trans);
-                rigidBodyComp->SetHaltMovement(false);
+        if (rigidBodyComp->ghost || rigidBodyComp->IsKinematic()) {
+            // Only push transforms that have changed, so that bodies that
+            // aren't moved by the game can go to sleep.
+            auto worldPos = rigidBodyComp->entity->GetWorldPosition();
+            auto worldOrientation = rigidBodyComp->entity->GetWorldOrientation();
+            bool moved = rigidBodyComp->UpdateSyncedTransform(worldPos, worldOrientation);
+
+            if (rigidBodyComp->ghost) {
+                if (moved) {
+                    rigidBodyComp->SetPosition(worldPos);
+                    rigidBodyComp->SetOrientation(worldOrientation);
+                    rigidBodyComp->ghostObject->activate(true);
+                }
+            } else {
+                if (moved) {
+                    rigidBodyComp->SetPosition(worldPos);
+                    rigidBodyComp->SetOrientation(worldOrientation);
+                    // Wake up from sleeping state. Apparently kinematic objects also
+                    // goes inactive, but are not woken up when we set position.
+                    rigidBodyComp->GetBulletRigidBody()->activate(true);
+                }
+
+                if (rigidBodyComp->GetHaltMovement()) {
+                    btTransform trans;
+                    rigidBodyComp->GetBulletRigidBody()->getMotionState()->getWorldTransform(trans);
+                    // Proceed twice to prevent interpolation of velocities.
+                    rigidBodyComp->GetBulletRigidBody()->proceedToTransform(trans);
+                    rigidBodyComp->GetBulletRigidBody()->proceedToTransform(trans);
+                    rigidBodyComp->SetHaltMovement(false);
+                }
             }
         } else if (rigidBodyComp->GetForceTransformSync()) {
             dynamicsWorld->removeRigidBody(rigidBodyComp->GetBulletRigidBody());
-            rigidBodyComp->SetPosition(worldPos);
-            rigidBodyComp->SetOrientation(worldOrientation);
+            rigidBodyComp->SetPosition(rigidBodyComp->entity->GetWorldPosition());
+            rigidBodyComp->SetOrientation(rigidBodyComp->entity->GetWorldOrientation());
             rigidBodyComp->GetBulletRigidBody()->activate(true); // To wake up from potentially sleeping state
             dynamicsWorld->addRigidBody(rigidBodyComp->GetBulletRigidBody());
             rigidBodyComp->SetForceTransformSync(false);
         }
     }
 
-    dynamicsWorld->stepSimulation(deltaTime, 10);
+    // Bullet returns the number of steps the time called for, before
+    // clamping it to the maximum.
+    int steps = dynamicsWorld->stepSimulation(deltaTime, maxSubSteps, timeStep);
+    subStepCount = std::min(steps, maxSubSteps);
+    droppedSubStepCount = steps - subStepCount;
 
     for (auto trigger : triggers) {
         trigger->Process(*dynamicsWorld);
@@ -99,17 +244,167 @@ void PhysicsManager::Update(float deltaTime) {
 }
 
 void PhysicsManager::UpdateEntityTransforms() {
-    for (auto rigidBodyComp : rigidBodyComponents.GetAll()) {
+    // Only bodies whose motion states Bullet updated during the step have
+    // moved. Sleeping bodies are never in the list.
+    for (auto rigidBodyComp : movedBodies) {
+        rigidBodyComp->ClearMoved();
+
         if (rigidBodyComp->IsKilled() || !rigidBodyComp->entity->IsEnabled())
             continue;
 
+        // The motion state holds the transform interpolated between the last
+        // two steps.
         Entity* entity = rigidBodyComp->entity;
-        auto trans = rigidBodyComp->GetBulletRigidBody()->getWorldTransform();
+        btTransform trans;
+        if (interpolate)
+            rigidBodyComp->GetBulletRigidBody()->getMotionState()->getWorldTransform(trans);
+        else
+            trans = rigidBodyComp->GetBulletRigidBody()->getWorldTransform();
+
         if (!rigidBodyComp->ghost && !rigidBodyComp->IsKinematic()) {
             entity->SetWorldPosition(Physics::btToGlm(trans.getOrigin()));
             entity->SetWorldOrientation(Physics::btToGlm(trans.getRotation()));
         }
     }
+    movedBodies.clear();
+}
+
+void PhysicsManager::SetTimeStep(float timeStep, int maxSubSteps) {
+    this->timeStep = timeStep;
+    this->maxSubSteps = std::max(maxSubSteps, 1);
+}
+
+float PhysicsManager::GetTimeStep() const {
+    return timeStep;
+}
+
+int PhysicsManager::GetMaxSubSteps() const {
+    return maxSubSteps;
+}
+
+void PhysicsManager::SetInterpolation(bool interpolate) {
+    this->interpolate = interpolate;
+}
+
+bool PhysicsManager::GetInterpolation() const {
+    return interpolate;
+}
+
+int PhysicsManager::GetSubStepCount() const {
+    return subStepCount;
+}
+
+int PhysicsManager::GetDroppedSubStepCount() const {
+    return droppedSubStepCount;
+}
+
+void PhysicsManager::SetThreadCount(int threadCount) {
+    threadCount = std::max(threadCount, 1);
+
+    // Pipelined updates step the simulation on a worker thread, which can't use the task scheduler.
+    if (threadCount > 1 && Hymn().GetPipelined()) {
+        Log(Log::WARNING) << "PhysicsManager::SetThreadCount: Physics can only use one thread when pipelined.\n";
+        threadCount = 1;
+    }
+
+#ifdef PHYSICS_MULTITHREADING
+    if (threadCount > 1 && taskScheduler == nullptr) {
+        taskScheduler = btCreateDefaultTaskScheduler();
+        if (taskScheduler == nullptr)
+            Log(Log::WARNING) << "PhysicsManager::SetThreadCount: No task scheduler available, physics will run on one thread.\n";
+        else
+            btSetTaskScheduler(taskScheduler);
+    }
+
+    if (taskScheduler == nullptr)
+        threadCount = 1;
+    else
+        threadCount = std::min(threadCount, taskScheduler->getMaxNumThreads());
+#else
+    if (threadCount > 1)
+        Log(Log::WARNING) << "PhysicsManager::SetThreadCount: Bullet was built without multithreading, physics will run on one thread.\n";
+    threadCount = 1;
+#endif
+
+    if (threadCount == this->threadCount)
+        return;
+
+    this->threadCount = threadCount;
+#ifdef PHYSICS_MULTITHREADING
+    if (taskScheduler != nullptr)
+        taskScheduler->setNumThreads(threadCount);
+#endif
+
+    // Move all collision objects over to a world of the new kind.
+    struct WorldObject {
+        btCollisionObject* object;
+        int group;
+        int mask;
+    };
+    std::vector<WorldObject> objects;
+    btCollisionObjectArray& objectArray = dynamicsWorld->getCollisionObjectArray();
+    for (int i = objectArray.size() - 1; i >= 0; --i) {
+        btCollisionObject* object = objectArray[i];
+        btBroadphaseProxy* proxy = object->getBroadphaseHandle();
+        objects.push_back({ object, proxy->m_collisionFilterGroup, proxy->m_collisionFilterMask });
+        dynamicsWorld->removeCollisionObject(object);
+    }
+
+    DestroyWorld();
+    CreateWorld();
+
+    for (auto it = objects.rbegin(); it != objects.rend(); ++it) {
+        // Ghost rigid bodies and triggers are plain collision objects.
+        btRigidBody* body = btRigidBody::upcast(it->object);
+        if (body != nullptr)
+            dynamicsWorld->addRigidBody(body, it->group, it->mask);
+        else
+            dynamicsWorld->addCollisionObject(it->object, it->group, it->mask);
+    }
+}
+
+int PhysicsManager::GetThreadCount() const {
+    return threadCount;
+}
+
+bool PhysicsManager::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Physics::QueryHit& hit, int mask) const {
+    return CastRay(*dynamicsWorld, { origin, direction, maxDistance }, hit, mask);
+}
+
+void PhysicsManager::Raycast(const std::vector<Physics::Ray>& rays, std::vector<Physics::QueryHit>& hits, int mask) const {
+    hits.resize(rays.size());
+
+#ifdef PHYSICS_MULTITHREADING
+    // The broadphase keeps a separate traversal stack per thread, so rays
+    // can be cast concurrently as long as the world isn't being stepped.
+    if (threadCount > 1) {
+        btParallelFor(0, static_cast<int>(rays.size()), 64, RaycastBody(*dynamicsWorld, rays, hits, mask));
+        return;
+    }
+#endif
+
+    for (std::size_t i = 0; i < rays.size(); ++i)
+        CastRay(*dynamicsWorld, rays[i], hits[i], mask);
+}
+
+bool PhysicsManager::SphereSweep(const glm::vec3& from, const glm::vec3& to, float radius, Physics::QueryHit& hit, int mask) const {
+    btSphereShape shape(radius);
+    return Sweep(shape, from, to, glm::quat(), hit, mask);
+}
+
+bool PhysicsManager::BoxSweep(const glm::vec3& from, const glm::vec3& to, const glm::vec3& halfExtents, const glm::quat& orientation, Physics::QueryHit& hit, int mask) const {
+    btBoxShape shape(Physics::glmToBt(halfExtents));
+    return Sweep(shape, from, to, orientation, hit, mask);
+}
+
+void PhysicsManager::OverlapSphere(const glm::vec3& center, float radius, std::vector<Entity*>& entities, int mask) const {
+    btSphereShape shape(radius);
+    Overlap(shape, center, glm::quat(), entities, mask);
+}
+
+void PhysicsManager::OverlapBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::quat& orientation, std::vector<Entity*>& entities, int mask) const {
+    btBoxShape shape(Physics::glmToBt(halfExtents));
+    Overlap(shape, center, orientation, entities, mask);
 }
 
 void PhysicsManager::OnTriggerEnter(Utility::LockBox<Physics::Trigger> trigger, Component::RigidBody* object, std::function<void()> callback) {
@@ -167,7 +462,7 @@ Component::RigidBody* PhysicsManager::CreateRigidBody(Entity* owner) {
     auto comp = rigidBodyComponents.Create();
     comp->entity = owner;
 
-    comp->NewBulletRigidBody(1.0f);
+    comp->NewBulletRigidBody(1.0f, movedBodies);
 
     auto shapeComp = comp->entity->GetComponent<Component::Shape>();
     if (shapeComp) {
@@ -179,36 +474,36 @@ Component::RigidBody* PhysicsManager::CreateRigidBody(Entity* owner) {
     return comp;
 }
 
-Component::RigidBody* PhysicsManager::CreateRigidBody(Entity* owner, const Json::Value& node) {
+Component::RigidBody* PhysicsManager::CreateRigidBody(Entity* owner, const SceneNode& node) {
     auto comp = rigidBodyComponents.Create();
     comp->entity = owner;
 
-    auto mass = node.get("mass", 1.0f).asFloat();
-    comp->NewBulletRigidBody(mass);
+    auto mass = node.GetFloat("mass", 1.0f);
+    comp->NewBulletRigidBody(mass, movedBodies);
 
-    auto friction = node.get("friction", 0.5f).asFloat();
+    auto friction = node.GetFloat("friction", 0.5f);
     comp->SetFriction(friction);
 
-    auto rollingFriction = node.get("rollingFriction", 0.0f).asFloat();
+    auto rollingFriction = node.GetFloat("rollingFriction", 0.0f);
     comp->SetRollingFriction(rollingFriction);
 
-    auto spinningFriction = node.get("spinningFriction", 0.0f).asFloat();
+    auto spinningFriction = node.GetFloat("spinningFriction", 0.0f);
     comp->SetSpinningFriction(spinningFriction);
 
-    auto cor = node.get("cor", 0.0f).asFloat();
+    auto cor = node.GetFloat("cor", 0.0f);
     comp->SetRestitution(cor);
 
-    auto linearDamping = node.get("linearDamping", 0.0f).asFloat();
+    auto linearDamping = node.GetFloat("linearDamping", 0.0f);
     comp->SetLinearDamping(linearDamping);
 
-    auto angularDamping = node.get("angularDamping", 0.0f).asFloat();
+    auto angularDamping = node.GetFloat("angularDamping", 0.0f);
     comp->SetAngularDamping(angularDamping);
 
-    auto kinematic = node.get("kinematic", false).asFloat();
+    auto kinematic = node.GetBool("kinematic", false);
     if (kinematic)
         comp->MakeKinematic();
 
-    auto ghost = node.get("ghost", false).asBool();
+    auto ghost = node.GetBool("ghost", false);
     if (ghost)
         comp->SetGhost(ghost);
 
@@ -229,7 +524,7 @@ Component::Shape* PhysicsManager::CreateShape(Entity* owner) {
     auto comp = shapeComponents.Create();
     comp->entity = owner;
 
-    auto shape = std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Sphere(1.0f)));
+    auto shape = shapeCache.Get(Physics::Shape::Sphere(1.0f));
     comp->SetShape(shape);
 
     auto rigidBodyComp = comp->entity->GetComponent<Component::RigidBody>();
@@ -245,45 +540,45 @@ Component::Shape* PhysicsManager::CreateShape(Entity* owner) {
     return comp;
 }
 
-Component::Shape* PhysicsManager::CreateShape(Entity* owner, const Json::Value& node) {
+Component::Shape* PhysicsManager::CreateShape(Entity* owner, const SceneNode& node) {
     auto comp = shapeComponents.Create();
     comp->entity = owner;
 
-    if (node.isMember("sphere")) {
-        auto sphere = node.get("sphere", {});
-        auto radius = sphere.get("radius", 1.0f).asFloat();
-        auto shape = std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Sphere(radius)));
+    if (node.IsMember("sphere")) {
+        SceneNode sphere = node.GetMember("sphere");
+        auto radius = sphere.GetFloat("radius", 1.0f);
+        auto shape = shapeCache.Get(Physics::Shape::Sphere(radius));
         comp->SetShape(shape);
-    } else if (node.isMember("plane")) {
-        auto plane = node.get("plane", {});
-        auto normal = Json::LoadVec3(plane.get("normal", {}));
-        auto planeCoeff = plane.get("planeCoeff", 0.0f).asFloat();
-        auto shape = std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Plane(normal, planeCoeff)));
+    } else if (node.IsMember("plane")) {
+        SceneNode plane = node.GetMember("plane");
+        auto normal = plane.GetVec3("normal");
+        auto planeCoeff = plane.GetFloat("planeCoeff", 0.0f);
+        auto shape = shapeCache.Get(Physics::Shape::Plane(normal, planeCoeff));
         comp->SetShape(shape);
-    } else if (node.isMember("box")) {
-        auto box = node.get("box", {});
-        auto width = box.get("width", 1.0f).asFloat();
-        auto height = box.get("height", 1.0f).asFloat();
-        auto depth = box.get("depth", 1.0f).asFloat();
-        auto shape = std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Box(width, height, depth)));
+    } else if (node.IsMember("box")) {
+        SceneNode box = node.GetMember("box");
+        auto width = box.GetFloat("width", 1.0f);
+        auto height = box.GetFloat("height", 1.0f);
+        auto depth = box.GetFloat("depth", 1.0f);
+        auto shape = shapeCache.Get(Physics::Shape::Box(width, height, depth));
         comp->SetShape(shape);
-    } else if (node.isMember("cylinder")) {
-        auto cylinder = node.get("cylinder", {});
-        auto radius = cylinder.get("radius", 1.0f).asFloat();
-        auto length = cylinder.get("length", 1.0f).asFloat();
-        auto shape = std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Cylinder(radius, length)));
+    } else if (node.IsMember("cylinder")) {
+        SceneNode cylinder = node.GetMember("cylinder");
+        auto radius = cylinder.GetFloat("radius", 1.0f);
+        auto length = cylinder.GetFloat("length", 1.0f);
+        auto shape = shapeCache.Get(Physics::Shape::Cylinder(radius, length));
         comp->SetShape(shape);
-    } else if (node.isMember("cone")) {
-        auto cone = node.get("cone", {});
-        auto radius = cone.get("radius", 1.0f).asFloat();
-        auto height = cone.get("height", 1.0f).asFloat();
-        auto shape = std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Cone(radius, height)));
+    } else if (node.IsMember("cone")) {
+        SceneNode cone = node.GetMember("cone");
+        auto radius = cone.GetFloat("radius", 1.0f);
+        auto height = cone.GetFloat("height", 1.0f);
+        auto shape = shapeCache.Get(Physics::Shape::Cone(radius, height));
         comp->SetShape(shape);
-    } else if (node.isMember("capsule")) {
-        auto capsule = node.get("capsule", {});
-        auto radius = capsule.get("radius", 1.0f).asFloat();
-        auto height = capsule.get("height", 1.0f).asFloat();
-        auto shape = std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Capsule(radius, height)));
+    } else if (node.IsMember("capsule")) {
+        SceneNode capsule = node.GetMember("capsule");
+        auto radius = capsule.GetFloat("radius", 1.0f);
+        auto height = capsule.GetFloat("height", 1.0f);
+        auto shape = shapeCache.Get(Physics::Shape::Capsule(radius, height));
         comp->SetShape(shape);
     }
 
@@ -304,6 +599,7 @@ Utility::LockBox<Physics::Trigger> PhysicsManager::CreateTrigger(std::shared_ptr
     btTransform trans(btQuaternion(0, 0, 0, 1), btVector3(0, 0, 0));
     Physics::Trigger* trigger = new Physics::Trigger(trans);
     trigger->SetCollisionShape(shape);
+    dynamicsWorld->addCollisionObject(trigger->GetCollisionObject(), btBroadphaseProxy::SensorTrigger, btBroadphaseProxy::AllFilter & ~btBroadphaseProxy::SensorTrigger);
     triggers.push_back(trigger);
     return Utility::LockBox<Physics::Trigger>(triggerLockBoxKey, trigger);
 }
@@ -315,10 +611,11 @@ void PhysicsManager::ReleaseTriggerVolume(Utility::LockBox<Physics::Trigger>&& t
         trigger.Open(triggerLockBoxKey, [this](Physics::Trigger& t) {
             auto it = std::find(triggers.begin(), triggers.end(), &t);
             if (it != triggers.end()) {
+                dynamicsWorld->removeCollisionObject((*it)->GetCollisionObject());
                 delete *it;
                 std::swap(*it, *triggers.rbegin());
                 triggers.pop_back();
-                }
+            }
         });
     }
 }
@@ -330,6 +627,9 @@ void PhysicsManager::SetPosition(Utility::LockBox<Physics::Trigger> trigger, con
 }
 
 void PhysicsManager::SetShape(Component::Shape* comp, std::shared_ptr<::Physics::Shape> shape) {
+    if (comp->GetShape() == shape)
+        return;
+
     comp->SetShape(shape);
 
     auto rigidBodyComp = comp->entity->GetComponent<Component::RigidBody>();
@@ -342,8 +642,14 @@ float PhysicsManager::GetMass(Component::RigidBody* comp) {
 }
 
 void PhysicsManager::SetShape(Utility::LockBox<Physics::Trigger> trigger, std::shared_ptr<Physics::Shape> shape) {
-    trigger.Open(triggerLockBoxKey, [shape](Physics::Trigger& trigger) {
+    trigger.Open(triggerLockBoxKey, [this, shape](Physics::Trigger& trigger) {
+        if (trigger.shape == shape)
+            return;
+
+        // Re-add the volume so the broadphase picks up the new bounds.
+        dynamicsWorld->removeCollisionObject(trigger.GetCollisionObject());
         trigger.SetCollisionShape(shape);
+        dynamicsWorld->addCollisionObject(trigger.GetCollisionObject(), btBroadphaseProxy::SensorTrigger, btBroadphaseProxy::AllFilter & ~btBroadphaseProxy::SensorTrigger);
     });
 }
 
@@ -421,6 +727,75 @@ void PhysicsManager::HaltMovement(Component::RigidBody* comp) {
     comp->SetHaltMovement(true);
 }
 
+void PhysicsManager::CreateWorld() {
+#ifdef PHYSICS_MULTITHREADING
+    if (threadCount > 1) {
+        // Narrowphase collision detection and island solving are split into
+        // tasks run by Bullet's task scheduler.
+        dispatcher = new btCollisionDispatcherMt(collisionConfiguration);
+        solverPool = new btConstraintSolverPoolMt(threadCount);
+        dynamicsWorld = new btDiscreteDynamicsWorldMt(dispatcher, broadphase, solverPool, nullptr, collisionConfiguration);
+        dynamicsWorld->setGravity(Physics::glmToBt(gravity));
+        return;
+    }
+#endif
+
+    dispatcher = new btCollisionDispatcher(collisionConfiguration);
+
+    // The solver makes objects interact by making use of gravity, collisions,
+    // game logic supplied forces, and constraints.
+    solver = new btSequentialImpulseConstraintSolver;
+
+    // The dynamics world encompasses objects included in the simulation.
+    dynamicsWorld = new btDiscreteDynamicsWorld(dispatcher, broadphase, solver, collisionConfiguration);
+    dynamicsWorld->setGravity(Physics::glmToBt(gravity));
+}
+
+void PhysicsManager::DestroyWorld() {
+    delete dynamicsWorld;
+    delete solver;
+#ifdef PHYSICS_MULTITHREADING
+    delete solverPool;
+#endif
+    delete dispatcher;
+
+    dynamicsWorld = nullptr;
+    solver = nullptr;
+    solverPool = nullptr;
+    dispatcher = nullptr;
+}
+
+bool PhysicsManager::Sweep(const btConvexShape& shape, const glm::vec3& from, const glm::vec3& to, const glm::quat& orientation, Physics::QueryHit& hit, int mask) const {
+    hit = Physics::QueryHit();
+
+    btQuaternion rotation = Physics::glmToBt(orientation);
+    btTransform fromTransform(rotation, Physics::glmToBt(from));
+    btTransform toTransform(rotation, Physics::glmToBt(to));
+    ClosestSweepCallback callback(fromTransform.getOrigin(), toTransform.getOrigin(), mask);
+    dynamicsWorld->convexSweepTest(&shape, fromTransform, toTransform, callback);
+    if (!callback.hasHit())
+        return false;
+
+    hit.entity = GetEntity(callback.m_hitCollisionObject);
+    hit.point = Physics::btToGlm(callback.m_hitPointWorld);
+    hit.normal = Physics::btToGlm(callback.m_hitNormalWorld);
+    hit.distance = callback.m_closestHitFraction * glm::distance(from, to);
+    return true;
+}
+
+void PhysicsManager::Overlap(btConvexShape& shape, const glm::vec3& center, const glm::quat& orientation, std::vector<Entity*>& entities, int mask) const {
+    btCollisionObject query;
+    query.setCollisionShape(&shape);
+    query.setWorldTransform(btTransform(Physics::glmToBt(orientation), Physics::glmToBt(center)));
+
+    OverlapCallback callback(entities, mask);
+    dynamicsWorld->contactTest(&query, callback);
+}
+
+Physics::ShapeCache& PhysicsManager::GetShapeCache() {
+    return shapeCache;
+}
+
 const std::vector<Component::Shape*>& PhysicsManager::GetShapeComponents() const {
     return shapeComponents.GetAll();
 }
@@ -428,10 +803,15 @@ const std::vector<Component::Shape*>& PhysicsManager::GetShapeComponents() const
 void PhysicsManager::ClearKilledComponents() {
     rigidBodyComponents.ClearKilled(
         [this](Component::RigidBody* body) {
+            auto it = std::find(movedBodies.begin(), movedBodies.end(), body);
+            if (it != movedBodies.end())
+                movedBodies.erase(it);
+
             if (body->ghost)
                 dynamicsWorld->removeCollisionObject(body->GetBulletCollisionObject());
             else
                 dynamicsWorld->removeRigidBody(body->GetBulletRigidBody());
         });
     shapeComponents.ClearKilled();
+    shapeCache.Prune();
 }
@@ -2,10 +2,13 @@
 
 #include <functional>
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <memory>
 #include <Utility/LockBox.hpp>
 #include <vector>
 #include "../Entity/ComponentContainer.hpp"
+#include "../Physics/Query.hpp"
+#include "../Physics/ShapeCache.hpp"
 #include "../linking.hpp"
 
 namespace Component {
@@ -18,15 +21,17 @@ namespace Physics {
     class Trigger;
 }
 
-namespace Json {
-    class Value;
-}
+class SceneNode;
 
 class btBroadphaseInterface;
 class btDefaultCollisionConfiguration;
 class btCollisionDispatcher;
-class btSequentialImpulseConstraintSolver;
+class btConstraintSolver;
+class btConvexShape;
+class btConstraintSolverPoolMt;
 class btDiscreteDynamicsWorld;
+class btGhostPairCallback;
+class btITaskScheduler;
 class Entity;
 
 /// Updates the physics of the world.
@@ -43,6 +48,145 @@ class PhysicsManager {
         /// Update transforms of entities according to positions of physics
         /// components.
         ENGINE_API void UpdateEntityTransforms();
+
+        /// Set how the simulation is stepped.
+        /**
+         * The simulation always advances in steps of |timeStep| seconds.
+         * Frame time that doesn't fill a whole step is carried over to the
+         * next frame. If a frame would need more than |maxSubSteps| steps,
+         * the excess time is dropped, slowing the simulation down instead of
+         * making the frame even longer.
+         * @param timeStep Length of a simulation step in seconds.
+         * @param maxSubSteps Maximum number of steps per frame.
+         */
+        ENGINE_API void SetTimeStep(float timeStep, int maxSubSteps);
+
+        /// Get the length of a simulation step.
+        /**
+         * @return The length of a step in seconds.
+         */
+        ENGINE_API float GetTimeStep() const;
+
+        /// Get the maximum number of simulation steps per frame.
+        /**
+         * @return The maximum number of steps.
+         */
+        ENGINE_API int GetMaxSubSteps() const;
+
+        /// Set whether entity transforms are interpolated between the last
+        /// two simulation steps.
+        /**
+         * Interpolation hides the difference between the frame rate and the
+         * simulation rate. Without it, entities are placed at the transform
+         * of the last step.
+         * @param interpolate Whether to interpolate.
+         */
+        ENGINE_API void SetInterpolation(bool interpolate);
+
+        /// Get whether entity transforms are interpolated.
+        /**
+         * @return Whether entity transforms are interpolated.
+         */
+        ENGINE_API bool GetInterpolation() const;
+
+        /// Get the number of simulation steps taken during the last update.
+        /**
+         * @return The number of steps.
+         */
+        ENGINE_API int GetSubStepCount() const;
+
+        /// Get the number of simulation steps dropped during the last update
+        /// because they would have exceeded the maximum.
+        /**
+         * @return The number of dropped steps.
+         */
+        ENGINE_API int GetDroppedSubStepCount() const;
+
+        /// Set the number of threads used to step the simulation.
+        /**
+         * With more than one thread, Bullet's multithreaded dynamics world is
+         * used, which runs collision detection and solves simulation islands
+         * in parallel. Changing the thread count recreates the dynamics world
+         * and moves all bodies and triggers over to it.
+         *
+         * If the engine was configured without UsePhysicsMultithreading, the
+         * simulation keeps running on one thread.
+         *
+         * The simulation must be stepped on the thread that set the thread
+         * count, so only one thread is used while updates are pipelined (see
+         * ActiveHymn::SetPipelined).
+         * @param threadCount The number of threads.
+         */
+        ENGINE_API void SetThreadCount(int threadCount);
+
+        /// Get the number of threads used to step the simulation.
+        /**
+         * @return The number of threads.
+         */
+        ENGINE_API int GetThreadCount() const;
+
+        /// Cast a ray and find the closest body it hits.
+        /**
+         * @param origin Where the ray starts, in world space.
+         * @param direction The direction of the ray.
+         * @param maxDistance How far to cast the ray.
+         * @param hit The closest hit.
+         * @param mask Which Physics::QueryFilter groups to hit.
+         * @return Whether the ray hit anything.
+         */
+        ENGINE_API bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Physics::QueryHit& hit, int mask = Physics::QUERY_DEFAULT) const;
+
+        /// Cast many rays and find the closest body each of them hits.
+        /**
+         * The rays are cast in parallel when the simulation runs on multiple
+         * threads.
+         * @param rays The rays to cast.
+         * @param hits The closest hit of each ray, with a null entity for rays that didn't hit anything.
+         * @param mask Which Physics::QueryFilter groups to hit.
+         */
+        ENGINE_API void Raycast(const std::vector<Physics::Ray>& rays, std::vector<Physics::QueryHit>& hits, int mask = Physics::QUERY_DEFAULT) const;
+
+        /// Sweep a sphere and find the closest body it hits.
+        /**
+         * @param from Where the center of the sphere starts, in world space.
+         * @param to Where the center of the sphere ends, in world space.
+         * @param radius The radius of the sphere.
+         * @param hit The closest hit.
+         * @param mask Which Physics::QueryFilter groups to hit.
+         * @return Whether the sphere hit anything.
+         */
+        ENGINE_API bool SphereSweep(const glm::vec3& from, const glm::vec3& to, float radius, Physics::QueryHit& hit, int mask = Physics::QUERY_DEFAULT) const;
+
+        /// Sweep a box and find the closest body it hits.
+        /**
+         * @param from Where the center of the box starts, in world space.
+         * @param to Where the center of the box ends, in world space.
+         * @param halfExtents Half the size of the box along each axis.
+         * @param orientation The orientation of the box.
+         * @param hit The closest hit.
+         * @param mask Which Physics::QueryFilter groups to hit.
+         * @return Whether the box hit anything.
+         */
+        ENGINE_API bool BoxSweep(const glm::vec3& from, const glm::vec3& to, const glm::vec3& halfExtents, const glm::quat& orientation, Physics::QueryHit& hit, int mask = Physics::QUERY_DEFAULT) const;
+
+        /// Find all entities whose bodies overlap a sphere.
+        /**
+         * @param center The center of the sphere, in world space.
+         * @param radius The radius of the sphere.
+         * @param entities Vector to add the overlapping entities to.
+         * @param mask Which Physics::QueryFilter groups to find.
+         */
+        ENGINE_API void OverlapSphere(const glm::vec3& center, float radius, std::vector<Entity*>& entities, int mask = Physics::QUERY_DEFAULT) const;
+
+        /// Find all entities whose bodies overlap a box.
+        /**
+         * @param center The center of the box, in world space.
+         * @param halfExtents Half the size of the box along each axis.
+         * @param orientation The orientation of the box.
+         * @param entities Vector to add the overlapping entities to.
+         * @param mask Which Physics::QueryFilter groups to find.
+         */
+        ENGINE_API void OverlapBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::quat& orientation, std::vector<Entity*>& entities, int mask = Physics::QUERY_DEFAULT) const;
         
         /// Set up listener for when |object| has entered |trigger|.
         /**
@@ -99,10 +243,10 @@ class PhysicsManager {
         /// Create rigid body component.
         /**
          * @param owner The %Entity that will own the component.
-         * @param node Json node from which to load component definition.
+         * @param node Scene node from which to load component definition.
          * @return The created component.
          */
-        ENGINE_API Component::RigidBody* CreateRigidBody(Entity* owner, const Json::Value& node);
+        ENGINE_API Component::RigidBody* CreateRigidBody(Entity* owner, const SceneNode& node);
 
         /// Create a component that represents a physical shape.
         /**
@@ -114,10 +258,10 @@ class PhysicsManager {
         /// Create a component that represents a physical shape.
         /**
          * @param owner The %Entity that will own the component.
-         * @param node Json node from which to load component definition.
+         * @param node Scene node from which to load component definition.
          * @return The created component.
          */
-        ENGINE_API Component::Shape* CreateShape(Entity* owner, const Json::Value& node);
+        ENGINE_API Component::Shape* CreateShape(Entity* owner, const SceneNode& node);
 
         /// Create a trigger volume that can be used to check intersection
         /// events against physics bodies.
@@ -248,6 +392,14 @@ class PhysicsManager {
          */
         ENGINE_API void HaltMovement(Component::RigidBody* comp);
 
+        /// Get the cache that shares shapes with identical parameters.
+        /**
+         * Shapes should be created through the cache, so that entities with
+         * the same shape share a single Bullet collision shape.
+         * @return The shape cache.
+         */
+        ENGINE_API Physics::ShapeCache& GetShapeCache();
+
         /// Get all shape components.
         /**
          * @return All shape components.
@@ -263,16 +415,33 @@ class PhysicsManager {
         PhysicsManager(PhysicsManager const&) = delete;
         void operator=(PhysicsManager const&) = delete;
 
+        void CreateWorld();
+        void DestroyWorld();
+        bool Sweep(const btConvexShape& shape, const glm::vec3& from, const glm::vec3& to, const glm::quat& orientation, Physics::QueryHit& hit, int mask) const;
+        void Overlap(btConvexShape& shape, const glm::vec3& center, const glm::quat& orientation, std::vector<Entity*>& entities, int mask) const;
+
         glm::vec3 gravity = glm::vec3(0.f, -9.82f, 0.f);
 
         ComponentContainer<Component::RigidBody> rigidBodyComponents;
         ComponentContainer<Component::Shape> shapeComponents;
+        Physics::ShapeCache shapeCache;
+        std::vector<Component::RigidBody*> movedBodies;
+
+        float timeStep = 1.0f / 60.0f;
+        int maxSubSteps = 4;
+        bool interpolate = true;
+        int subStepCount = 0;
+        int droppedSubStepCount = 0;
+        int threadCount = 1;
         
         btBroadphaseInterface* broadphase = nullptr;
         btDefaultCollisionConfiguration* collisionConfiguration = nullptr;
         btCollisionDispatcher* dispatcher = nullptr;
-        btSequentialImpulseConstraintSolver* solver = nullptr;
+        btConstraintSolver* solver = nullptr;
+        btConstraintSolverPoolMt* solverPool = nullptr;
         btDiscreteDynamicsWorld* dynamicsWorld = nullptr;
+        btGhostPairCallback* ghostPairCallback = nullptr;
+        btITaskScheduler* taskScheduler = nullptr;
 
         std::shared_ptr<Utility::LockBox<Physics::Trigger>::Key> triggerLockBoxKey;
         std::vector<::Physics::Trigger*> triggers;
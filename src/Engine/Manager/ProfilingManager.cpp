@@ -1,24 +1,167 @@
 #include "ProfilingManager.hpp"
 
-#include <GLFW/glfw3.h>
 #ifdef MEASURE_RAM
 #include <windows.h>
 #include <psapi.h>
+#elif defined(__linux__)
+#include <cstdio>
+#include <unistd.h>
 #endif
 
 #include <Utility/Log.hpp>
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
 
 #ifdef USINGMEMTRACK
 #include <MemTrackInclude.hpp>
 #endif
 
-ProfilingManager::ProfilingManager() : active(false) {
+namespace {
+    // Registered zone names, indexed by zone ID.
+    std::vector<const char*>& ZoneNames() {
+        static std::vector<const char*> names;
+        return names;
+    }
+
+    std::mutex& ZoneMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    // A captured zone event.
+    struct TraceEvent {
+        uint64_t time;
+        uint32_t zone;
+        uint32_t begin;
+    };
+}
+
+// The captured events of a thread. Only the owning thread writes to it, so
+// recording doesn't need a lock.
+struct ProfilingManager::TraceBuffer {
+    static const unsigned int capacity = 1 << 18;
+
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> count;
+    std::atomic<uint32_t> capture;
+    std::atomic<const char*> name;
+    unsigned int thread;
+
+    // Whether a thread owns the buffer. Guarded by TraceMutex.
+    bool used;
+};
+
+namespace {
+    typedef ProfilingManager::TraceBuffer TraceBuffer;
+
+    std::atomic<bool> capturing(false);
+    std::atomic<uint32_t> currentCapture(0);
+    std::atomic<uint64_t> droppedEvents(0);
+
+    // Buffers live for the rest of the program since WriteTrace reads them after their threads have exited.
+    // Buffers that are no longer used are handed to new threads instead of allocating new ones.
+    std::vector<std::unique_ptr<TraceBuffer>>& TraceBuffers() {
+        static std::vector<std::unique_ptr<TraceBuffer>> buffers;
+        return buffers;
+    }
+
+    std::mutex& TraceMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    TraceBuffer* AddTraceBuffer(const char* name) {
+        std::lock_guard<std::mutex> lock(TraceMutex());
+
+        // Events a reused buffer holds from the current capture are kept and written under the new thread's name.
+        for (const std::unique_ptr<TraceBuffer>& buffer : TraceBuffers()) {
+            if (!buffer->used) {
+                buffer->used = true;
+                buffer->name = name;
+                return buffer.get();
+            }
+        }
+
+        std::unique_ptr<TraceBuffer> buffer(new TraceBuffer());
+        buffer->events.resize(TraceBuffer::capacity);
+        buffer->count = 0;
+        buffer->capture = 0;
+        buffer->name = name;
+        buffer->thread = static_cast<unsigned int>(TraceBuffers().size() + 1);
+        buffer->used = true;
+        TraceBuffers().push_back(std::move(buffer));
+        return TraceBuffers().back().get();
+    }
+
+    void ReturnTraceBuffer(TraceBuffer* buffer) {
+        std::lock_guard<std::mutex> lock(TraceMutex());
+        buffer->used = false;
+    }
+
+    thread_local TraceBuffer* threadTraceBuffer = nullptr;
+    thread_local const char* threadName = nullptr;
+
+    // Returns the buffer a thread created for itself when the thread exits.
+    struct ThreadTraceBuffer {
+        TraceBuffer* buffer = nullptr;
+
+        ~ThreadTraceBuffer() {
+            if (buffer != nullptr)
+                ReturnTraceBuffer(buffer);
+            if (threadTraceBuffer == buffer)
+                threadTraceBuffer = nullptr;
+        }
+    };
+
+    thread_local ThreadTraceBuffer ownTraceBuffer;
+
+    // Get the calling thread's buffer, creating it the first time.
+    TraceBuffer* GetTraceBuffer() {
+        if (threadTraceBuffer == nullptr) {
+            threadTraceBuffer = AddTraceBuffer(threadName);
+            ownTraceBuffer.buffer = threadTraceBuffer;
+        }
+
+        return threadTraceBuffer;
+    }
+
+    // Write a string as a JSON string.
+    void WriteJSONString(std::ostream& stream, const char* string) {
+        stream << '"';
+        for (const char* c = string; *c != '\0'; ++c) {
+            if (*c == '"' || *c == '\\')
+                stream << '\\';
+            stream << *c;
+        }
+        stream << '"';
+    }
+}
+
+ProfilingManager::ProfilingManager(bool gpuProfiling) : active(false), gpuProfiling(gpuProfiling) {
     for (int i = 0; i < Type::COUNT; ++i) {
         root[i] = new Result("Root: " + TypeToString((Type)i), nullptr);
         root[i]->parent = nullptr;
+        current[i] = root[i];
     }
 
-    frameQuery = new Video::Query(Video::Query::TIME_ELAPSED);
+    samples.resize(sampleCapacity);
+    for (unsigned int i = 0; i < frames; ++i) {
+        frameTimes[0][i] = 0.0f;
+        frameTimes[1][i] = 0.0f;
+    }
+
+    for (GPUFrame& gpu : gpuFrames) {
+        for (int i = 0; i < Type::COUNT; ++i)
+            gpu.root[i] = i == Type::CPU_TIME ? nullptr : new Result("Root: " + TypeToString((Type)i), nullptr);
+
+        if (gpuProfiling)
+            gpu.frameQuery = new Video::Query(Video::Query::TIME_ELAPSED);
+    }
 
 #ifdef MEASURE_VRAM
     dxgiFactory = nullptr;
@@ -37,7 +180,19 @@ ProfilingManager::~ProfilingManager() {
         delete root[i];
     }
 
-    delete frameQuery;
+    for (GPUFrame& gpu : gpuFrames) {
+        for (int i = 0; i < Type::COUNT; ++i)
+            delete gpu.root[i];
+
+        delete gpu.frameQuery;
+        for (auto& it : gpu.queryMap)
+            delete it.second;
+    }
+
+    for (auto& it : queryPool) {
+        for (Video::Query* query : it.second)
+            delete query;
+    }
 
 #ifdef MEASURE_VRAM
     dxgiAdapter3->Release();
@@ -51,42 +206,69 @@ void ProfilingManager::BeginFrame() {
         return;
     }
 
-    // Clear previous results.
-    for (int i = 0; i < Type::COUNT; ++i) {
-        root[i]->children.clear();
-        current[i] = root[i];
+    current[Type::CPU_TIME] = root[Type::CPU_TIME];
+
+    // Only zones on the thread running the frame are recorded.
+    frameThread = std::this_thread::get_id();
+    depth = 0;
+    frameSamples[frame].firstSample = sampleCount;
+    frameSamples[frame].start = GetTime();
+
+    if (IsCapturing())
+        capturedFrames.push_back(std::make_pair(frameSamples[frame].start, static_cast<uint64_t>(0)));
+
+    // Record GPU queries into the next frame of the ring. If the GPU is so far
+    // behind that all frames are still in flight, skip GPU profiling of this
+    // frame rather than waiting for it.
+    gpuFrame = nullptr;
+    frameTimes[1][frame] = 0.0f;
+    if (gpuProfiling && !gpuFrames[nextGPUFrame].pending) {
+        gpuFrame = &gpuFrames[nextGPUFrame];
+        gpuFrame->frame = frame;
+        for (int i = 0; i < Type::COUNT; ++i) {
+            if (i != Type::CPU_TIME) {
+                gpuFrame->root[i]->children.clear();
+                gpuFrame->root[i]->value = 0.0;
+                current[i] = gpuFrame->root[i];
+            }
+        }
+        gpuFrame->frameQuery->Begin();
     }
-    frameStart = glfwGetTime();
-    frameQuery->Begin();
 }
 
 void ProfilingManager::EndFrame() {
-    // Calculate the CPU time of this frame.
-    frameTimes[0][frame] = static_cast<float>((glfwGetTime() - frameStart) * 1000.0);
+    if (!active) {
+        Log() << "ProfilingManager::EndFrame warning: Not active.\n";
+        return;
+    }
 
-    // Calculate the GPU time of this frame.
-    frameQuery->End();
-    frameTimes[1][frame] = static_cast<float>(frameQuery->Resolve() / 1000000.0);
+    // Calculate the CPU time of this frame.
+    frameSamples[frame].endSample = sampleCount;
+    frameSamples[frame].end = GetTime();
+    frameTimes[0][frame] = static_cast<float>((frameSamples[frame].end - frameSamples[frame].start) / 1000000.0);
+    lastFrame = frame;
+    ++completedFrames;
+
+    if (!capturedFrames.empty() && capturedFrames.back().second == 0)
+        capturedFrames.back().second = frameSamples[frame].end;
+
+    // Put this frame's GPU queries in flight.
+    if (gpuFrame != nullptr) {
+        gpuFrame->frameQuery->End();
+        gpuFrame->pending = true;
+        gpuFrame = nullptr;
+        nextGPUFrame = (nextGPUFrame + 1) % gpuFrameCount;
+    }
 
     if (++frame >= frames)
         frame = 0;
 
-    // Resolve and reset queries.
-    for (auto& it : queryMap) {
-        switch (it.second->GetType()) {
-        case Video::Query::Type::TIME_ELAPSED:
-            it.first->value = it.second->Resolve() / 1000000.0;
-            break;
-        case Video::Query::Type::SAMPLES_PASSED:
-            it.first->value = static_cast<double>(it.second->Resolve());
-            break;
-        default:
-            assert(false);
+    // Read back the frames the GPU has finished, oldest first.
+    for (unsigned int i = 0; i < gpuFrameCount; ++i) {
+        GPUFrame& gpu = gpuFrames[(nextGPUFrame + i) % gpuFrameCount];
+        if (gpu.pending && !ResolveGPUFrame(gpu))
             break;
-        }
-        queryPool[it.second->GetType()].push_back(it.second);
     }
-    queryMap.clear();
 }
 
 bool ProfilingManager::Active() const {
@@ -109,10 +291,155 @@ const float* ProfilingManager::GetGPUFrameTimes() const {
     return frameTimes[1];
 }
 
+void ProfilingManager::StartCapture() {
+    capturedFrames.clear();
+    droppedEvents = 0;
+
+    // Threads discard their old events the next time they record one.
+    ++currentCapture;
+    capturing = true;
+}
+
+void ProfilingManager::StopCapture() {
+    capturing = false;
+}
+
+unsigned int ProfilingManager::GetCapturedFrameCount() const {
+    if (!capturedFrames.empty() && capturedFrames.back().second == 0)
+        return static_cast<unsigned int>(capturedFrames.size() - 1);
+
+    return static_cast<unsigned int>(capturedFrames.size());
+}
+
+bool ProfilingManager::WriteTrace(const std::string& filename, unsigned int firstFrame, unsigned int lastFrame) const {
+    unsigned int frameCount = GetCapturedFrameCount();
+    if (frameCount == 0 || firstFrame >= frameCount || firstFrame > lastFrame) {
+        Log(Log::WARNING) << "ProfilingManager::WriteTrace warning: No captured frames in range.\n";
+        return false;
+    }
+    lastFrame = std::min(lastFrame, frameCount - 1);
+
+    std::ofstream file(filename);
+    if (!file) {
+        Log(Log::ERR) << "ProfilingManager::WriteTrace error: Couldn't open " << filename << " for writing.\n";
+        return false;
+    }
+
+    if (droppedEvents > 0)
+        Log(Log::WARNING) << "ProfilingManager::WriteTrace warning: " << static_cast<unsigned int>(droppedEvents) << " events didn't fit in the capture buffers.\n";
+
+    // Times are written in microseconds since the start of the first frame.
+    const uint64_t start = capturedFrames[firstFrame].first;
+    const uint64_t end = capturedFrames[lastFrame].second;
+    file.setf(std::ios::fixed);
+    file.precision(3);
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Frames\"}}";
+
+    for (unsigned int i = firstFrame; i <= lastFrame; ++i) {
+        file << ",\n{\"name\":\"Frame " << i << "\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" << (capturedFrames[i].first - start) / 1000.0;
+        file << ",\"dur\":" << (capturedFrames[i].second - capturedFrames[i].first) / 1000.0 << "}";
+    }
+
+    // Write a zone if it overlaps the range.
+    auto writeZone = [&file, start, end](uint32_t zone, unsigned int thread, uint64_t zoneStart, uint64_t zoneEnd) {
+        if (zoneStart > end || zoneEnd < start)
+            return;
+
+        zoneStart = std::max(zoneStart, start);
+        zoneEnd = std::min(zoneEnd, end);
+        file << ",\n{\"name\":";
+        WriteJSONString(file, GetZoneName(zone));
+        file << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread << ",\"ts\":" << (zoneStart - start) / 1000.0 << ",\"dur\":" << (zoneEnd - zoneStart) / 1000.0 << "}";
+    };
+
+    std::lock_guard<std::mutex> lock(TraceMutex());
+    std::vector<std::pair<uint32_t, uint64_t>> open;
+    for (const std::unique_ptr<TraceBuffer>& buffer : TraceBuffers()) {
+        if (buffer->capture.load(std::memory_order_acquire) != currentCapture)
+            continue;
+
+        const char* name = buffer->name;
+        file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->thread << ",\"args\":{\"name\":";
+        if (name != nullptr)
+            WriteJSONString(file, name);
+        else
+            file << "\"Thread " << buffer->thread << "\"";
+        file << "}}";
+
+        // Pair begin and end events into complete events. Unmatched end events are from zones entered before the capture started.
+        uint64_t count = buffer->count.load(std::memory_order_acquire);
+        open.clear();
+        for (uint64_t i = 0; i < count; ++i) {
+            const TraceEvent& event = buffer->events[i];
+            if (event.begin) {
+                open.push_back(std::make_pair(event.zone, event.time));
+            } else if (!open.empty()) {
+                writeZone(open.back().first, buffer->thread, open.back().second, event.time);
+                open.pop_back();
+            }
+        }
+
+        // Zones that were still open when the capture ended last until the end of the range.
+        for (const std::pair<uint32_t, uint64_t>& zone : open)
+            writeZone(zone.first, buffer->thread, zone.second, end);
+    }
+
+    file << "\n]}\n";
+
+    return true;
+}
+
+bool ProfilingManager::IsCapturing() {
+    return capturing.load(std::memory_order_relaxed);
+}
+
+void ProfilingManager::SetThreadName(const char* name) {
+    threadName = name;
+    if (threadTraceBuffer != nullptr)
+        threadTraceBuffer->name = name;
+}
+
+ProfilingManager::TraceBuffer* ProfilingManager::CreateTraceBuffer(const char* name) {
+    return AddTraceBuffer(name);
+}
+
+void ProfilingManager::ReleaseTraceBuffer(TraceBuffer* buffer) {
+    ReturnTraceBuffer(buffer);
+}
+
+void ProfilingManager::SetTraceBuffer(TraceBuffer* buffer) {
+    threadTraceBuffer = buffer;
+    threadName = buffer->name;
+}
+
 ProfilingManager::Result* ProfilingManager::GetResult(Type type) const {
+    if (type == Type::CPU_TIME && resultFrame != completedFrames) {
+        BuildCPUResult();
+        resultFrame = completedFrames;
+    }
+
     return root[type];
 }
 
+unsigned int ProfilingManager::RegisterZone(const char* name) {
+    std::lock_guard<std::mutex> lock(ZoneMutex());
+    std::vector<const char*>& names = ZoneNames();
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (std::strcmp(names[i], name) == 0)
+            return static_cast<unsigned int>(i);
+    }
+
+    names.push_back(name);
+    return static_cast<unsigned int>(names.size() - 1);
+}
+
+const char* ProfilingManager::GetZoneName(unsigned int zone) {
+    std::lock_guard<std::mutex> lock(ZoneMutex());
+    return ZoneNames()[zone];
+}
+
 std::string ProfilingManager::TypeToString(ProfilingManager::Type type) {
     switch (type) {
     case ProfilingManager::CPU_TIME:
@@ -136,6 +463,18 @@ unsigned int ProfilingManager::MeasureRAM() {
     PROCESS_MEMORY_COUNTERS_EX memoryCounters;
     GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&memoryCounters), sizeof(memoryCounters));
     return static_cast<unsigned int>(memoryCounters.PrivateUsage / 1024 / 1024);
+#elif defined(__linux__)
+    // The second field of statm is the number of resident pages.
+    unsigned long size = 0;
+    unsigned long resident = 0;
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file == nullptr)
+        return 0;
+    int read = fscanf(file, "%lu %lu", &size, &resident);
+    fclose(file);
+    if (read != 2)
+        return 0;
+    return static_cast<unsigned int>(resident * static_cast<unsigned long>(sysconf(_SC_PAGESIZE)) / 1024 / 1024);
 #endif
     return 0;
 }
@@ -150,6 +489,14 @@ unsigned int ProfilingManager::MeasureVRAM() {
     return 0;
 }
 
+Utility::MemoryTracker::Usage ProfilingManager::GetMemoryUsage(Utility::MemoryTracker::Tag tag) const {
+    return Utility::MemoryTracker::GetUsage(tag);
+}
+
+void ProfilingManager::ResetMemoryPeaks() {
+    Utility::MemoryTracker::ResetPeaks();
+}
+
 ProfilingManager::Result* ProfilingManager::StartResult(const std::string& name, Type type) {
     assert(active);
     assert(type != COUNT);
@@ -181,7 +528,7 @@ ProfilingManager::Result* ProfilingManager::StartResult(const std::string& name,
             query = queries.back();
             queries.pop_back();
         }
-        queryMap[result] = query;
+        gpuFrame->queryMap[result] = query;
         query->Begin();
     }
     
@@ -195,11 +542,144 @@ void ProfilingManager::FinishResult(Result* result, Type type) {
 
     // End query if type is GPU.
     if (type != Type::CPU_TIME)
-        queryMap[result]->End();
+        gpuFrame->queryMap[result]->End();
 
     current[type] = result->parent;
 }
 
+uint64_t ProfilingManager::BeginZone(unsigned int zone) {
+    if (std::this_thread::get_id() != frameThread)
+        return UINT64_MAX;
+
+    uint64_t index = sampleCount++;
+    Sample& sample = samples[index % sampleCapacity];
+    sample.zone = zone;
+    sample.depth = depth++;
+    sample.end = 0;
+    sample.start = GetTime();
+
+    return index;
+}
+
+void ProfilingManager::EndZone(uint64_t sample) {
+    if (sample == UINT64_MAX)
+        return;
+
+    uint64_t end = GetTime();
+    --depth;
+
+    // The sample may have been overwritten if the zone contained more samples than fit in the buffer.
+    if (sampleCount - sample <= sampleCapacity)
+        samples[sample % sampleCapacity].end = end;
+}
+
+void ProfilingManager::TraceZone(unsigned int zone, bool begin) {
+    TraceBuffer* buffer = GetTraceBuffer();
+
+    // Discard the events of an earlier capture.
+    uint32_t capture = currentCapture.load(std::memory_order_acquire);
+    if (buffer->capture.load(std::memory_order_relaxed) != capture) {
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->capture.store(capture, std::memory_order_release);
+    }
+
+    uint64_t count = buffer->count.load(std::memory_order_relaxed);
+    if (count >= TraceBuffer::capacity) {
+        ++droppedEvents;
+        return;
+    }
+
+    TraceEvent& event = buffer->events[count];
+    event.time = GetTime();
+    event.zone = zone;
+    event.begin = begin ? 1 : 0;
+    buffer->count.store(count + 1, std::memory_order_release);
+}
+
+void ProfilingManager::BuildCPUResult() const {
+    Result* result = root[Type::CPU_TIME];
+    result->children.clear();
+    result->value = 0.0;
+    if (completedFrames == 0)
+        return;
+
+    const FrameSamples& frameSample = frameSamples[lastFrame];
+    result->value = (frameSample.end - frameSample.start) / 1000000.0;
+
+    // Give up if the frame's samples have been overwritten.
+    if (sampleCount - frameSample.firstSample > sampleCapacity) {
+        Log(Log::WARNING) << "ProfilingManager: Too many profiling samples in a frame, increase the sample capacity.\n";
+        return;
+    }
+
+    // Samples are stored in the order zones were entered, so the parent of a sample is the last sample with a lower depth.
+    std::vector<Result*> parents;
+    parents.push_back(result);
+    for (uint64_t i = frameSample.firstSample; i < frameSample.endSample; ++i) {
+        const Sample& sample = samples[i % sampleCapacity];
+        parents.resize(std::min(static_cast<std::size_t>(sample.depth) + 1, parents.size()));
+        Result* parent = parents.back();
+
+        // Merge zones with the same name.
+        const char* name = GetZoneName(sample.zone);
+        Result* child = nullptr;
+        for (Result& sibling : parent->children) {
+            if (sibling.name == name) {
+                child = &sibling;
+                break;
+            }
+        }
+        if (child == nullptr) {
+            parent->children.push_back(Result(name, parent));
+            child = &parent->children.back();
+        }
+
+        if (sample.end >= sample.start)
+            child->value += (sample.end - sample.start) / 1000000.0;
+
+        parents.push_back(child);
+    }
+}
+
+bool ProfilingManager::ResolveGPUFrame(GPUFrame& gpu) {
+    // The frame query is ended after all other queries of the frame.
+    if (!gpu.frameQuery->IsAvailable())
+        return false;
+
+    for (auto& it : gpu.queryMap) {
+        if (!it.second->IsAvailable())
+            return false;
+    }
+
+    frameTimes[1][gpu.frame] = static_cast<float>(gpu.frameQuery->Resolve() / 1000000.0);
+
+    // Resolve and reset queries.
+    for (auto& it : gpu.queryMap) {
+        switch (it.second->GetType()) {
+        case Video::Query::Type::TIME_ELAPSED:
+            it.first->value = it.second->Resolve() / 1000000.0;
+            break;
+        case Video::Query::Type::SAMPLES_PASSED:
+            it.first->value = static_cast<double>(it.second->Resolve());
+            break;
+        default:
+            assert(false);
+            break;
+        }
+        queryPool[it.second->GetType()].push_back(it.second);
+    }
+    gpu.queryMap.clear();
+
+    // Publish the results by swapping them with the previous ones.
+    for (int i = 0; i < Type::COUNT; ++i) {
+        if (i != Type::CPU_TIME)
+            std::swap(root[i], gpu.root[i]);
+    }
+    gpu.pending = false;
+
+    return true;
+}
+
 ProfilingManager::Result::Result(const std::string& name, Result* parent) : name (name) {
     this->parent = parent;
 }
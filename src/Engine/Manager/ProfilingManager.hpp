@@ -1,10 +1,15 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <list>
 #include <map>
+#include <thread>
+#include <vector>
 
 #include <Video/Profiling/Query.hpp>
+#include <Utility/MemoryTracker.hpp>
 #include "../linking.hpp"
 #ifdef MEASURE_VRAM
 #include <d3d11_3.h>
@@ -13,6 +18,23 @@
 #endif
 
 /// Handles profiling.
+/**
+ * CPU zones are registered once with a static ID (see PROFILE) and each time
+ * a zone is entered a sample is written to a preallocated ring buffer, so
+ * profiling doesn't allocate memory. The tree of results is only built from
+ * the samples when it's requested.
+ *
+ * GPU queries are issued into a ring of frames in flight and only read back
+ * once the GPU reports them as available, so GPU profiling doesn't make the
+ * CPU wait for the GPU. GPU results and frame times are therefore a few
+ * frames behind, but are attributed to the frame they were measured in.
+ *
+ * Only zones on the thread running the frame are recorded into the profiling
+ * tree. In capture mode, zones on every thread are also recorded as begin and end
+ * events into a lock-free buffer per thread. The captured frames can be
+ * written to a Chrome trace file (viewable in chrome://tracing or Perfetto)
+ * with WriteTrace.
+ */
 class ProfilingManager {
     friend class Hub;
     friend class Profiling;
@@ -28,6 +50,9 @@ class ProfilingManager {
         };
 
         /// A profiling result.
+        /**
+         * For CPU time, the results of zones with the same name under the same parent are summed.
+         */
         struct Result {
             std::string name;
             double value = 0.0;
@@ -73,13 +98,104 @@ class ProfilingManager {
          */
         ENGINE_API const float* GetGPUFrameTimes() const;
 
+        /// Start capturing zones on all threads.
+        /**
+         * Any previous capture is discarded. Frames are counted from the first
+         * BeginFrame after the capture is started.
+         */
+        ENGINE_API void StartCapture();
+
+        /// Stop capturing zones.
+        ENGINE_API void StopCapture();
+
+        /// Get the number of frames that have been captured.
+        /**
+         * @return The number of completed frames in the capture.
+         */
+        ENGINE_API unsigned int GetCapturedFrameCount() const;
+
+        /// Write the captured zones of a range of frames to a Chrome trace file.
+        /**
+         * Zones on other threads are included if they overlap the frames.
+         * @param filename Path of the JSON file to write.
+         * @param firstFrame The first frame to include.
+         * @param lastFrame The last frame to include. Clamped to the last captured frame.
+         * @return Whether the trace could be written.
+         */
+        ENGINE_API bool WriteTrace(const std::string& filename, unsigned int firstFrame, unsigned int lastFrame) const;
+
+        /// Check whether zones are being captured.
+        /**
+         * @return Whether capture mode is on.
+         */
+        ENGINE_API static bool IsCapturing();
+
+        /// Set the name of the calling thread in captures.
+        /**
+         * @param name Name of the thread. Must stay valid for the lifetime of the program, eg. a string literal.
+         */
+        ENGINE_API static void SetThreadName(const char* name);
+
+        /// The captured events of a thread.
+        struct TraceBuffer;
+
+        /// Create the trace buffer of a thread ahead of time.
+        /**
+         * Threads otherwise create their buffer the first time they trace a
+         * zone, which allocates and locks. Real-time threads, eg. the audio
+         * callback, should get their buffer here and pass it to SetTraceBuffer.
+         * @param name Name of the thread. Must stay valid for the lifetime of the program, eg. a string literal.
+         * @return The buffer, which is used until it's passed to ReleaseTraceBuffer.
+         */
+        ENGINE_API static TraceBuffer* CreateTraceBuffer(const char* name);
+
+        /// Hand a buffer from CreateTraceBuffer back, so it can be reused.
+        /**
+         * No thread may record into the buffer afterwards. Buffers that threads
+         * create for themselves are handed back when the threads exit.
+         * @param buffer The buffer.
+         */
+        ENGINE_API static void ReleaseTraceBuffer(TraceBuffer* buffer);
+
+        /// Record the calling thread's zones into a buffer from CreateTraceBuffer.
+        /**
+         * Doesn't allocate or lock. Only one thread at a time may use a buffer.
+         * @param buffer The buffer.
+         */
+        ENGINE_API static void SetTraceBuffer(TraceBuffer* buffer);
+
         /// Get profiling result.
         /**
+         * The CPU time results are built from the samples of the last completed frame.
+         * The GPU results are from the last frame the GPU has finished.
          * @param type The type of profiling to get results for.
          * @return The measured result.
          */
         ENGINE_API Result* GetResult(Type type) const;
 
+        /// Register a CPU profiling zone.
+        /**
+         * Registering a name that is already registered returns the existing ID.
+         * @param name Name of the zone. Must stay valid for the lifetime of the program, eg. a string literal.
+         * @return The ID of the zone.
+         */
+        ENGINE_API static unsigned int RegisterZone(const char* name);
+
+        /// Get the name of a registered zone.
+        /**
+         * @param zone The ID of the zone.
+         * @return The name of the zone.
+         */
+        ENGINE_API static const char* GetZoneName(unsigned int zone);
+
+        /// Get the current time of the profiling clock.
+        /**
+         * @return Time in nanoseconds since an arbitrary point.
+         */
+        static uint64_t GetTime() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
         /// Get the name of a type of profiling.
         /**
          * @param type The type of profiling.
@@ -89,6 +205,7 @@ class ProfilingManager {
 
         /// Get current RAM usage.
         /**
+         * On Windows this is the private memory of the process and on Linux the resident set size.
          * @return The amount of ram used in Mebibytes.
          */
         ENGINE_API unsigned int MeasureRAM();
@@ -98,31 +215,91 @@ class ProfilingManager {
          * @return The amount of vram used in Mebibytes.
          */
         ENGINE_API unsigned int MeasureVRAM();
+
+        /// Get the memory usage of a subsystem.
+        /**
+         * @param tag The subsystem to get the memory usage of.
+         * @return The memory the subsystem has reported.
+         */
+        ENGINE_API Utility::MemoryTracker::Usage GetMemoryUsage(Utility::MemoryTracker::Tag tag) const;
+
+        /// Reset the peak memory usage of all subsystems to their current usage.
+        ENGINE_API void ResetMemoryPeaks();
         
     private:
-        ProfilingManager();
+        // A timed CPU zone.
+        struct Sample {
+            uint32_t zone;
+            uint32_t depth;
+            uint64_t start;
+            uint64_t end;
+        };
+
+        // The samples and time of a frame.
+        struct FrameSamples {
+            uint64_t firstSample = 0;
+            uint64_t endSample = 0;
+            uint64_t start = 0;
+            uint64_t end = 0;
+        };
+
+        // The GPU queries of a frame in flight.
+        struct GPUFrame {
+            unsigned int frame = 0;
+            bool pending = false;
+            Video::Query* frameQuery = nullptr;
+            Result* root[Type::COUNT];
+            std::map<Result*, Video::Query*> queryMap;
+        };
+
+        explicit ProfilingManager(bool gpuProfiling = true);
         ~ProfilingManager();
         ProfilingManager(ProfilingManager const&) = delete;
         void operator=(ProfilingManager const&) = delete;
         
         Result* StartResult(const std::string& name, Type type);
         void FinishResult(Result* result, Type type);
+
+        uint64_t BeginZone(unsigned int zone);
+        void EndZone(uint64_t sample);
+        static void TraceZone(unsigned int zone, bool begin);
+        void BuildCPUResult() const;
+        bool ResolveGPUFrame(GPUFrame& gpuFrame);
         
         void ShowResult(Result* result);
 
         bool active;
+        bool gpuProfiling;
         
         Result* root[Type::COUNT];
         Result* current[Type::COUNT];
 
+        // Ring buffer of CPU samples.
+        static const unsigned int sampleCapacity = 1 << 16;
+        std::vector<Sample> samples;
+        uint64_t sampleCount = 0;
+        uint32_t depth = 0;
+        std::thread::id frameThread;
+
+        // Start and end times of the captured frames.
+        std::vector<std::pair<uint64_t, uint64_t>> capturedFrames;
+
+        uint64_t completedFrames = 0;
+        mutable uint64_t resultFrame = 0;
+
         std::map<Video::Query::Type, std::list<Video::Query*>> queryPool;
-        std::map<Result*, Video::Query*> queryMap;
-        
-        Video::Query* frameQuery;
-        double frameStart;
+
+        // Ring of frames whose GPU queries haven't been read back yet.
+        static const unsigned int gpuFrameCount = 4;
+        GPUFrame gpuFrames[gpuFrameCount];
+        unsigned int nextGPUFrame = 0;
+        GPUFrame* gpuFrame = nullptr;
+
         static const unsigned int frames = 100;
         unsigned int frame = 0;
         float frameTimes[2][frames];
+        FrameSamples frameSamples[frames];
+        unsigned int lastFrame = 0;
 
 #ifdef MEASURE_VRAM
         IDXGIFactory* dxgiFactory = nullptr;
@@ -6,7 +6,9 @@
 #include <Video/Buffer/ReadWriteTexture.hpp>
 #include <Video/VideoErrorCheck.hpp>
 #include "Managers.hpp"
+#include "AnimationManager.hpp"
 #include "ResourceManager.hpp"
+#include "RenderSnapshot.hpp"
 #include "ParticleManager.hpp"
 #include "SoundManager.hpp"
 #include "PhysicsManager.hpp"
@@ -38,12 +40,13 @@
 #include <Video/Lighting/Light.hpp>
 #include "../Hymn.hpp"
 #include "../Util/Profiling.hpp"
-#include "../Util/Json.hpp"
+#include "../Util/SceneNode.hpp"
 #include "../Util/GPUProfiling.hpp"
 #include <Utility/Log.hpp>
 #include <Video/ShadowPass.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <Video/Texture/TexturePNG.hpp>
+#include <cassert>
 
 #ifdef USINGMEMTRACK
 #include <MemTrackInclude.hpp>
@@ -51,7 +54,62 @@
 
 using namespace Component;
 
-RenderManager::RenderManager() {
+namespace {
+    // Screen size used for the camera's projection when there's no window.
+    const glm::vec2 headlessScreenSize(1920.f, 1080.f);
+
+    // Add a draw to a snapshot, reusing the draws (and bone palettes) of the last snapshot.
+    RenderSnapshot::MeshDraw& AddMeshDraw(std::vector<RenderSnapshot::MeshDraw>& draws, std::size_t& drawCount, Video::Geometry::Geometry3D* geometry, Entity* entity, const glm::mat4& modelMatrix, bool visible) {
+        if (drawCount == draws.size())
+            draws.emplace_back();
+        RenderSnapshot::MeshDraw& draw = draws[drawCount++];
+
+        draw.geometry = geometry;
+        draw.modelMatrix = modelMatrix;
+        draw.visible = visible;
+
+        Material* material = entity->GetComponent<Material>();
+        draw.hasMaterial = material != nullptr;
+        draw.albedo = material != nullptr ? material->albedo->GetTexture() : nullptr;
+        draw.normal = material != nullptr ? material->normal->GetTexture() : nullptr;
+        draw.metallic = material != nullptr ? material->metallic->GetTexture() : nullptr;
+        draw.roughness = material != nullptr ? material->roughness->GetTexture() : nullptr;
+        draw.bones.clear();
+
+        return draw;
+    }
+
+    // Whether the geometry of an entity is inside a view frustum.
+    bool MeshInFrustum(const Video::Geometry::Geometry3D* geometry, const glm::mat4& modelMatrix, const glm::mat4& viewProjectionMatrix) {
+        return Video::Frustum(viewProjectionMatrix * modelMatrix).Collide(geometry->GetAxisAlignedBoundingBox());
+    }
+
+    // Whether the volume lit by a light is inside a view frustum.
+    bool LightInFrustum(const Video::Light& light, const glm::mat4& viewProjectionMatrix) {
+        const Video::AxisAlignedBoundingBox aabb(glm::vec3(2.f, 2.f, 2.f), glm::vec3(0.f, 0.f, 0.f), glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, 1.0f, 1.0f));
+        const glm::vec3 position(light.position);
+        const glm::mat4 modelMatrix = glm::translate(glm::mat4(), position) * glm::scale(glm::mat4(), glm::vec3(1.f, 1.f, 1.f) * light.distance);
+
+        return Video::Frustum(viewProjectionMatrix * modelMatrix).Collide(aabb);
+    }
+}
+
+RenderManager::RenderManager(bool headless) {
+    worldSnapshot = new RenderSnapshot();
+
+    // Only the components are kept when there's no graphics context.
+    if (headless) {
+        renderer = nullptr;
+        shadowPass = nullptr;
+        mainWindowRenderSurface = nullptr;
+        hmdRenderSurface = nullptr;
+        particleEmitterTexture = nullptr;
+        lightTexture = nullptr;
+        soundSourceTexture = nullptr;
+        cameraTexture = nullptr;
+        return;
+    }
+
     renderer = new Video::Renderer();
 
     // Render surface for main window.
@@ -73,6 +131,11 @@ RenderManager::RenderManager() {
 }
 
 RenderManager::~RenderManager() {
+    delete worldSnapshot;
+
+    if (IsHeadless())
+        return;
+
     Managers().resourceManager->FreeTexturePNG(particleEmitterTexture);
     Managers().resourceManager->FreeTexturePNG(lightTexture);
     Managers().resourceManager->FreeTexturePNG(soundSourceTexture);
@@ -88,23 +151,177 @@ RenderManager::~RenderManager() {
 }
 
 void RenderManager::Render(World& world, DISPLAY targetDisplay, bool soundSources, bool particleEmitters, bool lightSources, bool cameras, bool physics, Entity* camera, bool lighting, bool lightVolumes) {
+    assert(!IsHeadless());
+
+    { PROFILE("Create render snapshot");
+        CreateSnapshot(world, *worldSnapshot, camera);
+    }
+
+    RenderDisplay(*worldSnapshot, targetDisplay, lighting, lightVolumes, &world, soundSources, particleEmitters, lightSources, cameras, physics);
+}
+
+void RenderManager::Render(const RenderSnapshot& snapshot, DISPLAY targetDisplay, bool lighting, bool lightVolumes) {
+    assert(!IsHeadless());
+
+    RenderDisplay(snapshot, targetDisplay, lighting, lightVolumes, nullptr, false, false, false, false, false);
+}
+
+void RenderManager::CreateSnapshot(World& world, RenderSnapshot& snapshot, Entity* camera) {
+    snapshot.filterSettings = Hymn().filterSettings;
+
     // Find camera entity.
     if (camera == nullptr) {
         for (Lens* lens : lenses.GetAll())
             camera = lens->entity;
     }
 
+    snapshot.hasCamera = camera != nullptr;
+    snapshot.hasHeadset = false;
     if (camera != nullptr) {
+        Lens* lens = camera->GetComponent<Lens>();
+        snapshot.cameraMatrix = camera->GetModelMatrix();
+        snapshot.projectionMatrix = lens->GetProjection(IsHeadless() ? headlessScreenSize : mainWindowRenderSurface->GetSize());
+        snapshot.zNear = lens->zNear;
+        snapshot.zFar = lens->zFar;
+
+        VRDevice* headset = camera->GetComponent<VRDevice>();
+        if (hmdRenderSurface != nullptr && headset != nullptr) {
+            snapshot.hasHeadset = true;
+            snapshot.eyeProjectionMatrices[0] = headset->GetHMDProjectionMatrix(vr::Eye_Left, lens->zNear, lens->zFar);
+            snapshot.eyeProjectionMatrices[1] = headset->GetHMDProjectionMatrix(vr::Eye_Right, lens->zNear, lens->zFar);
+        }
+    }
+
+    // Light casting shadows.
+    snapshot.lightViewMatrix = glm::mat4();
+    snapshot.lightProjectionMatrix = glm::mat4();
+    for (Component::SpotLight* spotLight : spotLights.GetAll()) {
+        if (spotLight->IsKilled() || !spotLight->entity->IsEnabled())
+            continue;
+
+        if (spotLight->shadow) {
+            Entity* lightEntity = spotLight->entity;
+            snapshot.lightViewMatrix = glm::inverse(lightEntity->GetModelMatrix());
+            snapshot.lightProjectionMatrix = glm::perspective(glm::radians(2.f * spotLight->coneAngle), 1.0f, 0.01f, spotLight->distance);
+        }
+    }
+
+    // Each eye of a headset sees a bit more than the camera, so nothing is culled for them.
+    const bool cull = snapshot.hasCamera && !snapshot.hasHeadset;
+    const glm::mat4 viewProjectionMatrix = snapshot.projectionMatrix * glm::inverse(snapshot.cameraMatrix);
+
+    // Meshes outside the view frustum are kept since they may still cast shadows into it.
+    // Geometry loaded without a graphics context has no indices and is culled but never drawn.
+    { PROFILE("Cull meshes");
+        // Static meshes.
+        std::size_t drawCount = 0;
+        for (Mesh* mesh : meshes.GetAll()) {
+            Entity* entity = mesh->entity;
+            if (entity->IsKilled() || !entity->IsEnabled() || !mesh->geometry || mesh->geometry->GetType() != Video::Geometry::Geometry3D::STATIC)
+                continue;
+
+            const glm::mat4 modelMatrix = entity->GetModelMatrix();
+            const bool visible = !cull || MeshInFrustum(mesh->geometry, modelMatrix, viewProjectionMatrix);
+            if (mesh->geometry->GetIndexCount() != 0)
+                AddMeshDraw(snapshot.staticMeshes, drawCount, mesh->geometry, entity, modelMatrix, visible);
+        }
+        snapshot.staticMeshes.resize(drawCount);
+
+        // Skin meshes.
+        drawCount = 0;
+        for (AnimationController* controller : Managers().animationManager->GetAnimations()) {
+            Entity* entity = controller->entity;
+            if (entity->IsKilled() || !entity->IsEnabled())
+                continue;
+
+            Mesh* mesh = entity->GetComponent<Mesh>();
+            if (!mesh || !mesh->geometry || mesh->geometry->GetType() != Video::Geometry::Geometry3D::SKIN)
+                continue;
+
+            const glm::mat4 modelMatrix = entity->GetModelMatrix();
+            const bool visible = !cull || MeshInFrustum(mesh->geometry, modelMatrix, viewProjectionMatrix);
+            if (mesh->geometry->GetIndexCount() != 0)
+                AddMeshDraw(snapshot.skinMeshes, drawCount, mesh->geometry, entity, modelMatrix, visible).bones = controller->bones;
+        }
+        snapshot.skinMeshes.resize(drawCount);
+    }
+
+    // Directional lights.
+    snapshot.directionalLights.clear();
+    for (Component::DirectionalLight* directionalLight : directionalLights.GetAll()) {
+        if (directionalLight->IsKilled() || !directionalLight->entity->IsEnabled())
+            continue;
+
+        Video::Light light;
+        light.position = glm::vec4(-directionalLight->entity->GetDirection(), 0.f);
+        light.intensities = directionalLight->color;
+        light.attenuation = 1.f;
+        light.ambientCoefficient = directionalLight->ambientCoefficient;
+        light.coneAngle = 0.f;
+        light.direction = glm::vec3(0.f, 0.f, 0.f);
+        light.shadow = 0.f;
+        light.distance = 0.f;
+        snapshot.directionalLights.push_back(light);
+    }
+
+    // Spot and point lights whose volume is outside the view frustum don't light anything in it.
+    { PROFILE("Cull lights");
+        // Spot lights.
+        snapshot.spotLights.clear();
+        for (Component::SpotLight* spotLight : spotLights.GetAll()) {
+            if (spotLight->IsKilled() || !spotLight->entity->IsEnabled())
+                continue;
+
+            Entity* lightEntity = spotLight->entity;
+            glm::mat4 modelMatrix(lightEntity->GetModelMatrix());
+            Video::Light light;
+            light.position = glm::vec4(glm::vec3(modelMatrix[3][0], modelMatrix[3][1], modelMatrix[3][2]), 1.0);
+            light.intensities = spotLight->color * spotLight->intensity;
+            light.attenuation = spotLight->attenuation;
+            light.ambientCoefficient = spotLight->ambientCoefficient;
+            light.coneAngle = spotLight->coneAngle;
+            light.direction = lightEntity->GetDirection();
+            light.shadow = spotLight->shadow ? 1.f : 0.f;
+            light.distance = spotLight->distance;
+            if (!cull || LightInFrustum(light, viewProjectionMatrix))
+                snapshot.spotLights.push_back(light);
+        }
+
+        // Point lights.
+        snapshot.pointLights.clear();
+        for (Component::PointLight* pointLight : pointLights.GetAll()) {
+            if (pointLight->IsKilled() || !pointLight->entity->IsEnabled())
+                continue;
+
+            glm::mat4 modelMatrix(pointLight->entity->GetModelMatrix());
+            Video::Light light;
+            light.position = glm::vec4(glm::vec3(modelMatrix[3][0], modelMatrix[3][1], modelMatrix[3][2]), 1.0);
+            light.intensities = pointLight->color * pointLight->intensity;
+            light.attenuation = pointLight->attenuation;
+            light.ambientCoefficient = 0.f;
+            light.coneAngle = 180.f;
+            light.direction = glm::vec3(1.f, 0.f, 0.f);
+            light.shadow = 0.f;
+            light.distance = pointLight->distance;
+            if (!cull || LightInFrustum(light, viewProjectionMatrix))
+                snapshot.pointLights.push_back(light);
+        }
+    }
+}
+
+void RenderManager::RenderDisplay(const RenderSnapshot& snapshot, DISPLAY targetDisplay, bool lighting, bool lightVolumes, World* world, bool soundSources, bool particleEmitters, bool lightSources, bool cameras, bool physics) {
+    if (snapshot.hasCamera) {
         // Set image processing variables.
-        renderer->SetGamma(Hymn().filterSettings.gamma);
-        renderer->SetFogApply(Hymn().filterSettings.fogApply && lighting);
-        renderer->SetFogDensity(Hymn().filterSettings.fogDensity);
-        renderer->SetFogColor(Hymn().filterSettings.fogColor);
-        renderer->SetColorFilterApply(Hymn().filterSettings.colorFilterApply);
-        renderer->SetColorFilterColor(Hymn().filterSettings.colorFilterColor);
-        renderer->SetDitherApply(Hymn().filterSettings.ditherApply);
-        const bool fxaa = Hymn().filterSettings.fxaa;
+        renderer->SetGamma(snapshot.filterSettings.gamma);
+        renderer->SetFogApply(snapshot.filterSettings.fogApply && lighting);
+        renderer->SetFogDensity(snapshot.filterSettings.fogDensity);
+        renderer->SetFogColor(snapshot.filterSettings.fogColor);
+        renderer->SetColorFilterApply(snapshot.filterSettings.colorFilterApply);
+        renderer->SetColorFilterColor(snapshot.filterSettings.colorFilterColor);
+        renderer->SetDitherApply(snapshot.filterSettings.ditherApply);
+        const bool fxaa = snapshot.filterSettings.fxaa;
         const glm::vec2 windowSize = MainWindow::GetInstance()->GetSize();
+        const bool editorEntities = world != nullptr && (soundSources || particleEmitters || lightSources || cameras || physics);
 
         // Render to surfaces.
         switch (targetDisplay) {
@@ -114,16 +331,15 @@ void RenderManager::Render(World& world, DISPLAY targetDisplay, bool soundSource
                     // Render main window.
                     { PROFILE("Render main window");
                     { GPUPROFILE("Render main window", Video::Query::Type::TIME_ELAPSED);
-                        Lens* lens = camera->GetComponent<Lens>();
-                        const glm::mat4 projectionMatrix = lens->GetProjection(mainWindowRenderSurface->GetSize());
-                        const glm::mat4 viewMatrix = glm::inverse(camera->GetModelMatrix());
-                        const glm::vec3 position = camera->GetWorldPosition();
+                        const glm::mat4 projectionMatrix = snapshot.projectionMatrix;
+                        const glm::mat4 viewMatrix = glm::inverse(snapshot.cameraMatrix);
+                        const glm::vec3 position(snapshot.cameraMatrix[3][0], snapshot.cameraMatrix[3][1], snapshot.cameraMatrix[3][2]);
                         const glm::vec3 up(viewMatrix[0][1], viewMatrix[1][1], viewMatrix[2][1]);
 
                         { VIDEO_ERROR_CHECK("Render world entities");
                         { PROFILE("Render world entities");
                         { GPUPROFILE("Render world entities", Video::Query::Type::TIME_ELAPSED);
-                            RenderWorldEntities(world, viewMatrix, projectionMatrix, mainWindowRenderSurface, lighting, lens->zNear, lens->zFar, lightVolumes);
+                            RenderWorldEntities(snapshot, viewMatrix, projectionMatrix, mainWindowRenderSurface, lighting, lightVolumes);
                         }
                         }
                         }
@@ -152,10 +368,10 @@ void RenderManager::Render(World& world, DISPLAY targetDisplay, bool soundSource
                         }
                         }
 
-                        if (soundSources || particleEmitters || lightSources || cameras || physics) {
+                        if (editorEntities) {
                             { PROFILE("Render editor entities");
                             { GPUPROFILE("Render editor entities", Video::Query::Type::TIME_ELAPSED);
-                                RenderEditorEntities(world, soundSources, particleEmitters, lightSources, cameras, physics, position, up, viewMatrix, projectionMatrix, mainWindowRenderSurface);
+                                RenderEditorEntities(*world, soundSources, particleEmitters, lightSources, cameras, physics, position, up, viewMatrix, projectionMatrix, mainWindowRenderSurface);
                             }
                             }
                         }
@@ -172,7 +388,7 @@ void RenderManager::Render(World& world, DISPLAY targetDisplay, bool soundSource
                 }
                 break;
             case RenderManager::HMD:
-                if (hmdRenderSurface != nullptr) {
+                if (hmdRenderSurface != nullptr && snapshot.hasHeadset) {
                     // Render vr headset.
                     renderer->SetFrameSize(hmdRenderSurface->GetSize());
                     { PROFILE("Render main hmd");
@@ -180,20 +396,16 @@ void RenderManager::Render(World& world, DISPLAY targetDisplay, bool soundSource
                     for (int i = 0; i < 2; ++i) {
                         vr::Hmd_Eye nEye = i == 0 ? vr::Eye_Left : vr::Eye_Right;
 
-                        Lens* lens = camera->GetComponent<Lens>();
-
-                        VRDevice* headset = camera->GetComponent<VRDevice>();
-
-                        const glm::mat4 lensViewMatrix = glm::inverse(camera->GetModelMatrix());
+                        const glm::mat4 lensViewMatrix = glm::inverse(snapshot.cameraMatrix);
                         const glm::mat4 eyeTranslation = Managers().vrManager->GetHMDHeadToEyeMatrix(nEye);
                         const glm::mat4 eyeViewMatrix = eyeTranslation * lensViewMatrix;
-                        const glm::mat4 projectionMatrix = headset->GetHMDProjectionMatrix(nEye, lens->zNear, lens->zFar);
-                        const glm::vec3 position = camera->GetWorldPosition();
+                        const glm::mat4 projectionMatrix = snapshot.eyeProjectionMatrices[i];
+                        const glm::vec3 position(snapshot.cameraMatrix[3][0], snapshot.cameraMatrix[3][1], snapshot.cameraMatrix[3][2]);
                         const glm::vec3 up(lensViewMatrix[0][1], lensViewMatrix[1][1], lensViewMatrix[2][1]);
 
                         { PROFILE("Render world entities");
                         { GPUPROFILE("Render world entities", Video::Query::Type::TIME_ELAPSED);
-                            RenderWorldEntities(world, eyeViewMatrix, projectionMatrix, hmdRenderSurface, lighting, lens->zNear, lens->zFar, lightVolumes);
+                            RenderWorldEntities(snapshot, eyeViewMatrix, projectionMatrix, hmdRenderSurface, lighting, lightVolumes);
                         }
                         }
 
@@ -221,10 +433,10 @@ void RenderManager::Render(World& world, DISPLAY targetDisplay, bool soundSource
                         }
                         }
 
-                        if (soundSources || particleEmitters || lightSources || cameras || physics) {
+                        if (editorEntities) {
                             { PROFILE("Render editor entities");
                             { GPUPROFILE("Render editor entities", Video::Query::Type::TIME_ELAPSED);
-                                RenderEditorEntities(world, soundSources, particleEmitters, lightSources, cameras, physics, position, up, lensViewMatrix, projectionMatrix, hmdRenderSurface);
+                                RenderEditorEntities(*world, soundSources, particleEmitters, lightSources, cameras, physics, position, up, lensViewMatrix, projectionMatrix, hmdRenderSurface);
                             }
                             }
                         }
@@ -252,31 +464,22 @@ void RenderManager::Render(World& world, DISPLAY targetDisplay, bool soundSource
     }
 }
 
+bool RenderManager::IsHeadless() const {
+    return renderer == nullptr;
+}
+
 void RenderManager::UpdateBufferSize() {
     delete mainWindowRenderSurface;
     mainWindowRenderSurface = new Video::RenderSurface(MainWindow::GetInstance()->GetSize());
 }
 
-void RenderManager::RenderWorldEntities(World& world, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, Video::RenderSurface* renderSurface, bool lighting, float cameraNear, float cameraFar, bool lightVolumes) {
-    // Render from camera.
-    glm::mat4 lightViewMatrix;
-    glm::mat4 lightProjection;
-
-    for (Component::SpotLight* spotLight : spotLights.GetAll()) {
-        if (spotLight->IsKilled() || !spotLight->entity->IsEnabled())
-            continue;
-
-        if (spotLight->shadow) {
-            Entity* lightEntity = spotLight->entity;
-            lightViewMatrix = glm::inverse(lightEntity->GetModelMatrix());
-            lightProjection = glm::perspective(glm::radians(2.f * spotLight->coneAngle), 1.0f, 0.01f, spotLight->distance);
-        }
-    }
+void RenderManager::RenderWorldEntities(const RenderSnapshot& snapshot, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, Video::RenderSurface* renderSurface, bool lighting, bool lightVolumes) {
+    // Light matrices.
+    const glm::mat4& lightViewMatrix = snapshot.lightViewMatrix;
+    const glm::mat4& lightProjection = snapshot.lightProjectionMatrix;
 
     // Camera matrices.
     const glm::mat4 viewProjectionMatrix = projectionMatrix * viewMatrix;
-    const std::vector<Mesh*>& meshComponents = meshes.GetAll();
-    const std::vector<AnimationController*>& controllerComponents = animationControllers.GetAll();
 
     //Render shadows maps.
     { VIDEO_ERROR_CHECK("Render shadow meshes");
@@ -285,25 +488,12 @@ void RenderManager::RenderWorldEntities(World& world, const glm::mat4& viewMatri
     { GPUPROFILE("Render shadow meshes", Video::Query::Type::SAMPLES_PASSED);
         // Static meshes.
         renderer->PrepareStaticShadowRendering(lightViewMatrix, lightProjection, shadowPass->GetShadowID(), shadowPass->GetShadowMapSize(), shadowPass->GetDepthMapFbo());
-        for (Mesh* mesh : meshComponents) {
-            Entity* entity = mesh->entity;
-            if (entity->IsKilled() || !entity->IsEnabled())
-                continue;
-
-            if (mesh->geometry && mesh->geometry->GetIndexCount() != 0 && mesh->geometry->GetType() == Video::Geometry::Geometry3D::STATIC)
-                renderer->ShadowRenderStaticMesh(mesh->geometry, lightViewMatrix, lightProjection, entity->GetModelMatrix());
-        }
+        for (const RenderSnapshot::MeshDraw& draw : snapshot.staticMeshes)
+            renderer->ShadowRenderStaticMesh(draw.geometry, lightViewMatrix, lightProjection, draw.modelMatrix);
         // Skin meshes.
         renderer->PrepareSkinShadowRendering(lightViewMatrix, lightProjection, shadowPass->GetShadowID(), shadowPass->GetShadowMapSize(), shadowPass->GetDepthMapFbo());
-        for (AnimationController* controller : controllerComponents) {
-            Entity* entity = controller->entity;
-            if (entity->IsKilled() || !entity->IsEnabled())
-                continue;
-
-            Mesh* mesh = entity->GetComponent<Mesh>();
-            if (mesh && mesh->geometry && mesh->geometry->GetIndexCount() != 0 && mesh->geometry->GetType() == Video::Geometry::Geometry3D::SKIN)
-                renderer->ShadowRenderSkinMesh(mesh->geometry, lightViewMatrix, lightProjection, entity->GetModelMatrix(), controller->bones);
-        }
+        for (const RenderSnapshot::MeshDraw& draw : snapshot.skinMeshes)
+            renderer->ShadowRenderSkinMesh(draw.geometry, lightViewMatrix, lightProjection, draw.modelMatrix, draw.bones);
     }
     }
     }
@@ -318,27 +508,16 @@ void RenderManager::RenderWorldEntities(World& world, const glm::mat4& viewMatri
     { GPUPROFILE("Render z-pass meshes", Video::Query::Type::SAMPLES_PASSED);
         // Static meshes.
         renderer->PrepareStaticMeshDepthRendering(viewMatrix, projectionMatrix);
-        for (Mesh* mesh : meshComponents) {
-            Entity* entity = mesh->entity;
-            if (entity->IsKilled() || !entity->IsEnabled())
-                continue;
-
-            if (mesh->geometry && mesh->geometry->GetIndexCount() != 0 && mesh->geometry->GetType() == Video::Geometry::Geometry3D::STATIC)
-                if (entity->GetComponent<Material>() != nullptr)
-                    renderer->DepthRenderStaticMesh(mesh->geometry, viewMatrix, projectionMatrix, entity->GetModelMatrix());
+        for (const RenderSnapshot::MeshDraw& draw : snapshot.staticMeshes) {
+            if (draw.hasMaterial && draw.visible)
+                renderer->DepthRenderStaticMesh(draw.geometry, viewMatrix, projectionMatrix, draw.modelMatrix);
         }
 
         // Skin meshes.
         renderer->PrepareSkinMeshDepthRendering(viewMatrix, projectionMatrix);
-        for (AnimationController* controller : controllerComponents) {
-            Entity* entity = controller->entity;
-            if (entity->IsKilled() || !entity->IsEnabled())
-                continue;
-
-            Mesh* mesh = entity->GetComponent<Mesh>();
-            if (mesh && mesh->geometry && mesh->geometry->GetIndexCount() != 0 && mesh->geometry->GetType() == Video::Geometry::Geometry3D::SKIN)
-                if (entity->GetComponent<Material>() != nullptr)
-                    renderer->DepthRenderSkinMesh(mesh->geometry, viewMatrix, projectionMatrix, entity->GetModelMatrix(), controller->bones);
+        for (const RenderSnapshot::MeshDraw& draw : snapshot.skinMeshes) {
+            if (draw.hasMaterial && draw.visible)
+                renderer->DepthRenderSkinMesh(draw.geometry, viewMatrix, projectionMatrix, draw.modelMatrix, draw.bones);
         }
     }
     }
@@ -352,7 +531,7 @@ void RenderManager::RenderWorldEntities(World& world, const glm::mat4& viewMatri
     { GPUPROFILE("Update lights", Video::Query::Type::TIME_ELAPSED);
         if (lighting)
             // Cull lights and update light list.
-            LightWorld(viewMatrix, viewProjectionMatrix, lightVolumes);
+            LightWorld(snapshot, viewMatrix, viewProjectionMatrix, lightVolumes);
         else
             // Use full ambient light and ignore lights in the scene.
             LightAmbient();
@@ -370,17 +549,10 @@ void RenderManager::RenderWorldEntities(World& world, const glm::mat4& viewMatri
         { PROFILE("Static meshes");
         { GPUPROFILE("Static meshes", Video::Query::Type::TIME_ELAPSED);
         { GPUPROFILE("Static meshes", Video::Query::Type::SAMPLES_PASSED);
-            renderer->PrepareStaticMeshRendering(viewMatrix, projectionMatrix, cameraNear, cameraFar);
-            for (Mesh* mesh : meshComponents) {
-                Entity* entity = mesh->entity;
-                if (entity->IsKilled() || !entity->IsEnabled())
-                    continue;
-
-                if (mesh->geometry && mesh->geometry->GetIndexCount() != 0 && mesh->geometry->GetType() == Video::Geometry::Geometry3D::STATIC) {
-                    Material* material = entity->GetComponent<Material>();
-                    if (material != nullptr)
-                        renderer->RenderStaticMesh(mesh->geometry, material->albedo->GetTexture(), material->normal->GetTexture(), material->metallic->GetTexture(), material->roughness->GetTexture(), entity->GetModelMatrix());
-                }
+            renderer->PrepareStaticMeshRendering(viewMatrix, projectionMatrix, snapshot.zNear, snapshot.zFar);
+            for (const RenderSnapshot::MeshDraw& draw : snapshot.staticMeshes) {
+                if (draw.hasMaterial && draw.visible)
+                    renderer->RenderStaticMesh(draw.geometry, draw.albedo, draw.normal, draw.metallic, draw.roughness, draw.modelMatrix);
             }
         }
         }
@@ -392,18 +564,10 @@ void RenderManager::RenderWorldEntities(World& world, const glm::mat4& viewMatri
         { PROFILE("Skin meshes");
         { GPUPROFILE("Skin meshes", Video::Query::Type::TIME_ELAPSED);
         { GPUPROFILE("Skin meshes", Video::Query::Type::SAMPLES_PASSED);
-            renderer->PrepareSkinMeshRendering(viewMatrix, projectionMatrix, cameraNear, cameraFar);
-            for (AnimationController* controller : controllerComponents) {
-                Entity* entity = controller->entity;
-                if (entity->IsKilled() || !entity->IsEnabled())
-                    continue;
-
-                Mesh* mesh = entity->GetComponent<Mesh>();
-                if (mesh && mesh->geometry && mesh->geometry->GetIndexCount() != 0 && mesh->geometry->GetType() == Video::Geometry::Geometry3D::SKIN) {
-                    Material* material = entity->GetComponent<Material>();
-                    if (material)
-                        renderer->RenderSkinMesh(mesh->geometry, material->albedo->GetTexture(), material->normal->GetTexture(), material->metallic->GetTexture(), material->roughness->GetTexture(), entity->GetModelMatrix(), controller->bones);
-                }
+            renderer->PrepareSkinMeshRendering(viewMatrix, projectionMatrix, snapshot.zNear, snapshot.zFar);
+            for (const RenderSnapshot::MeshDraw& draw : snapshot.skinMeshes) {
+                if (draw.hasMaterial && draw.visible)
+                    renderer->RenderSkinMesh(draw.geometry, draw.albedo, draw.normal, draw.metallic, draw.roughness, draw.modelMatrix, draw.bones);
             }
         }
         }
@@ -416,16 +580,6 @@ void RenderManager::RenderWorldEntities(World& world, const glm::mat4& viewMatri
 }
 
 
-void RenderManager::UpdateAnimations(float deltaTime) {
-    // Update all enabled animation controllers.
-    for (Component::AnimationController* animationController : animationControllers.GetAll()) {
-        if (animationController->IsKilled() || !animationController->entity->IsEnabled())
-            continue;
-
-        animationController->UpdateAnimation(deltaTime);
-    }
-}
-
 void RenderManager::RenderEditorEntities(World& world, bool soundSources, bool particleEmitters, bool lightSources,
     bool cameras, bool physics, const glm::vec3& position, const glm::vec3& up, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
     Video::RenderSurface* renderSurface) {
@@ -491,38 +645,16 @@ void RenderManager::RenderEditorEntities(World& world, bool soundSources, bool p
     }
 }
 
-Component::AnimationController* RenderManager::CreateAnimation() {
-    return animationControllers.Create();
-}
-
-Component::AnimationController* RenderManager::CreateAnimation(const Json::Value& node) {
-    Component::AnimationController* animationController = animationControllers.Create();
-
-    std::string skeletonName = node.get("skeleton", "").asString();
-    if (!skeletonName.empty())
-        animationController->skeleton = Managers().resourceManager->CreateSkeleton(skeletonName);
-
-    std::string controllerName = node.get("animationController", "").asString();
-    if (!controllerName.empty())
-        animationController->controller = Managers().resourceManager->CreateAnimationController(controllerName);
-
-    return animationController;
-}
-
-const std::vector<Component::AnimationController*>& RenderManager::GetAnimations() const {
-    return animationControllers.GetAll();
-}
-
 Component::DirectionalLight* RenderManager::CreateDirectionalLight() {
     return directionalLights.Create();
 }
 
-Component::DirectionalLight* RenderManager::CreateDirectionalLight(const Json::Value& node) {
+Component::DirectionalLight* RenderManager::CreateDirectionalLight(const SceneNode& node) {
     Component::DirectionalLight* directionalLight = directionalLights.Create();
 
-    // Load values from Json node.
-    directionalLight->color = Json::LoadVec3(node["color"]);
-    directionalLight->ambientCoefficient = node.get("ambientCoefficient", 0.5f).asFloat();
+    // Load values from scene node.
+    directionalLight->color = node.GetVec3("color");
+    directionalLight->ambientCoefficient = node.GetFloat("ambientCoefficient", 0.5f);
 
     return directionalLight;
 }
@@ -535,13 +667,13 @@ Component::Lens* RenderManager::CreateLens() {
     return lenses.Create();
 }
 
-Component::Lens* RenderManager::CreateLens(const Json::Value& node) {
+Component::Lens* RenderManager::CreateLens(const SceneNode& node) {
     Component::Lens* lens = lenses.Create();
 
-    // Load values from Json node.
-    lens->fieldOfView = node.get("fieldOfView", 45.f).asFloat();
-    lens->zNear = node.get("zNear", 0.1f).asFloat();
-    lens->zFar = node.get("zFar", 100.f).asFloat();
+    // Load values from scene node.
+    lens->fieldOfView = node.GetFloat("fieldOfView", 45.f);
+    lens->zNear = node.GetFloat("zNear", 0.1f);
+    lens->zFar = node.GetFloat("zFar", 100.f);
 
     return lens;
 }
@@ -554,14 +686,15 @@ Component::Material* RenderManager::CreateMaterial() {
     return materials.Create();
 }
 
-Component::Material* RenderManager::CreateMaterial(const Json::Value& node) {
+Component::Material* RenderManager::CreateMaterial(const SceneNode& node) {
     Component::Material* material = materials.Create();
 
-    // Load values from Json node.
-    LoadTexture(material->albedo, node.get("albedo", "").asString());
-    LoadTexture(material->normal, node.get("normal", "").asString());
-    LoadTexture(material->metallic, node.get("metallic", "").asString());
-    LoadTexture(material->roughness, node.get("roughness", "").asString());
+    // Load values from scene node.
+    assert(!IsHeadless());
+    LoadTexture(material->albedo, node.GetString("albedo", ""));
+    LoadTexture(material->normal, node.GetString("normal", ""));
+    LoadTexture(material->metallic, node.GetString("metallic", ""));
+    LoadTexture(material->roughness, node.GetString("roughness", ""));
 
     return material;
 }
@@ -574,11 +707,11 @@ Component::Mesh* RenderManager::CreateMesh() {
     return meshes.Create();
 }
 
-Component::Mesh* RenderManager::CreateMesh(const Json::Value& node) {
+Component::Mesh* RenderManager::CreateMesh(const SceneNode& node) {
     Component::Mesh* mesh = meshes.Create();
 
-    // Load values from Json node.
-    std::string meshName = node.get("model", "").asString();
+    // Load values from scene node.
+    std::string meshName = node.GetString("model", "");
     mesh->geometry = Managers().resourceManager->CreateModel(meshName);
 
     return mesh;
@@ -592,14 +725,14 @@ Component::PointLight* RenderManager::CreatePointLight() {
     return pointLights.Create();
 }
 
-Component::PointLight* RenderManager::CreatePointLight(const Json::Value& node) {
+Component::PointLight* RenderManager::CreatePointLight(const SceneNode& node) {
     Component::PointLight* pointLight = pointLights.Create();
 
-    // Load values from Json node.
-    pointLight->color = Json::LoadVec3(node["color"]);
-    pointLight->attenuation = node.get("attenuation", 1.f).asFloat();
-    pointLight->intensity = node.get("intensity", 1.f).asFloat();
-    pointLight->distance = node.get("distance", 1.f).asFloat();
+    // Load values from scene node.
+    pointLight->color = node.GetVec3("color");
+    pointLight->attenuation = node.GetFloat("attenuation", 1.f);
+    pointLight->intensity = node.GetFloat("intensity", 1.f);
+    pointLight->distance = node.GetFloat("distance", 1.f);
 
     return pointLight;
 }
@@ -612,17 +745,17 @@ Component::SpotLight* RenderManager::CreateSpotLight() {
     return spotLights.Create();
 }
 
-Component::SpotLight* RenderManager::CreateSpotLight(const Json::Value& node) {
+Component::SpotLight* RenderManager::CreateSpotLight(const SceneNode& node) {
     Component::SpotLight* spotLight = spotLights.Create();
 
-    // Load values from Json node.
-    spotLight->color = Json::LoadVec3(node["color"]);
-    spotLight->ambientCoefficient = node.get("ambientCoefficient", 0.5f).asFloat();
-    spotLight->attenuation = node.get("attenuation", 1.f).asFloat();
-    spotLight->intensity = node.get("intensity", 1.f).asFloat();
-    spotLight->coneAngle = node.get("coneAngle", 15.f).asFloat();
-    spotLight->shadow = node.get("shadow", false).asBool();
-    spotLight->distance = node.get("distance", 1.f).asFloat();
+    // Load values from scene node.
+    spotLight->color = node.GetVec3("color");
+    spotLight->ambientCoefficient = node.GetFloat("ambientCoefficient", 0.5f);
+    spotLight->attenuation = node.GetFloat("attenuation", 1.f);
+    spotLight->intensity = node.GetFloat("intensity", 1.f);
+    spotLight->coneAngle = node.GetFloat("coneAngle", 15.f);
+    spotLight->shadow = node.GetBool("shadow", false);
+    spotLight->distance = node.GetFloat("distance", 1.f);
 
     return spotLight;
 }
@@ -632,7 +765,6 @@ const std::vector<Component::SpotLight*>& RenderManager::GetSpotLights() const {
 }
 
 void RenderManager::ClearKilledComponents() {
-    animationControllers.ClearKilled();
     directionalLights.ClearKilled();
     lenses.ClearKilled();
     materials.ClearKilled();
@@ -698,7 +830,9 @@ bool RenderManager::GetDitherApply() const {
 }
 
 void RenderManager::SetBloodApply(bool SetBloodApply) {
-   renderer->SetBloodApply(SetBloodApply);
+    // Scripts may call this in headless runs, which have nothing to render.
+    if (!IsHeadless())
+        renderer->SetBloodApply(SetBloodApply);
 }
 
 unsigned int RenderManager::GetLightCount() const {
@@ -717,82 +851,35 @@ uint16_t RenderManager::GetTextureReduction() const {
     return textureReduction;
 }
 
-void RenderManager::LightWorld(const glm::mat4& viewMatrix, const glm::mat4& viewProjectionMatrix, bool lightVolumes) {
+void RenderManager::LightWorld(const RenderSnapshot& snapshot, const glm::mat4& viewMatrix, const glm::mat4& viewProjectionMatrix, bool lightVolumes) {
     std::vector<Video::Light> lights;
 
-    Video::AxisAlignedBoundingBox aabb(glm::vec3(2.f, 2.f, 2.f), glm::vec3(0.f, 0.f, 0.f), glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, 1.0f, 1.0f));
-
     // Add all directional lights.
-    for (Component::DirectionalLight* directionalLight : directionalLights.GetAll()) {
-        if (directionalLight->IsKilled() || !directionalLight->entity->IsEnabled())
-            continue;
-
-        Entity* lightEntity = directionalLight->entity;
-        glm::vec4 direction(glm::vec4(lightEntity->GetDirection(), 0.f));
-        Video::Light light;
-        light.position = viewMatrix * -direction;
-        light.intensities = directionalLight->color;
-        light.attenuation = 1.f;
-        light.ambientCoefficient = directionalLight->ambientCoefficient;
-        light.coneAngle = 0.f;
-        light.direction = glm::vec3(0.f, 0.f, 0.f);
-        light.shadow = 0.f;
-        light.distance = 0.f;
+    for (Video::Light light : snapshot.directionalLights) {
+        light.position = viewMatrix * light.position;
         lights.push_back(light);
     }
 
+    // The snapshot was only culled against the camera, not against each eye of a headset.
     // Add all spot lights.
-    for (Component::SpotLight* spotLight : spotLights.GetAll()) {
-        if (spotLight->IsKilled() || !spotLight->entity->IsEnabled())
-            continue;
-
-        Entity* lightEntity = spotLight->entity;
-        glm::mat4 modelMat = glm::translate(glm::mat4(), lightEntity->GetWorldPosition()) * glm::scale(glm::mat4(), glm::vec3(1.f, 1.f, 1.f) * spotLight->distance);
-
-        //TMPTODO
-        Video::Frustum frustum(viewProjectionMatrix * modelMat);
-        if (frustum.Collide(aabb)) {
+    for (Video::Light light : snapshot.spotLights) {
+        if (LightInFrustum(light, viewProjectionMatrix)) {
             if (lightVolumes)
-                Managers().debugDrawingManager->AddSphere(lightEntity->GetWorldPosition(), spotLight->distance, glm::vec3(1.0f, 1.0f, 1.0f));
+                Managers().debugDrawingManager->AddSphere(glm::vec3(light.position), light.distance, glm::vec3(1.0f, 1.0f, 1.0f));
 
-            glm::vec4 direction(viewMatrix * glm::vec4(lightEntity->GetDirection(), 0.f));
-            glm::mat4 modelMatrix(lightEntity->GetModelMatrix());
-            Video::Light light;
-            light.position = viewMatrix * (glm::vec4(glm::vec3(modelMatrix[3][0], modelMatrix[3][1], modelMatrix[3][2]), 1.0));
-            light.intensities = spotLight->color * spotLight->intensity;
-            light.attenuation = spotLight->attenuation;
-            light.ambientCoefficient = spotLight->ambientCoefficient;
-            light.coneAngle = spotLight->coneAngle;
-            light.direction = glm::vec3(direction);
-            light.shadow = spotLight->shadow ? 1.f : 0.f;
-            light.distance = spotLight->distance;
+            light.position = viewMatrix * light.position;
+            light.direction = glm::vec3(viewMatrix * glm::vec4(light.direction, 0.f));
             lights.push_back(light);
         }
     }
 
     // Add all point lights.
-    for (Component::PointLight* pointLight : pointLights.GetAll()) {
-        if (pointLight->IsKilled() || !pointLight->entity->IsEnabled())
-            continue;
-
-        Entity* lightEntity = pointLight->entity;
-        glm::mat4 modelMat = glm::translate(glm::mat4(), lightEntity->GetWorldPosition()) * glm::scale(glm::mat4(), glm::vec3(1.f, 1.f, 1.f) * pointLight->distance);
-
-        Video::Frustum frustum(viewProjectionMatrix * modelMat);
-        if (frustum.Collide(aabb)) {
+    for (Video::Light light : snapshot.pointLights) {
+        if (LightInFrustum(light, viewProjectionMatrix)) {
             if (lightVolumes)
-                Managers().debugDrawingManager->AddSphere(lightEntity->GetWorldPosition(), pointLight->distance, glm::vec3(1.0f, 1.0f, 1.0f));
+                Managers().debugDrawingManager->AddSphere(glm::vec3(light.position), light.distance, glm::vec3(1.0f, 1.0f, 1.0f));
 
-            glm::mat4 modelMatrix(lightEntity->GetModelMatrix());
-            Video::Light light;
-            light.position = viewMatrix * (glm::vec4(glm::vec3(modelMatrix[3][0], modelMatrix[3][1], modelMatrix[3][2]), 1.0));
-            light.intensities = pointLight->color * pointLight->intensity;
-            light.attenuation = pointLight->attenuation;
-            light.ambientCoefficient = 0.f;
-            light.coneAngle = 180.f;
-            light.direction = glm::vec3(1.f, 0.f, 0.f);
-            light.shadow = 0.f;
-            light.distance = pointLight->distance;
+            light.position = viewMatrix * light.position;
             lights.push_back(light);
         }
     }
@@ -13,8 +13,8 @@ namespace Video {
 } // namespace Video
 class World;
 class Entity;
+struct RenderSnapshot;
 namespace Component {
-    class AnimationController;
     class DirectionalLight;
     class Lens;
     class Material;
@@ -22,12 +22,14 @@ namespace Component {
     class PointLight;
     class SpotLight;
 } // namespace Component
-namespace Json {
-    class Value;
-}
+class SceneNode;
 class TextureAsset;
 
 /// Handles rendering the world.
+/**
+ * When started headless the manager has no renderer. It still keeps the components and creates
+ * snapshots, so that culling can be measured without a graphics context, but it can't render.
+ */
 class RenderManager {
     friend class Hub;
 
@@ -52,34 +54,35 @@ class RenderManager {
          * @param lightVolumes Whether to show light culling volumes.
          */
         ENGINE_API void Render(World& world, DISPLAY targetDisplay, bool soundSources = true, bool particleEmitters = true, bool lightSources = true, bool cameras = true, bool physics = true, Entity* camera = nullptr, bool lighting = true, bool lightVolumes = false);
-        
-        /// Update all the animations in the scene.
+
+        /// Render a snapshot of the world.
         /**
-         * @param deltaTime Time between frames.
+         * Doesn't touch the world, so it can be updated while the snapshot is rendered.
+         * @param snapshot Snapshot created by CreateSnapshot.
+         * @param targetDisplay Display type to render.
+         * @param lighting Whether to light the scene (otherwise full ambient is used).
+         * @param lightVolumes Whether to show light culling volumes.
          */
-        ENGINE_API void UpdateAnimations(float deltaTime);
+        ENGINE_API void Render(const RenderSnapshot& snapshot, DISPLAY targetDisplay, bool lighting = true, bool lightVolumes = false);
 
-        /// Updates the buffers to fit the current screen size.
-        ENGINE_API void UpdateBufferSize();
-
-        /// Create animation component.
+        /// Copy what's needed to render the world into a snapshot.
         /**
-         * @return The created component.
+         * Meshes and lights are culled against the camera's view frustum, unless the camera is a VR headset.
+         * The snapshot's buffers are reused, so keep passing the same snapshot to avoid allocations.
+         * @param world World to snapshot.
+         * @param snapshot Snapshot to fill.
+         * @param camera Camera through which to render (or first camera in the world if nullptr).
          */
-        ENGINE_API Component::AnimationController* CreateAnimation();
-  
-        /// Create animation component.
+        ENGINE_API void CreateSnapshot(World& world, RenderSnapshot& snapshot, Entity* camera = nullptr);
+        
+        /// Get whether the manager was started without a graphics context.
         /**
-         * @param node Json node to load the component from.
-         * @return The created component.
+         * @return Whether the manager is headless.
          */
-        ENGINE_API Component::AnimationController* CreateAnimation(const Json::Value& node);
+        ENGINE_API bool IsHeadless() const;
 
-        /// Get all animation controller components.
-        /**
-         * @return All animation controller components.
-         */
-        ENGINE_API const std::vector<Component::AnimationController*>& GetAnimations() const;
+        /// Updates the buffers to fit the current screen size.
+        ENGINE_API void UpdateBufferSize();
 
         /// Create directional light component.
         /**
@@ -89,10 +92,10 @@ class RenderManager {
 
         /// Create directional light component.
         /**
-         * @param node Json node to load the component from.
+         * @param node Scene node to load the component from.
          * @return The created component.
          */
-        ENGINE_API Component::DirectionalLight* CreateDirectionalLight(const Json::Value& node);
+        ENGINE_API Component::DirectionalLight* CreateDirectionalLight(const SceneNode& node);
 
         /// Get all directional light components.
         /**
@@ -108,10 +111,10 @@ class RenderManager {
 
         /// Create lens component.
         /**
-         * @param node Json node to load the component from.
+         * @param node Scene node to load the component from.
          * @return The created component.
          */
-        ENGINE_API Component::Lens* CreateLens(const Json::Value& node);
+        ENGINE_API Component::Lens* CreateLens(const SceneNode& node);
 
         /// Get all lens components.
         /**
@@ -127,10 +130,10 @@ class RenderManager {
 
         /// Create material component.
         /**
-         * @param node Json node to load the component from.
+         * @param node Scene node to load the component from.
          * @return The created component.
          */
-        ENGINE_API Component::Material* CreateMaterial(const Json::Value& node);
+        ENGINE_API Component::Material* CreateMaterial(const SceneNode& node);
 
         /// Get all material components.
         /**
@@ -146,10 +149,10 @@ class RenderManager {
 
         /// Create mesh component.
         /**
-         * @param node Json node to load the component from.
+         * @param node Scene node to load the component from.
          * @return The created component.
          */
-        ENGINE_API Component::Mesh* CreateMesh(const Json::Value& node);
+        ENGINE_API Component::Mesh* CreateMesh(const SceneNode& node);
 
         /// Get all mesh components.
         /**
@@ -165,10 +168,10 @@ class RenderManager {
 
         /// Create point light component.
         /**
-         * @param node Json node to load the component from.
+         * @param node Scene node to load the component from.
          * @return The created component.
          */
-        ENGINE_API Component::PointLight* CreatePointLight(const Json::Value& node);
+        ENGINE_API Component::PointLight* CreatePointLight(const SceneNode& node);
 
         /// Get all point light components.
         /**
@@ -184,10 +187,10 @@ class RenderManager {
 
         /// Create spot light component.
         /**
-         * @param node Json node to load the component from.
+         * @param node Scene node to load the component from.
          * @return The created component.
          */
-        ENGINE_API Component::SpotLight* CreateSpotLight(const Json::Value& node);
+        ENGINE_API Component::SpotLight* CreateSpotLight(const SceneNode& node);
 
         /// Get all spot light components.
         /**
@@ -317,16 +320,18 @@ class RenderManager {
         ENGINE_API void SetShadowMapSize(unsigned int shadowMapSize);
 
     private:
-        RenderManager();
+        explicit RenderManager(bool headless = false);
         ~RenderManager();
         RenderManager(RenderManager const&) = delete;
         void operator=(RenderManager const&) = delete;
 
-        void RenderWorldEntities(World& world, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, Video::RenderSurface* renderSurface, bool lighting, float cameraNear, float cameraFar, bool lightVolumes);
+        void RenderDisplay(const RenderSnapshot& snapshot, DISPLAY targetDisplay, bool lighting, bool lightVolumes, World* world, bool soundSources, bool particleEmitters, bool lightSources, bool cameras, bool physics);
+
+        void RenderWorldEntities(const RenderSnapshot& snapshot, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, Video::RenderSurface* renderSurface, bool lighting, bool lightVolumes);
 
         void RenderEditorEntities(World& world, bool soundSources, bool particleEmitters, bool lightSources, bool cameras, bool physics, const glm::vec3& position, const glm::vec3& up, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, Video::RenderSurface* renderSurface);
 
-        void LightWorld(const glm::mat4& viewMatrix, const glm::mat4& viewProjectionMatrix, bool lightVolumes);
+        void LightWorld(const RenderSnapshot& snapshot, const glm::mat4& viewMatrix, const glm::mat4& viewProjectionMatrix, bool lightVolumes);
         void LightAmbient();
 
         void LoadTexture(TextureAsset*& texture, const std::string& name);
@@ -335,6 +340,9 @@ class RenderManager {
 
         Video::ShadowPass* shadowPass;
 
+        // Snapshot used when rendering the world directly.
+        RenderSnapshot* worldSnapshot;
+
         Video::RenderSurface* mainWindowRenderSurface;
         Video::RenderSurface* hmdRenderSurface;
 
@@ -345,7 +353,6 @@ class RenderManager {
         Video::TexturePNG* cameraTexture;
 
         // Components.
-        ComponentContainer<Component::AnimationController> animationControllers;
         ComponentContainer<Component::DirectionalLight> directionalLights;
         ComponentContainer<Component::Lens> lenses;
         ComponentContainer<Component::Material> materials;
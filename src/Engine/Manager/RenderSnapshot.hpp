@@ -0,0 +1,95 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <Video/Lighting/Light.hpp>
+#include "../Hymn.hpp"
+
+namespace Video {
+    class Texture2D;
+    namespace Geometry {
+        class Geometry3D;
+    }
+}
+
+/// Everything needed to render the world, copied from it after an update.
+/**
+ * Lets the world be rendered while it's being updated again. Meshes and textures are referenced
+ * rather than copied. They stay alive until killed components are cleared at the end of the next update.
+ */
+struct RenderSnapshot {
+    /// A mesh to draw.
+    struct MeshDraw {
+        /// The geometry to draw.
+        Video::Geometry::Geometry3D* geometry;
+
+        /// Model matrix of the mesh's entity.
+        glm::mat4 modelMatrix;
+
+        /// Whether the entity has a material. Meshes without one only cast shadows.
+        bool hasMaterial;
+
+        /// Whether the mesh is inside the camera's view frustum. Meshes outside it only cast shadows.
+        bool visible;
+
+        /// Albedo texture of the material.
+        Video::Texture2D* albedo;
+
+        /// Normal texture of the material.
+        Video::Texture2D* normal;
+
+        /// Metallic texture of the material.
+        Video::Texture2D* metallic;
+
+        /// Roughness texture of the material.
+        Video::Texture2D* roughness;
+
+        /// Bone palette of skinned meshes.
+        std::vector<glm::mat4> bones;
+    };
+
+    /// Whether the world has a camera. Nothing is rendered otherwise.
+    bool hasCamera = false;
+
+    /// Model matrix of the camera.
+    glm::mat4 cameraMatrix;
+
+    /// Projection matrix of the camera for the main window.
+    glm::mat4 projectionMatrix;
+
+    /// Near plane of the camera.
+    float zNear = 0.0f;
+
+    /// Far plane of the camera.
+    float zFar = 0.0f;
+
+    /// Whether the camera is a VR headset.
+    bool hasHeadset = false;
+
+    /// Projection matrices of the headset's left and right eye.
+    glm::mat4 eyeProjectionMatrices[2];
+
+    /// View matrix of the light casting shadows.
+    glm::mat4 lightViewMatrix;
+
+    /// Projection matrix of the light casting shadows.
+    glm::mat4 lightProjectionMatrix;
+
+    /// Static meshes.
+    std::vector<MeshDraw> staticMeshes;
+
+    /// Skinned meshes.
+    std::vector<MeshDraw> skinMeshes;
+
+    /// Directional lights, with positions and directions in world space.
+    std::vector<Video::Light> directionalLights;
+
+    /// Spot lights inside the camera's view frustum, with positions and directions in world space.
+    std::vector<Video::Light> spotLights;
+
+    /// Point lights inside the camera's view frustum, with positions in world space.
+    std::vector<Video::Light> pointLights;
+
+    /// Filter settings of the hymn.
+    ActiveHymn::FilterSettings filterSettings;
+};
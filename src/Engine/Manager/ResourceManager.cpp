@@ -13,6 +13,8 @@
 #include <Utility/Log.hpp>
 #include "../Audio/AudioMaterial.hpp"
 #include "../Audio/VorbisFile.hpp"
+#include "../Entity/SceneTemplate.hpp"
+#include "../Hymn.hpp"
 
 #ifdef USINGMEMTRACK
 #include <MemTrackInclude.hpp>
@@ -20,6 +22,10 @@
 
 using namespace std;
 
+ResourceManager::~ResourceManager() {
+    ClearSceneTemplates();
+}
+
 Geometry::Model* ResourceManager::CreateModel(const std::string& name) {
     if (models.find(name) == models.end()) {
         Geometry::Model* model = new Geometry::Model();
@@ -231,3 +237,115 @@ void ResourceManager::FreeAudioMaterial(Audio::AudioMaterial* audioMaterial) {
         audioMaterials.erase(name);
     }
 }
+
+const SceneTemplate* ResourceManager::GetSceneTemplate(const std::string& name) {
+    // Templates are keyed by path so that scenes from different hymns don't collide.
+    std::string filename = Hymn().GetPath() + "/" + name;
+    auto it = sceneTemplates.find(filename);
+    if (it != sceneTemplates.end()) {
+        if (it->second->IsValid())
+            return it->second;
+
+        // The scene failed to load last time, but may have been saved since.
+        delete it->second;
+        sceneTemplates.erase(it);
+    }
+
+    SceneTemplate* sceneTemplate = new SceneTemplate(name);
+    sceneTemplates[filename] = sceneTemplate;
+
+    // Gather the scenes referenced by nested scenes. Only the direct scenes of
+    // other templates are used, since templates further up the recursion
+    // haven't gathered theirs yet. The template is already cached at this
+    // point, so cyclic references terminate.
+    std::set<std::string> referencedScenes;
+    std::vector<std::string> scenesToVisit(sceneTemplate->directScenes.begin(), sceneTemplate->directScenes.end());
+    while (!scenesToVisit.empty()) {
+        std::string nestedName = scenesToVisit.back();
+        scenesToVisit.pop_back();
+        if (!referencedScenes.insert(nestedName).second)
+            continue;
+
+        const SceneTemplate* nested = GetSceneTemplate(nestedName);
+        scenesToVisit.insert(scenesToVisit.end(), nested->directScenes.begin(), nested->directScenes.end());
+    }
+    sceneTemplate->referencedScenes = referencedScenes;
+
+    return sceneTemplate;
+}
+
+void ResourceManager::ClearSceneTemplates() {
+    for (auto& it : sceneTemplates)
+        delete it.second;
+    sceneTemplates.clear();
+}
+
+void ResourceManager::RetainResources() {
+    for (auto& it : models) {
+        it.second.count++;
+        retained.models.push_back(it.second.model);
+    }
+
+    for (auto& it : animationClips) {
+        it.second.count++;
+        retained.animationClips.push_back(it.second.animationClip);
+    }
+
+    for (auto& it : animationControllers) {
+        it.second.count++;
+        retained.animationControllers.push_back(it.second.animationController);
+    }
+
+    for (auto& it : skeletons) {
+        it.second.count++;
+        retained.skeletons.push_back(it.second.skeleton);
+    }
+
+    for (auto& it : textureAssets) {
+        it.second.count++;
+        retained.textureAssets.push_back(it.second.textureAsset);
+    }
+
+    for (auto& it : sounds) {
+        it.second.count++;
+        retained.sounds.push_back(it.second.sound);
+    }
+
+    for (auto& it : scriptFiles) {
+        it.second.count++;
+        retained.scriptFiles.push_back(it.second.scriptFile);
+    }
+
+    for (auto& it : audioMaterials) {
+        it.second.count++;
+        retained.audioMaterials.push_back(it.second.audioMaterial);
+    }
+}
+
+void ResourceManager::ReleaseResources() {
+    for (Geometry::Model* model : retained.models)
+        FreeModel(model);
+
+    for (Animation::AnimationClip* animationClip : retained.animationClips)
+        FreeAnimationClip(animationClip);
+
+    for (Animation::AnimationController* animationController : retained.animationControllers)
+        FreeAnimationController(animationController);
+
+    for (Animation::Skeleton* skeleton : retained.skeletons)
+        FreeSkeleton(skeleton);
+
+    for (TextureAsset* textureAsset : retained.textureAssets)
+        FreeTextureAsset(textureAsset);
+
+    for (Audio::SoundFile* sound : retained.sounds)
+        FreeSound(sound);
+
+    for (ScriptFile* scriptFile : retained.scriptFiles)
+        FreeScriptFile(scriptFile);
+
+    for (Audio::AudioMaterial* audioMaterial : retained.audioMaterials)
+        FreeAudioMaterial(audioMaterial);
+
+    retained = RetainedResources();
+}
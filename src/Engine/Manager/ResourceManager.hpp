@@ -1,6 +1,8 @@
 #pragma once
 
 #include <map>
+#include <string>
+#include <vector>
 #include <GL/glew.h>
 #include "../linking.hpp"
 
@@ -26,6 +28,7 @@ namespace Animation {
 }
 class TextureAsset;
 class ScriptFile;
+class SceneTemplate;
 
 /// Handles all resources.
 class ResourceManager {
@@ -35,6 +38,9 @@ class ResourceManager {
         /// Constructor
         ResourceManager() {}
 
+        /// Destructor.
+        ENGINE_API ~ResourceManager();
+
         /// Create an animation clip.
         /**
          * @param name Name of animation clip.
@@ -163,6 +169,32 @@ class ResourceManager {
          * @param audioMaterial %AudioMaterial to dereference.
          */
         ENGINE_API void FreeAudioMaterial(Audio::AudioMaterial* audioMaterial);
+
+        /// Get the template of a scene, loading it if it isn't cached.
+        /**
+         * Templates stay cached until ClearSceneTemplates is called, so
+         * instantiating the same scene again doesn't touch the filesystem.
+         * Scenes that failed to load are loaded again on the next call.
+         * @param name Name of the scene.
+         * @return The scene template (which may be invalid if the scene file doesn't exist). An invalid template is deleted by the next call for the same scene.
+         */
+        ENGINE_API const SceneTemplate* GetSceneTemplate(const std::string& name);
+
+        /// Forget all cached scene templates, eg. after a scene has been saved.
+        ENGINE_API void ClearSceneTemplates();
+
+        /// Keep all currently loaded resources alive until ReleaseResources is called.
+        /**
+         * Used by world snapshots so that reloading a world reuses the
+         * resources instead of loading them from disk again.
+         */
+        ENGINE_API void RetainResources();
+
+        /// Release the references taken by RetainResources.
+        /**
+         * Resources that aren't used by anything else are deleted.
+         */
+        ENGINE_API void ReleaseResources();
         
     private:
         ResourceManager(ResourceManager const&) = delete;
@@ -248,4 +280,20 @@ class ResourceManager {
         };
         std::map<std::string, AudioMaterialInstance> audioMaterials;
         std::map<Audio::AudioMaterial*, std::string> audioMaterialsInverse;
+
+        // Scene templates (keyed by file path).
+        std::map<std::string, SceneTemplate*> sceneTemplates;
+
+        // Resources referenced by RetainResources.
+        struct RetainedResources {
+            std::vector<Geometry::Model*> models;
+            std::vector<Animation::AnimationClip*> animationClips;
+            std::vector<Animation::AnimationController*> animationControllers;
+            std::vector<Animation::Skeleton*> skeletons;
+            std::vector<TextureAsset*> textureAssets;
+            std::vector<Audio::SoundFile*> sounds;
+            std::vector<ScriptFile*> scriptFiles;
+            std::vector<Audio::AudioMaterial*> audioMaterials;
+        };
+        RetainedResources retained;
 };
@@ -7,18 +7,22 @@
 #include <scriptmath/scriptmath.h>
 #include <scriptstdstring/scriptstdstring.h>
 #include <Utility/Log.hpp>
+#include <Utility/MemoryTracker.hpp>
 #include <Video/Geometry/Geometry3D.hpp>
+#include <algorithm>
 #include <map>
 #include <typeindex>
 #include <sstream>
 #include <cstring>
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 
 #include "../Util/FileSystem.hpp"
 #include "../Util/Input.hpp"
 #include "../Util/RayIntersection.hpp"
 #include "../Util/MousePicking.hpp"
+#include "../Util/SceneNode.hpp"
 #include "../Hymn.hpp"
 #include "../Entity/World.hpp"
 #include "../Entity/Entity.hpp"
@@ -46,6 +50,14 @@
 
 using namespace Component;
 
+void* AngelScriptAllocate(size_t size) {
+    return Utility::MemoryTracker::TaggedMalloc(Utility::MemoryTracker::SCRIPTS, size);
+}
+
+void AngelScriptFree(void* memory) {
+    Utility::MemoryTracker::TaggedFree(Utility::MemoryTracker::SCRIPTS, memory);
+}
+
 void AngelScriptMessageCallback(const asSMessageInfo* message, void* param) {
     Log() << message->section << " (" << message->row << ", " << message->col << " : ";
     
@@ -130,14 +142,26 @@ void RegisterUpdate() {
     Managers().scriptManager->RegisterUpdate(Managers().scriptManager->currentEntity);
 }
 
+bool IsVRActive() {
+    // The VR manager isn't started by headless runs.
+    return Managers().vrManager != nullptr && Managers().vrManager->Active();
+}
+
 bool ButtonInput(int buttonIndex, Entity* controllerEntity) {
-    if (Managers().vrManager->Active())
+    if (IsVRActive())
         return Input::GetInstance().CheckVRButton(buttonIndex, controllerEntity->GetComponent<VRDevice>());
-    else
-        return Input::GetInstance().CheckButton(buttonIndex);
+    
+    // Headless runs have no window to read input from.
+    if (MainWindow::GetInstance() == nullptr)
+        return false;
+    
+    return Input::GetInstance().CheckButton(buttonIndex);
 }
 
 glm::vec2 GetCursorXY() {
+    if (Input() == nullptr)
+        return glm::vec2(0.f, 0.f);
+    
     return Input()->GetCursorXY();
 }
 
@@ -150,6 +174,9 @@ void RestartScene() {
 }
 
 bool IsIntersect(Entity* checker, Entity* camera) {
+    if (MainWindow::GetInstance() == nullptr)
+        return false;
+    
     MousePicking mousePicker = MousePicking(camera, camera->GetComponent<Component::Lens>()->GetProjection(glm::vec2(MainWindow::GetInstance()->GetSize().x, MainWindow::GetInstance()->GetSize().y)));
     mousePicker.Update();
     RayIntersection rayIntersector;
@@ -164,8 +191,41 @@ bool IsIntersect(Entity* checker, Entity* camera) {
     return false;
 }
 
-bool IsVRActive() {
-    return Managers().vrManager->Active();
+CScriptArray* RaycastBatch(const CScriptArray* origins, const CScriptArray* directions, float maxDistance, int mask, const PhysicsManager* physicsManager) {
+    std::vector<Physics::Ray> rays(std::min(origins->GetSize(), directions->GetSize()));
+    for (std::size_t i = 0; i < rays.size(); ++i)
+        rays[i] = { *static_cast<const glm::vec3*>(origins->At(i)), *static_cast<const glm::vec3*>(directions->At(i)), maxDistance };
+
+    std::vector<Physics::QueryHit> hits;
+    physicsManager->Raycast(rays, hits, mask);
+
+    asITypeInfo* type = asGetActiveContext()->GetEngine()->GetTypeInfoByDecl("array<QueryHit>");
+    CScriptArray* result = CScriptArray::Create(type, static_cast<asUINT>(hits.size()));
+    for (std::size_t i = 0; i < hits.size(); ++i)
+        *static_cast<Physics::QueryHit*>(result->At(i)) = hits[i];
+
+    return result;
+}
+
+CScriptArray* EntityArray(const std::vector<Entity*>& entities) {
+    asITypeInfo* type = asGetActiveContext()->GetEngine()->GetTypeInfoByDecl("array<Entity@>");
+    CScriptArray* result = CScriptArray::Create(type, static_cast<asUINT>(entities.size()));
+    for (std::size_t i = 0; i < entities.size(); ++i)
+        *static_cast<Entity**>(result->At(i)) = entities[i];
+
+    return result;
+}
+
+CScriptArray* OverlapSphere(const glm::vec3& center, float radius, int mask, const PhysicsManager* physicsManager) {
+    std::vector<Entity*> entities;
+    physicsManager->OverlapSphere(center, radius, entities, mask);
+    return EntityArray(entities);
+}
+
+CScriptArray* OverlapBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::quat& orientation, int mask, const PhysicsManager* physicsManager) {
+    std::vector<Entity*> entities;
+    physicsManager->OverlapBox(center, halfExtents, orientation, entities, mask);
+    return EntityArray(entities);
 }
 
 void vec2Constructor(float x, float y, void* memory) {
@@ -234,6 +294,10 @@ glm::vec4 mat4MulVec4(const glm::vec4& a, const void* memory) {
 }
 
 ScriptManager::ScriptManager() {
+    // Report the script engine's memory to the memory tracker. Has to be set
+    // before the engine allocates anything.
+    asSetGlobalMemoryFunctions(AngelScriptAllocate, AngelScriptFree);
+
     // Create the script engine
     engine = asCreateScriptEngine();
     
@@ -385,9 +449,9 @@ ScriptManager::ScriptManager() {
     engine->RegisterObjectMethod("Entity", "Entity@ GetChild(const string &in) const", asMETHOD(Entity, GetChild), asCALL_THISCALL);
     engine->RegisterObjectMethod("Entity", "Entity@ GetChildFromIndex(int) const", asMETHOD(Entity, GetChildFromIndex), asCALL_THISCALL);
     engine->RegisterObjectMethod("Entity", "uint GetNumChildren() const", asMETHOD(Entity, GetNumChildren), asCALL_THISCALL);
-    engine->RegisterObjectMethod("Entity", "uint GetUniqueIdentifier() const", asMETHOD(Entity, GetUniqueIdentifier), asCALL_THISCALL);
+    engine->RegisterObjectMethod("Entity", "uint64 GetUniqueIdentifier() const", asMETHOD(Entity, GetUniqueIdentifier), asCALL_THISCALL);
 
-    engine->RegisterGlobalFunction("Entity@ GetEntityByGUID(uint GUID)", asFUNCTIONPR(ActiveHymn::GetEntityByGUID, (unsigned int), Entity*), asCALL_CDECL);
+    engine->RegisterGlobalFunction("Entity@ GetEntityByGUID(uint64 GUID)", asFUNCTIONPR(ActiveHymn::GetEntityByGUID, (uint64_t), Entity*), asCALL_CDECL);
 
     engine->RegisterObjectMethod("Entity", "void RotateYaw(float angle)", asMETHOD(Entity, RotateYaw), asCALL_THISCALL);
     engine->RegisterObjectMethod("Entity", "void RotatePitch(float angle)", asMETHOD(Entity, RotatePitch), asCALL_THISCALL);
@@ -478,11 +542,29 @@ ScriptManager::ScriptManager() {
     engine->RegisterObjectMethod("RenderManager", "bool GetDitherApply()", asMETHOD(RenderManager, GetDitherApply), asCALL_THISCALL);
     engine->RegisterObjectMethod("RenderManager", "void SetBloodApply(bool)", asMETHOD(RenderManager, SetBloodApply), asCALL_THISCALL);
 
+    engine->RegisterEnum("QueryFilter");
+    engine->RegisterEnumValue("QueryFilter", "QUERY_DYNAMIC", Physics::QUERY_DYNAMIC);
+    engine->RegisterEnumValue("QueryFilter", "QUERY_STATIC", Physics::QUERY_STATIC);
+    engine->RegisterEnumValue("QueryFilter", "QUERY_DEFAULT", Physics::QUERY_DEFAULT);
+
+    engine->RegisterObjectType("QueryHit", sizeof(Physics::QueryHit), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<Physics::QueryHit>());
+    engine->RegisterObjectProperty("QueryHit", "Entity@ entity", asOFFSET(Physics::QueryHit, entity));
+    engine->RegisterObjectProperty("QueryHit", "vec3 point", asOFFSET(Physics::QueryHit, point));
+    engine->RegisterObjectProperty("QueryHit", "vec3 normal", asOFFSET(Physics::QueryHit, normal));
+    engine->RegisterObjectProperty("QueryHit", "float distance", asOFFSET(Physics::QueryHit, distance));
+    engine->RegisterObjectBehaviour("QueryHit", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(glmConstructor<Physics::QueryHit>), asCALL_CDECL_OBJLAST);
+
     engine->RegisterObjectType("PhysicsManager", 0, asOBJ_REF | asOBJ_NOCOUNT);
     engine->RegisterObjectMethod("PhysicsManager", "void MakeKinematic(Component::RigidBody@)", asMETHOD(PhysicsManager, MakeKinematic), asCALL_THISCALL);
     engine->RegisterObjectMethod("PhysicsManager", "void MakeDynamic(Component::RigidBody@)", asMETHOD(PhysicsManager, MakeDynamic), asCALL_THISCALL);
     engine->RegisterObjectMethod("PhysicsManager", "void ForceTransformSync(Component::RigidBody@)", asMETHOD(PhysicsManager, ForceTransformSync), asCALL_THISCALL);
     engine->RegisterObjectMethod("PhysicsManager", "void HaltMovement(Component::RigidBody@)", asMETHOD(PhysicsManager, HaltMovement), asCALL_THISCALL);
+    engine->RegisterObjectMethod("PhysicsManager", "bool Raycast(const vec3 &in, const vec3 &in, float, QueryHit &out, int = QUERY_DEFAULT) const", asMETHODPR(PhysicsManager, Raycast, (const glm::vec3&, const glm::vec3&, float, Physics::QueryHit&, int) const, bool), asCALL_THISCALL);
+    engine->RegisterObjectMethod("PhysicsManager", "array<QueryHit>@ Raycast(const array<vec3> &in, const array<vec3> &in, float, int = QUERY_DEFAULT) const", asFUNCTION(RaycastBatch), asCALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("PhysicsManager", "bool SphereSweep(const vec3 &in, const vec3 &in, float, QueryHit &out, int = QUERY_DEFAULT) const", asMETHOD(PhysicsManager, SphereSweep), asCALL_THISCALL);
+    engine->RegisterObjectMethod("PhysicsManager", "bool BoxSweep(const vec3 &in, const vec3 &in, const vec3 &in, const quat &in, QueryHit &out, int = QUERY_DEFAULT) const", asMETHOD(PhysicsManager, BoxSweep), asCALL_THISCALL);
+    engine->RegisterObjectMethod("PhysicsManager", "array<Entity@>@ OverlapSphere(const vec3 &in, float, int = QUERY_DEFAULT) const", asFUNCTION(OverlapSphere), asCALL_CDECL_OBJLAST);
+    engine->RegisterObjectMethod("PhysicsManager", "array<Entity@>@ OverlapBox(const vec3 &in, const vec3 &in, const quat &in, int = QUERY_DEFAULT) const", asFUNCTION(OverlapBox), asCALL_CDECL_OBJLAST);
 
     engine->RegisterObjectType("Hub", 0, asOBJ_REF | asOBJ_NOCOUNT);
     engine->RegisterObjectProperty("Hub", "DebugDrawingManager@ debugDrawingManager", asOFFSET(Hub, debugDrawingManager));
@@ -657,36 +739,21 @@ void ScriptManager::FillPropertyMap(Script* script) {
                 script->AddToPropertyMap(name, typeId, size, varPointer);
             } else if (typeId == engine->GetTypeIdByDecl("Entity@") && name != "self") {
                   
-                int size = sizeof(unsigned int);
+                int size = sizeof(uint64_t);
                 
                 Entity* pointer = *(Entity**)varPointer;
 
-                const std::vector<Entity*> entities = Hymn().world.GetEntities();
-                
-                bool initialized = false;
-                for (std::size_t i = 0; i < entities.size(); ++i) {
-
-                    if (entities[i] == pointer) {
-
-                        initialized = true;
-                        break;
-
-                    }
+                //We start with setting the GUID to 0, which means it's uninitialized.
+                uint64_t GUID = 0;
 
+                // Only store the GUID if the pointer is a live entity in the world.
+                if (pointer != nullptr) {
+                    uint64_t pointerGUID = pointer->GetUniqueIdentifier();
+                    if (Hymn().GetEntityByGUID(pointerGUID) == pointer)
+                        GUID = pointerGUID;
                 }
 
-                if (initialized) {
-
-                    unsigned int GUID = pointer->GetUniqueIdentifier();
-                    script->AddToPropertyMap(name, typeId, size, (void*)(&GUID));
-
-                } else {
-
-                    //We start with setting the GUID to 0, which means it's uninitialized.
-                    unsigned int GUID = 0;
-                    script->AddToPropertyMap(name, typeId, size, (void*)(&GUID));
-
-                }                
+                script->AddToPropertyMap(name, typeId, size, (void*)(&GUID));
             }
         }
     }
@@ -738,7 +805,7 @@ void ScriptManager::Update(World& world, float deltaTime) {
 
                     if (typeId == engine->GetTypeIdByDecl("Entity@")) {
                         
-                        unsigned int* GUID = (unsigned int*)script->GetDataFromPropertyMap(name);
+                        uint64_t* GUID = (uint64_t*)script->GetDataFromPropertyMap(name);
 
                         //We make sure it is initialized.
                         if (*GUID != 0)
@@ -825,35 +892,41 @@ Component::Script* ScriptManager::CreateScript() {
     return scripts.Create();
 }
 
-Component::Script* ScriptManager::CreateScript(const Json::Value& node) {
+Component::Script* ScriptManager::CreateScript(const SceneNode& node) {
     Component::Script* script = scripts.Create();
     
-    // Load values from Json node.
-    std::string name = node.get("scriptName", "").asString();
+    // Load values from scene node.
+    std::string name = node.GetString("scriptName", "");
     script->scriptFile = Managers().resourceManager->CreateScriptFile(name);
 
-    if (node.isMember("propertyMap")) {
+    if (node.IsMember("propertyMap")) {
 
-        Json::Value propertyMapJson = node.get("propertyMap", "");
-        std::vector<std::string> names = propertyMapJson.getMemberNames();
+        SceneNode propertyMap = node.GetMember("propertyMap");
+        std::vector<std::string> names = propertyMap.GetMemberNames();
 
         for (auto& name : names) {
 
-            if (propertyMapJson.isMember(name)) {
+            SceneNode typeIdValue = propertyMap.GetMember(name.c_str());
+
+            std::vector<std::string> typeIds = typeIdValue.GetMemberNames();
+            if (typeIds.empty())
+                continue;
 
-                Json::Value typeId_value = propertyMapJson.get(name, "");
+            int typeId = std::atoi(typeIds[0].c_str());
+            std::vector<uint8_t> bytes = typeIdValue.GetMember(typeIds[0].c_str()).AsBytes();
+            int size = static_cast<int>(bytes.size());
 
-                std::vector<std::string> typeIds = typeId_value.getMemberNames();
-                int typeId = std::atoi(typeIds[0].c_str());
-                int size = typeId_value[typeIds[0]].size();
-                void* data = malloc(size + 1);
-                for (int i = 0; i < size; i++)
-                    ((unsigned char*)data)[i] = (unsigned char)(typeId_value[typeIds[0]][i].asInt());
+            // Entity references used to be stored as 32-bit GUIDs.
+            int storedSize = size;
+            if (typeId == engine->GetTypeIdByDecl("Entity@") && size < static_cast<int>(sizeof(uint64_t)))
+                size = sizeof(uint64_t);
 
-                script->AddToPropertyMap(name, typeId, size, data);
-                std::free(data);
+            void* data = calloc(size + 1, 1);
+            if (storedSize > 0)
+                std::memcpy(data, bytes.data(), storedSize);
 
-            }
+            script->AddToPropertyMap(name, typeId, size, data);
+            std::free(data);
         }
     }
     
@@ -16,9 +16,7 @@ class ScriptFile;
 namespace Component {
     class Script;
 }
-namespace Json {
-    class Value;
-}
+class SceneNode;
 
 /// Handles scripting.
 class ScriptManager {
@@ -79,10 +77,10 @@ class ScriptManager {
         
         /// Create script component.
         /**
-         * @param node Json node to load the component from.
+         * @param node Scene node to load the component from.
          * @return The created component.
          */
-        ENGINE_API Component::Script* CreateScript(const Json::Value& node);
+        ENGINE_API Component::Script* CreateScript(const SceneNode& node);
         
         /// Used to get the string identifier used to check if a property is a string.
         /**
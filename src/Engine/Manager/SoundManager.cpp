@@ -14,6 +14,9 @@
 #include <Video/Geometry/Geometry3D.hpp>
 #include "Managers.hpp"
 #include "ResourceManager.hpp"
+#include "ProfilingManager.hpp"
+#include "../Util/Profiling.hpp"
+#include "../Util/SceneNode.hpp"
 #include <portaudio.h>
 #include <cstdint>
 #include <cstring>
@@ -39,6 +42,9 @@ SoundManager::SoundManager() {
         outputParams.suggestedLatency = Pa_GetDeviceInfo(outputParams.device)->defaultHighOutputLatency;
     }
 
+    callbackZone = ProfilingManager::RegisterZone("Audio callback");
+    traceBuffer = ProfilingManager::CreateTraceBuffer("Audio");
+
     // Open Stream
     err = Pa_OpenStream(
         &stream,
@@ -62,6 +68,9 @@ SoundManager::SoundManager() {
 SoundManager::~SoundManager() {
     Pa_CloseStream(stream);
     Pa_Terminate();
+
+    // The callback has stopped, so the next sound manager can reuse the buffer.
+    ProfilingManager::ReleaseTraceBuffer(traceBuffer);
 }
 
 void SoundManager::CheckError(PaError err) {
@@ -94,6 +103,8 @@ void SoundManager::CheckStatusFlag(PaStreamCallbackFlags flags) {
 
 int SoundManager::PortAudioStreamCallback(const void* inputBuffer, void* outputBuffer, unsigned long framesPerBuffer, const PaStreamCallbackTimeInfo* timeInfo, PaStreamCallbackFlags statusFlags, void* userData) {
     SoundManager* soundManager = (SoundManager*)userData;
+    ProfilingManager::SetTraceBuffer(soundManager->traceBuffer);
+    Profiling profiling(soundManager->callbackZone);
 
     std::unique_lock<std::mutex> updateLock(soundManager->updateMutex, std::defer_lock);
     updateLock.lock();
@@ -213,18 +224,18 @@ Component::SoundSource* SoundManager::CreateSoundSource() {
     return soundSource;
 }
 
-Component::SoundSource* SoundManager::CreateSoundSource(const Json::Value& node) {
+Component::SoundSource* SoundManager::CreateSoundSource(const SceneNode& node) {
     std::unique_lock<std::mutex> updateLock(updateMutex, std::defer_lock);
     updateLock.lock();
     Component::SoundSource* soundSource = soundSources.Create();
 
-    // Load values from Json node.
-    std::string name = node.get("sound", "").asString();
+    // Load values from scene node.
+    std::string name = node.GetString("sound", "");
     if (!name.empty())
         soundSource->soundBuffer->SetSoundFile(Managers().resourceManager->CreateSound(name));
 
-    soundSource->volume = node.get("volume", 1.f).asFloat();
-    soundSource->loop = node.get("loop", false).asBool();
+    soundSource->volume = node.GetFloat("volume", 1.f);
+    soundSource->loop = node.GetBool("loop", false);
 
     updateLock.unlock();
     return soundSource;
@@ -242,7 +253,7 @@ Component::Listener* SoundManager::CreateListener() {
     return listener;
 }
 
-Component::Listener* SoundManager::CreateListener(const Json::Value& node) {
+Component::Listener* SoundManager::CreateListener(const SceneNode& node) {
     std::unique_lock<std::mutex> updateLock(updateMutex, std::defer_lock);
     updateLock.lock();
     Component::Listener* listener = listeners.Create();
@@ -262,13 +273,13 @@ Component::AudioMaterial* SoundManager::CreateAudioMaterial() {
     return audioMaterial;
 }
 
-Component::AudioMaterial* SoundManager::CreateAudioMaterial(const Json::Value& node) {
+Component::AudioMaterial* SoundManager::CreateAudioMaterial(const SceneNode& node) {
     std::unique_lock<std::mutex> updateLock(updateMutex, std::defer_lock);
     updateLock.lock();
     Component::AudioMaterial* audioMaterial = audioMaterials.Create();
 
-    // Load values from Json node.
-    std::string name = node.get("audio material", "").asString();
+    // Load values from scene node.
+    std::string name = node.GetString("audio material", "");
     if (!name.empty())
         audioMaterial->material = Managers().resourceManager->CreateAudioMaterial(name);
 
@@ -5,6 +5,7 @@
 #include "../Audio/SteamAudioInterface.hpp"
 #include "../linking.hpp"
 #include "../Audio/SoundStreamer.hpp"
+#include "ProfilingManager.hpp"
 #include <Utility/Queue.hpp>
 #include <mutex>
 
@@ -17,9 +18,7 @@ namespace Component {
     class Listener;
     class SoundSource;
 }
-namespace Json {
-    class Value;
-}
+class SceneNode;
 
 /// Handles OpenAL sound.
 class SoundManager {
@@ -34,10 +33,10 @@ class SoundManager {
         
         /// Create sound source component.
         /**
-         * @param node Json node to load the component from.
+         * @param node Scene node to load the component from.
          * @return The created component.
          */
-        ENGINE_API Component::SoundSource* CreateSoundSource(const Json::Value& node);
+        ENGINE_API Component::SoundSource* CreateSoundSource(const SceneNode& node);
         
         /// Get all sound source components.
         /**
@@ -53,10 +52,10 @@ class SoundManager {
         
         /// Create listener component.
         /**
-         * @param node Json node to load the component from.
+         * @param node Scene node to load the component from.
          * @return The created component.
          */
-        ENGINE_API Component::Listener* CreateListener(const Json::Value& node);
+        ENGINE_API Component::Listener* CreateListener(const SceneNode& node);
         
         /// Get all listener components.
         /**
@@ -72,10 +71,10 @@ class SoundManager {
 
         /// Create audio material component.
         /**
-         * @param node Json node to load the component from.
+         * @param node Scene node to load the component from.
          * @return The created component.
          */
-        ENGINE_API Component::AudioMaterial* CreateAudioMaterial(const Json::Value& node);
+        ENGINE_API Component::AudioMaterial* CreateAudioMaterial(const SceneNode& node);
 
         /// Get all audio material components.
         /**
@@ -120,6 +119,10 @@ class SoundManager {
 
         std::mutex updateMutex;
 
+        // Profiling of the audio callback, set up before the stream starts since the callback must not allocate or lock.
+        unsigned int callbackZone;
+        ProfilingManager::TraceBuffer* traceBuffer;
+
         float processedBuffer[Audio::CHUNK_SIZE * 2];
 
         float volume = 1.f;
@@ -1,4 +1,5 @@
 #include "Managers.hpp"
+#include <algorithm>
 #include "PhysicsManager.hpp"
 #include "TriggerManager.hpp"
 #include "ScriptManager.hpp"
@@ -7,11 +8,11 @@
 #include "../Physics/Shape.hpp"
 #include "../Trigger/SuperTrigger.hpp"
 #include "../Trigger/TriggerRepeat.hpp"
-#include "../Util/Json.hpp"
+#include "../Util/SceneNode.hpp"
 
 
 TriggerManager::TriggerManager() {
-
+    eventQueue.reserve(64);
 }
 
 TriggerManager::~TriggerManager() {
@@ -19,12 +20,23 @@ TriggerManager::~TriggerManager() {
 }
 
 void TriggerManager::ProcessTriggers() {
-    for (auto trigger : triggerComponents.GetAll()) {
-        if (trigger->IsKilled() || !trigger->entity->IsEnabled())
-            continue;
-
-        trigger->superTrigger->Process();
+    // Scripts may cause new intersections to be queued (eg. by moving
+    // triggers), so only the events present at the start are dispatched.
+    std::size_t eventCount = eventQueue.size();
+    for (std::size_t i = 0; i < eventCount; ++i) {
+        triggerEvent::QueuedEvent event = eventQueue[i];
+        event.trigger->Process(event);
     }
+
+    eventQueue.erase(eventQueue.begin(), eventQueue.begin() + eventCount);
+}
+
+void TriggerManager::QueueEvent(SuperTrigger* trigger, Entity* entity, triggerEvent::Phase phase) {
+    eventQueue.push_back({ trigger, entity, phase });
+}
+
+const std::vector<triggerEvent::QueuedEvent>& TriggerManager::GetQueuedEvents() const {
+    return eventQueue;
 }
 
 Component::Trigger* TriggerManager::CreateTrigger() {
@@ -36,40 +48,69 @@ Component::Trigger* TriggerManager::CreateTrigger() {
     return comp;
 }
 
-Component::Trigger* TriggerManager::CreateTrigger(const Json::Value& node) {
+Component::Trigger* TriggerManager::CreateTrigger(const SceneNode& node) {
 
     auto comp = triggerComponents.Create();
     auto repeat = new TriggerRepeat;
-    std::string name = node.get("trigger", "").asString();
+    std::string name = node.GetString("trigger", "");
     auto triggerVolume = Managers().physicsManager->CreateTrigger(std::make_shared<Physics::Shape>(Physics::Shape::Sphere(1.0f)));
     repeat->triggerVolume = triggerVolume;
 
     if (!name.empty()) {
-        triggerEvent::EventStruct eventstruct;
-
-        repeat->name = node.get("triggerName", "").asString();
-        repeat->startActive = node.get("triggerActive", false).asBool();
-        repeat->delay = node.get("triggerDelay", 0).asFloat();
-        repeat->cooldown = node.get("triggerCooldown", 0).asFloat();
-        repeat->triggerCharges = node.get("triggerCharges", 0).asInt();
-        repeat->targetFunction.push_back(node.get("triggerFunction", "").asString());
-
-        repeat->collidedEntityUID = node.get("triggerCollidedEntityUID", 0).asInt();
-        repeat->targetEntityUID = node.get("triggerTargetEntity", 0).asInt();
-        repeat->owningEntityUID = node.get("triggerOwner", 0).asInt();
-
-        eventstruct.m_eventID = node.get("triggerEventStruct_EventID", 0).asInt();
-        eventstruct.m_shapeID = node.get("triggerEventStruct_ShapeID", 0).asInt();
-        eventstruct.m_targetID = node.get("triggerEventStruct_TargetID", 0).asInt();
-        eventstruct.m_scriptID = node.get("triggerEventStruct_ScriptID", 0).asInt();
-        eventstruct.check[0] = node.get("triggerEventStruct_Check_0", false).asBool();
-        eventstruct.check[1] = node.get("triggerEventStruct_Check_1", false).asBool();
-        eventstruct.check[2] = node.get("triggerEventStruct_Check_2", false).asBool();
-        eventstruct.check[3] = node.get("triggerEventStruct_Check_3", false).asBool();
-
-        repeat->eventVector.push_back(eventstruct);
-
-        repeat->triggered = node.get("triggerTriggered", false).asBool();
+        repeat->name = node.GetString("triggerName", "");
+        repeat->startActive = node.GetBool("triggerActive", false);
+        repeat->delay = node.GetFloat("triggerDelay", 0);
+        repeat->cooldown = node.GetFloat("triggerCooldown", 0);
+        repeat->triggerCharges = node.GetInt("triggerCharges", 0);
+        repeat->owningEntityUID = node.GetUInt64("triggerOwner", 0);
+
+        if (node.IsMember("triggerEvents")) {
+            SceneNode functions = node.GetMember("triggerFunctions");
+            for (unsigned int i = 0; i < functions.GetSize(); ++i)
+                repeat->targetFunction.push_back(functions.GetElement(i).AsString());
+            SceneNode targetEntities = node.GetMember("triggerTargetEntities");
+            for (unsigned int i = 0; i < targetEntities.GetSize(); ++i)
+                repeat->targetEntityUIDs.push_back(targetEntities.GetElement(i).AsUInt64());
+            SceneNode collidedEntities = node.GetMember("triggerCollidedEntities");
+            for (unsigned int i = 0; i < collidedEntities.GetSize(); ++i)
+                repeat->collidedEntityUIDs.push_back(collidedEntities.GetElement(i).AsUInt64());
+
+            SceneNode events = node.GetMember("triggerEvents");
+            for (unsigned int i = 0; i < events.GetSize(); ++i) {
+                SceneNode eventNode = events.GetElement(i);
+                triggerEvent::EventStruct eventstruct;
+                eventstruct.m_eventID = eventNode.GetInt("eventID", 0);
+                eventstruct.m_shapeID = eventNode.GetInt("shapeID", 0);
+                eventstruct.m_targetID = eventNode.GetInt("targetID", 0);
+                eventstruct.m_scriptID = eventNode.GetInt("scriptID", 0);
+                SceneNode check = eventNode.GetMember("check");
+                for (unsigned int j = 0; j < 4; ++j)
+                    eventstruct.check[j] = check.GetElement(j).AsBool();
+                repeat->eventVector.push_back(eventstruct);
+            }
+        } else {
+            // Triggers saved before multiple entities were supported.
+            triggerEvent::EventStruct eventstruct;
+
+            repeat->targetFunction.push_back(node.GetString("triggerFunction", ""));
+            repeat->collidedEntityUIDs.push_back(node.GetUInt64("triggerCollidedEntityUID", 0));
+            repeat->targetEntityUIDs.push_back(node.GetUInt64("triggerTargetEntity", 0));
+
+            eventstruct.m_eventID = node.GetInt("triggerEventStruct_EventID", 0);
+            eventstruct.m_shapeID = node.GetInt("triggerEventStruct_ShapeID", 0);
+            eventstruct.m_targetID = node.GetInt("triggerEventStruct_TargetID", 0);
+            eventstruct.m_scriptID = node.GetInt("triggerEventStruct_ScriptID", 0);
+            eventstruct.check[0] = node.GetBool("triggerEventStruct_Check_0", false);
+            eventstruct.check[1] = node.GetBool("triggerEventStruct_Check_1", false);
+            eventstruct.check[2] = node.GetBool("triggerEventStruct_Check_2", false);
+            eventstruct.check[3] = node.GetBool("triggerEventStruct_Check_3", false);
+
+            repeat->eventVector.push_back(eventstruct);
+        }
+
+        // The editor used to set a single collided entity for all events.
+        if (repeat->collidedEntityUIDs.size() == 1 && repeat->eventVector.size() > 1)
+            repeat->collidedEntityUIDs.resize(repeat->eventVector.size(), repeat->collidedEntityUIDs.front());
 
         repeat->triggerVolume = triggerVolume;
     }
@@ -112,7 +153,14 @@ void TriggerManager::SynchronizeTriggers() {
 }
 
 void TriggerManager::ClearKilledComponents() {
-    triggerComponents.ClearKilled();
+    triggerComponents.ClearKilled(
+        [this](Component::Trigger* trigger) {
+            // Don't dispatch events to triggers that no longer exist.
+            SuperTrigger* superTrigger = trigger->superTrigger;
+            eventQueue.erase(std::remove_if(eventQueue.begin(), eventQueue.end(), [superTrigger](const triggerEvent::QueuedEvent& event) {
+                return event.trigger == superTrigger;
+            }), eventQueue.end());
+        });
 }
 
 void TriggerManager::InitiateUID() {
@@ -134,3 +182,40 @@ void TriggerManager::InitiateVolumes() {
 
     }
 }
+
+void TriggerManager::InitiateTriggers(Entity* root, const std::map<uint64_t, uint64_t>& identifiers) {
+    std::vector<Component::Trigger*> triggers;
+    GetTriggers(root, triggers);
+
+    // Point UIDs saved in the scene to the instantiated entities.
+    auto remap = [&identifiers](uint64_t& uid) {
+        auto it = identifiers.find(uid);
+        if (it != identifiers.end())
+            uid = it->second;
+    };
+
+    for (Component::Trigger* trigger : triggers) {
+        TriggerRepeat* repeat = GetTriggerRepeat(*trigger);
+        if (repeat != nullptr) {
+            for (uint64_t& uid : repeat->targetEntityUIDs)
+                remap(uid);
+            for (uint64_t& uid : repeat->collidedEntityUIDs)
+                remap(uid);
+            remap(repeat->owningEntityUID);
+        }
+
+        trigger->superTrigger->InitTriggerUID();
+    }
+
+    for (Component::Trigger* trigger : triggers)
+        trigger->superTrigger->InitiateVolumes();
+}
+
+void TriggerManager::GetTriggers(Entity* entity, std::vector<Component::Trigger*>& triggers) const {
+    Component::Trigger* trigger = entity->GetComponent<Component::Trigger>();
+    if (trigger != nullptr && !trigger->IsKilled() && entity->IsEnabled())
+        triggers.push_back(trigger);
+
+    for (Entity* child : entity->GetChildren())
+        GetTriggers(child, triggers);
+}
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <vector>
 #include "../Entity/ComponentContainer.hpp"
+#include "../Trigger/TriggerEvent.hpp"
 #include "../linking.hpp"
 
+class Entity;
 class SuperTrigger;
 class TriggerRepeat;
 
@@ -11,9 +16,7 @@ namespace Component {
     class Trigger;
 }
 
-namespace Json {
-    class Value;
-}
+class SceneNode;
 
 namespace Physics {
     class Shape;
@@ -24,11 +27,26 @@ class TriggerManager {
     friend class Hub;
 
     public:
-        /// Iterate triggers and have them call their target scripts if
-        /// conditions are satisfied. This should be called after both the
-        /// physics- and script managers have been updated.
+        /// Dispatch the trigger events queued since the last call, having
+        /// the triggers call their target scripts. This should be called
+        /// after both the physics- and script managers have been updated.
         ENGINE_API void ProcessTriggers();
 
+        /// Queue an intersection with a trigger volume to be dispatched by
+        /// ProcessTriggers.
+        /**
+         * @param trigger The trigger whose volume was intersected.
+         * @param entity The entity intersecting the volume.
+         * @param phase The phase of the intersection.
+         */
+        ENGINE_API void QueueEvent(SuperTrigger* trigger, Entity* entity, triggerEvent::Phase phase);
+
+        /// Get the events waiting to be dispatched.
+        /**
+         * @return The queued events, in the order they happened.
+         */
+        ENGINE_API const std::vector<triggerEvent::QueuedEvent>& GetQueuedEvents() const;
+
         /// Create a trigger component.
         /**
          * @return The created component.
@@ -37,10 +55,10 @@ class TriggerManager {
 
         /// Create a trigger component from JSON definition.
         /**
-         * @param node Json node from which to load component definition.
+         * @param node Scene node from which to load component definition.
          * @return The created component.
          */
-        ENGINE_API Component::Trigger* CreateTrigger(const Json::Value& node);
+        ENGINE_API Component::Trigger* CreateTrigger(const SceneNode& node);
 
         /// Add a repeating trigger to the component.
         /**
@@ -71,14 +89,29 @@ class TriggerManager {
         /// Set trigger volumes.
         ENGINE_API void InitiateVolumes();
 
+        /// Find entities and set trigger volumes for the triggers in a hierarchy.
+        /**
+         * Used when instantiating a scene so that only the newly created
+         * triggers are initialized.
+         * @param root Root entity of the hierarchy.
+         * @param identifiers Maps UIDs saved in the scene to the UIDs of the instantiated entities.
+         */
+        ENGINE_API void InitiateTriggers(Entity* root, const std::map<uint64_t, uint64_t>& identifiers);
+
         /// Remove all killed components.
         void ClearKilledComponents();
 
     private:
+        void GetTriggers(Entity* entity, std::vector<Component::Trigger*>& triggers) const;
+
         TriggerManager();
         ~TriggerManager();
         TriggerManager(const TriggerManager&) = delete;
         void operator=(const TriggerManager&) = delete;
 
         ComponentContainer<Component::Trigger> triggerComponents;
+
+        // Events are only appended and the queue is cleared after dispatch,
+        // so it stops allocating once it has grown to the busiest frame.
+        std::vector<triggerEvent::QueuedEvent> eventQueue;
 };
@@ -3,6 +3,7 @@
 #include <Utility/Log.hpp>
 #include "../Component/VRDevice.hpp"
 #include "../Entity/Entity.hpp"
+#include "../Util/SceneNode.hpp"
 
 VRManager::VRManager() : scale(1.f) {
     // Check if VR runtime is installed.
@@ -151,17 +152,17 @@ Component::VRDevice* VRManager::CreateVRDevice() {
     return vrDevices.Create();
 }
 
-Component::VRDevice* VRManager::CreateVRDevice(const Json::Value& node) {
+Component::VRDevice* VRManager::CreateVRDevice(const SceneNode& node) {
     Component::VRDevice* vrDevice = vrDevices.Create();
 
-    // Load values from Json node.
-    std::string type = node.get("type", "controller").asString();
+    // Load values from scene node.
+    std::string type = node.GetString("type", "controller");
     if (type == "controller")
         vrDevice->type = Component::VRDevice::CONTROLLER;
     else if (type == "headset")
         vrDevice->type = Component::VRDevice::HEADSET;
     
-    vrDevice->controllerID = node.get("controllerID", 1).asInt();
+    vrDevice->controllerID = node.GetInt("controllerID", 1);
 
     return vrDevice;
 }
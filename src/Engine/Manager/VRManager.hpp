@@ -9,9 +9,7 @@ namespace Component {
     class VRDevice;
 }
 
-namespace Json {
-    class Value;
-}
+class SceneNode;
 
 /// Handles communication with VR devices using OpenVR.
 class VRManager {
@@ -87,10 +85,10 @@ class VRManager {
 
         /// Create VR device component.
         /**
-         * @param node Json node to load the component from
+         * @param node Scene node to load the component from.
          * @return The created component.
          */
-        ENGINE_API Component::VRDevice* CreateVRDevice(const Json::Value& node);
+        ENGINE_API Component::VRDevice* CreateVRDevice(const SceneNode& node);
 
         /// Get all VR device components.
         /**
@@ -0,0 +1,299 @@
+#include "CpuParticleSimulator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <Utility/MemoryTracker.hpp>
+#include <Utility/Worker.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_SSE
+#include <emmintrin.h>
+#endif
+
+#ifdef USINGMEMTRACK
+#include <MemTrackInclude.hpp>
+#endif
+
+using namespace Video;
+
+namespace {
+    // Number of particles in each task handed to a thread.
+    const unsigned int TASK_SIZE = 4096;
+
+    const float GRAVITY = -9.8f;
+
+    // Number of bytes used by the state of an emitter's particles.
+    std::size_t ByteSize(const CpuParticleSimulator::Particles& particles) {
+        return particles.shot.size() * sizeof(float) * 9;
+    }
+}
+
+CpuParticleSimulator::CpuParticleSimulator(uint32_t seed) {
+    randomEngine.seed(seed);
+}
+
+CpuParticleSimulator::~CpuParticleSimulator() {
+    for (Utility::Worker* worker : workers)
+        delete worker;
+
+    for (const Emitter& emitter : emitters) {
+        if (!emitter.particles.shot.empty())
+            Utility::MemoryTracker::Free(Utility::MemoryTracker::PARTICLES, ByteSize(emitter.particles));
+    }
+}
+
+void CpuParticleSimulator::SetSeed(uint32_t seed) {
+    randomEngine.seed(seed);
+}
+
+void CpuParticleSimulator::SetThreadCount(int threadCount) {
+    this->threadCount = std::max(threadCount, 1);
+
+    while (workers.size() + 1 > static_cast<std::size_t>(this->threadCount)) {
+        delete workers.back();
+        workers.pop_back();
+    }
+    while (workers.size() + 1 < static_cast<std::size_t>(this->threadCount))
+        workers.push_back(new Utility::Worker());
+}
+
+int CpuParticleSimulator::GetThreadCount() const {
+    return threadCount;
+}
+
+unsigned int CpuParticleSimulator::AddEmitter(unsigned int particleCount) {
+    unsigned int emitter;
+    if (freeEmitters.empty()) {
+        emitter = static_cast<unsigned int>(emitters.size());
+        emitters.emplace_back();
+    } else {
+        emitter = freeEmitters.back();
+        freeEmitters.pop_back();
+        emitters[emitter] = Emitter();
+    }
+
+    Resize(emitters[emitter], particleCount);
+
+    return emitter;
+}
+
+void CpuParticleSimulator::RemoveEmitter(unsigned int emitter) {
+    if (!emitters[emitter].particles.shot.empty())
+        Utility::MemoryTracker::Free(Utility::MemoryTracker::PARTICLES, ByteSize(emitters[emitter].particles));
+
+    emitters[emitter] = Emitter();
+    freeEmitters.push_back(emitter);
+    queuedEmitters.erase(std::remove(queuedEmitters.begin(), queuedEmitters.end(), emitter), queuedEmitters.end());
+}
+
+void CpuParticleSimulator::Update(unsigned int emitter, float dt, const ParticleSystemRenderer::EmitterSettings& settings) {
+    Emitter& e = emitters[emitter];
+
+    unsigned int count = static_cast<unsigned int>(std::max(settings.nr_particles, 0));
+    if (count != e.count) {
+        Resize(e, count);
+        e.shootIndex = glm::vec2(0, 30);
+    }
+
+    e.timer += dt;
+
+    Step& step = e.step;
+    step.worldPosition = settings.worldPos;
+    step.velocity = settings.velocity;
+    step.speed = settings.velocityMultiplier;
+    step.mass = settings.mass;
+    step.alphaControl = settings.alpha_control;
+    step.lifetime = settings.lifetime;
+    step.dt = dt;
+    step.shootIndex = e.shootIndex;
+    ParticleSystemRenderer::GenerateRandomDirections(settings, randomEngine, step.randomDirections);
+
+    // Same emission schedule as the compute shader.
+    int nr_new_particles = settings.nr_new_particles;
+    e.shootIndex.y = nr_new_particles - 1.f;
+
+    if (e.timer >= settings.rate) {
+        e.shootIndex.x += nr_new_particles;
+        e.shootIndex.y = e.shootIndex.x + nr_new_particles;
+        if (e.shootIndex.y > e.count) {
+            e.shootIndex.y = static_cast<float>(nr_new_particles);
+            e.shootIndex.x = 0;
+        }
+        e.timer = 0.0f;
+    }
+
+    queuedEmitters.push_back(emitter);
+}
+
+void CpuParticleSimulator::Simulate() {
+    // Emit new particles and split the rest of the work into tasks.
+    tasks.clear();
+    for (unsigned int emitter : queuedEmitters) {
+        Emitter& e = emitters[emitter];
+        Emit(e);
+
+        unsigned int size = static_cast<unsigned int>(e.particles.shot.size());
+        for (unsigned int begin = 0; begin < size; begin += TASK_SIZE)
+            tasks.push_back({ &e, begin, std::min(begin + TASK_SIZE, size) });
+    }
+    queuedEmitters.clear();
+
+    // Particles are independent of each other, so the order tasks run in doesn't affect the result.
+    std::atomic<std::size_t> nextTask(0);
+    auto work = [this, &nextTask]() {
+        for (std::size_t task = nextTask++; task < tasks.size(); task = nextTask++)
+            Integrate(tasks[task]);
+    };
+
+    std::size_t helperCount = std::min(workers.size(), tasks.size() > 0 ? tasks.size() - 1 : 0);
+    for (std::size_t i = 0; i < helperCount; ++i)
+        workers[i]->Start(work);
+    work();
+    for (std::size_t i = 0; i < helperCount; ++i)
+        workers[i]->Wait();
+}
+
+unsigned int CpuParticleSimulator::GetParticleCount(unsigned int emitter) const {
+    return emitters[emitter].count;
+}
+
+const CpuParticleSimulator::Particles& CpuParticleSimulator::GetParticles(unsigned int emitter) const {
+    return emitters[emitter].particles;
+}
+
+void CpuParticleSimulator::Resize(Emitter& emitter, unsigned int count) {
+    emitter.count = count;
+
+    // Pad to a multiple of four so the kernels don't need a scalar tail.
+    std::size_t size = (count + 3) / 4 * 4;
+    Particles& particles = emitter.particles;
+    if (!particles.shot.empty())
+        Utility::MemoryTracker::Free(Utility::MemoryTracker::PARTICLES, ByteSize(particles));
+
+    for (std::vector<float>* array : { &particles.positionX, &particles.positionY, &particles.positionZ, &particles.velocityX, &particles.velocityY, &particles.velocityZ, &particles.life, &particles.alpha, &particles.shot })
+        array->assign(size, 0.0f);
+
+    if (size > 0)
+        Utility::MemoryTracker::Allocate(Utility::MemoryTracker::PARTICLES, ByteSize(particles));
+}
+
+void CpuParticleSimulator::Emit(Emitter& emitter) {
+    const Step& step = emitter.step;
+    Particles& particles = emitter.particles;
+
+    if (step.shootIndex.y < 0.0f)
+        return;
+
+    unsigned int first = static_cast<unsigned int>(step.shootIndex.x);
+    unsigned int last = std::min(static_cast<unsigned int>(step.shootIndex.y), emitter.count - 1);
+    for (unsigned int i = first; i <= last && i < emitter.count; ++i) {
+        glm::vec3 velocity = step.speed * (step.randomDirections[std::min(i - first, 31u)] + step.velocity);
+        particles.positionX[i] = step.worldPosition.x;
+        particles.positionY[i] = step.worldPosition.y;
+        particles.positionZ[i] = step.worldPosition.z;
+        particles.velocityX[i] = velocity.x;
+        particles.velocityY[i] = velocity.y;
+        particles.velocityZ[i] = velocity.z;
+        particles.alpha[i] = 0.7f;
+        particles.shot[i] = 1.0f;
+    }
+}
+
+void CpuParticleSimulator::Integrate(const Task& task) {
+    const Step& step = task.emitter->step;
+    Particles& particles = task.emitter->particles;
+
+    // Terms that are the same for every particle.
+    const float dt = step.dt;
+    const float fade = dt / step.alphaControl;
+    const glm::vec3 acceleration = step.velocity + step.mass * glm::vec3(0.0f, GRAVITY, 0.0f) * dt;
+    const glm::vec3 resetVelocity = step.speed * (step.randomDirections[0] + step.velocity);
+
+    float* positionX = particles.positionX.data();
+    float* positionY = particles.positionY.data();
+    float* positionZ = particles.positionZ.data();
+    float* velocityX = particles.velocityX.data();
+    float* velocityY = particles.velocityY.data();
+    float* velocityZ = particles.velocityZ.data();
+    float* life = particles.life.data();
+    float* alpha = particles.alpha.data();
+    float* shot = particles.shot.data();
+
+#ifdef PARTICLE_SSE
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 dt4 = _mm_set1_ps(dt);
+    const __m128 fade4 = _mm_set1_ps(fade);
+    const __m128 lifetime4 = _mm_set1_ps(step.lifetime);
+    const __m128 accelerationX = _mm_set1_ps(acceleration.x);
+    const __m128 accelerationY = _mm_set1_ps(acceleration.y);
+    const __m128 accelerationZ = _mm_set1_ps(acceleration.z);
+    const __m128 worldX = _mm_set1_ps(step.worldPosition.x);
+    const __m128 worldY = _mm_set1_ps(step.worldPosition.y);
+    const __m128 worldZ = _mm_set1_ps(step.worldPosition.z);
+    const __m128 resetX = _mm_set1_ps(resetVelocity.x);
+    const __m128 resetY = _mm_set1_ps(resetVelocity.y);
+    const __m128 resetZ = _mm_set1_ps(resetVelocity.z);
+
+    for (unsigned int i = task.begin; i < task.end; i += 4) {
+        __m128 s = _mm_loadu_ps(shot + i);
+        __m128 alive = _mm_cmpeq_ps(s, one);
+
+        // Move particles that have been emitted.
+        __m128 a = _mm_sub_ps(_mm_loadu_ps(alpha + i), _mm_and_ps(alive, fade4));
+        __m128 l = _mm_add_ps(_mm_loadu_ps(life + i), _mm_and_ps(alive, dt4));
+        __m128 vx = _mm_add_ps(_mm_loadu_ps(velocityX + i), _mm_and_ps(alive, accelerationX));
+        __m128 vy = _mm_add_ps(_mm_loadu_ps(velocityY + i), _mm_and_ps(alive, accelerationY));
+        __m128 vz = _mm_add_ps(_mm_loadu_ps(velocityZ + i), _mm_and_ps(alive, accelerationZ));
+        __m128 px = _mm_add_ps(_mm_loadu_ps(positionX + i), _mm_and_ps(alive, _mm_mul_ps(vx, dt4)));
+        __m128 py = _mm_add_ps(_mm_loadu_ps(positionY + i), _mm_and_ps(alive, _mm_mul_ps(vy, dt4)));
+        __m128 pz = _mm_add_ps(_mm_loadu_ps(positionZ + i), _mm_and_ps(alive, _mm_mul_ps(vz, dt4)));
+
+        // Reset particles that have outlived their lifetime.
+        __m128 dead = _mm_cmpgt_ps(l, lifetime4);
+        a = _mm_andnot_ps(dead, a);
+        l = _mm_andnot_ps(dead, l);
+        s = _mm_andnot_ps(dead, s);
+        px = _mm_or_ps(_mm_and_ps(dead, worldX), _mm_andnot_ps(dead, px));
+        py = _mm_or_ps(_mm_and_ps(dead, worldY), _mm_andnot_ps(dead, py));
+        pz = _mm_or_ps(_mm_and_ps(dead, worldZ), _mm_andnot_ps(dead, pz));
+        vx = _mm_or_ps(_mm_and_ps(dead, resetX), _mm_andnot_ps(dead, vx));
+        vy = _mm_or_ps(_mm_and_ps(dead, resetY), _mm_andnot_ps(dead, vy));
+        vz = _mm_or_ps(_mm_and_ps(dead, resetZ), _mm_andnot_ps(dead, vz));
+
+        _mm_storeu_ps(alpha + i, a);
+        _mm_storeu_ps(life + i, l);
+        _mm_storeu_ps(shot + i, s);
+        _mm_storeu_ps(positionX + i, px);
+        _mm_storeu_ps(positionY + i, py);
+        _mm_storeu_ps(positionZ + i, pz);
+        _mm_storeu_ps(velocityX + i, vx);
+        _mm_storeu_ps(velocityY + i, vy);
+        _mm_storeu_ps(velocityZ + i, vz);
+    }
+#else
+    for (unsigned int i = task.begin; i < task.end; ++i) {
+        if (shot[i] == 1.0f) {
+            alpha[i] -= fade;
+            life[i] += dt;
+            velocityX[i] += acceleration.x;
+            velocityY[i] += acceleration.y;
+            velocityZ[i] += acceleration.z;
+            positionX[i] += velocityX[i] * dt;
+            positionY[i] += velocityY[i] * dt;
+            positionZ[i] += velocityZ[i] * dt;
+        }
+
+        if (life[i] > step.lifetime) {
+            alpha[i] = 0.0f;
+            life[i] = 0.0f;
+            shot[i] = 0.0f;
+            positionX[i] = step.worldPosition.x;
+            positionY[i] = step.worldPosition.y;
+            positionZ[i] = step.worldPosition.z;
+            velocityX[i] = resetVelocity.x;
+            velocityY[i] = resetVelocity.y;
+            velocityZ[i] = resetVelocity.z;
+        }
+    }
+#endif
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Video/ParticleSystemRenderer.hpp>
+#include "../linking.hpp"
+
+namespace Utility {
+    class Worker;
+}
+
+/// Simulates particle emitters on the CPU.
+/**
+ * Alternative to the compute shader in Video::ParticleSystemRenderer that
+ * doesn't need a GL context, so effects can be simulated headlessly and
+ * tested. Particles are stored as structures of arrays and updated four at a
+ * time with SSE when it's available. Emitters can be simulated on several
+ * threads, which are created by SetThreadCount and kept between steps.
+ *
+ * All random numbers are drawn from one seedable engine in the order the
+ * emitters are updated, so the same seed and sequence of updates always gives
+ * the same particles, regardless of the number of threads.
+ */
+class CpuParticleSimulator {
+    public:
+        /// Particle state as a structure of arrays.
+        /**
+         * The arrays are padded to a multiple of four particles.
+         */
+        struct Particles {
+            std::vector<float> positionX;
+            std::vector<float> positionY;
+            std::vector<float> positionZ;
+            std::vector<float> velocityX;
+            std::vector<float> velocityY;
+            std::vector<float> velocityZ;
+            std::vector<float> life;
+            std::vector<float> alpha;
+
+            /// 1 if the particle has been emitted and is alive, otherwise 0.
+            std::vector<float> shot;
+        };
+
+        /// Create new simulator.
+        /**
+         * @param seed Seed of the random engine.
+         */
+        ENGINE_API explicit CpuParticleSimulator(uint32_t seed = 0);
+
+        /// Destructor.
+        ENGINE_API ~CpuParticleSimulator();
+
+        /// Seed the random engine.
+        /**
+         * @param seed The seed.
+         */
+        ENGINE_API void SetSeed(uint32_t seed);
+
+        /// Set the number of threads to simulate particles on.
+        /**
+         * The calling thread is one of them, the others are started here.
+         * @param threadCount The number of threads (at least 1).
+         */
+        ENGINE_API void SetThreadCount(int threadCount);
+
+        /// Get the number of threads particles are simulated on.
+        /**
+         * @return The number of threads.
+         */
+        ENGINE_API int GetThreadCount() const;
+
+        /// Add an emitter.
+        /**
+         * @param particleCount Number of particles in the emitter.
+         * @return Handle of the emitter.
+         */
+        ENGINE_API unsigned int AddEmitter(unsigned int particleCount);
+
+        /// Remove an emitter.
+        /**
+         * @param emitter Handle of the emitter to remove.
+         */
+        ENGINE_API void RemoveEmitter(unsigned int emitter);
+
+        /// Queue an emitter for simulation.
+        /**
+         * The emitter's particles are reset if the number of particles has changed.
+         * @param emitter Handle of the emitter.
+         * @param dt Deltatime.
+         * @param settings Emitter settings.
+         */
+        ENGINE_API void Update(unsigned int emitter, float dt, const Video::ParticleSystemRenderer::EmitterSettings& settings);
+
+        /// Simulate one step of all emitters queued by Update.
+        ENGINE_API void Simulate();
+
+        /// Get the number of particles in an emitter.
+        /**
+         * @param emitter Handle of the emitter.
+         * @return The number of particles.
+         */
+        ENGINE_API unsigned int GetParticleCount(unsigned int emitter) const;
+
+        /// Get the particles of an emitter.
+        /**
+         * @param emitter Handle of the emitter.
+         * @return The particle state.
+         */
+        ENGINE_API const Particles& GetParticles(unsigned int emitter) const;
+
+    private:
+        CpuParticleSimulator(const CpuParticleSimulator&) = delete;
+        void operator=(const CpuParticleSimulator&) = delete;
+
+        // Parameters of the next simulation step.
+        struct Step {
+            glm::vec3 worldPosition;
+            glm::vec3 velocity;
+            float speed;
+            float mass;
+            float alphaControl;
+            float lifetime;
+            float dt;
+            glm::vec2 shootIndex;
+            glm::vec3 randomDirections[32];
+        };
+
+        struct Emitter {
+            Particles particles;
+            unsigned int count = 0;
+            float timer = 0.0f;
+            glm::vec2 shootIndex = glm::vec2(0, 30);
+            Step step;
+        };
+
+        struct Task {
+            Emitter* emitter;
+            unsigned int begin;
+            unsigned int end;
+        };
+
+        void Resize(Emitter& emitter, unsigned int count);
+        static void Emit(Emitter& emitter);
+        static void Integrate(const Task& task);
+
+        std::mt19937 randomEngine;
+        int threadCount = 1;
+
+        std::vector<Emitter> emitters;
+        std::vector<unsigned int> freeEmitters;
+        std::vector<unsigned int> queuedEmitters;
+        std::vector<Task> tasks;
+
+        // Threads helping the calling thread, threadCount - 1 of them.
+        std::vector<Utility::Worker*> workers;
+};
@@ -0,0 +1,25 @@
+#include "MotionState.hpp"
+
+#ifdef USINGMEMTRACK
+#include <MemTrackInclude.hpp>
+#endif
+
+namespace Physics {
+    MotionState::MotionState(Component::RigidBody* rigidBody, std::vector<Component::RigidBody*>& movedBodies)
+        : btDefaultMotionState(btTransform(btQuaternion(0, 0, 0, 1), btVector3(0, 0, 0))), rigidBody(rigidBody), movedBodies(movedBodies) {
+
+    }
+
+    void MotionState::setWorldTransform(const btTransform& transform) {
+        btDefaultMotionState::setWorldTransform(transform);
+
+        if (!moved) {
+            moved = true;
+            movedBodies.push_back(rigidBody);
+        }
+    }
+
+    void MotionState::ClearMoved() {
+        moved = false;
+    }
+}
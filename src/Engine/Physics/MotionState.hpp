@@ -0,0 +1,42 @@
+#pragma once
+
+#include <LinearMath/btDefaultMotionState.h>
+#include <vector>
+
+namespace Component {
+    class RigidBody;
+}
+
+namespace Physics {
+    /// Motion state that keeps track of which rigid bodies Bullet has moved.
+    /**
+     * Bullet only updates the motion states of active dynamic bodies, so
+     * sleeping bodies are never added to the list of moved bodies.
+     * \note Intended to be used only within the physics related engine classes.
+     */
+    class MotionState : public btDefaultMotionState {
+        public:
+            BT_DECLARE_ALIGNED_ALLOCATOR();
+
+            /// Constructor.
+            /**
+             * @param rigidBody The rigid body component the motion state belongs to.
+             * @param movedBodies List to add the rigid body to when it has moved.
+             */
+            MotionState(Component::RigidBody* rigidBody, std::vector<Component::RigidBody*>& movedBodies);
+
+            /// Called by Bullet when the body has moved.
+            /**
+             * @param transform The new world transform.
+             */
+            void setWorldTransform(const btTransform& transform) override;
+
+            /// Allow the rigid body to be added to the list of moved bodies again.
+            void ClearMoved();
+
+        private:
+            Component::RigidBody* rigidBody;
+            std::vector<Component::RigidBody*>& movedBodies;
+            bool moved = false;
+    };
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+class Entity;
+
+namespace Physics {
+    /// Collision filter groups that queries can be limited to.
+    /**
+     * The values match Bullet's default collision filter groups. Kinematic
+     * bodies are placed in the static group.
+     */
+    enum QueryFilter {
+        /// Dynamic rigid bodies and ghosts.
+        QUERY_DYNAMIC = 1,
+        /// Static and kinematic rigid bodies.
+        QUERY_STATIC = 2,
+        /// All rigid bodies.
+        QUERY_DEFAULT = QUERY_DYNAMIC | QUERY_STATIC
+    };
+
+    /// A ray to cast into the physics world.
+    struct Ray {
+        /// Where the ray starts, in world space.
+        glm::vec3 origin;
+
+        /// The direction of the ray.
+        glm::vec3 direction;
+
+        /// How far to cast the ray.
+        float maxDistance;
+    };
+
+    /// The closest hit of a physics query.
+    struct QueryHit {
+        /// The entity that was hit, or nullptr if nothing was hit.
+        Entity* entity;
+
+        /// The point of the hit, in world space.
+        glm::vec3 point;
+
+        /// The surface normal at the hit point.
+        glm::vec3 normal;
+
+        /// The distance from the start of the query to the hit.
+        float distance;
+    };
+}
@@ -0,0 +1,70 @@
+#include "ShapeCache.hpp"
+
+#include <algorithm>
+
+#ifdef USINGMEMTRACK
+#include <MemTrackInclude.hpp>
+#endif
+
+namespace Physics {
+    std::shared_ptr<Shape> ShapeCache::Get(const Shape::Sphere& params) {
+        return Get({ Shape::Kind::Sphere, { params.radius, 0.0f, 0.0f, 0.0f } }, params);
+    }
+
+    std::shared_ptr<Shape> ShapeCache::Get(const Shape::Plane& params) {
+        return Get({ Shape::Kind::Plane, { params.normal.x, params.normal.y, params.normal.z, params.planeCoeff } }, params);
+    }
+
+    std::shared_ptr<Shape> ShapeCache::Get(const Shape::Box& params) {
+        return Get({ Shape::Kind::Box, { params.width, params.height, params.depth, 0.0f } }, params);
+    }
+
+    std::shared_ptr<Shape> ShapeCache::Get(const Shape::Cylinder& params) {
+        return Get({ Shape::Kind::Cylinder, { params.radius, params.length, 0.0f, 0.0f } }, params);
+    }
+
+    std::shared_ptr<Shape> ShapeCache::Get(const Shape::Cone& params) {
+        return Get({ Shape::Kind::Cone, { params.radius, params.height, 0.0f, 0.0f } }, params);
+    }
+
+    std::shared_ptr<Shape> ShapeCache::Get(const Shape::Capsule& params) {
+        return Get({ Shape::Kind::Capsule, { params.radius, params.height, 0.0f, 0.0f } }, params);
+    }
+
+    void ShapeCache::Prune() {
+        for (auto it = shapes.begin(); it != shapes.end();) {
+            if (it->second.expired())
+                it = shapes.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    std::size_t ShapeCache::GetShapeCount() const {
+        std::size_t count = 0;
+        for (auto& it : shapes) {
+            if (!it.second.expired())
+                ++count;
+        }
+
+        return count;
+    }
+
+    bool ShapeCache::Key::operator<(const Key& other) const {
+        if (kind != other.kind)
+            return kind < other.kind;
+
+        return std::lexicographical_compare(values, values + 4, other.values, other.values + 4);
+    }
+
+    template<typename Params> std::shared_ptr<Shape> ShapeCache::Get(const Key& key, const Params& params) {
+        std::weak_ptr<Shape>& cached = shapes[key];
+        std::shared_ptr<Shape> shape = cached.lock();
+        if (!shape) {
+            shape = std::shared_ptr<Shape>(new Shape(params));
+            cached = shape;
+        }
+
+        return shape;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include "Shape.hpp"
+#include "../linking.hpp"
+
+namespace Physics {
+    /// Shares shapes with identical parameters.
+    /**
+     * Shapes are handed out as shared pointers, so a shape lives as long as
+     * something uses it. The cache only holds weak references and forgets
+     * shapes once they are no longer used.
+     */
+    class ShapeCache {
+        public:
+            /// Get a sphere shape.
+            /**
+             * @param params Sphere specific parameters.
+             * @return A shape with the given parameters.
+             */
+            ENGINE_API std::shared_ptr<Shape> Get(const Shape::Sphere& params);
+
+            /// Get a plane shape.
+            /**
+             * @param params Plane specific parameters.
+             * @return A shape with the given parameters.
+             */
+            ENGINE_API std::shared_ptr<Shape> Get(const Shape::Plane& params);
+
+            /// Get a box shape.
+            /**
+             * @param params Box specific parameters.
+             * @return A shape with the given parameters.
+             */
+            ENGINE_API std::shared_ptr<Shape> Get(const Shape::Box& params);
+
+            /// Get a cylinder shape.
+            /**
+             * @param params Cylinder specific parameters.
+             * @return A shape with the given parameters.
+             */
+            ENGINE_API std::shared_ptr<Shape> Get(const Shape::Cylinder& params);
+
+            /// Get a cone shape.
+            /**
+             * @param params Cone specific parameters.
+             * @return A shape with the given parameters.
+             */
+            ENGINE_API std::shared_ptr<Shape> Get(const Shape::Cone& params);
+
+            /// Get a capsule shape.
+            /**
+             * @param params Capsule specific parameters.
+             * @return A shape with the given parameters.
+             */
+            ENGINE_API std::shared_ptr<Shape> Get(const Shape::Capsule& params);
+
+            /// Forget shapes that are no longer used.
+            ENGINE_API void Prune();
+
+            /// Get the number of shapes in use.
+            /**
+             * @return The number of distinct shapes that are still alive.
+             */
+            ENGINE_API std::size_t GetShapeCount() const;
+
+        private:
+            struct Key {
+                Shape::Kind kind;
+                float values[4];
+
+                bool operator<(const Key& other) const;
+            };
+
+            template<typename Params> std::shared_ptr<Shape> Get(const Key& key, const Params& params);
+
+            std::map<Key, std::weak_ptr<Shape>> shapes;
+    };
+}
@@ -1,5 +1,5 @@
-#include <algorithm>
 #include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionDispatch/btGhostObject.h>
 #include "../Component/RigidBody.hpp"
 #include "Shape.hpp"
 #include "Trigger.hpp"
@@ -10,28 +10,89 @@
 #endif
 
 namespace Physics {
+    namespace {
+        // Whether the objects of an overlapping pair touch, according to the
+        // contacts computed by the world's dispatcher during the last step.
+        bool IsTouching(btCollisionWorld& world, const btBroadphasePair& pair, btManifoldArray& manifolds) {
+            btBroadphasePair* collisionPair = world.getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
+            if (collisionPair == nullptr || collisionPair->m_algorithm == nullptr)
+                return false;
+
+            manifolds.resize(0);
+            collisionPair->m_algorithm->getAllContactManifolds(manifolds);
+            for (int i = 0; i < manifolds.size(); ++i) {
+                const btPersistentManifold* manifold = manifolds[i];
+                for (int j = 0; j < manifold->getNumContacts(); ++j) {
+                    if (manifold->getContactPoint(j).getDistance() <= btScalar(0))
+                        return true;
+                }
+            }
+
+            return false;
+        }
+    }
+
     Trigger::Trigger(const btTransform& transform) {
-        trigger.reset(new btCollisionObject());
+        trigger.reset(new btPairCachingGhostObject());
         trigger->setWorldTransform(transform);
+        trigger->setCollisionFlags(trigger->getCollisionFlags() | btCollisionObject::CF_NO_CONTACT_RESPONSE);
+    }
+
+    Trigger::~Trigger() {
+
     }
 
     void Trigger::Process(btCollisionWorld& world) {
-        for (auto& observer : observers) {
-            world.contactPairTest(trigger.get(), observer->GetBulletCollisionObject(), *observer);
+        updatedObservers.clear();
+
+        // The ghost object's pair cache only holds the bodies whose bounding
+        // boxes overlap the trigger, so we don't have to test every observer.
+        btManifoldArray manifolds;
+        btBroadphasePairArray& pairs = trigger->getOverlappingPairCache()->getOverlappingPairArray();
+        for (int i = 0; i < pairs.size(); ++i) {
+            const btBroadphasePair& pair = pairs[i];
+            const btCollisionObject* other = static_cast<const btCollisionObject*>(pair.m_pProxy0->m_clientObject);
+            if (other == trigger.get())
+                other = static_cast<const btCollisionObject*>(pair.m_pProxy1->m_clientObject);
+
+            auto it = observerLookup.find(other);
+            if (it == observerLookup.end())
+                continue;
+
+            if (IsTouching(world, pair, manifolds)) {
+                it->second->SetIntersecting();
+                updatedObservers.push_back(it->second);
+            }
+        }
+
+        // Observers that touched the trigger last step need to be updated
+        // too, so they can leave it.
+        for (TriggerObserver* observer : activeObservers) {
+            if (!observer->IsIntersecting())
+                updatedObservers.push_back(observer);
+        }
+
+        activeObservers.clear();
+        for (TriggerObserver* observer : updatedObservers) {
             observer->PostIntersectionTest();
+            if (observer->GetPhase() != TriggerObserver::IntersectionPhase::None)
+                activeObservers.push_back(observer);
         }
     }
 
     void Trigger::ForObserver(btCollisionObject* body, const std::function<void(TriggerObserver& observer)>& fun) {
-        auto obs = std::find_if(observers.begin(), observers.end(), [body](std::unique_ptr<Physics::TriggerObserver>& ptr) {
-            return body == ptr->GetBulletCollisionObject();
-        });
-
-        if (obs == observers.end()) {
-            obs = observers.insert(observers.end(), std::unique_ptr<TriggerObserver>(new TriggerObserver(*body)));
+        auto it = observerLookup.find(body);
+        if (it == observerLookup.end()) {
+            TriggerObserver* observer = new TriggerObserver(*body);
+            observers.push_back(std::unique_ptr<TriggerObserver>(observer));
+            it = observerLookup.insert(std::make_pair(body, observer)).first;
         }
 
-        fun(**obs);
+        fun(*it->second);
+    }
+
+    btCollisionObject* Trigger::GetCollisionObject() {
+        return trigger.get();
     }
 
     void Trigger::SetCollisionShape(std::shared_ptr<Shape> shape) {
@@ -3,9 +3,13 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include "../linking.hpp"
 
 class PhysicsManager;
+class btCollisionWorld;
+class btPairCachingGhostObject;
 
 namespace Physics {
     class Shape;
@@ -13,15 +17,23 @@ namespace Physics {
 
     /// Represent a trigger that checks intersections of specific rigid bodies
     /// against itself.
+    /**
+     * The trigger volume is a ghost object in the physics world, so the
+     * broadphase tracks which bodies overlap it. Only those bodies are
+     * tested, instead of every observer each step.
+     */
     class Trigger {
         friend class ::PhysicsManager;
 
         private:
             // Construct a trigger with world transform |transform|.
             explicit Trigger(const btTransform& transform);
+            ~Trigger();
 
             // Process observers against the trigger volume, passing the world
-            // in which rigid bodies reside.
+            // in which rigid bodies reside. Must be called after the world
+            // has been stepped, since the contacts computed during the step
+            // are used.
             void Process(btCollisionWorld& world);
 
             // Get access to a particular observer of the trigger to work with
@@ -29,12 +41,20 @@ namespace Physics {
             // will be created.
             void ForObserver(btCollisionObject* body, const std::function<void(TriggerObserver&)>& fun);
 
+            // Get the ghost object representing the trigger volume.
+            btCollisionObject* GetCollisionObject();
+
             void SetCollisionShape(std::shared_ptr<Shape> shape);
             void SetPosition(const btVector3& position);
 
         private:
-            std::unique_ptr<btCollisionObject> trigger = nullptr;
+            std::unique_ptr<btPairCachingGhostObject> trigger;
             std::shared_ptr<Shape> shape = nullptr;
             std::vector<std::unique_ptr<TriggerObserver>> observers;
+            std::unordered_map<const btCollisionObject*, TriggerObserver*> observerLookup;
+
+            // Observers that weren't in the None phase after the last step.
+            std::vector<TriggerObserver*> activeObservers;
+            std::vector<TriggerObserver*> updatedObservers;
     };
 }
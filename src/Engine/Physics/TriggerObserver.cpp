@@ -8,7 +8,7 @@
 
 namespace Physics {
     TriggerObserver::TriggerObserver(btCollisionObject& body)
-    : btCollisionWorld::ContactResultCallback(), rigidBody(body) {
+    : rigidBody(body) {
 
     }
 
@@ -20,6 +20,14 @@ namespace Physics {
         return phase;
     }
 
+    void TriggerObserver::SetIntersecting() {
+        didCallback = true;
+    }
+
+    bool TriggerObserver::IsIntersecting() const {
+        return didCallback;
+    }
+
     void TriggerObserver::PostIntersectionTest() {
         if (didCallback) {
             // Intersection happened; update phase accordingly.
@@ -113,16 +121,4 @@ namespace Physics {
     void TriggerObserver::ForgetLeave() {
         leaveHandler = nullptr;
     }
-
-    // Called with each contact for our own processing. This is where we can
-    // provide custom intersection handling.
-    btScalar TriggerObserver::addSingleResult(btManifoldPoint& cp,
-        const btCollisionObjectWrapper* colObj0, int partId0, int index0,
-        const btCollisionObjectWrapper* colObj1, int partId1, int index1) {
-
-        assert(colObj0->getCollisionObject() == &rigidBody || colObj1->getCollisionObject() == &rigidBody);
-        didCallback = true;
-
-        return 0; // Was a planned purpose, but is not used.
-    }
 }
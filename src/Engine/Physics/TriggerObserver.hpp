@@ -1,6 +1,5 @@
 #pragma once
 
-#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 #include <functional>
 #include "../linking.hpp"
 
@@ -14,7 +13,7 @@ namespace Physics {
      * always the same. If not, intersection phases may be erroneous.
      * \note Intended to be used only within the physics related engine classes.
      */
-    class TriggerObserver : public btCollisionWorld::ContactResultCallback {
+    class TriggerObserver {
         public:
             /// The type of intersection this observer has to its trigger.
             enum class IntersectionPhase {
@@ -48,6 +47,18 @@ namespace Physics {
              */
             ENGINE_API IntersectionPhase GetPhase() const;
 
+            /// Report that the observer intersects the trigger volume during
+            /// this simulation step.
+            ENGINE_API void SetIntersecting();
+
+            /// Get whether an intersection has been reported during this
+            /// simulation step.
+            /**
+             * @return Whether SetIntersecting has been called since the last
+             * call to PostIntersectionTest.
+             */
+            ENGINE_API bool IsIntersecting() const;
+
             /// Determine new intersection phase after collision test has been
             /// applied.
             ENGINE_API void PostIntersectionTest();
@@ -86,12 +97,6 @@ namespace Physics {
             ENGINE_API void ForgetLeave();
 
         private:
-            /// Overridden from btCollisionWorld::ContactResultCallback for
-            /// custom intersection handling.
-            virtual btScalar addSingleResult(btManifoldPoint& cp,
-                const btCollisionObjectWrapper* colObj0, int partId0, int index0,
-                const btCollisionObjectWrapper* colObj1, int partId1, int index1) override;
-
             IntersectionPhase phase = IntersectionPhase::None;
             btCollisionObject& rigidBody;
             // Control value to determine whether an intersection happened
@@ -4,6 +4,10 @@ namespace Json {
     class Value;
 }
 
+namespace triggerEvent {
+    struct QueuedEvent;
+}
+
 /// %Super class for triggers to inherit from.
 class SuperTrigger {
     public:
@@ -13,8 +17,11 @@ class SuperTrigger {
         /// Destructor.
         virtual ~SuperTrigger();
 
-        /// Process the trigger in case of collision.
-        virtual void Process() = 0;
+        /// Process an intersection with the trigger volume.
+        /**
+         * @param event The intersection event.
+         */
+        virtual void Process(const triggerEvent::QueuedEvent& event) = 0;
 
         /// Update position for trigger volume.
         virtual void Update() = 0;
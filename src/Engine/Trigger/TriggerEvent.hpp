@@ -0,0 +1,38 @@
+#pragma once
+
+class Entity;
+class SuperTrigger;
+
+namespace triggerEvent {
+    /// The phase of an intersection with a trigger volume.
+    /**
+     * The values match EventStruct::m_eventID.
+     */
+    enum Phase {
+        ENTER = 0, ///< The entity started intersecting the volume.
+        RETAIN, ///< The entity kept intersecting the volume.
+        LEAVE ///< The entity stopped intersecting the volume.
+    };
+
+    /// Configuration of one event of a trigger.
+    struct EventStruct {
+        int m_eventID = 0;
+        int m_shapeID = 0;
+        int m_targetID = 0;
+        int m_scriptID = 0;
+        bool check[4] = { false }; /// Simple check, should probably be replaced soon.
+    };
+
+    /// An intersection that happened during the frame, waiting to be
+    /// dispatched by the trigger manager.
+    struct QueuedEvent {
+        /// The trigger whose volume was intersected.
+        SuperTrigger* trigger;
+
+        /// The entity intersecting the volume.
+        Entity* entity;
+
+        /// The phase of the intersection.
+        Phase phase;
+    };
+}
@@ -1,11 +1,13 @@
 #include "TriggerRepeat.hpp"
 
+#include <algorithm>
 #include "../Component/RigidBody.hpp"
 #include "../Component/Shape.hpp"
 #include "../Entity/Entity.hpp"
 #include "../Manager/Managers.hpp"
 #include "../Manager/PhysicsManager.hpp"
 #include "../Manager/ScriptManager.hpp"
+#include "../Manager/TriggerManager.hpp"
 #include "../Physics/Shape.hpp"
 #include "../Hymn.hpp"
 
@@ -15,49 +17,21 @@ TriggerRepeat::TriggerRepeat() {
 }
 
 TriggerRepeat::~TriggerRepeat() {
-    /// @todo: Vector support
-    if (!collidedEntity.empty() && collidedEntity.front()->GetComponent<Component::RigidBody>()) {
-        Component::RigidBody* rigidBodyComp = collidedEntity.front()->GetComponent<Component::RigidBody>();
-        Managers().physicsManager->ForgetTriggerEnter(triggerVolume, rigidBodyComp);
-        Managers().physicsManager->ForgetTriggerRetain(triggerVolume, rigidBodyComp);
-        Managers().physicsManager->ForgetTriggerLeave(triggerVolume, rigidBodyComp);
-    }
+    Forget();
 
     Managers().physicsManager->ReleaseTriggerVolume(std::move(triggerVolume));
 }
 
-// ADD SUPPORT FOR VECTOR
 void TriggerRepeat::OnEnter() {
-    if (!collidedEntity.empty() && collidedEntity.front()->GetComponent<Component::RigidBody>()) {
-        Component::RigidBody* rigidBodyComp = collidedEntity.front()->GetComponent<Component::RigidBody>();
-        Managers().physicsManager->ForgetTriggerEnter(triggerVolume, rigidBodyComp);
-        Managers().physicsManager->ForgetTriggerRetain(triggerVolume, rigidBodyComp);
-        Managers().physicsManager->ForgetTriggerLeave(triggerVolume, rigidBodyComp);
-        Managers().physicsManager->OnTriggerEnter(triggerVolume, rigidBodyComp, std::bind(&TriggerRepeat::HandleTriggerEvent, this));
-    }
+    Listen(true, false, false);
 }
 
-// ADD SUPPORT FOR VECTOR
 void TriggerRepeat::OnRetain() {
-    if (!collidedEntity.empty() && collidedEntity.front()->GetComponent<Component::RigidBody>()) {
-        Component::RigidBody* rigidBodyComp = collidedEntity.front()->GetComponent<Component::RigidBody>();
-        Managers().physicsManager->ForgetTriggerEnter(triggerVolume, rigidBodyComp);
-        Managers().physicsManager->ForgetTriggerRetain(triggerVolume, rigidBodyComp);
-        Managers().physicsManager->ForgetTriggerLeave(triggerVolume, rigidBodyComp);
-        Managers().physicsManager->OnTriggerRetain(triggerVolume, rigidBodyComp, std::bind(&TriggerRepeat::HandleTriggerEvent, this));
-    }
+    Listen(false, true, false);
 }
 
-// ADD SUPPORT FOR VECTOR
 void TriggerRepeat::OnLeave() {
-
-    if (!collidedEntity.empty() && collidedEntity.front()->GetComponent<Component::RigidBody>()) {
-        Component::RigidBody* rigidBodyComp = collidedEntity.front()->GetComponent<Component::RigidBody>();
-        Managers().physicsManager->ForgetTriggerEnter(triggerVolume, rigidBodyComp);
-        Managers().physicsManager->ForgetTriggerRetain(triggerVolume, rigidBodyComp);
-        Managers().physicsManager->ForgetTriggerLeave(triggerVolume, rigidBodyComp);
-        Managers().physicsManager->OnTriggerLeave(triggerVolume, rigidBodyComp, std::bind(&TriggerRepeat::HandleTriggerEvent, this));
-    }
+    Listen(false, false, true);
 }
 
 const std::string& TriggerRepeat::GetName() const {
@@ -112,10 +86,6 @@ std::vector<Entity*>* TriggerRepeat::GetCollidedEntity() {
     return &collidedEntity;
 }
 
-void TriggerRepeat::HandleTriggerEvent() {
-    triggered = true;
-}
-
 std::vector<triggerEvent::EventStruct>* TriggerRepeat::GetEventVector() {
     return &eventVector;
 }
@@ -129,21 +99,38 @@ void TriggerRepeat::SetOwningEntity(Entity* value) {
 }
 
 void TriggerRepeat::InitTriggerUID() {
+    Forget();
+
+    // Missing entities are kept as nullptr so that the targets and collided
+    // entities stay aligned with the events.
+    targetEntity.clear();
+    for (uint64_t uid : targetEntityUIDs)
+        targetEntity.push_back(Hymn().GetEntityByGUID(uid));
 
-    if (Hymn().GetEntityByGUID(targetEntityUID) != nullptr)
-        targetEntity.push_back(Hymn().GetEntityByGUID(targetEntityUID));
-    if (Hymn().GetEntityByGUID(collidedEntityUID) != nullptr)
-        collidedEntity.push_back(Hymn().GetEntityByGUID(collidedEntityUID));
-    if (Hymn().GetEntityByGUID(owningEntityUID) != nullptr)
-        owningEntity = Hymn().GetEntityByGUID(owningEntityUID);
+    collidedEntity.clear();
+    for (uint64_t uid : collidedEntityUIDs)
+        collidedEntity.push_back(Hymn().GetEntityByGUID(uid));
 
+    Entity* entity = Hymn().GetEntityByGUID(owningEntityUID);
+    if (entity != nullptr)
+        owningEntity = entity;
 }
 
-void TriggerRepeat::Process() {
-    // ADD SUPPORT FOR VECTOR
-    if (triggered) {
-        Managers().scriptManager->ExecuteScriptMethod(targetEntity.front(), targetFunction.front());
-        triggered = false;
+bool TriggerRepeat::IsEventTriggered(std::size_t index, const triggerEvent::QueuedEvent& event) const {
+    if (index >= eventVector.size() || index >= targetEntity.size() || index >= targetFunction.size() || index >= collidedEntity.size())
+        return false;
+
+    const triggerEvent::EventStruct& eventStruct = eventVector[index];
+    return targetEntity[index] != nullptr && collidedEntity[index] == event.entity && eventStruct.m_eventID == event.phase && eventStruct.check[0] && eventStruct.check[1] && eventStruct.check[2] && eventStruct.check[3];
+}
+
+void TriggerRepeat::Process(const triggerEvent::QueuedEvent& event) {
+    if (owningEntity != nullptr && (owningEntity->IsKilled() || !owningEntity->IsEnabled()))
+        return;
+
+    for (std::size_t i = 0; i < eventVector.size(); ++i) {
+        if (IsEventTriggered(i, event))
+            Managers().scriptManager->ExecuteScriptMethod(targetEntity[i], targetFunction[i]);
     }
 }
 
@@ -159,22 +146,14 @@ void TriggerRepeat::Update() {
 }
 
 void TriggerRepeat::InitiateVolumes() {
-    if (GetEventVector()->front().check[0] == true &&
-        GetEventVector()->front().check[1] == true &&
-        GetEventVector()->front().check[2] == true &&
-        GetEventVector()->front().check[3] == true && GetEventVector()->front().m_eventID == 0) {
-        OnEnter();
-    } else if (GetEventVector()->front().check[0] == true &&
-        GetEventVector()->front().check[1] == true &&
-        GetEventVector()->front().check[2] == true &&
-        GetEventVector()->front().check[3] == true && GetEventVector()->front().m_eventID == 1) {
-        OnRetain();
-    } else if (GetEventVector()->front().check[0] == true &&
-        GetEventVector()->front().check[1] == true &&
-        GetEventVector()->front().check[2] == true &&
-        GetEventVector()->front().check[3] == true && GetEventVector()->front().m_eventID == 2) {
-        OnLeave();
+    // Listen to the phases that any of the events are interested in.
+    bool phases[3] = { false, false, false };
+    for (const triggerEvent::EventStruct& eventStruct : eventVector) {
+        if (eventStruct.check[0] && eventStruct.check[1] && eventStruct.check[2] && eventStruct.check[3] && eventStruct.m_eventID >= 0 && eventStruct.m_eventID < 3)
+            phases[eventStruct.m_eventID] = true;
     }
+
+    Listen(phases[triggerEvent::ENTER], phases[triggerEvent::RETAIN], phases[triggerEvent::LEAVE]);
 }
 
 Json::Value TriggerRepeat::Save() {
@@ -187,37 +166,98 @@ Json::Value TriggerRepeat::Save() {
     component["triggerCooldown"] = cooldown;
     component["triggerCharges"] = triggerCharges;
 
-    if (!targetFunction.empty())
-        component["triggerFunction"] = targetFunction.front(); // ADD SUPPORT FOR VECTOR
-    if (!targetEntity.empty())
-        component["triggerTargetEntity"] = targetEntity.front()->GetUniqueIdentifier(); // ADD SUPPORT FOR VECTOR
-
-    if (!eventVector.empty()) {
-        component["triggerEventStruct_EventID"] = eventVector.front().m_eventID; // ADD SUPPORT FOR VECTOR
-        component["triggerEventStruct_ShapeID"] = eventVector.front().m_shapeID; // ADD SUPPORT FOR VECTOR
-        component["triggerEventStruct_TargetID"] = eventVector.front().m_targetID; // ADD SUPPORT FOR VECTOR
-        component["triggerEventStruct_ScriptID"] = eventVector.front().m_scriptID; // ADD SUPPORT FOR VECTOR
-        component["triggerEventStruct_Check_0"] = eventVector.front().check[0]; // ADD SUPPORT FOR VECTOR
-        component["triggerEventStruct_Check_1"] = eventVector.front().check[1]; // ADD SUPPORT FOR VECTOR
-        component["triggerEventStruct_Check_2"] = eventVector.front().check[2]; // ADD SUPPORT FOR VECTOR
-        component["triggerEventStruct_Check_3"] = eventVector.front().check[3]; // ADD SUPPORT FOR VECTOR
-                
+    Json::Value functionsNode(Json::arrayValue);
+    for (const std::string& function : targetFunction)
+        functionsNode.append(function);
+    component["triggerFunctions"] = functionsNode;
+
+    Json::Value targetsNode(Json::arrayValue);
+    for (Entity* entity : targetEntity)
+        targetsNode.append(static_cast<Json::UInt64>(entity != nullptr ? entity->GetUniqueIdentifier() : 0));
+    component["triggerTargetEntities"] = targetsNode;
+
+    Json::Value collidedNode(Json::arrayValue);
+    for (uint64_t uid : collidedEntityUIDs)
+        collidedNode.append(static_cast<Json::UInt64>(uid));
+    component["triggerCollidedEntities"] = collidedNode;
+
+    Json::Value eventsNode(Json::arrayValue);
+    for (const triggerEvent::EventStruct& eventStruct : eventVector) {
+        Json::Value eventNode;
+        eventNode["eventID"] = eventStruct.m_eventID;
+        eventNode["shapeID"] = eventStruct.m_shapeID;
+        eventNode["targetID"] = eventStruct.m_targetID;
+        eventNode["scriptID"] = eventStruct.m_scriptID;
+        for (int i = 0; i < 4; ++i)
+            eventNode["check"].append(eventStruct.check[i]);
+        eventsNode.append(eventNode);
     }
-
-    component["triggerCollidedEntityUID"] = collidedEntityUID;
-    component["triggerTriggered"] = triggered;
+    component["triggerEvents"] = eventsNode;
 
     if (owningEntity != nullptr)
-        component["triggerOwner"] = owningEntity->GetUniqueIdentifier();
+        component["triggerOwner"] = static_cast<Json::UInt64>(owningEntity->GetUniqueIdentifier());
 
     return component;
 
 }
 
-void TriggerRepeat::SetCollidedEntityUID(int value) {
-    collidedEntityUID = value;
+void TriggerRepeat::SetCollidedEntityUID(std::size_t index, uint64_t value) {
+    if (collidedEntityUIDs.size() <= index)
+        collidedEntityUIDs.resize(index + 1, 0);
+    collidedEntityUIDs[index] = value;
+}
+
+uint64_t TriggerRepeat::GetCollidedEntityUID(std::size_t index) const {
+    return index < collidedEntityUIDs.size() ? collidedEntityUIDs[index] : 0;
+}
+
+std::vector<uint64_t>* TriggerRepeat::GetCollidedEntityUIDs() {
+    return &collidedEntityUIDs;
 }
 
-int TriggerRepeat::GetCollidedEntityUID() {
-    return collidedEntityUID;
-}
\ No newline at end of file
+void TriggerRepeat::Listen(bool enter, bool retain, bool leave) {
+    Forget();
+
+    // The handlers only capture two pointers, which fits in std::function
+    // without allocating, and queue the event for the trigger manager.
+    PhysicsManager* physicsManager = Managers().physicsManager;
+    for (Entity* entity : collidedEntity) {
+        if (entity == nullptr)
+            continue;
+
+        Component::RigidBody* rigidBodyComp = entity->GetComponent<Component::RigidBody>();
+        if (rigidBodyComp == nullptr)
+            continue;
+
+        // Several events may share a collided entity, which is only listened to once.
+        if (std::find(listenedEntityUIDs.begin(), listenedEntityUIDs.end(), entity->GetUniqueIdentifier()) != listenedEntityUIDs.end())
+            continue;
+        listenedEntityUIDs.push_back(entity->GetUniqueIdentifier());
+
+        if (enter)
+            physicsManager->OnTriggerEnter(triggerVolume, rigidBodyComp, [this, entity]() { Managers().triggerManager->QueueEvent(this, entity, triggerEvent::ENTER); });
+        if (retain)
+            physicsManager->OnTriggerRetain(triggerVolume, rigidBodyComp, [this, entity]() { Managers().triggerManager->QueueEvent(this, entity, triggerEvent::RETAIN); });
+        if (leave)
+            physicsManager->OnTriggerLeave(triggerVolume, rigidBodyComp, [this, entity]() { Managers().triggerManager->QueueEvent(this, entity, triggerEvent::LEAVE); });
+    }
+}
+
+void TriggerRepeat::Forget() {
+    // Entities may have been removed since they were listened to, so look
+    // them up again rather than using the collided entity pointers.
+    for (uint64_t uid : listenedEntityUIDs) {
+        Entity* entity = Hymn().GetEntityByGUID(uid);
+        if (entity == nullptr)
+            continue;
+
+        Component::RigidBody* rigidBodyComp = entity->GetComponent<Component::RigidBody>();
+        if (rigidBodyComp == nullptr)
+            continue;
+
+        Managers().physicsManager->ForgetTriggerEnter(triggerVolume, rigidBodyComp);
+        Managers().physicsManager->ForgetTriggerRetain(triggerVolume, rigidBodyComp);
+        Managers().physicsManager->ForgetTriggerLeave(triggerVolume, rigidBodyComp);
+    }
+    listenedEntityUIDs.clear();
+}
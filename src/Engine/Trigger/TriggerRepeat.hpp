@@ -1,31 +1,30 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <Utility/LockBox.hpp>
 #include <vector>
 #include "../linking.hpp"
 #include "SuperTrigger.hpp"
+#include "TriggerEvent.hpp"
 
 
 class Entity;
 class TriggerManager;
 
-namespace triggerEvent {
-    struct EventStruct {
-        int m_eventID = 0;
-        int m_shapeID = 0;
-        int m_targetID = 0;
-        int m_scriptID = 0;
-        bool check[4] = { false }; /// Simple check, should probably be replaced soon.
-    };
-}
-
 namespace Physics {
     class Trigger;
 }
 
 /// %Trigger that can be executed multiple times.
+/**
+ * Any number of collided entities can intersect the trigger volume. Their
+ * intersections are queued by the trigger manager and dispatched once per
+ * frame. Each event in the event vector is run by intersections of the
+ * collided entity with the same index, and runs the target function with the
+ * same index on the target entity with the same index.
+ */
 class TriggerRepeat : public SuperTrigger {
     friend class ::TriggerManager;
 
@@ -36,16 +35,19 @@ class TriggerRepeat : public SuperTrigger {
         /// Destructor.
         ENGINE_API ~TriggerRepeat();
 
-        /// Setup the trigger to listen for `enter` events on the trigger
-        /// volume, forgetting any previously set listener
+        /// Setup the trigger to listen for `enter` events of all collided
+        /// entities on the trigger volume, forgetting any previously set
+        /// listener
         ENGINE_API void OnEnter();
 
-        /// Setup the trigger to listen for `retain` events on the trigger
-        /// volume, forgetting any previously set listener
+        /// Setup the trigger to listen for `retain` events of all collided
+        /// entities on the trigger volume, forgetting any previously set
+        /// listener
         ENGINE_API void OnRetain();
 
-        /// Setup the trigger to listen for `leave` events on the trigger
-        /// volume, forgetting any previously set listener
+        /// Setup the trigger to listen for `leave` events of all collided
+        /// entities on the trigger volume, forgetting any previously set
+        /// listener
         ENGINE_API void OnLeave();
 
         /// Get the name of the trigger.
@@ -122,6 +124,7 @@ class TriggerRepeat : public SuperTrigger {
 
         /// Vector containing collided entities.
         /**
+         * Aligned with the events, with nullptr for missing entities.
          * @return Pointer to the vector containing collided entities.
          */
         ENGINE_API std::vector<Entity*>* GetCollidedEntity();
@@ -144,8 +147,19 @@ class TriggerRepeat : public SuperTrigger {
          */
         ENGINE_API void SetOwningEntity(Entity* value);
 
-        /// Process the trigger in case of collision.
-        ENGINE_API void Process() override;
+        /// Get whether an intersection runs an event.
+        /**
+         * @param index Index of the event.
+         * @param event The intersection event.
+         * @return Whether the intersection is of the event's collided entity and phase, and the event is fully set up.
+         */
+        ENGINE_API bool IsEventTriggered(std::size_t index, const triggerEvent::QueuedEvent& event) const;
+
+        /// Run the target functions of the events matching an intersection.
+        /**
+         * @param event The intersection event.
+         */
+        ENGINE_API void Process(const triggerEvent::QueuedEvent& event) override;
 
         /// Update position for trigger volume.
         ENGINE_API void Update() override;
@@ -162,20 +176,30 @@ class TriggerRepeat : public SuperTrigger {
         /// Initialize trigger volumes.
         ENGINE_API void InitiateVolumes() override;
 
-        /// Set UID for this triggers collided entity.
+        /// Set the UID of the collided entity of an event.
         /**
-         * @param value Set UID for collided entity.
+         * Takes effect when the entity references are initialized (see InitTriggerUID).
+         * @param index Index of the event.
+         * @param value UID of the entity whose intersections run the event.
          */
-        ENGINE_API void SetCollidedEntityUID(int value);
+        ENGINE_API void SetCollidedEntityUID(std::size_t index, uint64_t value);
 
-        /// Get UID for this triggers collided entity.
+        /// Get the UID of the collided entity of an event.
         /**
-         * @return int unique identifier for collided entity.
+         * @param index Index of the event.
+         * @return Unique identifier for collided entity, or 0 if there is none.
          */
-        ENGINE_API int GetCollidedEntityUID();
+        ENGINE_API uint64_t GetCollidedEntityUID(std::size_t index) const;
+
+        /// Vector containing the UIDs of the collided entities.
+        /**
+         * @return Pointer to the vector containing collided entity UIDs.
+         */
+        ENGINE_API std::vector<uint64_t>* GetCollidedEntityUIDs();
 
     private:
-        void HandleTriggerEvent();
+        void Listen(bool enter, bool retain, bool leave);
+        void Forget();
 
         std::string name = "New Trigger";
         bool startActive = false;
@@ -187,10 +211,12 @@ class TriggerRepeat : public SuperTrigger {
         std::vector<Entity*> collidedEntity;
         std::vector<triggerEvent::EventStruct> eventVector;
         Utility::LockBox<Physics::Trigger> triggerVolume;
-        bool triggered = false;
         Entity* owningEntity = nullptr;
 
-        int targetEntityUID = 0;
-        int collidedEntityUID = 0;
-        int owningEntityUID = 0;
+        std::vector<uint64_t> targetEntityUIDs;
+        std::vector<uint64_t> collidedEntityUIDs;
+        uint64_t owningEntityUID = 0;
+
+        // UIDs of the collided entities the trigger volume has handlers for.
+        std::vector<uint64_t> listenedEntityUIDs;
 };
@@ -0,0 +1,783 @@
+#include "BinaryScene.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include <json/json.h>
+
+namespace BinaryScene {
+    const uint16_t VERSION = 2;
+    const char* const EXTENSION = ".hysc";
+
+    namespace {
+        const char MAGIC[4] = { 'H', 'Y', 'S', 'C' };
+        const std::size_t HEADER_SIZE = 8;
+
+        // Value tags.
+        enum Tag : uint8_t {
+            TAG_NULL = 0,
+            TAG_FALSE,
+            TAG_TRUE,
+            TAG_INT,
+            TAG_UINT,
+            TAG_FLOAT,
+            TAG_DOUBLE,
+            TAG_STRING,
+            TAG_ARRAY,
+            TAG_OBJECT,
+            TAG_VEC2,
+            TAG_VEC3,
+            TAG_QUAT,
+            TAG_BYTES
+        };
+
+        // Keys of the objects stored as raw floats, in storage order.
+        const char* const VEC2_KEYS[] = { "x", "y" };
+        const char* const VEC3_KEYS[] = { "x", "y", "z" };
+        const char* const QUAT_KEYS[] = { "w", "x", "y", "z" };
+
+        bool IsExactFloat(const Json::Value& value) {
+            if (value.type() != Json::realValue)
+                return false;
+            double d = value.asDouble();
+            return static_cast<double>(static_cast<float>(d)) == d;
+        }
+
+        bool IsFloatObject(const Json::Value& value, const char* const keys[], unsigned int count) {
+            if (value.size() != count)
+                return false;
+            for (unsigned int i = 0; i < count; ++i) {
+                if (!value.isMember(keys[i]) || !IsExactFloat(value[keys[i]]))
+                    return false;
+            }
+            return true;
+        }
+
+        bool IsByteArray(const Json::Value& value) {
+            if (value.empty())
+                return false;
+            for (const Json::Value& element : value) {
+                if (element.type() != Json::intValue || element.asInt() < 0 || element.asInt() > 255)
+                    return false;
+            }
+            return true;
+        }
+
+        class Writer {
+            public:
+                void Write(const Json::Value& root, std::string& out) {
+                    CollectStrings(root);
+
+                    out.append(MAGIC, sizeof(MAGIC));
+                    WriteFixed(out, VERSION, 2);
+                    WriteFixed(out, 0, 2);
+
+                    WriteVarint(out, strings.size());
+                    for (const std::string* string : strings) {
+                        WriteVarint(out, string->size());
+                        out.append(*string);
+                    }
+
+                    WriteValue(out, root);
+                }
+
+            private:
+                void AddString(const std::string& string) {
+                    if (stringIndices.find(string) == stringIndices.end()) {
+                        auto it = stringIndices.emplace(string, static_cast<uint64_t>(strings.size())).first;
+                        strings.push_back(&it->first);
+                    }
+                }
+
+                void CollectStrings(const Json::Value& value) {
+                    switch (value.type()) {
+                    case Json::stringValue:
+                        AddString(value.asString());
+                        break;
+                    case Json::arrayValue:
+                        for (const Json::Value& element : value)
+                            CollectStrings(element);
+                        break;
+                    case Json::objectValue:
+                        if (IsFloatObject(value, VEC2_KEYS, 2) || IsFloatObject(value, VEC3_KEYS, 3) || IsFloatObject(value, QUAT_KEYS, 4))
+                            break;
+                        for (auto it = value.begin(); it != value.end(); ++it) {
+                            AddString(it.name());
+                            CollectStrings(*it);
+                        }
+                        break;
+                    default:
+                        break;
+                    }
+                }
+
+                static void WriteFixed(std::string& out, uint64_t value, unsigned int bytes) {
+                    for (unsigned int i = 0; i < bytes; ++i)
+                        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+                }
+
+                static void WriteVarint(std::string& out, uint64_t value) {
+                    while (value >= 0x80) {
+                        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                        value >>= 7;
+                    }
+                    out.push_back(static_cast<char>(value));
+                }
+
+                // Reserve room for the byte size of an array or object, filled in by EndSized.
+                static std::size_t BeginSized(std::string& out) {
+                    out.append(4, '\0');
+                    return out.size();
+                }
+
+                static void EndSized(std::string& out, std::size_t start) {
+                    uint64_t size = out.size() - start;
+                    for (unsigned int i = 0; i < 4; ++i)
+                        out[start - 4 + i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+                }
+
+                static void WriteFloat(std::string& out, float value) {
+                    uint32_t bits;
+                    std::memcpy(&bits, &value, sizeof(bits));
+                    WriteFixed(out, bits, 4);
+                }
+
+                void WriteFloats(std::string& out, Tag tag, const Json::Value& value, const char* const keys[], unsigned int count) {
+                    out.push_back(static_cast<char>(tag));
+                    for (unsigned int i = 0; i < count; ++i)
+                        WriteFloat(out, value[keys[i]].asFloat());
+                }
+
+                void WriteValue(std::string& out, const Json::Value& value) {
+                    switch (value.type()) {
+                    case Json::nullValue:
+                        out.push_back(static_cast<char>(TAG_NULL));
+                        break;
+                    case Json::booleanValue:
+                        out.push_back(static_cast<char>(value.asBool() ? TAG_TRUE : TAG_FALSE));
+                        break;
+                    case Json::intValue: {
+                        // Zigzag encode so small negative numbers stay small.
+                        int64_t i = value.asInt64();
+                        out.push_back(static_cast<char>(TAG_INT));
+                        WriteVarint(out, (static_cast<uint64_t>(i) << 1) ^ static_cast<uint64_t>(i >> 63));
+                        break;
+                    }
+                    case Json::uintValue:
+                        out.push_back(static_cast<char>(TAG_UINT));
+                        WriteVarint(out, value.asUInt64());
+                        break;
+                    case Json::realValue:
+                        if (IsExactFloat(value)) {
+                            out.push_back(static_cast<char>(TAG_FLOAT));
+                            WriteFloat(out, value.asFloat());
+                        } else {
+                            double d = value.asDouble();
+                            uint64_t bits;
+                            std::memcpy(&bits, &d, sizeof(bits));
+                            out.push_back(static_cast<char>(TAG_DOUBLE));
+                            WriteFixed(out, bits, 8);
+                        }
+                        break;
+                    case Json::stringValue:
+                        out.push_back(static_cast<char>(TAG_STRING));
+                        WriteVarint(out, stringIndices[value.asString()]);
+                        break;
+                    case Json::arrayValue:
+                        if (IsByteArray(value)) {
+                            out.push_back(static_cast<char>(TAG_BYTES));
+                            WriteVarint(out, value.size());
+                            for (const Json::Value& element : value)
+                                out.push_back(static_cast<char>(element.asInt()));
+                        } else {
+                            out.push_back(static_cast<char>(TAG_ARRAY));
+                            WriteVarint(out, value.size());
+                            std::size_t start = BeginSized(out);
+                            for (const Json::Value& element : value)
+                                WriteValue(out, element);
+                            EndSized(out, start);
+                        }
+                        break;
+                    case Json::objectValue:
+                        if (IsFloatObject(value, VEC2_KEYS, 2)) {
+                            WriteFloats(out, TAG_VEC2, value, VEC2_KEYS, 2);
+                        } else if (IsFloatObject(value, VEC3_KEYS, 3)) {
+                            WriteFloats(out, TAG_VEC3, value, VEC3_KEYS, 3);
+                        } else if (IsFloatObject(value, QUAT_KEYS, 4)) {
+                            WriteFloats(out, TAG_QUAT, value, QUAT_KEYS, 4);
+                        } else {
+                            out.push_back(static_cast<char>(TAG_OBJECT));
+                            WriteVarint(out, value.size());
+                            std::size_t start = BeginSized(out);
+                            for (auto it = value.begin(); it != value.end(); ++it) {
+                                WriteVarint(out, stringIndices[it.name()]);
+                                WriteValue(out, *it);
+                            }
+                            EndSized(out, start);
+                        }
+                        break;
+                    }
+                }
+
+                std::unordered_map<std::string, uint64_t> stringIndices;
+                std::vector<const std::string*> strings;
+        };
+    }
+
+    const uint32_t Reader::NO_STRING;
+    const std::size_t Reader::NO_VALUE;
+
+    Reader::Reader() {
+
+    }
+
+    bool Reader::Open(const char* data, std::size_t length) {
+        this->data = reinterpret_cast<const uint8_t*>(data);
+        this->length = length;
+        open = false;
+        strings.clear();
+        stringIndices.clear();
+
+        if (!IsBinary(data, length))
+            return false;
+        std::size_t position = sizeof(MAGIC);
+
+        uint64_t version;
+        uint64_t flags;
+        if (!ReadFixed(position, version, 2) || !ReadFixed(position, flags, 2) || version > VERSION)
+            return false;
+        hasSizes = version >= 2;
+
+        uint64_t stringCount;
+        if (!ReadVarint(position, stringCount) || stringCount > length)
+            return false;
+        strings.reserve(static_cast<std::size_t>(stringCount));
+        for (uint64_t i = 0; i < stringCount; ++i) {
+            uint64_t stringLength;
+            if (!ReadVarint(position, stringLength) || stringLength > length - position)
+                return false;
+            strings.emplace_back(reinterpret_cast<const char*>(this->data + position), static_cast<std::size_t>(stringLength));
+            stringIndices.emplace(strings.back(), static_cast<uint32_t>(i));
+            position += static_cast<std::size_t>(stringLength);
+        }
+
+        root = position;
+        open = Validate(position, 0) && position == length;
+        return open;
+    }
+
+    bool Reader::IsOpen() const {
+        return open;
+    }
+
+    std::size_t Reader::GetRoot() const {
+        return root;
+    }
+
+    uint32_t Reader::FindString(const std::string& string) const {
+        auto it = stringIndices.find(string);
+        return it != stringIndices.end() ? it->second : NO_STRING;
+    }
+
+    const std::string& Reader::GetString(uint32_t index) const {
+        return strings[index];
+    }
+
+    uint32_t Reader::GetCount(std::size_t value) const {
+        if (data[value] != TAG_ARRAY && data[value] != TAG_OBJECT)
+            return 0;
+
+        std::size_t position = value + 1;
+        uint64_t count;
+        ReadVarint(position, count);
+        return static_cast<uint32_t>(count);
+    }
+
+    std::size_t Reader::GetFirst(std::size_t value) const {
+        std::size_t position = value + 1;
+        uint64_t count;
+        ReadVarint(position, count);
+        return hasSizes ? position + 4 : position;
+    }
+
+    std::size_t Reader::GetNext(std::size_t value) const {
+        std::size_t position = value;
+        uint8_t tag = data[position++];
+        uint64_t count;
+        switch (tag) {
+        case TAG_INT:
+        case TAG_UINT:
+        case TAG_STRING:
+            ReadVarint(position, count);
+            return position;
+        case TAG_FLOAT:
+            return position + 4;
+        case TAG_DOUBLE:
+            return position + 8;
+        case TAG_VEC2:
+            return position + 8;
+        case TAG_VEC3:
+            return position + 12;
+        case TAG_QUAT:
+            return position + 16;
+        case TAG_BYTES:
+            ReadVarint(position, count);
+            return position + static_cast<std::size_t>(count);
+        case TAG_ARRAY:
+        case TAG_OBJECT: {
+            ReadVarint(position, count);
+            if (hasSizes) {
+                uint64_t size;
+                ReadFixed(position, size, 4);
+                return position + static_cast<std::size_t>(size);
+            }
+
+            // Older files have to be walked.
+            for (uint64_t i = 0; i < count; ++i) {
+                if (tag == TAG_OBJECT)
+                    position = GetMember(position).value;
+                position = GetNext(position);
+            }
+            return position;
+        }
+        default:
+            return position;
+        }
+    }
+
+    Reader::Member Reader::GetMember(std::size_t position) const {
+        uint64_t key;
+        ReadVarint(position, key);
+
+        Member member;
+        member.key = static_cast<uint32_t>(key);
+        member.value = position;
+        return member;
+    }
+
+    std::size_t Reader::FindMember(std::size_t object, uint32_t key) const {
+        if (!IsObject(object) || key == NO_STRING)
+            return NO_VALUE;
+
+        uint32_t count = GetCount(object);
+
+        std::size_t position = GetFirst(object);
+        for (uint32_t i = 0; i < count; ++i) {
+            Member member = GetMember(position);
+            if (member.key == key)
+                return member.value;
+            position = GetNext(member.value);
+        }
+
+        return NO_VALUE;
+    }
+
+    bool Reader::IsNull(std::size_t value) const {
+        return value == NO_VALUE || data[value] == TAG_NULL;
+    }
+
+    bool Reader::IsObject(std::size_t value) const {
+        return value != NO_VALUE && data[value] == TAG_OBJECT;
+    }
+
+    bool Reader::IsArray(std::size_t value) const {
+        return value != NO_VALUE && data[value] == TAG_ARRAY;
+    }
+
+    bool Reader::GetBool(std::size_t value) const {
+        if (value == NO_VALUE)
+            return false;
+
+        std::size_t position = value + 1;
+        uint64_t integer;
+        switch (data[value]) {
+        case TAG_TRUE:
+            return true;
+        case TAG_INT:
+        case TAG_UINT:
+            ReadVarint(position, integer);
+            return integer != 0;
+        case TAG_FLOAT:
+            return ReadFloat(position) != 0.0f;
+        case TAG_DOUBLE:
+            ReadFixed(position, integer, 8);
+            return (integer << 1) != 0;
+        default:
+            return false;
+        }
+    }
+
+    uint64_t Reader::GetUInt64(std::size_t value) const {
+        if (value == NO_VALUE)
+            return 0;
+
+        std::size_t position = value + 1;
+        uint64_t integer;
+        switch (data[value]) {
+        case TAG_INT:
+            // Zigzag encoded, negative numbers have the lowest bit set.
+            ReadVarint(position, integer);
+            return (integer & 1) == 0 ? integer >> 1 : 0;
+        case TAG_UINT:
+            ReadVarint(position, integer);
+            return integer;
+        default:
+            return 0;
+        }
+    }
+
+    int64_t Reader::GetInt64(std::size_t value) const {
+        if (value == NO_VALUE)
+            return 0;
+
+        std::size_t position = value + 1;
+        uint64_t integer;
+        switch (data[value]) {
+        case TAG_TRUE:
+            return 1;
+        case TAG_INT:
+            ReadVarint(position, integer);
+            return static_cast<int64_t>((integer >> 1) ^ (~(integer & 1) + 1));
+        case TAG_UINT:
+            ReadVarint(position, integer);
+            return static_cast<int64_t>(integer);
+        case TAG_FLOAT:
+        case TAG_DOUBLE:
+            return static_cast<int64_t>(GetDouble(value));
+        default:
+            return 0;
+        }
+    }
+
+    double Reader::GetDouble(std::size_t value) const {
+        if (value == NO_VALUE)
+            return 0.0;
+
+        std::size_t position = value + 1;
+        uint64_t bits;
+        double d;
+        switch (data[value]) {
+        case TAG_TRUE:
+            return 1.0;
+        case TAG_INT:
+            return static_cast<double>(GetInt64(value));
+        case TAG_UINT:
+            return static_cast<double>(GetUInt64(value));
+        case TAG_FLOAT:
+            return static_cast<double>(ReadFloat(position));
+        case TAG_DOUBLE:
+            ReadFixed(position, bits, 8);
+            std::memcpy(&d, &bits, sizeof(d));
+            return d;
+        default:
+            return 0.0;
+        }
+    }
+
+    const std::string* Reader::GetStringValue(std::size_t value) const {
+        if (value == NO_VALUE || data[value] != TAG_STRING)
+            return nullptr;
+
+        std::size_t position = value + 1;
+        uint64_t index;
+        ReadVarint(position, index);
+        return &strings[static_cast<std::size_t>(index)];
+    }
+
+    bool Reader::GetVec3(std::size_t value, glm::vec3& vector) const {
+        if (value == NO_VALUE || data[value] != TAG_VEC3)
+            return false;
+
+        std::size_t position = value + 1;
+        vector.x = ReadFloat(position);
+        vector.y = ReadFloat(position);
+        vector.z = ReadFloat(position);
+        return true;
+    }
+
+    bool Reader::GetQuaternion(std::size_t value, glm::quat& quaternion) const {
+        if (value == NO_VALUE || data[value] != TAG_QUAT)
+            return false;
+
+        // Stored in the order of QUAT_KEYS.
+        std::size_t position = value + 1;
+        quaternion.w = ReadFloat(position);
+        quaternion.x = ReadFloat(position);
+        quaternion.y = ReadFloat(position);
+        quaternion.z = ReadFloat(position);
+        return true;
+    }
+
+    const uint8_t* Reader::GetBytes(std::size_t value, std::size_t& count) const {
+        count = 0;
+        if (value == NO_VALUE || data[value] != TAG_BYTES)
+            return nullptr;
+
+        std::size_t position = value + 1;
+        uint64_t size;
+        ReadVarint(position, size);
+        count = static_cast<std::size_t>(size);
+        return data + position;
+    }
+
+    void Reader::Decode(std::size_t value, Json::Value& result) const {
+        if (value == NO_VALUE) {
+            result = Json::Value();
+            return;
+        }
+
+        std::size_t position = value + 1;
+        uint8_t tag = data[value];
+        switch (tag) {
+        case TAG_NULL:
+            result = Json::Value();
+            break;
+        case TAG_FALSE:
+        case TAG_TRUE:
+            result = Json::Value(tag == TAG_TRUE);
+            break;
+        case TAG_INT: {
+            uint64_t zigzag;
+            ReadVarint(position, zigzag);
+            result = Json::Value(static_cast<Json::Int64>((zigzag >> 1) ^ (~(zigzag & 1) + 1)));
+            break;
+        }
+        case TAG_UINT: {
+            uint64_t u;
+            ReadVarint(position, u);
+            result = Json::Value(static_cast<Json::UInt64>(u));
+            break;
+        }
+        case TAG_FLOAT:
+            result = Json::Value(static_cast<double>(ReadFloat(position)));
+            break;
+        case TAG_DOUBLE: {
+            uint64_t bits;
+            ReadFixed(position, bits, 8);
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            result = Json::Value(d);
+            break;
+        }
+        case TAG_STRING:
+            result = Json::Value(*GetStringValue(value));
+            break;
+        case TAG_ARRAY: {
+            uint32_t count = GetCount(value);
+            result = Json::Value(Json::arrayValue);
+            result.resize(count);
+            std::size_t element = count > 0 ? GetFirst(value) : 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                Decode(element, result[i]);
+                element = GetNext(element);
+            }
+            break;
+        }
+        case TAG_OBJECT: {
+            uint32_t count = GetCount(value);
+            result = Json::Value(Json::objectValue);
+            std::size_t memberPosition = count > 0 ? GetFirst(value) : 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                Member member = GetMember(memberPosition);
+                Decode(member.value, result[strings[member.key]]);
+                memberPosition = GetNext(member.value);
+            }
+            break;
+        }
+        case TAG_VEC2:
+            ReadFloats(position, result, VEC2_KEYS, 2);
+            break;
+        case TAG_VEC3:
+            ReadFloats(position, result, VEC3_KEYS, 3);
+            break;
+        case TAG_QUAT:
+            ReadFloats(position, result, QUAT_KEYS, 4);
+            break;
+        case TAG_BYTES: {
+            uint64_t count;
+            ReadVarint(position, count);
+            result = Json::Value(Json::arrayValue);
+            result.resize(static_cast<Json::ArrayIndex>(count));
+            for (uint64_t i = 0; i < count; ++i)
+                result[static_cast<Json::ArrayIndex>(i)] = static_cast<int>(data[position++]);
+            break;
+        }
+        }
+    }
+
+    bool Reader::ReadFixed(std::size_t& position, uint64_t& value, unsigned int bytes) const {
+        if (length - position < bytes)
+            return false;
+        value = 0;
+        for (unsigned int i = 0; i < bytes; ++i)
+            value |= static_cast<uint64_t>(data[position++]) << (8 * i);
+        return true;
+    }
+
+    bool Reader::ReadVarint(std::size_t& position, uint64_t& value) const {
+        value = 0;
+        for (unsigned int shift = 0; shift < 64; shift += 7) {
+            if (position >= length)
+                return false;
+            uint8_t byte = data[position++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    float Reader::ReadFloat(std::size_t& position) const {
+        uint64_t bits;
+        ReadFixed(position, bits, 4);
+        uint32_t bits32 = static_cast<uint32_t>(bits);
+        float f;
+        std::memcpy(&f, &bits32, sizeof(f));
+        return f;
+    }
+
+    bool Reader::Validate(std::size_t& position, unsigned int depth) const {
+        // Guard against stack overflows from malicious or corrupt files.
+        if (depth > 512 || position >= length)
+            return false;
+
+        uint8_t tag = data[position++];
+        uint64_t value;
+        switch (tag) {
+        case TAG_NULL:
+        case TAG_FALSE:
+        case TAG_TRUE:
+            return true;
+        case TAG_INT:
+        case TAG_UINT:
+            return ReadVarint(position, value);
+        case TAG_STRING:
+            return ReadVarint(position, value) && value < strings.size();
+        case TAG_FLOAT:
+            return ReadFixed(position, value, 4);
+        case TAG_DOUBLE:
+            return ReadFixed(position, value, 8);
+        case TAG_VEC2:
+        case TAG_VEC3:
+        case TAG_QUAT: {
+            std::size_t size = tag == TAG_VEC2 ? 8 : (tag == TAG_VEC3 ? 12 : 16);
+            if (length - position < size)
+                return false;
+            position += size;
+            return true;
+        }
+        case TAG_BYTES:
+            if (!ReadVarint(position, value) || value > length - position)
+                return false;
+            position += static_cast<std::size_t>(value);
+            return true;
+        case TAG_ARRAY:
+        case TAG_OBJECT: {
+            uint64_t count;
+            if (!ReadVarint(position, count) || count > length - position)
+                return false;
+
+            uint64_t size = 0;
+            if (hasSizes && !ReadFixed(position, size, 4))
+                return false;
+            std::size_t start = position;
+
+            for (uint64_t i = 0; i < count; ++i) {
+                if (tag == TAG_OBJECT && (!ReadVarint(position, value) || value >= strings.size()))
+                    return false;
+                if (!Validate(position, depth + 1))
+                    return false;
+            }
+
+            return !hasSizes || position - start == size;
+        }
+        default:
+            return false;
+        }
+    }
+
+    void Reader::ReadFloats(std::size_t position, Json::Value& value, const char* const keys[], unsigned int count) const {
+        value = Json::Value(Json::objectValue);
+        for (unsigned int i = 0; i < count; ++i)
+            value[keys[i]] = ReadFloat(position);
+    }
+
+    bool IsBinary(const char* data, std::size_t length) {
+        return length >= HEADER_SIZE && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+    }
+
+    std::string Write(const Json::Value& value) {
+        std::string out;
+        Writer writer;
+        writer.Write(value, out);
+        return out;
+    }
+
+    bool Read(const char* data, std::size_t length, Json::Value& value) {
+        Reader reader;
+        if (!reader.Open(data, length))
+            return false;
+
+        reader.Decode(reader.GetRoot(), value);
+        return true;
+    }
+
+    bool Parse(const std::string& data, Json::Value& value) {
+        if (IsBinary(data.data(), data.size()))
+            return Read(data.data(), data.size(), value);
+
+        std::istringstream stream(data);
+        try {
+            stream >> value;
+        } catch (const std::exception&) {
+            return false;
+        }
+        return true;
+    }
+
+    bool ReadFile(const std::string& filename, std::string& data) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file)
+            return false;
+
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    std::string FindSceneFile(const std::string& path) {
+        std::string filename = path + EXTENSION;
+        if (std::ifstream(filename, std::ios::binary))
+            return filename;
+
+        return path + ".json";
+    }
+
+    bool LoadFile(const std::string& filename, Json::Value& value) {
+        std::string data;
+        return ReadFile(filename, data) && Parse(data, value);
+    }
+
+    bool SaveFile(const std::string& filename, const Json::Value& value, bool binary) {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file)
+            return false;
+
+        if (binary) {
+            std::string data = Write(value);
+            file.write(data.data(), data.size());
+        } else {
+            file << value;
+        }
+
+        return static_cast<bool>(file);
+    }
+
+    bool Convert(const std::string& source, const std::string& destination, bool binary) {
+        Json::Value value;
+        return LoadFile(source, value) && SaveFile(destination, value, binary);
+    }
+}
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "../linking.hpp"
+
+namespace Json {
+    class Value;
+}
+
+/// Compact binary encoding of scene files.
+/**
+ * Scenes are stored as the same tree of values as the JSON scene files, so
+ * converting between the two formats is lossless. The binary file starts
+ * with a magic number and a format version, followed by a table of all
+ * strings (object keys and string values) and the tagged value tree.
+ * Vectors and quaternions are stored as raw floats and script property maps
+ * as raw byte blobs, instead of as nested objects and arrays. Objects and
+ * arrays store their size in bytes, so a Reader can skip over them without
+ * decoding them.
+ *
+ * Binary scenes use their own file extension (see EXTENSION).
+ */
+namespace BinaryScene {
+    /// The version of the format written by Write.
+    ENGINE_API extern const uint16_t VERSION;
+
+    /// File extension of binary scenes, including the dot.
+    ENGINE_API extern const char* const EXTENSION;
+
+    /// Reads values of a binary scene in place, without decoding them into a value tree.
+    /**
+     * Values are referred to by their offset in the data. The whole value tree is
+     * validated when the data is opened, so it can be navigated without checks.
+     */
+    class Reader {
+        public:
+            /// Member of an object.
+            struct Member {
+                /// Index of the member's key in the string table.
+                uint32_t key;
+
+                /// Offset of the member's value.
+                std::size_t value;
+            };
+
+            /// Returned by FindString for strings that aren't in the string table.
+            static const uint32_t NO_STRING = 0xFFFFFFFFu;
+
+            /// Returned by FindMember for members that don't exist.
+            static const std::size_t NO_VALUE = static_cast<std::size_t>(-1);
+
+            /// Create new reader without data.
+            ENGINE_API Reader();
+
+            /// Open binary scene data.
+            /**
+             * The data has to stay alive for as long as the reader is used.
+             * @param data The encoded data.
+             * @param length The length of the encoded data.
+             * @return Whether the data is a valid binary scene.
+             */
+            ENGINE_API bool Open(const char* data, std::size_t length);
+
+            /// Get whether valid data has been opened.
+            /**
+             * @return Whether the reader can be used.
+             */
+            ENGINE_API bool IsOpen() const;
+
+            /// Get the root value.
+            /**
+             * @return Offset of the root value.
+             */
+            ENGINE_API std::size_t GetRoot() const;
+
+            /// Find a string in the string table.
+            /**
+             * Keys can be looked up once and then compared to the keys of members.
+             * @param string The string to find.
+             * @return The index of the string or NO_STRING if the scene doesn't contain it.
+             */
+            ENGINE_API uint32_t FindString(const std::string& string) const;
+
+            /// Get a string from the string table.
+            /**
+             * @param index Index of the string.
+             * @return The string.
+             */
+            ENGINE_API const std::string& GetString(uint32_t index) const;
+
+            /// Get the number of members of an object or elements of an array.
+            /**
+             * @param value Offset of the value.
+             * @return The number of members or elements, or 0 if the value isn't an object or array.
+             */
+            ENGINE_API uint32_t GetCount(std::size_t value) const;
+
+            /// Get the first element of an array or member of an object.
+            /**
+             * Use GetNext to get the following ones, and GetMember to read members.
+             * @param value Offset of the array or object, which must not be empty.
+             * @return Offset of the first element or member.
+             */
+            ENGINE_API std::size_t GetFirst(std::size_t value) const;
+
+            /// Skip past a value.
+            /**
+             * @param value Offset of the value.
+             * @return Offset of the next element or member.
+             */
+            ENGINE_API std::size_t GetNext(std::size_t value) const;
+
+            /// Read a member of an object.
+            /**
+             * @param position Offset of the member, from GetFirst or GetNext.
+             * @return The member.
+             */
+            ENGINE_API Member GetMember(std::size_t position) const;
+
+            /// Find a member of an object.
+            /**
+             * @param object Offset of the object.
+             * @param key Index of the key, from FindString.
+             * @return Offset of the member's value or NO_VALUE if there is no such member.
+             */
+            ENGINE_API std::size_t FindMember(std::size_t object, uint32_t key) const;
+
+            /// Get whether a value is null.
+            /**
+             * @param value Offset of the value, or NO_VALUE.
+             * @return Whether the value is null or NO_VALUE.
+             */
+            ENGINE_API bool IsNull(std::size_t value) const;
+
+            /// Get whether a value is an object.
+            /**
+             * @param value Offset of the value, or NO_VALUE.
+             * @return Whether the value is an object.
+             */
+            ENGINE_API bool IsObject(std::size_t value) const;
+
+            /// Get whether a value is an array.
+            /**
+             * @param value Offset of the value, or NO_VALUE.
+             * @return Whether the value is an array.
+             */
+            ENGINE_API bool IsArray(std::size_t value) const;
+
+            /// Read a value as a boolean.
+            /**
+             * @param value Offset of the value, or NO_VALUE.
+             * @return The boolean, or false if the value isn't a boolean or number.
+             */
+            ENGINE_API bool GetBool(std::size_t value) const;
+
+            /// Read a value as an unsigned integer.
+            /**
+             * @param value Offset of the value, or NO_VALUE.
+             * @return The integer, or 0 if the value isn't a non-negative integer.
+             */
+            ENGINE_API uint64_t GetUInt64(std::size_t value) const;
+
+            /// Read a value as a signed integer.
+            /**
+             * Floating point numbers are truncated.
+             * @param value Offset of the value, or NO_VALUE.
+             * @return The integer, or 0 if the value isn't a number or boolean.
+             */
+            ENGINE_API int64_t GetInt64(std::size_t value) const;
+
+            /// Read a value as a floating point number.
+            /**
+             * @param value Offset of the value, or NO_VALUE.
+             * @return The number, or 0 if the value isn't a number or boolean.
+             */
+            ENGINE_API double GetDouble(std::size_t value) const;
+
+            /// Read a string value.
+            /**
+             * @param value Offset of the value, or NO_VALUE.
+             * @return The string, or nullptr if the value isn't a string.
+             */
+            ENGINE_API const std::string* GetStringValue(std::size_t value) const;
+
+            /// Read a vector stored as raw floats.
+            /**
+             * @param value Offset of the value, or NO_VALUE.
+             * @param vector The vector to read into.
+             * @return Whether the value was stored as a raw vector.
+             */
+            ENGINE_API bool GetVec3(std::size_t value, glm::vec3& vector) const;
+
+            /// Read a quaternion stored as raw floats.
+            /**
+             * @param value Offset of the value, or NO_VALUE.
+             * @param quaternion The quaternion to read into.
+             * @return Whether the value was stored as a raw quaternion.
+             */
+            ENGINE_API bool GetQuaternion(std::size_t value, glm::quat& quaternion) const;
+
+            /// Read a byte array stored as a raw blob.
+            /**
+             * @param value Offset of the value, or NO_VALUE.
+             * @param count Set to the number of bytes.
+             * @return The bytes, or nullptr if the value wasn't stored as a blob.
+             */
+            ENGINE_API const uint8_t* GetBytes(std::size_t value, std::size_t& count) const;
+
+            /// Decode a value into a value tree.
+            /**
+             * @param value Offset of the value, or NO_VALUE to get a null value.
+             * @param result The value to decode into.
+             */
+            ENGINE_API void Decode(std::size_t value, Json::Value& result) const;
+
+        private:
+            bool ReadFixed(std::size_t& position, uint64_t& value, unsigned int bytes) const;
+            bool ReadVarint(std::size_t& position, uint64_t& value) const;
+            float ReadFloat(std::size_t& position) const;
+            bool Validate(std::size_t& position, unsigned int depth) const;
+            void ReadFloats(std::size_t position, Json::Value& value, const char* const keys[], unsigned int count) const;
+
+            const uint8_t* data = nullptr;
+            std::size_t length = 0;
+            std::size_t root = 0;
+            bool hasSizes = false;
+            bool open = false;
+            std::vector<std::string> strings;
+            std::unordered_map<std::string, uint32_t> stringIndices;
+    };
+
+    /// Check whether a buffer starts like a binary scene.
+    /**
+     * @param data The buffer to check.
+     * @param length The length of the buffer.
+     * @return Whether the buffer starts with the binary scene magic number.
+     */
+    ENGINE_API bool IsBinary(const char* data, std::size_t length);
+
+    /// Encode a value tree.
+    /**
+     * @param value The value to encode.
+     * @return The encoded data.
+     */
+    ENGINE_API std::string Write(const Json::Value& value);
+
+    /// Decode a value tree.
+    /**
+     * @param data The encoded data.
+     * @param length The length of the encoded data.
+     * @param value The value to decode into.
+     * @return Whether the data could be decoded.
+     */
+    ENGINE_API bool Read(const char* data, std::size_t length, Json::Value& value);
+
+    /// Parse scene data, which may be either binary or JSON.
+    /**
+     * @param data The contents of a scene file.
+     * @param value The value to parse into.
+     * @return Whether the data could be parsed.
+     */
+    ENGINE_API bool Parse(const std::string& data, Json::Value& value);
+
+    /// Read the contents of a file.
+    /**
+     * @param filename The name of the file.
+     * @param data The string to read into.
+     * @return Whether the file could be read.
+     */
+    ENGINE_API bool ReadFile(const std::string& filename, std::string& data);
+
+    /// Get the file of a scene, preferring the binary file if there is one.
+    /**
+     * @param path Path of the scene, without extension.
+     * @return The binary scene file if it exists, otherwise the JSON scene file.
+     */
+    ENGINE_API std::string FindSceneFile(const std::string& path);
+
+    /// Load a scene file, which may be either binary or JSON.
+    /**
+     * @param filename The name of the file.
+     * @param value The value to load into.
+     * @return Whether the file could be loaded.
+     */
+    ENGINE_API bool LoadFile(const std::string& filename, Json::Value& value);
+
+    /// Save a scene file.
+    /**
+     * @param filename The name of the file.
+     * @param value The value to save.
+     * @param binary Whether to save in the binary format instead of JSON.
+     * @return Whether the file could be written.
+     */
+    ENGINE_API bool SaveFile(const std::string& filename, const Json::Value& value, bool binary);
+
+    /// Convert a scene file between the binary and JSON formats.
+    /**
+     * @param source The file to convert, in either format.
+     * @param destination The file to write.
+     * @param binary Whether to write the binary format instead of JSON.
+     * @return Whether the conversion succeeded.
+     */
+    ENGINE_API bool Convert(const std::string& source, const std::string& destination, bool binary);
+}
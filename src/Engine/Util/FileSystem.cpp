@@ -17,8 +17,10 @@
 #include <direct.h>
 #include <windows.h>
 #undef CreateDirectory
+#undef RemoveDirectory
 #else
 #include <dirent.h>
+#include <unistd.h>
 #endif
 
 namespace FileSystem {
@@ -66,6 +68,44 @@ namespace FileSystem {
 #endif
     }
     
+    void RemoveDirectory(const std::string& path) {
+        if (!FileExists(path.c_str()))
+            return;
+        
+        for (const std::string& directory : DirectoryContents(path, DIRECTORY))
+            RemoveDirectory(path + DELIMITER + directory);
+        for (const std::string& file : DirectoryContents(path, FILE))
+            remove((path + DELIMITER + file).c_str());
+        
+#if defined(_WIN32) || defined(WIN32)
+        // Windows
+        _rmdir(path.c_str());
+#else
+        // MacOS and Linux
+        rmdir(path.c_str());
+#endif
+    }
+    
+    std::string TemporaryPath(const char* name) {
+        std::string path;
+        
+#if defined(_WIN32) || defined(WIN32)
+        // Windows, the path ends with a delimiter.
+        char buffer[MAX_PATH + 1];
+        if (GetTempPathA(MAX_PATH + 1, buffer) > 0)
+            path = buffer;
+#else
+        // MacOS and Linux
+        const char* directory = getenv("TMPDIR");
+        path = directory != nullptr ? directory : "/tmp";
+        path += DELIMITER;
+#endif
+        
+        path += name;
+        
+        return path;
+    }
+    
     std::vector<std::string> DirectoryContents(const std::string& directoryName, unsigned int type) {
         std::vector<std::string> contents;
         
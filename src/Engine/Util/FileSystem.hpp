@@ -37,6 +37,21 @@ namespace FileSystem {
      */
     ENGINE_API void CreateDirectory(const char* filename);
     
+    /// Remove a directory and everything in it.
+    /**
+     * @param path Path (either absolute or relative) to the directory to remove.
+     */
+    ENGINE_API void RemoveDirectory(const std::string& path);
+    
+    /// Get a path in the system's directory for temporary files.
+    /**
+     * On Windows, this is in the directory from GetTempPath.
+     * Elsewhere, this is in $TMPDIR or /tmp.
+     * @param name Name of the file or directory.
+     * @return The path. Nothing is created.
+     */
+    ENGINE_API std::string TemporaryPath(const char* name);
+    
     /// Get all the contents of a directory.
     /**
      * @param directoryName Path to the directory to scan.
@@ -0,0 +1,161 @@
+#include "FramePacer.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+    // Bounds of the time to spin before a frame is due.
+    const std::chrono::microseconds MINIMUM_SPIN_TIME(500);
+    const std::chrono::microseconds MAXIMUM_SPIN_TIME(4000);
+
+    // Frames to wait between quality changes, so the effect of the last change can be measured.
+    const unsigned int QUALITY_CHANGE_INTERVAL = 30;
+
+    // Quality is lowered faster than it's raised, to get back to the target frame rate quickly.
+    const float QUALITY_DECREASE = 0.1f;
+    const float QUALITY_INCREASE = 0.05f;
+
+    // Fractions of the target frame time above which quality is lowered and below which it's raised.
+    const double HIGH_LOAD = 0.9;
+    const double LOW_LOAD = 0.7;
+
+    // Weight of the latest frame in the average work time.
+    const double WORK_TIME_WEIGHT = 0.1;
+}
+
+FramePacer::FramePacer() : spinTime(std::chrono::milliseconds(2)) {
+    SetTargetFrameRate(targetFrameRate);
+    Reset();
+}
+
+void FramePacer::SetTargetFrameRate(double frameRate) {
+    targetFrameRate = std::max(frameRate, 0.0);
+    if (targetFrameRate > 0.0)
+        framePeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFrameRate));
+    else
+        framePeriod = Clock::duration::zero();
+
+    nextFrame = frameStart + framePeriod;
+}
+
+double FramePacer::GetTargetFrameRate() const {
+    return targetFrameRate;
+}
+
+void FramePacer::SetMaxDeltaTime(float maxDeltaTime) {
+    this->maxDeltaTime = maxDeltaTime;
+}
+
+void FramePacer::SetQualityScaling(bool enabled) {
+    qualityScaling = enabled;
+    if (!enabled)
+        qualityScale = 1.0f;
+}
+
+void FramePacer::SetMinimumQualityScale(float minimumScale) {
+    minimumQualityScale = std::min(std::max(minimumScale, 0.0f), 1.0f);
+    qualityScale = std::max(qualityScale, minimumQualityScale);
+}
+
+float FramePacer::GetQualityScale() const {
+    return qualityScale;
+}
+
+void FramePacer::Reset() {
+    frameStart = Clock::now();
+    nextFrame = frameStart + framePeriod;
+    deltaTimeIndex = 0;
+    deltaTimeCount = 0;
+    framesSinceQualityChange = 0;
+}
+
+float FramePacer::BeginFrame() {
+    Clock::time_point now = Clock::now();
+    double deltaTime = std::chrono::duration<double>(now - frameStart).count();
+    frameStart = now;
+    workEndMarked = false;
+
+    return SmoothDeltaTime(deltaTime);
+}
+
+void FramePacer::MarkWorkEnd() {
+    workTime = std::chrono::duration<double>(Clock::now() - frameStart).count();
+    workEndMarked = true;
+}
+
+void FramePacer::EndFrame() {
+    Clock::time_point now = Clock::now();
+    if (!workEndMarked)
+        workTime = std::chrono::duration<double>(now - frameStart).count();
+    UpdateQualityScale(workTime);
+
+    if (targetFrameRate <= 0.0)
+        return;
+
+    // If we've fallen more than a frame behind, start over rather than rushing frames to catch up.
+    if (now > nextFrame + framePeriod)
+        nextFrame = now;
+    else
+        WaitUntil(nextFrame);
+
+    nextFrame += framePeriod;
+}
+
+double FramePacer::GetWorkTime() const {
+    return workTime;
+}
+
+float FramePacer::SmoothDeltaTime(double deltaTime) {
+    deltaTimes[deltaTimeIndex] = std::min(deltaTime, static_cast<double>(maxDeltaTime));
+    deltaTimeIndex = (deltaTimeIndex + 1) % SMOOTHING_FRAMES;
+    if (deltaTimeCount < SMOOTHING_FRAMES)
+        ++deltaTimeCount;
+
+    double sum = 0.0;
+    for (unsigned int i = 0; i < deltaTimeCount; ++i)
+        sum += deltaTimes[i];
+
+    return static_cast<float>(sum / deltaTimeCount);
+}
+
+void FramePacer::UpdateQualityScale(double workTime) {
+    if (framesSinceQualityChange == 0)
+        averageWorkTime = workTime;
+    else
+        averageWorkTime += (workTime - averageWorkTime) * WORK_TIME_WEIGHT;
+    ++framesSinceQualityChange;
+
+    if (!qualityScaling || targetFrameRate <= 0.0 || framesSinceQualityChange < QUALITY_CHANGE_INTERVAL)
+        return;
+
+    double frameTime = 1.0 / targetFrameRate;
+    if (averageWorkTime > frameTime * HIGH_LOAD && qualityScale > minimumQualityScale) {
+        qualityScale = std::max(qualityScale - QUALITY_DECREASE, minimumQualityScale);
+        framesSinceQualityChange = 0;
+    } else if (averageWorkTime < frameTime * LOW_LOAD && qualityScale < 1.0f) {
+        qualityScale = std::min(qualityScale + QUALITY_INCREASE, 1.0f);
+        framesSinceQualityChange = 0;
+    }
+}
+
+void FramePacer::WaitUntil(Clock::time_point time) {
+    // Sleep until shortly before the frame is due.
+    Clock::time_point now = Clock::now();
+    if (time - now > spinTime) {
+        Clock::time_point wakeUp = time - spinTime;
+        std::this_thread::sleep_until(wakeUp);
+
+        // Keep spinning for a bit longer than sleeps overshoot, slowly shortening it while they don't.
+        Clock::duration overshoot = Clock::now() - wakeUp;
+        Clock::duration margin = overshoot + overshoot / 2;
+        if (margin > spinTime)
+            spinTime = margin;
+        else
+            spinTime -= (spinTime - margin) / 16;
+        spinTime = std::min<Clock::duration>(std::max<Clock::duration>(spinTime, MINIMUM_SPIN_TIME), MAXIMUM_SPIN_TIME);
+    }
+
+    // Spin for the rest.
+    while (Clock::now() < time)
+        std::this_thread::yield();
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+#include "../linking.hpp"
+
+/// Paces the main loop to a target frame rate.
+/**
+ * Waits for the next frame by sleeping until shortly before it's due and spinning for the rest,
+ * since sleeping alone tends to overshoot. The delta time handed to the simulation is clamped
+ * and averaged over a few frames, so single long frames don't cause jumps. Optionally lowers
+ * a quality scale when frames take longer than the target frame time and raises it again when
+ * there is time to spare.
+ */
+class FramePacer {
+    public:
+        /// Create new frame pacer.
+        ENGINE_API FramePacer();
+
+        /// Set the frame rate to pace to.
+        /**
+         * @param frameRate Frames per second, or 0 to not wait between frames.
+         */
+        ENGINE_API void SetTargetFrameRate(double frameRate);
+
+        /// Get the frame rate to pace to.
+        /**
+         * @return Frames per second, or 0 if frames aren't waited for.
+         */
+        ENGINE_API double GetTargetFrameRate() const;
+
+        /// Set the longest delta time to simulate in one frame.
+        /**
+         * @param maxDeltaTime Maximum delta time (in seconds).
+         */
+        ENGINE_API void SetMaxDeltaTime(float maxDeltaTime);
+
+        /// Set whether to adjust the quality scale to the measured frame time.
+        /**
+         * Requires a target frame rate.
+         * @param enabled Whether to adjust the quality scale.
+         */
+        ENGINE_API void SetQualityScaling(bool enabled);
+
+        /// Set the lowest quality scale to go down to.
+        /**
+         * @param minimumScale Lowest quality scale, between 0 and 1.
+         */
+        ENGINE_API void SetMinimumQualityScale(float minimumScale);
+
+        /// Get the quality scale.
+        /**
+         * @return A factor between the minimum quality scale and 1 to scale the quality by.
+         */
+        ENGINE_API float GetQualityScale() const;
+
+        /// Restart timing, eg. after loading.
+        ENGINE_API void Reset();
+
+        /// Start a frame.
+        /**
+         * @return The delta time to simulate (in seconds).
+         */
+        ENGINE_API float BeginFrame();
+
+        /// Mark the end of the frame's work.
+        /**
+         * Call before blocking on the display (eg. swapping buffers), so time spent waiting for vsync isn't counted as work. If not called, the work is measured until EndFrame.
+         */
+        ENGINE_API void MarkWorkEnd();
+
+        /// End a frame and wait until the next one is due.
+        ENGINE_API void EndFrame();
+
+        /// Get the time the last frame spent working, not counting the wait.
+        /**
+         * @return The work time (in seconds).
+         */
+        ENGINE_API double GetWorkTime() const;
+
+        /// Smooth and clamp a measured delta time.
+        /**
+         * Called by BeginFrame.
+         * @param deltaTime The time since the last frame (in seconds).
+         * @return The delta time to simulate (in seconds).
+         */
+        ENGINE_API float SmoothDeltaTime(double deltaTime);
+
+        /// Adjust the quality scale to the time a frame spent working.
+        /**
+         * Called by EndFrame.
+         * @param workTime The time the frame spent working (in seconds).
+         */
+        ENGINE_API void UpdateQualityScale(double workTime);
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        void WaitUntil(Clock::time_point time);
+
+        double targetFrameRate = 60.0;
+        Clock::duration framePeriod;
+        float maxDeltaTime = 0.1f;
+
+        Clock::time_point frameStart;
+        Clock::time_point nextFrame;
+        double workTime = 0.0;
+        bool workEndMarked = false;
+
+        // Time before a deadline to stop sleeping and start spinning, adjusted to how much sleeps overshoot.
+        Clock::duration spinTime;
+
+        // The last few delta times, averaged to smooth them.
+        static const unsigned int SMOOTHING_FRAMES = 4;
+        double deltaTimes[SMOOTHING_FRAMES];
+        unsigned int deltaTimeIndex = 0;
+        unsigned int deltaTimeCount = 0;
+
+        bool qualityScaling = false;
+        float qualityScale = 1.0f;
+        float minimumQualityScale = 0.5f;
+        double averageWorkTime = 0.0;
+        unsigned int framesSinceQualityChange = 0;
+};
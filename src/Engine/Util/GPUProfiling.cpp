@@ -6,7 +6,7 @@
 
 GPUProfiling::GPUProfiling(const std::string& name, Video::Query::Type type) : active(false) {
     // Check if profiling.
-    if (Managers().profilingManager->Active()) {
+    if (Managers().profilingManager != nullptr && Managers().profilingManager->Active() && Managers().profilingManager->gpuFrame != nullptr) {
         active = true;
 
         // Get type.
@@ -24,8 +24,9 @@ GPUProfiling::GPUProfiling(const std::string& name, Video::Query::Type type) : a
 
         // Check if nested.
         if (this->type == ProfilingManager::Type::GPU_SAMPLES_PASSED) {
-            if (Managers().profilingManager->current[this->type] != Managers().profilingManager->root[this->type] && 
-                Managers().profilingManager->current[this->type]->parent == Managers().profilingManager->root[this->type]) {
+            ProfilingManager::Result* root = Managers().profilingManager->gpuFrame->root[this->type];
+            if (Managers().profilingManager->current[this->type] != root && 
+                Managers().profilingManager->current[this->type]->parent == root) {
                 Log() << "Warning: GPU_SAMPLES_PASSED can't be nested! Name: " << name << "\n";
                 active = false;
             }
@@ -1,24 +1,28 @@
 #include "Profiling.hpp"
 
-#include <GLFW/glfw3.h>
 #include "../Manager/Managers.hpp"
 
 #ifdef USINGMEMTRACK
 #include <MemTrackInclude.hpp>
 #endif
 
-using namespace std;
-
-Profiling::Profiling(const std::string& name) {
-    if (Managers().profilingManager->Active()) {
-        result = Managers().profilingManager->StartResult(name, ProfilingManager::Type::CPU_TIME);
-        start = glfwGetTime();
+Profiling::Profiling(unsigned int zone) : zone(zone), active(false) {
+    ProfilingManager* profilingManager = Managers().profilingManager;
+    if (profilingManager != nullptr && profilingManager->Active()) {
+        active = true;
+        sample = profilingManager->BeginZone(zone);
     }
+
+    // Captures record zones on all threads.
+    tracing = ProfilingManager::IsCapturing();
+    if (tracing)
+        ProfilingManager::TraceZone(zone, true);
 }
 
 Profiling::~Profiling() {
-    if (Managers().profilingManager->Active()) {
-        result->value = (glfwGetTime() - start) * 1000.0;
-        Managers().profilingManager->FinishResult(result, ProfilingManager::Type::CPU_TIME);
-    }
+    if (tracing)
+        ProfilingManager::TraceZone(zone, false);
+
+    if (active)
+        Managers().profilingManager->EndZone(sample);
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <string>
+#include <cstdint>
 #include "../Manager/ProfilingManager.hpp"
 #include "../linking.hpp"
 
@@ -9,16 +9,26 @@ class Profiling {
     public:
         /// Start profiling.
         /**
-         * @param name Name of the segment.
+         * @param zone ID of the zone, from ProfilingManager::RegisterZone.
          */
-        ENGINE_API explicit Profiling(const std::string& name);
+        ENGINE_API explicit Profiling(unsigned int zone);
         
         /// End profiling.
         ENGINE_API ~Profiling();
         
     private:
-        ProfilingManager::Result* result;
-        double start;
+        unsigned int zone;
+        bool active;
+        bool tracing;
+        uint64_t sample;
 };
 
-#define PROFILE(name) Profiling __profileInstance(name)
+#define PROFILE_CONCAT_INNER(a, b) a ## b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+/// Profile the rest of the scope as a zone.
+/**
+ * The zone is registered the first time the statement runs.
+ * @param name Name of the zone, a string literal.
+ */
+#define PROFILE(name) static const unsigned int PROFILE_CONCAT(__profileZone, __LINE__) = ProfilingManager::RegisterZone(name); Profiling PROFILE_CONCAT(__profileInstance, __LINE__)(PROFILE_CONCAT(__profileZone, __LINE__))
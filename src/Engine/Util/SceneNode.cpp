@@ -0,0 +1,185 @@
+#include "SceneNode.hpp"
+
+#include <json/json.h>
+#include "BinaryScene.hpp"
+
+SceneNode::SceneNode(const Json::Value& value) : json(&value), value(BinaryScene::Reader::NO_VALUE) {
+
+}
+
+SceneNode::SceneNode(const BinaryScene::Reader& reader, std::size_t value) : reader(&reader), value(value) {
+
+}
+
+SceneNode::SceneNode() : value(BinaryScene::Reader::NO_VALUE) {
+
+}
+
+bool SceneNode::IsNull() const {
+    if (byte >= 0)
+        return false;
+    if (json != nullptr)
+        return json->isNull();
+    return reader == nullptr || reader->IsNull(value);
+}
+
+bool SceneNode::IsMember(const char* key) const {
+    return !GetMember(key).IsMissing();
+}
+
+SceneNode SceneNode::GetMember(const char* key) const {
+    SceneNode member;
+    if (json != nullptr) {
+        if (json->isObject() && json->isMember(key))
+            member.json = &(*json)[key];
+    } else if (reader != nullptr && reader->IsObject(value)) {
+        member.reader = reader;
+        member.value = reader->FindMember(value, reader->FindString(key));
+    }
+    return member;
+}
+
+std::vector<std::string> SceneNode::GetMemberNames() const {
+    std::vector<std::string> names;
+    if (json != nullptr) {
+        if (json->isObject())
+            names = json->getMemberNames();
+    } else if (reader != nullptr && reader->IsObject(value)) {
+        uint32_t count = reader->GetCount(value);
+        names.reserve(count);
+        std::size_t position = count > 0 ? reader->GetFirst(value) : 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            BinaryScene::Reader::Member member = reader->GetMember(position);
+            names.push_back(reader->GetString(member.key));
+            position = reader->GetNext(member.value);
+        }
+    }
+    return names;
+}
+
+unsigned int SceneNode::GetSize() const {
+    if (json != nullptr)
+        return json->isArray() ? json->size() : 0;
+    if (reader == nullptr || value == BinaryScene::Reader::NO_VALUE || byte >= 0)
+        return 0;
+    if (reader->IsArray(value))
+        return reader->GetCount(value);
+
+    std::size_t count;
+    reader->GetBytes(value, count);
+    return static_cast<unsigned int>(count);
+}
+
+SceneNode SceneNode::GetElement(unsigned int index) const {
+    SceneNode element;
+    if (index >= GetSize())
+        return element;
+
+    if (json != nullptr) {
+        element.json = &(*json)[index];
+    } else if (reader->IsArray(value)) {
+        element.reader = reader;
+        element.value = reader->GetFirst(value);
+        for (unsigned int i = 0; i < index; ++i)
+            element.value = reader->GetNext(element.value);
+    } else {
+        std::size_t count;
+        element.byte = reader->GetBytes(value, count)[index];
+    }
+    return element;
+}
+
+bool SceneNode::AsBool() const {
+    if (byte >= 0)
+        return byte != 0;
+    if (json != nullptr)
+        return json->asBool();
+    return reader != nullptr && reader->GetBool(value);
+}
+
+int SceneNode::AsInt() const {
+    if (byte >= 0)
+        return byte;
+    if (json != nullptr)
+        return json->asInt();
+    return reader != nullptr ? static_cast<int>(reader->GetInt64(value)) : 0;
+}
+
+uint64_t SceneNode::AsUInt64() const {
+    if (byte >= 0)
+        return static_cast<uint64_t>(byte);
+    if (json != nullptr)
+        return json->asUInt64();
+    return reader != nullptr ? reader->GetUInt64(value) : 0;
+}
+
+float SceneNode::AsFloat() const {
+    if (byte >= 0)
+        return static_cast<float>(byte);
+    if (json != nullptr)
+        return json->asFloat();
+    return reader != nullptr ? static_cast<float>(reader->GetDouble(value)) : 0.0f;
+}
+
+std::string SceneNode::AsString() const {
+    if (json != nullptr)
+        return json->asString();
+    const std::string* string = reader != nullptr && byte < 0 ? reader->GetStringValue(value) : nullptr;
+    return string != nullptr ? *string : std::string();
+}
+
+std::vector<uint8_t> SceneNode::AsBytes() const {
+    std::vector<uint8_t> bytes;
+    if (json == nullptr && reader != nullptr && byte < 0) {
+        std::size_t count;
+        const uint8_t* data = reader->GetBytes(value, count);
+        if (data != nullptr)
+            return std::vector<uint8_t>(data, data + count);
+    }
+
+    unsigned int size = GetSize();
+    bytes.reserve(size);
+    for (unsigned int i = 0; i < size; ++i)
+        bytes.push_back(static_cast<uint8_t>(GetElement(i).AsInt()));
+    return bytes;
+}
+
+bool SceneNode::GetBool(const char* key, bool defaultValue) const {
+    SceneNode member = GetMember(key);
+    return member.IsMissing() ? defaultValue : member.AsBool();
+}
+
+int SceneNode::GetInt(const char* key, int defaultValue) const {
+    SceneNode member = GetMember(key);
+    return member.IsMissing() ? defaultValue : member.AsInt();
+}
+
+uint64_t SceneNode::GetUInt64(const char* key, uint64_t defaultValue) const {
+    SceneNode member = GetMember(key);
+    return member.IsMissing() ? defaultValue : member.AsUInt64();
+}
+
+float SceneNode::GetFloat(const char* key, float defaultValue) const {
+    SceneNode member = GetMember(key);
+    return member.IsMissing() ? defaultValue : member.AsFloat();
+}
+
+std::string SceneNode::GetString(const char* key, const std::string& defaultValue) const {
+    SceneNode member = GetMember(key);
+    return member.IsMissing() ? defaultValue : member.AsString();
+}
+
+glm::vec3 SceneNode::GetVec3(const char* key) const {
+    SceneNode member = GetMember(key);
+
+    // Vectors are usually stored as raw floats in binary scenes.
+    glm::vec3 vector;
+    if (member.json == nullptr && member.reader != nullptr && member.reader->GetVec3(member.value, vector))
+        return vector;
+
+    return glm::vec3(member.GetFloat("x", 0.0f), member.GetFloat("y", 0.0f), member.GetFloat("z", 0.0f));
+}
+
+bool SceneNode::IsMissing() const {
+    return byte < 0 && json == nullptr && (reader == nullptr || value == BinaryScene::Reader::NO_VALUE);
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../linking.hpp"
+
+namespace Json {
+    class Value;
+}
+namespace BinaryScene {
+    class Reader;
+}
+
+/// Read-only view of a value in a JSON or binary scene.
+/**
+ * Component loaders read their settings through this, so components in binary scenes are
+ * read from the scene data in place instead of being decoded into a JSON tree first. The
+ * viewed value has to stay alive for as long as the node is used.
+ */
+class SceneNode {
+    public:
+        /// Create a node viewing a JSON value.
+        /**
+         * @param value The JSON value.
+         */
+        ENGINE_API SceneNode(const Json::Value& value);
+
+        /// Create a node viewing a value in a binary scene.
+        /**
+         * @param reader The reader the scene was opened in.
+         * @param value Offset of the value, or BinaryScene::Reader::NO_VALUE.
+         */
+        ENGINE_API SceneNode(const BinaryScene::Reader& reader, std::size_t value);
+
+        /// Get whether the value is missing or null.
+        /**
+         * @return Whether the value is missing or null.
+         */
+        ENGINE_API bool IsNull() const;
+
+        /// Get whether an object has a member.
+        /**
+         * @param key The name of the member.
+         * @return Whether the value is an object with the member.
+         */
+        ENGINE_API bool IsMember(const char* key) const;
+
+        /// Get a member of an object.
+        /**
+         * @param key The name of the member.
+         * @return The member, which is missing if there is no such member.
+         */
+        ENGINE_API SceneNode GetMember(const char* key) const;
+
+        /// Get the names of all members of an object.
+        /**
+         * @return The member names, or none if the value isn't an object.
+         */
+        ENGINE_API std::vector<std::string> GetMemberNames() const;
+
+        /// Get the number of elements of an array.
+        /**
+         * Byte arrays stored as raw blobs count as arrays.
+         * @return The number of elements, or 0 if the value isn't an array.
+         */
+        ENGINE_API unsigned int GetSize() const;
+
+        /// Get an element of an array.
+        /**
+         * @param index The index of the element.
+         * @return The element, which is missing if the index is out of range.
+         */
+        ENGINE_API SceneNode GetElement(unsigned int index) const;
+
+        /// Read the value as a boolean.
+        /**
+         * @return The boolean, or false if the value isn't a boolean or number.
+         */
+        ENGINE_API bool AsBool() const;
+
+        /// Read the value as an integer.
+        /**
+         * @return The integer, or 0 if the value isn't a number or boolean.
+         */
+        ENGINE_API int AsInt() const;
+
+        /// Read the value as an unsigned 64-bit integer.
+        /**
+         * @return The integer, or 0 if the value isn't a non-negative integer.
+         */
+        ENGINE_API uint64_t AsUInt64() const;
+
+        /// Read the value as a floating point number.
+        /**
+         * @return The number, or 0 if the value isn't a number or boolean.
+         */
+        ENGINE_API float AsFloat() const;
+
+        /// Read the value as a string.
+        /**
+         * @return The string, or an empty string if the value isn't a string.
+         */
+        ENGINE_API std::string AsString() const;
+
+        /// Read an array of bytes.
+        /**
+         * @return The bytes, or none if the value isn't an array.
+         */
+        ENGINE_API std::vector<uint8_t> AsBytes() const;
+
+        /// Read a boolean member.
+        /**
+         * @param key The name of the member.
+         * @param defaultValue The value to return if there is no such member.
+         * @return The member's value.
+         */
+        ENGINE_API bool GetBool(const char* key, bool defaultValue) const;
+
+        /// Read an integer member.
+        /**
+         * @param key The name of the member.
+         * @param defaultValue The value to return if there is no such member.
+         * @return The member's value.
+         */
+        ENGINE_API int GetInt(const char* key, int defaultValue) const;
+
+        /// Read an unsigned 64-bit integer member.
+        /**
+         * @param key The name of the member.
+         * @param defaultValue The value to return if there is no such member.
+         * @return The member's value.
+         */
+        ENGINE_API uint64_t GetUInt64(const char* key, uint64_t defaultValue) const;
+
+        /// Read a floating point member.
+        /**
+         * @param key The name of the member.
+         * @param defaultValue The value to return if there is no such member.
+         * @return The member's value.
+         */
+        ENGINE_API float GetFloat(const char* key, float defaultValue) const;
+
+        /// Read a string member.
+        /**
+         * @param key The name of the member.
+         * @param defaultValue The value to return if there is no such member.
+         * @return The member's value.
+         */
+        ENGINE_API std::string GetString(const char* key, const std::string& defaultValue) const;
+
+        /// Read a vector member.
+        /**
+         * Missing components are read as 0, like Json::LoadVec3.
+         * @param key The name of the member.
+         * @return The member's value.
+         */
+        ENGINE_API glm::vec3 GetVec3(const char* key) const;
+
+    private:
+        SceneNode();
+        bool IsMissing() const;
+
+        const Json::Value* json = nullptr;
+        const BinaryScene::Reader* reader = nullptr;
+        std::size_t value;
+
+        // Elements of byte arrays stored as raw blobs don't have an offset of their own.
+        int byte = -1;
+};
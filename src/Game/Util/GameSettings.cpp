@@ -23,4 +23,9 @@ void GameSettings::Load() {
     
     AddLongSetting("Texture Reduction", "Graphics", "Texture Reduction", 1);
     AddLongSetting("Shadow Map Size", "Graphics", "Shadow Map Size", 1024);
+    AddDoubleSetting("Target Frame Rate", "Graphics", "Target Frame Rate", 60.0);
+    AddBoolSetting("Quality Scaling", "Graphics", "Quality Scaling", false);
+    AddDoubleSetting("Minimum Quality Scale", "Graphics", "Minimum Quality Scale", 0.5);
+    AddBoolSetting("Pipelined Rendering", "Graphics", "Pipelined Rendering", false);
+    AddLongSetting("Physics Threads", "Physics", "Threads", 1);
 }
@@ -2,6 +2,8 @@
 #include <GLFW/glfw3.h>
 #include <Engine/MainWindow.hpp>
 #include <Engine/Manager/Managers.hpp>
+#include <Engine/Manager/ParticleManager.hpp>
+#include <Engine/Manager/PhysicsManager.hpp>
 #include <Engine/Manager/ScriptManager.hpp>
 #include <Engine/Manager/ProfilingManager.hpp>
 #include <Engine/Manager/RenderManager.hpp>
@@ -9,9 +11,10 @@
 #include <Engine/Manager/VRManager.hpp>
 #include <Engine/Hymn.hpp>
 #include <Engine/Input/Input.hpp>
+#include <Engine/Util/BinaryScene.hpp>
+#include <Engine/Util/FramePacer.hpp>
 #include <Engine/Util/Input.hpp>
 #include <Utility/Log.hpp>
-#include <thread>
 #include <iostream>
 #include <fstream>
 #include <ctime>
@@ -30,6 +33,7 @@ int main(int argc, char* argv[]) {
 
     bool testing = false;
     bool frameLimit = false;
+    bool trace = false;
 
     // Quick fix in order to implement a testing parameter, 
     for (int i = 1; i < argc; i++) {
@@ -43,6 +47,11 @@ int main(int argc, char* argv[]) {
             testing = true;
             Log() << "Testing enabled. You'll have to quit manually.\n";
         }
+
+        if (std::string(argv[i]) == "trace") {
+            trace = true;
+            Log() << "Capturing a trace, it will be written to Trace.json on exit.\n";
+        }
     }
     
     int numberOfBadFrames = 0;
@@ -71,9 +80,16 @@ int main(int argc, char* argv[]) {
     GameSettings::GetInstance().Load();
     Managers().renderManager->SetTextureReduction(static_cast<uint16_t>(GameSettings::GetInstance().GetLong("Texture Reduction")));
     Managers().renderManager->SetShadowMapSize(GameSettings::GetInstance().GetLong("Shadow Map Size"));
+    Managers().physicsManager->SetThreadCount(GameSettings::GetInstance().GetLong("Physics Threads"));
+    Hymn().SetPipelined(GameSettings::GetInstance().GetBool("Pipelined Rendering"));
+    
+    FramePacer framePacer;
+    framePacer.SetTargetFrameRate(GameSettings::GetInstance().GetDouble("Target Frame Rate"));
+    framePacer.SetQualityScaling(GameSettings::GetInstance().GetBool("Quality Scaling"));
+    framePacer.SetMinimumQualityScale(static_cast<float>(GameSettings::GetInstance().GetDouble("Minimum Quality Scale")));
     
     // Load world.
-    Hymn().world.Load(Hymn().GetPath() + "/" + Hymn().startupScene + ".json");
+    Hymn().world.Load(BinaryScene::FindSceneFile(Hymn().GetPath() + "/" + Hymn().startupScene));
 
     // Compile scripts.
     Managers().scriptManager->RegisterInput();
@@ -82,13 +98,25 @@ int main(int argc, char* argv[]) {
     // Create audio environment.
     Managers().soundManager->CreateAudioEnvironment();
     
+    // Capture zones on all threads.
+    ProfilingManager::SetThreadName("Main");
+    if (trace) {
+        Managers().profilingManager->SetActive(true);
+        Managers().profilingManager->StartCapture();
+    }
+
+    // Quality scaling shortens the particle distances.
+    const float particleCullDistance = Managers().particleManager->GetCullDistance();
+    const float particleLodDistance = Managers().particleManager->GetLodDistance();
+    float qualityScale = 1.0f;
+
     // Main loop.
-    double targetFPS = 60.0;
-    double lastTime = glfwGetTime();
-    double lastTimeRender = glfwGetTime();
+    framePacer.Reset();
     while ((!window->ShouldClose() && !frameLimit) || (frameLimit && (numberOfFrames < 600)) ) {
-        double deltaTime = glfwGetTime() - lastTime;
-        lastTime = glfwGetTime();
+        float deltaTime = framePacer.BeginFrame();
+
+        if (trace)
+            Managers().profilingManager->BeginFrame();
 
         if (Input()->Triggered(InputHandler::WINDOWMODE)) {
             bool fullscreen, borderless;
@@ -97,22 +125,33 @@ int main(int argc, char* argv[]) {
         }
 
         window->Update();
-        Hymn().Update(static_cast<float>(deltaTime));
-        if (Managers().vrManager->Active())
-            Hymn().Render(RenderManager::HMD);
-        else
-            Hymn().Render(RenderManager::MONITOR);
-
+        Hymn().UpdateAndRender(deltaTime, Managers().vrManager->Active() ? RenderManager::HMD : RenderManager::MONITOR);
 
+        // Testing measures the GPU's work too.
         if ( testing )
             glFinish();
+
+        // Don't count waiting for the display as work.
+        framePacer.MarkWorkEnd();
         
-        // Swap buffers and wait until next frame.
+        // Swap buffers.
         window->SwapBuffers();
+
+        if (trace)
+            Managers().profilingManager->EndFrame();
+        
+        // Wait until next frame.
+        framePacer.EndFrame();
+        
+        if (framePacer.GetQualityScale() != qualityScale) {
+            qualityScale = framePacer.GetQualityScale();
+            Managers().particleManager->SetCullDistance(particleCullDistance * qualityScale);
+            Managers().particleManager->SetLodDistance(particleLodDistance * qualityScale);
+        }
         
         if ( testing ) {
             // Frame measurements.
-            double frameTime = (glfwGetTime() - lastTimeRender);
+            double frameTime = framePacer.GetWorkTime();
             totalFrameTime += frameTime;
             averageFrameTime = (totalFrameTime / numberOfFrames) * 1000.0;
 
@@ -122,11 +161,6 @@ int main(int argc, char* argv[]) {
             if (frameTime * 1000.0 > 32.0)
                 numberOfBadFrames++;
         }
-
-        long wait = static_cast<long>((1.0 / targetFPS + lastTimeRender - glfwGetTime()) * 1000000.0);
-        if ( wait > 0 )
-            std::this_thread::sleep_for(std::chrono::microseconds(wait));
-        lastTimeRender = glfwGetTime();
         
         // Get input.
         glfwPollEvents();
@@ -171,9 +205,17 @@ int main(int argc, char* argv[]) {
         Log() << "Max vram used: " << maxVramUsed << "MiB\n";
     }
 
+    if (trace) {
+        Managers().profilingManager->StopCapture();
+        unsigned int frames = Managers().profilingManager->GetCapturedFrameCount();
+        if (frames > 0)
+            Managers().profilingManager->WriteTrace("Trace.json", 0, frames - 1);
+    }
+
     // Save game settings.
     GameSettings::GetInstance().Save();
 
+    Hymn().SetPipelined(false);
     Hymn().world.Clear();
     Managers().ShutDown();
     
@@ -0,0 +1,51 @@
+#include <Engine/Util/BinaryScene.hpp>
+#include <Utility/Log.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    Log().SetupStreams(&std::cout, &std::cout, &std::cout, &std::cerr);
+
+    // Parse arguments.
+    std::string input;
+    std::string output;
+    int format = -1;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument(argv[i]);
+        if (argument == "--binary") {
+            format = 1;
+        } else if (argument == "--json") {
+            format = 0;
+        } else if (input.empty()) {
+            input = argument;
+        } else if (output.empty()) {
+            output = argument;
+        } else {
+            input.clear();
+            break;
+        }
+    }
+
+    if (input.empty() || output.empty()) {
+        Log(Log::ERR) << "Usage: SceneConverter [--binary|--json] <input> <output>\n";
+        return 1;
+    }
+
+    // Default to converting to the other format.
+    if (format == -1) {
+        std::ifstream file(input, std::ios::binary);
+        char header[8] = {};
+        file.read(header, sizeof(header));
+        format = BinaryScene::IsBinary(header, static_cast<std::size_t>(file.gcount())) ? 0 : 1;
+    }
+
+    if (!BinaryScene::Convert(input, output, format == 1)) {
+        Log(Log::ERR) << "Couldn't convert " << input << " to " << output << "\n";
+        return 1;
+    }
+
+    Log() << "Converted " << input << " to " << (format == 1 ? "binary" : "JSON") << " scene " << output << "\n";
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <catch.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/Util/BinaryScene.hpp>
+#include <Engine/Util/Json.hpp>
+#include <Engine/Util/SceneNode.hpp>
+#include <sstream>
+
+namespace {
+    Json::Value RoundTrip(const Json::Value& value) {
+        std::string data = BinaryScene::Write(value);
+        Json::Value result;
+        REQUIRE(BinaryScene::Read(data.data(), data.size(), result));
+        return result;
+    }
+
+    Json::Value CreateScene() {
+        Json::Value root;
+        root["name"] = "Root";
+        root["position"] = Json::SaveVec3(glm::vec3(1.5f, -2.0f, 0.25f));
+        root["rotation"] = Json::SaveQuaternion(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+        root["uid"] = static_cast<Json::UInt64>(0xFFFFFFFF00000001ull);
+        root["enabled"] = true;
+        root["static"] = false;
+        root["nothing"] = Json::Value();
+        root["precise"] = 0.1;
+        root["negative"] = -123456;
+        root["emptyArray"] = Json::Value(Json::arrayValue);
+        root["emptyObject"] = Json::Value(Json::objectValue);
+
+        // Script property maps are stored one byte per element.
+        Json::Value bytes;
+        for (int i = 0; i < 16; ++i)
+            bytes.append(i * 16);
+        root["script"]["propertyMap"]["speed"] = bytes;
+
+        // Not bytes or vectors, should be stored as generic values.
+        Json::Value mixed;
+        mixed.append(1);
+        mixed.append(300);
+        mixed.append("text");
+        root["mixed"] = mixed;
+        root["notVector"]["x"] = 1.0;
+        root["notVector"]["y"] = "y";
+
+        for (int i = 0; i < 3; ++i) {
+            Json::Value child;
+            child["name"] = "Child";
+            child["scale"] = Json::SaveVec3(glm::vec3(1.0f, 1.0f, 1.0f));
+            root["children"].append(child);
+        }
+
+        return root;
+    }
+}
+
+TEST_CASE("Binary scene check", "[BinaryScene]") {
+    Json::Value scene = CreateScene();
+
+    SECTION("Round trip preserves the scene") {
+        REQUIRE(RoundTrip(scene) == scene);
+    }
+
+    SECTION("Round trip preserves saved entities") {
+        Entity entity(nullptr, "Entity");
+        entity.position = glm::vec3(0.1f, 2.0f, -3.0f);
+        entity.scale = glm::vec3(2.0f, 2.0f, 2.0f);
+        Json::Value saved = entity.Save();
+        REQUIRE(RoundTrip(saved) == saved);
+    }
+
+    SECTION("Binary scenes are detected") {
+        std::string data = BinaryScene::Write(scene);
+        REQUIRE(BinaryScene::IsBinary(data.data(), data.size()));
+
+        std::ostringstream json;
+        json << scene;
+        REQUIRE_FALSE(BinaryScene::IsBinary(json.str().data(), json.str().size()));
+    }
+
+    SECTION("Binary scenes are smaller than JSON") {
+        std::ostringstream json;
+        json << scene;
+        REQUIRE(BinaryScene::Write(scene).size() < json.str().size());
+    }
+
+    SECTION("Reader navigates the scene in place") {
+        std::string data = BinaryScene::Write(scene);
+        BinaryScene::Reader reader;
+        REQUIRE(reader.Open(data.data(), data.size()));
+        std::size_t root = reader.GetRoot();
+        REQUIRE(reader.IsObject(root));
+
+        glm::vec3 position;
+        REQUIRE(reader.GetVec3(reader.FindMember(root, reader.FindString("position")), position));
+        REQUIRE(position.x == 1.5f);
+        REQUIRE(position.y == -2.0f);
+        REQUIRE(position.z == 0.25f);
+
+        glm::quat rotation;
+        REQUIRE(reader.GetQuaternion(reader.FindMember(root, reader.FindString("rotation")), rotation));
+        REQUIRE(rotation.w == 1.0f);
+
+        REQUIRE(reader.GetUInt64(reader.FindMember(root, reader.FindString("uid"))) == 0xFFFFFFFF00000001ull);
+        REQUIRE(reader.GetBool(reader.FindMember(root, reader.FindString("enabled"))));
+        REQUIRE(*reader.GetStringValue(reader.FindMember(root, reader.FindString("name"))) == "Root");
+        REQUIRE(reader.FindMember(root, reader.FindString("missing")) == BinaryScene::Reader::NO_VALUE);
+
+        // Children are skipped over without decoding them.
+        std::size_t children = reader.FindMember(root, reader.FindString("children"));
+        REQUIRE(reader.IsArray(children));
+        REQUIRE(reader.GetCount(children) == 3);
+        std::size_t child = reader.GetFirst(children);
+        for (unsigned int i = 0; i < 3; ++i) {
+            Json::Value decoded;
+            reader.Decode(child, decoded);
+            REQUIRE(decoded == scene["children"][i]);
+            child = reader.GetNext(child);
+        }
+    }
+
+    SECTION("Scene nodes read binary values like JSON values") {
+        std::string data = BinaryScene::Write(scene);
+        BinaryScene::Reader reader;
+        REQUIRE(reader.Open(data.data(), data.size()));
+        SceneNode binary(reader, reader.GetRoot());
+        SceneNode json(scene);
+
+        for (const SceneNode& node : { json, binary }) {
+            REQUIRE(node.GetString("name", "") == "Root");
+            REQUIRE(node.GetString("missing", "Default") == "Default");
+            REQUIRE(node.GetUInt64("uid", 0) == 0xFFFFFFFF00000001ull);
+            REQUIRE(node.GetBool("enabled", false));
+            REQUIRE_FALSE(node.GetBool("static", true));
+            REQUIRE(node.GetInt("negative", 0) == -123456);
+            REQUIRE(node.GetFloat("precise", 0.0f) == 0.1f);
+            REQUIRE(node.GetFloat("missing", 2.5f) == 2.5f);
+            REQUIRE(node.GetMember("nothing").IsNull());
+            REQUIRE(node.GetMember("missing").IsNull());
+            REQUIRE_FALSE(node.IsMember("missing"));
+
+            glm::vec3 position = node.GetVec3("position");
+            REQUIRE(position.x == 1.5f);
+            REQUIRE(position.y == -2.0f);
+            REQUIRE(position.z == 0.25f);
+            REQUIRE(node.GetMember("notVector").GetFloat("x", 0.0f) == 1.0f);
+
+            // Byte arrays are stored as raw blobs in binary scenes.
+            SceneNode speed = node.GetMember("script").GetMember("propertyMap").GetMember("speed");
+            REQUIRE(node.GetMember("script").GetMember("propertyMap").GetMemberNames() == std::vector<std::string>(1, "speed"));
+            REQUIRE(speed.GetSize() == 16);
+            REQUIRE(speed.GetElement(15).AsInt() == 240);
+            REQUIRE(speed.GetElement(16).IsNull());
+            std::vector<uint8_t> bytes = speed.AsBytes();
+            REQUIRE(bytes.size() == 16);
+            REQUIRE(bytes[1] == 16);
+
+            SceneNode mixed = node.GetMember("mixed");
+            REQUIRE(mixed.GetSize() == 3);
+            REQUIRE(mixed.GetElement(1).AsInt() == 300);
+            REQUIRE(mixed.GetElement(2).AsString() == "text");
+            REQUIRE(node.GetMember("children").GetElement(2).GetString("name", "") == "Child");
+        }
+    }
+
+    SECTION("Truncated data is rejected") {
+        std::string data = BinaryScene::Write(scene);
+        Json::Value result;
+        for (std::size_t length = 0; length < data.size(); ++length)
+            REQUIRE_FALSE(BinaryScene::Read(data.data(), length, result));
+    }
+
+    SECTION("Corrupt data is rejected") {
+        std::string data = BinaryScene::Write(scene);
+        data.back() = static_cast<char>(0xFF);
+        data.push_back(0);
+        Json::Value result;
+        REQUIRE_FALSE(BinaryScene::Read(data.data(), data.size(), result));
+    }
+}
@@ -0,0 +1,93 @@
+#include <catch.hpp>
+#include <Engine/Particles/CpuParticleSimulator.hpp>
+#include <vector>
+
+namespace {
+    typedef Video::ParticleSystemRenderer::EmitterSettings EmitterSettings;
+
+    // Simulate an emitter for |steps| steps and return all of its particle state.
+    std::vector<float> Run(uint32_t seed, int threadCount, unsigned int particleCount, int steps) {
+        CpuParticleSimulator simulator(seed);
+        simulator.SetThreadCount(threadCount);
+
+        EmitterSettings settings;
+        settings.nr_particles = particleCount;
+        settings.spread = 5;
+        settings.rate = 0.1f;
+        settings.velocity = glm::vec3(0.0f, 1.0f, 0.0f);
+        settings.worldPos = glm::vec3(1.0f, 2.0f, 3.0f);
+
+        unsigned int emitter = simulator.AddEmitter(particleCount);
+        for (int i = 0; i < steps; ++i) {
+            simulator.Update(emitter, 0.1f, settings);
+            simulator.Simulate();
+        }
+
+        const CpuParticleSimulator::Particles& particles = simulator.GetParticles(emitter);
+        std::vector<float> state;
+        for (const std::vector<float>* array : { &particles.positionX, &particles.positionY, &particles.positionZ, &particles.velocityX, &particles.velocityY, &particles.velocityZ, &particles.life, &particles.alpha, &particles.shot })
+            state.insert(state.end(), array->begin(), array->end());
+
+        return state;
+    }
+}
+
+TEST_CASE("CPU particle simulator check", "[particles]") {
+    SECTION("Same seed gives the same particles") {
+        REQUIRE(Run(42, 1, 1024, 200) == Run(42, 1, 1024, 200));
+        REQUIRE(Run(42, 1, 1024, 200) != Run(43, 1, 1024, 200));
+    }
+
+    SECTION("Thread count doesn't affect the particles") {
+        REQUIRE(Run(7, 1, 20000, 50) == Run(7, 4, 20000, 50));
+    }
+
+    SECTION("Emitted particles move and expire") {
+        CpuParticleSimulator simulator;
+
+        EmitterSettings settings;
+        settings.nr_particles = 64;
+        settings.nr_new_particles = 4;
+        settings.spread = 1;
+        settings.randomVec = glm::vec3(0.0f, 1.0f, 0.0f);
+        settings.velocity = glm::vec3(0.0f, 0.0f, 0.0f);
+        settings.velocityMultiplier = 10.0f;
+        settings.mass = 0.0f;
+        settings.lifetime = 1.0f;
+        settings.rate = 100.0f;
+        settings.worldPos = glm::vec3(0.0f, 5.0f, 0.0f);
+
+        unsigned int emitter = simulator.AddEmitter(64);
+        simulator.Update(emitter, 0.1f, settings);
+        simulator.Simulate();
+
+        // The first burst is shot straight up from the emitter.
+        const CpuParticleSimulator::Particles& particles = simulator.GetParticles(emitter);
+        REQUIRE(particles.shot[10] == 1.0f);
+        REQUIRE(particles.positionY[10] == Approx(6.0f));
+        REQUIRE(particles.velocityY[10] == Approx(10.0f));
+        REQUIRE(particles.shot[63] == 0.0f);
+
+        // Particles are reset to the emitter once they outlive their lifetime.
+        for (int i = 0; i < 10; ++i) {
+            simulator.Update(emitter, 0.1f, settings);
+            simulator.Simulate();
+        }
+        REQUIRE(particles.shot[10] == 0.0f);
+        REQUIRE(particles.life[10] == 0.0f);
+        REQUIRE(particles.positionY[10] == Approx(5.0f));
+    }
+
+    SECTION("Changing the particle count resizes the emitter") {
+        CpuParticleSimulator simulator;
+        unsigned int emitter = simulator.AddEmitter(100);
+        REQUIRE(simulator.GetParticleCount(emitter) == 100);
+        REQUIRE(simulator.GetParticles(emitter).shot.size() % 4 == 0);
+
+        EmitterSettings settings;
+        settings.nr_particles = 10;
+        simulator.Update(emitter, 0.1f, settings);
+        simulator.Simulate();
+        REQUIRE(simulator.GetParticleCount(emitter) == 10);
+    }
+}
@@ -0,0 +1,125 @@
+#include <catch.hpp>
+#include <Video/DebugDrawingBatch.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+
+using namespace Video;
+
+namespace {
+    bool Equal(const glm::vec3& a, const glm::vec3& b) {
+        return glm::length(a - b) < 0.0001f;
+    }
+}
+
+TEST_CASE("Debug drawing batch check", "[debugdrawing]") {
+    DebugDrawingBatch batch;
+    const glm::vec3 red(1.0f, 0.0f, 0.0f);
+    const glm::vec3 green(0.0f, 1.0f, 0.0f);
+
+    SECTION("Empty batch has no groups") {
+        batch.Build();
+        REQUIRE(batch.GetVertices().empty());
+        REQUIRE(batch.GetGroups().empty());
+    }
+
+    SECTION("Lines are expanded into world space vertices") {
+        batch.AddLine(glm::vec3(1.0f, 2.0f, 3.0f), glm::vec3(4.0f, 5.0f, 6.0f), red, 1.0f, true);
+        batch.Build();
+
+        const std::vector<DebugDrawingBatch::Vertex>& vertices = batch.GetVertices();
+        REQUIRE(vertices.size() == 2);
+        REQUIRE(Equal(vertices[0].position, glm::vec3(1.0f, 2.0f, 3.0f)));
+        REQUIRE(Equal(vertices[1].position, glm::vec3(4.0f, 5.0f, 6.0f)));
+        REQUIRE(Equal(vertices[0].color, red));
+
+        REQUIRE(batch.GetGroups().size() == 1);
+        REQUIRE(!batch.GetGroups()[0].points);
+        REQUIRE(batch.GetGroups()[0].count == 2);
+    }
+
+    SECTION("Shapes are transformed by their matrix") {
+        glm::mat4 matrix(glm::translate(glm::mat4(), glm::vec3(10.0f, 0.0f, 0.0f)));
+        batch.AddCuboid(glm::vec3(2.0f, 4.0f, 6.0f), matrix, red, 1.0f, true);
+        batch.Build();
+
+        const std::vector<DebugDrawingBatch::Vertex>& vertices = batch.GetVertices();
+        REQUIRE(vertices.size() == 24);
+        for (const DebugDrawingBatch::Vertex& vertex : vertices) {
+            REQUIRE(std::abs(std::abs(vertex.position.x - 10.0f) - 1.0f) < 0.0001f);
+            REQUIRE(std::abs(std::abs(vertex.position.y) - 2.0f) < 0.0001f);
+            REQUIRE(std::abs(std::abs(vertex.position.z) - 3.0f) < 0.0001f);
+        }
+    }
+
+    SECTION("Spheres and circles have the radius they were given") {
+        const glm::vec3 center(1.0f, -2.0f, 3.0f);
+        batch.AddSphere(center, 2.5f, red, 1.0f, true);
+        batch.AddCircle(center, glm::vec3(0.0f, 1.0f, 0.0f), 2.5f, red, 1.0f, true);
+        batch.Build();
+
+        const std::vector<DebugDrawingBatch::Vertex>& vertices = batch.GetVertices();
+        REQUIRE(vertices.size() % 2 == 0);
+        for (const DebugDrawingBatch::Vertex& vertex : vertices)
+            REQUIRE(std::abs(glm::distance(vertex.position, center) - 2.5f) < 0.0001f);
+    }
+
+    SECTION("Circles lie in the plane of their normal") {
+        const glm::vec3 normals[] = { glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f) };
+        for (const glm::vec3& normal : normals) {
+            batch.Clear();
+            batch.AddCircle(glm::vec3(0.0f, 0.0f, 0.0f), normal, 1.0f, red, 1.0f, true);
+            batch.Build();
+
+            for (const DebugDrawingBatch::Vertex& vertex : batch.GetVertices())
+                REQUIRE(std::abs(glm::dot(vertex.position, normal)) < 0.0001f);
+        }
+    }
+
+    SECTION("Primitives are grouped by depth testing and line width") {
+        for (int i = 0; i < 100; ++i) {
+            batch.AddSphere(glm::vec3(static_cast<float>(i), 0.0f, 0.0f), 1.0f, red, 1.0f, true);
+            batch.AddCylinder(1.0f, 2.0f, glm::mat4(), green, 1.0f, true);
+            batch.AddLine(glm::vec3(0.0f), glm::vec3(1.0f), green, 2.0f, true);
+            batch.AddCone(1.0f, 2.0f, glm::mat4(), red, 1.0f, false);
+            batch.AddPoint(glm::vec3(0.0f), red, 5.0f, true);
+        }
+        batch.Build();
+
+        const std::vector<DebugDrawingBatch::Group>& groups = batch.GetGroups();
+        REQUIRE(groups.size() == 4);
+
+        // Groups cover the vertex stream without overlapping.
+        unsigned int first = 0;
+        for (const DebugDrawingBatch::Group& group : groups) {
+            REQUIRE(group.first == first);
+            REQUIRE(group.count > 0);
+            if (!group.points)
+                REQUIRE(group.count % 2 == 0);
+            first += group.count;
+        }
+        REQUIRE(first == batch.GetVertices().size());
+
+        REQUIRE(groups[0].depthTesting);
+        REQUIRE(groups[0].size == 1.0f);
+        REQUIRE(groups[1].size == 2.0f);
+        REQUIRE(groups[1].count == 200);
+        REQUIRE(!groups[2].depthTesting);
+        REQUIRE(groups[3].points);
+        REQUIRE(groups[3].size == 5.0f);
+        REQUIRE(groups[3].count == 100);
+    }
+
+    SECTION("Clear removes all primitives") {
+        batch.AddLine(glm::vec3(0.0f), glm::vec3(1.0f), red, 1.0f, true);
+        batch.Build();
+        batch.Clear();
+        batch.Build();
+        REQUIRE(batch.GetVertices().empty());
+        REQUIRE(batch.GetGroups().empty());
+
+        batch.AddPoint(glm::vec3(0.0f), red, 1.0f, false);
+        batch.Build();
+        REQUIRE(batch.GetGroups().size() == 1);
+        REQUIRE(batch.GetGroups()[0].points);
+    }
+}
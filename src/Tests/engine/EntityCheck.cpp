@@ -1,5 +1,7 @@
 #include <catch.hpp>
 #include <Engine/Entity/Entity.hpp>
+#include <Engine/Component/Material.hpp>
+#include <Engine/Component/Mesh.hpp>
 
 TEST_CASE("Entity check", "[entity component]")
 {
@@ -12,4 +14,13 @@ TEST_CASE("Entity check", "[entity component]")
         REQUIRE(nullWorldEntity.rotation == glm::quat(1, 0, 0, 0));
         REQUIRE(nullWorldEntity.scale == glm::vec3(1, 1, 1));
     }
+
+    SECTION ("Test component slots.")
+    {
+        REQUIRE(nullWorldEntity.GetComponentMask() == 0);
+        REQUIRE(nullWorldEntity.GetComponent<Component::Mesh>() == nullptr);
+        REQUIRE(nullWorldEntity.HasComponents(0));
+        REQUIRE_FALSE(nullWorldEntity.HasComponents(Component::MaskOf<Component::Mesh, Component::Material>()));
+        REQUIRE(Component::MaskOf<Component::Mesh, Component::Material>() == (Component::MaskOf<Component::Mesh>() | Component::MaskOf<Component::Material>()));
+    }
 }
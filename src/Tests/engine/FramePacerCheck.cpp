@@ -0,0 +1,81 @@
+#include <catch.hpp>
+#include <Engine/Util/FramePacer.hpp>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("Frame pacer check", "[framepacer]") {
+    FramePacer framePacer;
+
+    SECTION("Delta time is clamped") {
+        framePacer.SetMaxDeltaTime(0.1f);
+        REQUIRE(framePacer.SmoothDeltaTime(5.0) == Approx(0.1f));
+    }
+
+    SECTION("Delta time is averaged over a few frames") {
+        for (int i = 0; i < 10; ++i)
+            framePacer.SmoothDeltaTime(0.016);
+
+        // A single hitch only moves the delta time part of the way.
+        float deltaTime = framePacer.SmoothDeltaTime(0.05);
+        REQUIRE(deltaTime > 0.016f);
+        REQUIRE(deltaTime < 0.05f);
+
+        // And is forgotten after a few frames.
+        for (int i = 0; i < 10; ++i)
+            deltaTime = framePacer.SmoothDeltaTime(0.016);
+        REQUIRE(deltaTime == Approx(0.016f));
+    }
+
+    SECTION("Quality is lowered when frames are too slow and raised again when they're fast") {
+        framePacer.SetTargetFrameRate(60.0);
+        framePacer.SetQualityScaling(true);
+        framePacer.SetMinimumQualityScale(0.5f);
+        REQUIRE(framePacer.GetQualityScale() == 1.0f);
+
+        for (int i = 0; i < 1000; ++i)
+            framePacer.UpdateQualityScale(0.03);
+        REQUIRE(framePacer.GetQualityScale() == Approx(0.5f));
+
+        for (int i = 0; i < 1000; ++i)
+            framePacer.UpdateQualityScale(0.005);
+        REQUIRE(framePacer.GetQualityScale() == Approx(1.0f));
+    }
+
+    SECTION("Quality isn't changed without quality scaling") {
+        for (int i = 0; i < 1000; ++i)
+            framePacer.UpdateQualityScale(0.03);
+        REQUIRE(framePacer.GetQualityScale() == 1.0f);
+    }
+
+    SECTION("Frames are paced to the target frame rate") {
+        framePacer.SetTargetFrameRate(200.0);
+        framePacer.Reset();
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 10; ++i) {
+            framePacer.BeginFrame();
+            framePacer.EndFrame();
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        REQUIRE(elapsed >= 0.0495);
+        REQUIRE(framePacer.GetWorkTime() < 0.005);
+    }
+
+    SECTION("Time after the work is marked as done isn't counted as work") {
+        framePacer.SetTargetFrameRate(0.0);
+        framePacer.Reset();
+
+        framePacer.BeginFrame();
+        framePacer.MarkWorkEnd();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        framePacer.EndFrame();
+        REQUIRE(framePacer.GetWorkTime() < 0.01);
+
+        // Without marking, the whole frame is work.
+        framePacer.BeginFrame();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        framePacer.EndFrame();
+        REQUIRE(framePacer.GetWorkTime() >= 0.019);
+    }
+}
@@ -0,0 +1,86 @@
+#include <catch.hpp>
+#include <Engine/Component/AnimationController.hpp>
+#include <Engine/Component/Material.hpp>
+#include <Engine/Component/Mesh.hpp>
+#include <Engine/Component/ParticleSystem.hpp>
+#include <Engine/Component/Shape.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/Entity/World.hpp>
+#include <Engine/Manager/Managers.hpp>
+#include <Engine/Manager/ParticleManager.hpp>
+#include <Engine/Util/BinaryScene.hpp>
+#include <Engine/Util/Json.hpp>
+
+TEST_CASE("Headless world check", "[headless]") {
+    Managers().StartUpHeadless();
+
+    Json::Value child;
+    child["name"] = "Emitter";
+    child["scale"] = Json::SaveVec3(glm::vec3(1.0f, 1.0f, 1.0f));
+    child["AnimationController"] = Json::Value(Json::objectValue);
+    child["Mesh"]["meshName"] = "Missing";
+    child["Material"] = Json::Value(Json::objectValue);
+    child["Shape"]["sphere"]["radius"] = 1.0f;
+    child["ParticleSystem"]["NrOfParticles"] = 128;
+    child["ParticleSystem"]["emitAmount"] = 4;
+    child["ParticleSystem"]["mass"] = 0.0f;
+    child["ParticleSystem"]["randomVelocity"] = Json::SaveVec3(glm::vec3(0.0f, 1.0f, 0.0f));
+
+    Json::Value root;
+    root["name"] = "Root";
+    root["children"].append(child);
+
+    World world;
+    world.Load(root);
+
+    Entity* emitter = nullptr;
+    for (Entity* entity : world.GetEntities()) {
+        if (entity->name == "Emitter")
+            emitter = entity;
+    }
+    REQUIRE(emitter != nullptr);
+
+    SECTION("Components that need a graphics context are skipped") {
+        REQUIRE(emitter->GetComponent<Component::Material>() == nullptr);
+        REQUIRE(emitter->AddComponent<Component::Material>() == nullptr);
+        REQUIRE(emitter->GetComponent<Component::AnimationController>() != nullptr);
+        REQUIRE(emitter->GetComponent<Component::Mesh>() != nullptr);
+        REQUIRE(emitter->GetComponent<Component::Shape>() != nullptr);
+        REQUIRE(emitter->GetComponent<Component::ParticleSystemComponent>() != nullptr);
+        REQUIRE(emitter->GetComponent<Component::ParticleSystemComponent>()->particleType.nr_particles == 128);
+    }
+
+    SECTION("Binary scenes load the same as JSON scenes") {
+        std::string data = BinaryScene::Write(root);
+        BinaryScene::Reader reader;
+        REQUIRE(reader.Open(data.data(), data.size()));
+
+        World binaryWorld;
+        binaryWorld.Load(reader);
+        REQUIRE(binaryWorld.GetSaveJson() == world.GetSaveJson());
+        binaryWorld.Clear();
+    }
+
+    SECTION("Particles are simulated on the CPU") {
+        Managers().particleManager->SetCamera(glm::mat4(1.0f), glm::mat4(1.0f));
+        for (int i = 0; i < 10; ++i)
+            Managers().particleManager->Update(world, 0.1f);
+        REQUIRE(Managers().particleManager->GetTextureAtlas() == nullptr);
+
+        // Emitted particles are shot upwards from the emitter and none have expired yet.
+        const CpuParticleSimulator::Particles* particles = Managers().particleManager->GetSimulatedParticles(emitter->GetComponent<Component::ParticleSystemComponent>());
+        REQUIRE(particles != nullptr);
+        unsigned int liveCount = 0;
+        for (std::size_t i = 0; i < 128; ++i) {
+            if (particles->shot[i] == 1.0f) {
+                ++liveCount;
+                REQUIRE(particles->positionY[i] > 0.0f);
+            }
+        }
+        REQUIRE(liveCount >= 4);
+        REQUIRE(liveCount < 128);
+    }
+
+    world.Clear();
+    Managers().ShutDown();
+}
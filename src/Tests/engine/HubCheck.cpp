@@ -0,0 +1,25 @@
+#include <catch.hpp>
+#include <Engine/Component/Shape.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/Entity/World.hpp>
+#include <Engine/Manager/Managers.hpp>
+#include <Engine/Manager/PhysicsManager.hpp>
+
+TEST_CASE("Restarted hub clears killed components", "[headless]") {
+    Managers().StartUpHeadless();
+    Managers().ShutDown();
+    Managers().StartUpHeadless();
+
+    World world;
+    world.CreateRoot();
+    Entity* entity = world.GetRoot()->AddChild("Shape");
+    entity->AddComponent<Component::Shape>();
+    REQUIRE(Managers().physicsManager->GetShapeComponents().size() == 1);
+
+    entity->Kill();
+    world.ClearKilled();
+    REQUIRE(Managers().physicsManager->GetShapeComponents().empty());
+
+    world.Clear();
+    Managers().ShutDown();
+}
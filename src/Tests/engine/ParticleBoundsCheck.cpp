@@ -0,0 +1,69 @@
+#include <catch.hpp>
+#include <Engine/Particles/CpuParticleSimulator.hpp>
+#include <Video/ParticleSystemRenderer.hpp>
+
+namespace {
+    typedef Video::ParticleSystemRenderer::EmitterSettings EmitterSettings;
+
+    bool Contains(const Video::AxisAlignedBoundingBox& bounds, const glm::vec3& point) {
+        return point.x >= bounds.minVertex.x && point.x <= bounds.maxVertex.x
+            && point.y >= bounds.minVertex.y && point.y <= bounds.maxVertex.y
+            && point.z >= bounds.minVertex.z && point.z <= bounds.maxVertex.z;
+    }
+}
+
+TEST_CASE("Particle emitter bounds check", "[particles]") {
+    EmitterSettings settings;
+    settings.worldPos = glm::vec3(10.0f, 0.0f, -5.0f);
+    settings.spread = 4;
+    settings.rate = 0.1f;
+    settings.lifetime = 3.0f;
+    settings.mass = 1.0f;
+    settings.velocity = glm::vec3(0.1f, 0.2f, 0.0f);
+
+    SECTION("Simulated particles stay inside the bounds") {
+        Video::AxisAlignedBoundingBox bounds = Video::ParticleSystemRenderer::GetBounds(settings);
+        REQUIRE(Contains(bounds, settings.worldPos));
+
+        CpuParticleSimulator simulator(3);
+        unsigned int emitter = simulator.AddEmitter(settings.nr_particles);
+        unsigned int outside = 0;
+        for (int step = 0; step < 100; ++step) {
+            simulator.Update(emitter, 0.1f, settings);
+            simulator.Simulate();
+
+            const CpuParticleSimulator::Particles& particles = simulator.GetParticles(emitter);
+            for (unsigned int i = 0; i < simulator.GetParticleCount(emitter); ++i) {
+                if (particles.shot[i] == 1.0f && !Contains(bounds, glm::vec3(particles.positionX[i], particles.positionY[i], particles.positionZ[i])))
+                    ++outside;
+            }
+        }
+        REQUIRE(outside == 0);
+    }
+
+    SECTION("Bounds grow with lifetime and speed") {
+        Video::AxisAlignedBoundingBox bounds = Video::ParticleSystemRenderer::GetBounds(settings);
+
+        EmitterSettings longer = settings;
+        longer.lifetime = 6.0f;
+        Video::AxisAlignedBoundingBox longerBounds = Video::ParticleSystemRenderer::GetBounds(longer);
+        REQUIRE(longerBounds.dimensions.y > bounds.dimensions.y);
+
+        EmitterSettings faster = settings;
+        faster.velocityMultiplier = 20.0f;
+        Video::AxisAlignedBoundingBox fasterBounds = Video::ParticleSystemRenderer::GetBounds(faster);
+        REQUIRE(fasterBounds.dimensions.x > bounds.dimensions.x);
+    }
+
+    SECTION("Emitters without spread have tighter bounds") {
+        EmitterSettings narrow = settings;
+        narrow.spread = 1;
+        narrow.randomVec = glm::vec3(0.0f, 1.0f, 0.0f);
+        narrow.velocity = glm::vec3(0.0f, 0.0f, 0.0f);
+        narrow.mass = 0.0f;
+
+        Video::AxisAlignedBoundingBox bounds = Video::ParticleSystemRenderer::GetBounds(narrow);
+        REQUIRE(bounds.dimensions.x == Approx(narrow.scale * 2.0f * 1.4143f));
+        REQUIRE(bounds.maxVertex.y > narrow.worldPos.y + 10.0f);
+    }
+}
@@ -0,0 +1,169 @@
+#include <catch.hpp>
+#include <Engine/Component/RigidBody.hpp>
+#include <Engine/Component/Shape.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/Manager/Managers.hpp>
+#include <Engine/Manager/PhysicsManager.hpp>
+#include <Engine/Physics/Shape.hpp>
+#include <memory>
+#include <vector>
+
+namespace {
+    // Drop a body for |frames| frames of length |deltaTime| and return where it ends up.
+    glm::vec3 Drop(float deltaTime, int frames, bool interpolate) {
+        PhysicsManager* physicsManager = Managers().physicsManager;
+        physicsManager->SetTimeStep(1.0f / 60.0f, 4);
+        physicsManager->SetInterpolation(interpolate);
+
+        Entity entity(nullptr, "Body");
+        entity.position = glm::vec3(0.0f, 10.0f, 0.0f);
+        entity.AddComponent<Component::Shape>();
+        Component::RigidBody* rigidBody = entity.AddComponent<Component::RigidBody>();
+        physicsManager->ForceTransformSync(rigidBody);
+
+        for (int i = 0; i < frames; ++i) {
+            physicsManager->Update(deltaTime);
+            physicsManager->UpdateEntityTransforms();
+        }
+
+        glm::vec3 position = entity.position;
+        entity.KillComponent<Component::RigidBody>();
+        entity.KillComponent<Component::Shape>();
+        physicsManager->ClearKilledComponents();
+
+        return position;
+    }
+}
+
+TEST_CASE("Physics manager check", "[physics]")
+{
+    Managers().StartUpHeadless();
+    PhysicsManager* physicsManager = Managers().physicsManager;
+
+    SECTION ("Test sub step counts.")
+    {
+        physicsManager->SetTimeStep(1.0f / 60.0f, 4);
+
+        physicsManager->Update(1.0f / 60.0f);
+        REQUIRE(physicsManager->GetSubStepCount() == 1);
+        REQUIRE(physicsManager->GetDroppedSubStepCount() == 0);
+
+        physicsManager->Update(1.0f / 240.0f);
+        REQUIRE(physicsManager->GetSubStepCount() == 0);
+
+        physicsManager->Update(10.0f / 60.0f);
+        REQUIRE(physicsManager->GetSubStepCount() == 4);
+        REQUIRE(physicsManager->GetDroppedSubStepCount() > 0);
+    }
+
+    SECTION ("Test result is independent of frame rate.")
+    {
+        // Without interpolation, bodies are placed at the last whole step.
+        glm::vec3 fast = Drop(1.0f / 120.0f, 60, false);
+        glm::vec3 slow = Drop(1.0f / 30.0f, 15, false);
+        REQUIRE(fast.y < 10.0f);
+        REQUIRE(fast.y == Approx(slow.y));
+    }
+
+    SECTION ("Test shape cache.")
+    {
+        Physics::ShapeCache& shapeCache = physicsManager->GetShapeCache();
+        std::shared_ptr<Physics::Shape> box = shapeCache.Get(Physics::Shape::Box(1.0f, 2.0f, 3.0f));
+        std::shared_ptr<Physics::Shape> sameBox = shapeCache.Get(Physics::Shape::Box(1.0f, 2.0f, 3.0f));
+        std::shared_ptr<Physics::Shape> otherBox = shapeCache.Get(Physics::Shape::Box(3.0f, 2.0f, 1.0f));
+        std::shared_ptr<Physics::Shape> sphere = shapeCache.Get(Physics::Shape::Sphere(1.0f));
+        REQUIRE(box == sameBox);
+        REQUIRE(box != otherBox);
+        REQUIRE(shapeCache.GetShapeCount() == 3);
+
+        otherBox.reset();
+        shapeCache.Prune();
+        REQUIRE(shapeCache.GetShapeCount() == 2);
+    }
+
+    SECTION ("Test queries.")
+    {
+        // A static box with its top at y = 0.5.
+        Entity entity(nullptr, "Box");
+        physicsManager->SetShape(entity.AddComponent<Component::Shape>(), std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Box(1.0f, 1.0f, 1.0f))));
+        Component::RigidBody* rigidBody = entity.AddComponent<Component::RigidBody>();
+        physicsManager->SetMass(rigidBody, 0.0f);
+        physicsManager->ForceTransformSync(rigidBody);
+        physicsManager->Update(0.0f);
+
+        Physics::QueryHit hit;
+        REQUIRE(physicsManager->Raycast(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 100.0f, hit));
+        REQUIRE(hit.entity == &entity);
+        REQUIRE(hit.distance == Approx(9.5f));
+        REQUIRE(hit.normal.y == Approx(1.0f));
+        REQUIRE_FALSE(physicsManager->Raycast(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 5.0f, hit));
+        REQUIRE_FALSE(physicsManager->Raycast(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 100.0f, hit, Physics::QUERY_DYNAMIC));
+
+        std::vector<Physics::Ray> rays;
+        rays.push_back({ glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 100.0f });
+        rays.push_back({ glm::vec3(5.0f, 10.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 100.0f });
+        std::vector<Physics::QueryHit> hits;
+        physicsManager->Raycast(rays, hits);
+        REQUIRE(hits.size() == 2);
+        REQUIRE(hits[0].entity == &entity);
+        REQUIRE(hits[1].entity == nullptr);
+
+        REQUIRE(physicsManager->SphereSweep(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, -10.0f, 0.0f), 1.0f, hit));
+        REQUIRE(hit.entity == &entity);
+        REQUIRE(hit.point.y == Approx(0.5f));
+
+        std::vector<Entity*> entities;
+        physicsManager->OverlapSphere(glm::vec3(0.0f, 1.0f, 0.0f), 1.0f, entities);
+        REQUIRE(entities.size() == 1);
+        entities.clear();
+        physicsManager->OverlapBox(glm::vec3(5.0f, 0.0f, 0.0f), glm::vec3(1.0f, 1.0f, 1.0f), glm::quat(), entities);
+        REQUIRE(entities.empty());
+
+        entity.KillComponent<Component::RigidBody>();
+        entity.KillComponent<Component::Shape>();
+        physicsManager->ClearKilledComponents();
+    }
+
+    SECTION ("Test multithreaded world.")
+    {
+        glm::vec3 serial = Drop(1.0f / 60.0f, 30, false);
+
+        physicsManager->SetThreadCount(4);
+#ifdef USINGPHYSICSMULTITHREADING
+        REQUIRE(physicsManager->GetThreadCount() == 4);
+#else
+        REQUIRE(physicsManager->GetThreadCount() == 1);
+#endif
+
+        // A single body is simulated the same way on the multithreaded world.
+        glm::vec3 parallel = Drop(1.0f / 60.0f, 30, false);
+        REQUIRE(parallel.y < 10.0f);
+        REQUIRE(parallel.y == Approx(serial.y));
+
+        // Batched raycasts are split over the threads.
+        Entity entity(nullptr, "Box");
+        physicsManager->SetShape(entity.AddComponent<Component::Shape>(), std::shared_ptr<Physics::Shape>(new Physics::Shape(Physics::Shape::Box(1.0f, 1.0f, 1.0f))));
+        Component::RigidBody* rigidBody = entity.AddComponent<Component::RigidBody>();
+        physicsManager->SetMass(rigidBody, 0.0f);
+        physicsManager->ForceTransformSync(rigidBody);
+        physicsManager->Update(0.0f);
+
+        std::vector<Physics::Ray> rays;
+        for (int i = 0; i < 256; ++i)
+            rays.push_back({ glm::vec3(i % 2 == 0 ? 0.0f : 5.0f, 10.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 100.0f });
+        std::vector<Physics::QueryHit> hits;
+        physicsManager->Raycast(rays, hits);
+        REQUIRE(hits.size() == rays.size());
+        for (std::size_t i = 0; i < hits.size(); ++i)
+            REQUIRE(hits[i].entity == (i % 2 == 0 ? &entity : nullptr));
+
+        entity.KillComponent<Component::RigidBody>();
+        entity.KillComponent<Component::Shape>();
+        physicsManager->ClearKilledComponents();
+
+        physicsManager->SetThreadCount(1);
+        REQUIRE(physicsManager->GetThreadCount() == 1);
+    }
+
+    Managers().ShutDown();
+}
@@ -0,0 +1,188 @@
+#include <catch.hpp>
+#include <Engine/Manager/Managers.hpp>
+#include <Engine/Manager/ProfilingManager.hpp>
+#include <Engine/Util/Profiling.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace {
+    void Inner() {
+        PROFILE("Inner");
+    }
+
+    void Outer(int innerCount) {
+        PROFILE("Outer");
+        for (int i = 0; i < innerCount; ++i)
+            Inner();
+    }
+}
+
+TEST_CASE("Profiling manager check", "[profiling]") {
+    Managers().StartUpHeadless();
+    ProfilingManager* profilingManager = Managers().profilingManager;
+    profilingManager->SetActive(true);
+
+    SECTION("Zones are registered once") {
+        unsigned int zone = ProfilingManager::RegisterZone("Zone");
+        REQUIRE(ProfilingManager::RegisterZone("Zone") == zone);
+        REQUIRE(ProfilingManager::RegisterZone("Other zone") != zone);
+        REQUIRE(std::string(ProfilingManager::GetZoneName(zone)) == "Zone");
+    }
+
+    SECTION("Results are built from the last frame") {
+        profilingManager->BeginFrame();
+        Outer(3);
+        profilingManager->EndFrame();
+
+        ProfilingManager::Result* result = profilingManager->GetResult(ProfilingManager::CPU_TIME);
+        REQUIRE(result->children.size() == 1);
+
+        ProfilingManager::Result& outer = result->children.front();
+        REQUIRE(outer.name == "Outer");
+        REQUIRE(outer.value <= result->value);
+
+        // Calls of the same zone are merged.
+        REQUIRE(outer.children.size() == 1);
+        REQUIRE(outer.children.front().name == "Inner");
+        REQUIRE(outer.children.front().value <= outer.value);
+
+        // The next frame replaces the results.
+        profilingManager->BeginFrame();
+        Inner();
+        profilingManager->EndFrame();
+
+        result = profilingManager->GetResult(ProfilingManager::CPU_TIME);
+        REQUIRE(result->children.size() == 1);
+        REQUIRE(result->children.front().name == "Inner");
+        REQUIRE(result->children.front().children.empty());
+    }
+
+    SECTION("Zones are ignored when not active") {
+        profilingManager->BeginFrame();
+        profilingManager->SetActive(false);
+        Outer(1);
+        profilingManager->SetActive(true);
+        profilingManager->EndFrame();
+        REQUIRE(profilingManager->GetResult(ProfilingManager::CPU_TIME)->children.empty());
+    }
+
+    SECTION("Frame times are recorded") {
+        profilingManager->BeginFrame();
+        Outer(10);
+        profilingManager->EndFrame();
+
+        bool recorded = false;
+        for (unsigned int i = 0; i < profilingManager->GetFrameCount(); ++i)
+            recorded = recorded || profilingManager->GetCPUFrameTimes()[i] > 0.0f;
+        REQUIRE(recorded);
+    }
+
+    SECTION("Captures include all threads") {
+        profilingManager->StartCapture();
+
+        profilingManager->BeginFrame();
+        Outer(1);
+        profilingManager->EndFrame();
+
+        profilingManager->BeginFrame();
+        std::thread worker([]() {
+            ProfilingManager::SetThreadName("Worker");
+            PROFILE("Work");
+        });
+        worker.join();
+        Inner();
+        profilingManager->EndFrame();
+
+        profilingManager->StopCapture();
+        REQUIRE(profilingManager->GetCapturedFrameCount() == 2);
+
+        // Only the requested frames are written.
+        const std::string filename = "ProfilingManagerCheck.json";
+        REQUIRE(profilingManager->WriteTrace(filename, 1, 5));
+        std::ifstream file(filename);
+        std::stringstream stream;
+        stream << file.rdbuf();
+        file.close();
+        std::remove(filename.c_str());
+        std::string trace = stream.str();
+
+        REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+        REQUIRE(trace.find("\"name\":\"Frame 1\"") != std::string::npos);
+        REQUIRE(trace.find("\"name\":\"Frame 0\"") == std::string::npos);
+        REQUIRE(trace.find("\"name\":\"Worker\"") != std::string::npos);
+        REQUIRE(trace.find("\"name\":\"Work\"") != std::string::npos);
+        REQUIRE(trace.find("\"name\":\"Inner\"") != std::string::npos);
+        REQUIRE(trace.find("\"name\":\"Outer\"") == std::string::npos);
+    }
+
+    SECTION("Threads can trace into buffers created ahead of time") {
+        // Like the audio callback, which must not allocate or lock.
+        unsigned int zone = ProfilingManager::RegisterZone("Real-time work");
+        ProfilingManager::TraceBuffer* buffer = ProfilingManager::CreateTraceBuffer("Real-time");
+
+        profilingManager->StartCapture();
+        profilingManager->BeginFrame();
+        std::thread worker([zone, buffer]() {
+            ProfilingManager::SetTraceBuffer(buffer);
+            Profiling profiling(zone);
+        });
+        worker.join();
+        Inner();
+        profilingManager->EndFrame();
+        profilingManager->StopCapture();
+
+        const std::string filename = "ProfilingManagerCheck.json";
+        REQUIRE(profilingManager->WriteTrace(filename, 0, 0));
+        std::ifstream file(filename);
+        std::stringstream stream;
+        stream << file.rdbuf();
+        file.close();
+        std::remove(filename.c_str());
+        std::string trace = stream.str();
+
+        REQUIRE(trace.find("\"name\":\"Real-time\"") != std::string::npos);
+        REQUIRE(trace.find("\"name\":\"Real-time work\"") != std::string::npos);
+
+        // Released buffers are reused.
+        ProfilingManager::ReleaseTraceBuffer(buffer);
+        ProfilingManager::TraceBuffer* reused = ProfilingManager::CreateTraceBuffer("Real-time");
+        ProfilingManager::ReleaseTraceBuffer(reused);
+        REQUIRE(ProfilingManager::CreateTraceBuffer("Real-time") == reused);
+        ProfilingManager::ReleaseTraceBuffer(reused);
+    }
+
+    SECTION("Buffers of exited threads are reused") {
+        profilingManager->StartCapture();
+        profilingManager->BeginFrame();
+        for (const char* name : { "First", "Second" }) {
+            std::thread worker([name]() {
+                ProfilingManager::SetThreadName(name);
+                PROFILE("Work");
+            });
+            worker.join();
+        }
+        profilingManager->EndFrame();
+        profilingManager->StopCapture();
+
+        const std::string filename = "ProfilingManagerCheck.json";
+        REQUIRE(profilingManager->WriteTrace(filename, 0, 0));
+        std::ifstream file(filename);
+        std::stringstream stream;
+        stream << file.rdbuf();
+        file.close();
+        std::remove(filename.c_str());
+        std::string trace = stream.str();
+
+        // The second thread records into the first thread's buffer, after its events.
+        REQUIRE(trace.find("\"name\":\"First\"") == std::string::npos);
+        REQUIRE(trace.find("\"name\":\"Second\"") != std::string::npos);
+        std::size_t work = trace.find("\"name\":\"Work\"");
+        REQUIRE(work != std::string::npos);
+        REQUIRE(trace.find("\"name\":\"Work\"", work + 1) != std::string::npos);
+    }
+
+    profilingManager->SetActive(false);
+    Managers().ShutDown();
+}
@@ -0,0 +1,101 @@
+#include <catch.hpp>
+#include <Engine/Entity/SceneTemplate.hpp>
+#include <Engine/Hymn.hpp>
+#include <Engine/Manager/Managers.hpp>
+#include <Engine/Manager/ResourceManager.hpp>
+#include <Engine/Util/BinaryScene.hpp>
+#include <Engine/Util/FileSystem.hpp>
+#include <map>
+#include <vector>
+
+namespace {
+    // Write a scene which instantiates the given scenes.
+    void WriteScene(const std::string& name, const std::vector<std::string>& nestedScenes) {
+        Json::Value root;
+        root["name"] = name;
+        for (const std::string& nestedName : nestedScenes) {
+            Json::Value child;
+            child["scene"] = true;
+            child["sceneName"] = nestedName;
+            root["children"].append(child);
+        }
+
+        BinaryScene::SaveFile(Hymn().GetPath() + "/" + name + ".json", root, false);
+    }
+
+    // Write a binary scene which instantiates the given scene.
+    void WriteBinaryScene(const std::string& name, const std::string& nestedName) {
+        Json::Value child;
+        child["scene"] = true;
+        child["sceneName"] = nestedName;
+
+        Json::Value root;
+        root["name"] = name;
+        root["children"].append(child);
+
+        BinaryScene::SaveFile(Hymn().GetPath() + "/" + name + BinaryScene::EXTENSION, root, true);
+    }
+}
+
+TEST_CASE("Scene template check", "[SceneTemplate]") {
+    Managers().StartUpHeadless();
+
+    const std::string path = FileSystem::TemporaryPath("SceneTemplateCheck");
+    Hymn().SetPath(path);
+
+    SECTION("Referenced scenes are gathered through cycles") {
+        // A -> {B, X}, X -> Y, B -> C, C -> A.
+        std::map<std::string, std::vector<std::string>> scenes;
+        scenes["A"] = { "B", "X" };
+        scenes["B"] = { "C" };
+        scenes["C"] = { "A" };
+        scenes["X"] = { "Y" };
+        scenes["Y"] = {};
+        for (auto& scene : scenes)
+            WriteScene(scene.first, scene.second);
+
+        // Templates found further down the recursion must see the whole cycle.
+        for (auto& scene : scenes) {
+            const SceneTemplate* sceneTemplate = Managers().resourceManager->GetSceneTemplate(scene.first);
+            REQUIRE(sceneTemplate->IsValid());
+        }
+
+        const std::string cycle[] = { "A", "B", "C" };
+        for (const std::string& name : cycle) {
+            const SceneTemplate* sceneTemplate = Managers().resourceManager->GetSceneTemplate(name);
+            for (const std::string& other : { "A", "B", "C", "X", "Y" })
+                REQUIRE(sceneTemplate->ReferencesScene(other));
+        }
+
+        const SceneTemplate* x = Managers().resourceManager->GetSceneTemplate("X");
+        REQUIRE(x->ReferencesScene("Y"));
+        REQUIRE_FALSE(x->ReferencesScene("A"));
+        REQUIRE_FALSE(Managers().resourceManager->GetSceneTemplate("Y")->ReferencesScene("Y"));
+    }
+
+    SECTION("Binary scenes are preferred and read in place") {
+        WriteScene("Binary", {});
+        WriteBinaryScene("Binary", "Nested");
+        WriteScene("Nested", {});
+
+        const SceneTemplate* sceneTemplate = Managers().resourceManager->GetSceneTemplate("Binary");
+        REQUIRE(sceneTemplate->IsValid());
+        REQUIRE(sceneTemplate->IsBinary());
+        REQUIRE(sceneTemplate->ReferencesScene("Nested"));
+        REQUIRE_FALSE(Managers().resourceManager->GetSceneTemplate("Nested")->IsBinary());
+    }
+
+    SECTION("Scenes that failed to load are loaded again") {
+        REQUIRE_FALSE(Managers().resourceManager->GetSceneTemplate("Later")->IsValid());
+
+        WriteScene("Later", {});
+        REQUIRE(Managers().resourceManager->GetSceneTemplate("Later")->IsValid());
+    }
+
+    Managers().resourceManager->ClearSceneTemplates();
+    Hymn().Clear();
+    Managers().ShutDown();
+
+    FileSystem::RemoveDirectory(path);
+    REQUIRE_FALSE(FileSystem::FileExists(path.c_str()));
+}
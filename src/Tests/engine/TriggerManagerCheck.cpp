@@ -0,0 +1,133 @@
+#include <catch.hpp>
+#include <Engine/Component/Trigger.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/Entity/World.hpp>
+#include <Engine/Hymn.hpp>
+#include <Engine/Manager/Managers.hpp>
+#include <Engine/Manager/TriggerManager.hpp>
+#include <Engine/Trigger/SuperTrigger.hpp>
+#include <Engine/Trigger/TriggerEvent.hpp>
+#include <Engine/Trigger/TriggerRepeat.hpp>
+#include <Engine/Util/Json.hpp>
+#include <vector>
+
+namespace {
+    // Trigger recording the events dispatched to it.
+    class RecordingTrigger : public SuperTrigger {
+        public:
+            explicit RecordingTrigger(std::vector<triggerEvent::QueuedEvent>& events) : events(events) {}
+
+            void Process(const triggerEvent::QueuedEvent& event) override {
+                events.push_back(event);
+
+                // Events queued while dispatching wait for the next dispatch.
+                if (queueOnProcess)
+                    Managers().triggerManager->QueueEvent(this, event.entity, triggerEvent::LEAVE);
+                queueOnProcess = false;
+            }
+
+            void Update() override {}
+            Json::Value Save() override { return Json::Value(); }
+            void InitTriggerUID() override {}
+            void InitiateVolumes() override {}
+
+            bool queueOnProcess = false;
+
+        private:
+            std::vector<triggerEvent::QueuedEvent>& events;
+    };
+}
+
+TEST_CASE("Trigger manager check", "[trigger]") {
+    Managers().StartUpHeadless();
+
+    Json::Value root;
+    root["name"] = "Root";
+    Hymn().world.Load(root);
+    Entity* first = Hymn().world.GetRoot()->AddChild("First");
+    Entity* second = Hymn().world.GetRoot()->AddChild("Second");
+
+    std::vector<triggerEvent::QueuedEvent> events;
+
+    SECTION("Events are dispatched in the order they were queued") {
+        RecordingTrigger trigger(events);
+        trigger.queueOnProcess = true;
+        Managers().triggerManager->QueueEvent(&trigger, first, triggerEvent::ENTER);
+        Managers().triggerManager->QueueEvent(&trigger, second, triggerEvent::ENTER);
+        Managers().triggerManager->QueueEvent(&trigger, first, triggerEvent::RETAIN);
+
+        Managers().triggerManager->ProcessTriggers();
+        REQUIRE(events.size() == 3);
+        REQUIRE(events[0].entity == first);
+        REQUIRE(events[0].phase == triggerEvent::ENTER);
+        REQUIRE(events[1].entity == second);
+        REQUIRE(events[1].phase == triggerEvent::ENTER);
+        REQUIRE(events[2].entity == first);
+        REQUIRE(events[2].phase == triggerEvent::RETAIN);
+
+        // The event queued during the dispatch is kept for the next one.
+        REQUIRE(Managers().triggerManager->GetQueuedEvents().size() == 1);
+        Managers().triggerManager->ProcessTriggers();
+        REQUIRE(events.size() == 4);
+        REQUIRE(events[3].phase == triggerEvent::LEAVE);
+        REQUIRE(Managers().triggerManager->GetQueuedEvents().empty());
+    }
+
+    SECTION("Events of killed triggers are dropped") {
+        Component::Trigger* killed = first->AddComponent<Component::Trigger>();
+        Component::Trigger* alive = second->AddComponent<Component::Trigger>();
+        REQUIRE(killed != nullptr);
+        REQUIRE(alive != nullptr);
+        killed->SetTrigger(new RecordingTrigger(events));
+        alive->SetTrigger(new RecordingTrigger(events));
+
+        Managers().triggerManager->QueueEvent(killed->GetTrigger(), second, triggerEvent::ENTER);
+        Managers().triggerManager->QueueEvent(alive->GetTrigger(), first, triggerEvent::ENTER);
+        first->KillComponent<Component::Trigger>();
+        Hymn().world.ClearKilled();
+
+        Managers().triggerManager->ProcessTriggers();
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].trigger == alive->GetTrigger());
+    }
+
+    SECTION("Events are dispatched to the targets of their collided entities") {
+        Entity* third = Hymn().world.GetRoot()->AddChild("Third");
+
+        TriggerRepeat repeat;
+        repeat.SetCollidedEntityUID(0, first->GetUniqueIdentifier());
+        repeat.SetCollidedEntityUID(1, first->GetUniqueIdentifier());
+        repeat.SetCollidedEntityUID(2, second->GetUniqueIdentifier());
+        repeat.InitTriggerUID();
+
+        triggerEvent::EventStruct eventStruct;
+        eventStruct.m_eventID = triggerEvent::ENTER;
+        for (bool& check : eventStruct.check)
+            check = true;
+        repeat.GetEventVector()->assign(3, eventStruct);
+        *repeat.GetTargetEntity() = { second, third, first };
+        *repeat.GetTargetFunction() = { "void A()", "void B()", "void C()" };
+
+        // Both events of the first entity run, on different targets.
+        triggerEvent::QueuedEvent event = { &repeat, first, triggerEvent::ENTER };
+        REQUIRE(repeat.IsEventTriggered(0, event));
+        REQUIRE(repeat.IsEventTriggered(1, event));
+        REQUIRE_FALSE(repeat.IsEventTriggered(2, event));
+
+        event.entity = second;
+        REQUIRE_FALSE(repeat.IsEventTriggered(0, event));
+        REQUIRE_FALSE(repeat.IsEventTriggered(1, event));
+        REQUIRE(repeat.IsEventTriggered(2, event));
+
+        // Other phases and entities don't run any events.
+        event.phase = triggerEvent::LEAVE;
+        REQUIRE_FALSE(repeat.IsEventTriggered(2, event));
+        event.entity = third;
+        event.phase = triggerEvent::ENTER;
+        for (std::size_t i = 0; i < 3; ++i)
+            REQUIRE_FALSE(repeat.IsEventTriggered(i, event));
+    }
+
+    Hymn().world.Clear();
+    Managers().ShutDown();
+}
@@ -0,0 +1,96 @@
+#include <catch.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/Entity/UniqueIdentifierAllocator.hpp>
+
+TEST_CASE("Unique identifier allocator", "[UniqueIdentifierAllocator]") {
+    UniqueIdentifierAllocator allocator;
+    Entity first(nullptr, "First");
+    Entity second(nullptr, "Second");
+
+    SECTION("Allocated identifiers are unique and valid") {
+        uint64_t a = allocator.Allocate(&first);
+        uint64_t b = allocator.Allocate(&second);
+        REQUIRE(a != b);
+        REQUIRE(a != UniqueIdentifierAllocator::INVALID);
+        REQUIRE(allocator.Get(a) == &first);
+        REQUIRE(allocator.Get(b) == &second);
+    }
+
+    SECTION("Freed identifiers are invalidated") {
+        uint64_t a = allocator.Allocate(&first);
+        allocator.Free(a);
+        REQUIRE_FALSE(allocator.IsValid(a));
+        REQUIRE(allocator.Get(a) == nullptr);
+
+        SECTION("Reused slots get a new generation") {
+            uint64_t b = allocator.Allocate(&second);
+            REQUIRE(UniqueIdentifierAllocator::GetIndex(a) == UniqueIdentifierAllocator::GetIndex(b));
+            REQUIRE(UniqueIdentifierAllocator::GetGeneration(a) != UniqueIdentifierAllocator::GetGeneration(b));
+            REQUIRE(allocator.Get(a) == nullptr);
+            REQUIRE(allocator.Get(b) == &second);
+        }
+    }
+
+    SECTION("Saved identifiers can be reserved") {
+        uint64_t saved = UniqueIdentifierAllocator::MakeIdentifier(5, 3);
+        REQUIRE(allocator.Reserve(saved, &first) == saved);
+        REQUIRE(allocator.Get(saved) == &first);
+        REQUIRE(allocator.GetSlotCount() == 6);
+
+        SECTION("Reserving a taken identifier allocates an alias") {
+            uint64_t b = allocator.Reserve(saved, &second);
+            REQUIRE(b != saved);
+            REQUIRE(allocator.Get(b) == &second);
+            REQUIRE(allocator.Get(saved) == &first);
+        }
+    }
+
+    SECTION("Legacy identifiers resolve through aliases") {
+        uint64_t legacy = 1510000000;
+        uint64_t a = allocator.Reserve(legacy, &first);
+        uint64_t b = allocator.Reserve(legacy, &second);
+        REQUIRE(a != legacy);
+        REQUIRE(b != legacy);
+        REQUIRE(allocator.Get(legacy) == &first);
+        REQUIRE(allocator.GetSlotCount() == 2);
+
+        SECTION("Aliases are removed when their entity is freed") {
+            allocator.Free(a);
+            REQUIRE(allocator.Get(legacy) == nullptr);
+
+            // The alias can be claimed again.
+            Entity third(nullptr, "Third");
+            allocator.Reserve(legacy, &third);
+            REQUIRE(allocator.Get(legacy) == &third);
+        }
+    }
+
+    SECTION("Reserving an old generation doesn't revive stale identifiers") {
+        uint64_t a = allocator.Allocate(&first);
+        allocator.Free(a);
+
+        uint64_t b = allocator.Reserve(a, &second);
+        REQUIRE(b != a);
+        REQUIRE(UniqueIdentifierAllocator::GetGeneration(b) > UniqueIdentifierAllocator::GetGeneration(a));
+        REQUIRE_FALSE(allocator.IsValid(a));
+        REQUIRE(allocator.Get(b) == &second);
+    }
+
+    SECTION("Corrupt indices don't grow the slot array") {
+        uint64_t corrupt = UniqueIdentifierAllocator::MakeIdentifier(0xFFFFFFF0u, 1);
+        uint64_t a = allocator.Reserve(corrupt, &first);
+        REQUIRE(a != corrupt);
+        REQUIRE(allocator.GetSlotCount() == 1);
+        REQUIRE(allocator.Get(corrupt) == &first);
+    }
+
+    SECTION("Clear frees all identifiers") {
+        uint64_t a = allocator.Allocate(&first);
+        allocator.Clear();
+        REQUIRE(allocator.Get(a) == nullptr);
+
+        // Reloading the cleared world gets the same identifiers back.
+        REQUIRE(allocator.Reserve(a, &second) == a);
+        REQUIRE(allocator.Get(a) == &second);
+    }
+}
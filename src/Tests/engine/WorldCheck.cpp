@@ -0,0 +1,98 @@
+#include <catch.hpp>
+#include <Engine/Entity/Entity.hpp>
+#include <Engine/Entity/World.hpp>
+#include <Engine/Hymn.hpp>
+#include <Engine/Manager/Managers.hpp>
+#include <Engine/Manager/PhysicsManager.hpp>
+#include <Engine/Manager/RenderManager.hpp>
+#include <Engine/Util/BinaryScene.hpp>
+#include <Engine/Util/Json.hpp>
+#include <vector>
+
+namespace {
+    // Get the identifiers of an entity tree in depth-first order.
+    void GetIdentifiers(const Entity* entity, std::vector<uint64_t>& identifiers) {
+        identifiers.push_back(entity->GetUniqueIdentifier());
+        for (const Entity* child : entity->GetChildren())
+            GetIdentifiers(child, identifiers);
+    }
+}
+
+TEST_CASE("World check", "[world]") {
+    Managers().StartUpHeadless();
+
+    World world;
+    world.CreateRoot();
+    Entity* removed = world.GetRoot()->AddChild("Removed");
+    Entity* parent = world.GetRoot()->AddChild("Parent");
+    parent->AddChild("Child");
+
+    // Reuse a freed slot, so the saved identifiers aren't all of the first generation.
+    removed->Kill();
+    world.ClearKilled();
+    world.GetRoot()->AddChild("Reused");
+
+    std::vector<uint64_t> identifiers;
+    GetIdentifiers(world.GetRoot(), identifiers);
+    REQUIRE(identifiers.size() == 4);
+
+    SECTION("Identifiers survive saving and loading") {
+        for (int i = 0; i < 3; ++i) {
+            world.Load(world.GetSaveJson());
+
+            std::vector<uint64_t> loadedIdentifiers;
+            GetIdentifiers(world.GetRoot(), loadedIdentifiers);
+            REQUIRE(loadedIdentifiers == identifiers);
+            for (uint64_t identifier : identifiers)
+                REQUIRE(world.GetEntityByUniqueIdentifier(identifier) != nullptr);
+        }
+    }
+
+    SECTION("Identifiers survive saving and loading binary scenes") {
+        for (int i = 0; i < 3; ++i) {
+            std::string data = BinaryScene::Write(world.GetSaveJson());
+            BinaryScene::Reader reader;
+            REQUIRE(reader.Open(data.data(), data.size()));
+            world.Load(reader);
+
+            std::vector<uint64_t> loadedIdentifiers;
+            GetIdentifiers(world.GetRoot(), loadedIdentifiers);
+            REQUIRE(loadedIdentifiers == identifiers);
+        }
+    }
+
+    world.Clear();
+    Managers().ShutDown();
+}
+
+TEST_CASE("Pipelined world check", "[world]") {
+    Managers().StartUpHeadless();
+
+    Json::Value root;
+    root["name"] = "Root";
+    Hymn().world.Load(root);
+    Hymn().SetPipelined(true);
+
+    SECTION("Loading the world discards the render snapshot") {
+        Hymn().UpdateAndRender(0.016f, RenderManager::MONITOR);
+        REQUIRE(Hymn().HasRenderSnapshot());
+
+        Hymn().world.Load(root);
+        REQUIRE_FALSE(Hymn().HasRenderSnapshot());
+
+        Hymn().UpdateAndRender(0.016f, RenderManager::MONITOR);
+        REQUIRE(Hymn().HasRenderSnapshot());
+
+        Hymn().world.Clear();
+        REQUIRE_FALSE(Hymn().HasRenderSnapshot());
+    }
+
+    SECTION("Physics uses one thread when pipelined") {
+        Managers().physicsManager->SetThreadCount(4);
+        REQUIRE(Managers().physicsManager->GetThreadCount() == 1);
+    }
+
+    Hymn().SetPipelined(false);
+    Hymn().world.Clear();
+    Managers().ShutDown();
+}
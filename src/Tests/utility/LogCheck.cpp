@@ -1,6 +1,10 @@
 #include <catch.hpp>
 #include <Utility/Log.hpp>
+#include <cstdio>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 void testException() {
     Log(Log::ERR) << "Test\n";
@@ -36,6 +40,77 @@ TEST_CASE("Log check", "[Log]") {
         
     }
 
+    SECTION("Records from several threads aren't interleaved") {
+        std::stringstream stream;
+        REQUIRE(Log().SetupStream(Log::DEFAULT, &stream));
+
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < 4; ++thread) {
+            threads.emplace_back([thread]() {
+                for (int i = 0; i < 100; ++i)
+                    Log() << "Thread " << thread << ": " << i << "\n";
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        Log::Flush();
+
+        // Every line is complete and each thread's lines are in order.
+        int next[4] = { 0, 0, 0, 0 };
+        Log::AccessStreams([&stream, &next]() {
+            std::string line;
+            while (std::getline(stream, line)) {
+                int thread, i;
+                REQUIRE(std::sscanf(line.c_str(), "Thread %d: %d", &thread, &i) == 2);
+                REQUIRE(i == next[thread]++);
+            }
+        });
+        for (int count : next)
+            REQUIRE(count == 100);
+
+        REQUIRE(Log().SetupStream(Log::DEFAULT, &std::cout));
+    }
+
+    SECTION("Channels below the minimum severity are ignored") {
+        std::stringstream stream;
+        REQUIRE(Log().SetupStreams(&stream, &stream, &stream, &stream));
+        Log::SetMinimumSeverity(Log::WARNING);
+        REQUIRE(Log::GetMinimumSeverity() == Log::WARNING);
+
+        Log() << "Default\n";
+        Log(Log::INFO) << "Info " << 1.5f << "\n";
+        Log(Log::WARNING) << "Warning " << 1.5f << "\n";
+        Log::Flush();
+        Log::SetMinimumSeverity(Log::DEFAULT);
+
+        Log::AccessStreams([&stream]() {
+            REQUIRE(stream.str() == "Warning 1.5\n");
+        });
+
+        REQUIRE(Log().SetupStreams(&std::cout, &std::cout, &std::cout, &std::cerr));
+    }
+
+    SECTION("Errors are written right away and never dropped") {
+        std::stringstream stream;
+        REQUIRE(Log().SetupStreams(&stream, &stream, &stream, &stream));
+
+        // Fill the buffer so that records are dropped.
+        for (int i = 0; i < 2000; ++i)
+            Log() << "Record\n";
+
+        // Errors throw when testing, after the text has been added to the record.
+        try {
+            Log(Log::ERR) << "Error\n";
+        } catch (...) {
+        }
+
+        Log::AccessStreams([&stream]() {
+            REQUIRE(stream.str().find("Error\n") != std::string::npos);
+        });
+
+        REQUIRE(Log().SetupStreams(&std::cout, &std::cout, &std::cout, &std::cerr));
+    }
+
     SECTION("Throwing exceptions with log") {
         REQUIRE_THROWS( testException() );
     }
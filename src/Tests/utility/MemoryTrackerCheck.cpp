@@ -0,0 +1,72 @@
+#include <catch.hpp>
+#include <Utility/MemoryTracker.hpp>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace Utility;
+
+TEST_CASE("Memory tracker check", "[MemoryTracker]") {
+    // Other tests may have allocated memory already, so only compare with the usage before.
+    MemoryTracker::Usage before = MemoryTracker::GetUsage(MemoryTracker::MESHES);
+
+    SECTION("Allocations are counted per tag") {
+        MemoryTracker::Usage particlesBefore = MemoryTracker::GetUsage(MemoryTracker::PARTICLES);
+
+        MemoryTracker::Allocate(MemoryTracker::MESHES, 100);
+        MemoryTracker::Allocate(MemoryTracker::MESHES, 50);
+        MemoryTracker::Usage usage = MemoryTracker::GetUsage(MemoryTracker::MESHES);
+        REQUIRE(usage.liveBytes == before.liveBytes + 150);
+        REQUIRE(usage.liveAllocations == before.liveAllocations + 2);
+        REQUIRE(usage.totalAllocations == before.totalAllocations + 2);
+        REQUIRE(MemoryTracker::GetUsage(MemoryTracker::PARTICLES).liveBytes == particlesBefore.liveBytes);
+
+        MemoryTracker::Free(MemoryTracker::MESHES, 100);
+        MemoryTracker::Free(MemoryTracker::MESHES, 50);
+        usage = MemoryTracker::GetUsage(MemoryTracker::MESHES);
+        REQUIRE(usage.liveBytes == before.liveBytes);
+        REQUIRE(usage.liveAllocations == before.liveAllocations);
+        REQUIRE(usage.totalAllocations == before.totalAllocations + 2);
+    }
+
+    SECTION("The peak is kept until it's reset") {
+        MemoryTracker::ResetPeaks();
+        MemoryTracker::Allocate(MemoryTracker::MESHES, 1000);
+        MemoryTracker::Free(MemoryTracker::MESHES, 1000);
+        REQUIRE(MemoryTracker::GetUsage(MemoryTracker::MESHES).peakBytes == before.liveBytes + 1000);
+
+        MemoryTracker::ResetPeaks();
+        REQUIRE(MemoryTracker::GetUsage(MemoryTracker::MESHES).peakBytes == before.liveBytes);
+    }
+
+    SECTION("Tagged allocations report their size when freed") {
+        void* memory = MemoryTracker::TaggedMalloc(MemoryTracker::MESHES, 256);
+        REQUIRE(memory != nullptr);
+        REQUIRE(reinterpret_cast<uintptr_t>(memory) % alignof(double) == 0);
+        REQUIRE(MemoryTracker::GetUsage(MemoryTracker::MESHES).liveBytes == before.liveBytes + 256);
+
+        MemoryTracker::TaggedFree(MemoryTracker::MESHES, memory);
+        MemoryTracker::TaggedFree(MemoryTracker::MESHES, nullptr);
+        REQUIRE(MemoryTracker::GetUsage(MemoryTracker::MESHES).liveBytes == before.liveBytes);
+    }
+
+    SECTION("Allocations can be reported from several threads") {
+        MemoryTracker::ResetPeaks();
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < 4; ++thread) {
+            threads.emplace_back([]() {
+                for (int i = 0; i < 1000; ++i)
+                    MemoryTracker::Allocate(MemoryTracker::MESHES, 8);
+                for (int i = 0; i < 1000; ++i)
+                    MemoryTracker::Free(MemoryTracker::MESHES, 8);
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+
+        MemoryTracker::Usage usage = MemoryTracker::GetUsage(MemoryTracker::MESHES);
+        REQUIRE(usage.liveBytes == before.liveBytes);
+        REQUIRE(usage.totalAllocations == before.totalAllocations + 4000);
+        REQUIRE(usage.peakBytes <= before.liveBytes + 4 * 8000);
+    }
+}
@@ -0,0 +1,66 @@
+#include <catch.hpp>
+#include <Utility/Worker.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Utility;
+
+TEST_CASE("Worker check", "[Worker]") {
+    Worker worker;
+
+    SECTION("Jobs run on another thread") {
+        std::thread::id jobThread;
+        worker.Start([&jobThread] { jobThread = std::this_thread::get_id(); });
+        worker.Wait();
+        REQUIRE(jobThread != std::this_thread::get_id());
+    }
+
+    SECTION("Wait returns once the job has finished") {
+        bool done = false;
+        worker.Start([&done] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            done = true;
+        });
+        worker.Wait();
+        REQUIRE(done);
+    }
+
+    SECTION("Jobs run one at a time in order") {
+        std::atomic<int> running(0);
+        std::atomic<bool> overlapped(false);
+        int last = -1;
+        bool ordered = true;
+        for (int i = 0; i < 100; ++i) {
+            worker.Start([&, i] {
+                if (running.fetch_add(1) != 0)
+                    overlapped = true;
+                if (i != last + 1)
+                    ordered = false;
+                last = i;
+                running.fetch_sub(1);
+            });
+        }
+        worker.Wait();
+        REQUIRE(!overlapped);
+        REQUIRE(ordered);
+        REQUIRE(last == 99);
+    }
+
+    SECTION("Wait without a job returns immediately") {
+        worker.Wait();
+        worker.Wait();
+    }
+}
+
+TEST_CASE("Worker finishes its job when destroyed", "[Worker]") {
+    bool done = false;
+    {
+        Worker worker;
+        worker.Start([&done] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            done = true;
+        });
+    }
+    REQUIRE(done);
+}
@@ -1,27 +1,274 @@
 #include "Log.hpp"
 
-#include <ostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
-ostream* Log::streams[NUMBER_OF_CHANNELS];
+namespace {
+    // Number of records a thread can have waiting to be written.
+    const uint32_t BUFFER_CAPACITY = 1024;
+
+    // How often the logging thread writes records when nobody is waiting for them.
+    const chrono::milliseconds DRAIN_INTERVAL(10);
+
+    struct Record {
+        uint64_t sequence = 0;
+        Log::Channel channel = Log::DEFAULT;
+        string text;
+    };
+
+    // Records logged by one thread. Only the owning thread pushes records and
+    // only the logging thread pops them, so no locks are needed.
+    struct ThreadBuffer {
+        ThreadBuffer() : head(0), tail(0), released(false) {}
+
+        Record records[BUFFER_CAPACITY];
+        atomic<uint32_t> head;
+        atomic<uint32_t> tail;
+
+        // Set when the owning thread has exited.
+        atomic<bool> released;
+    };
+
+    // Releases the buffer of a thread when it exits.
+    struct ThreadBufferOwner {
+        ~ThreadBufferOwner() {
+            if (buffer != nullptr)
+                buffer->released = true;
+            buffer = nullptr;
+        }
+
+        ThreadBuffer* buffer = nullptr;
+    };
+
+    thread_local ThreadBufferOwner threadBuffer;
+
+    ostream* streams[Log::NUMBER_OF_CHANNELS];
+    atomic<int> minimumSeverity(Log::DEFAULT);
+
+    // Set once the logging thread has stopped, after which records are written directly.
+    atomic<bool> stopped(false);
+
+    // Write a record to the stream of its channel.
+    void Write(const Log::Channel channel, const string& text) {
+        if (streams[channel] != nullptr)
+            *streams[channel] << text;
+
+#ifdef USINGDOUBLELOGGING
+        if (channel != Log::INFO)
+            std::cout << text;
+#endif
+    }
+
+    // Collects records from all threads and writes them in batches on a background thread.
+    class Backend {
+        public:
+            Backend() {
+                thread = std::thread(&Backend::Run, this);
+            }
+
+            ~Backend() {
+                stopped = true;
+                {
+                    lock_guard<mutex> lock(wakeMutex);
+                    stopping = true;
+                }
+                wake.notify_one();
+                thread.join();
+
+                // Buffers of threads that are still running are leaked since the threads may still use them.
+                for (ThreadBuffer* buffer : buffers) {
+                    if (buffer->released)
+                        delete buffer;
+                }
+            }
+
+            void Push(const Log::Channel channel, string& text) {
+                if (!TryPush(channel, text))
+                    ++dropped;
+            }
+
+            // Errors often precede a crash or exit, so they are written before returning and never dropped.
+            void PushError(string& text) {
+                while (!TryPush(Log::ERR, text))
+                    Flush();
+                Flush();
+            }
+
+            void Flush() {
+                unique_lock<mutex> lock(wakeMutex);
+                unsigned int request = ++flushRequests;
+                wake.notify_one();
+                flushed.wait(lock, [this, request]() { return flushedRequests >= request || stopping; });
+            }
+
+            mutex streamMutex;
+
+        private:
+            bool TryPush(const Log::Channel channel, string& text) {
+                ThreadBuffer* buffer = threadBuffer.buffer;
+                if (buffer == nullptr)
+                    buffer = Register();
+
+                uint32_t tail = buffer->tail.load(memory_order_relaxed);
+                if (tail - buffer->head.load(memory_order_acquire) >= BUFFER_CAPACITY)
+                    return false;
+
+                Record& record = buffer->records[tail % BUFFER_CAPACITY];
+                record.sequence = nextSequence++;
+                record.channel = channel;
+                record.text.swap(text);
+                buffer->tail.store(tail + 1, memory_order_release);
+                return true;
+            }
+
+            ThreadBuffer* Register() {
+                ThreadBuffer* buffer = new ThreadBuffer();
+                {
+                    lock_guard<mutex> lock(buffersMutex);
+                    buffers.push_back(buffer);
+                }
+                threadBuffer.buffer = buffer;
+                return buffer;
+            }
+
+            void Run() {
+                unique_lock<mutex> lock(wakeMutex);
+                while (!stopping) {
+                    unsigned int requests = flushRequests;
+                    lock.unlock();
+                    Drain();
+                    lock.lock();
+
+                    flushedRequests = requests;
+                    flushed.notify_all();
+                    if (!stopping && flushRequests == requests)
+                        wake.wait_for(lock, DRAIN_INTERVAL);
+                }
+                lock.unlock();
+
+                Drain();
+                flushed.notify_all();
+            }
+
+            void Drain() {
+                batch.clear();
+                {
+                    lock_guard<mutex> lock(buffersMutex);
+                    for (auto it = buffers.begin(); it != buffers.end();) {
+                        ThreadBuffer* buffer = *it;
+
+                        // Check whether the thread has exited first, so the buffer is empty once it's been drained.
+                        bool released = buffer->released.load(memory_order_acquire);
+                        uint32_t head = buffer->head.load(memory_order_relaxed);
+                        uint32_t tail = buffer->tail.load(memory_order_acquire);
+                        for (; head != tail; ++head) {
+                            batch.emplace_back();
+                            Record& record = buffer->records[head % BUFFER_CAPACITY];
+                            batch.back().sequence = record.sequence;
+                            batch.back().channel = record.channel;
+                            batch.back().text.swap(record.text);
+                        }
+                        buffer->head.store(head, memory_order_release);
+
+                        if (released) {
+                            delete buffer;
+                            it = buffers.erase(it);
+                        } else {
+                            ++it;
+                        }
+                    }
+                }
+
+                uint32_t droppedCount = dropped.exchange(0);
+                if (batch.empty() && droppedCount == 0)
+                    return;
+
+                // Write the records from all threads in the order they were logged.
+                sort(batch.begin(), batch.end(), [](const Record& a, const Record& b) { return a.sequence < b.sequence; });
+
+                lock_guard<mutex> lock(streamMutex);
+                bool written[Log::NUMBER_OF_CHANNELS] = { false };
+                for (const Record& record : batch) {
+                    Write(record.channel, record.text);
+                    written[record.channel] = true;
+                }
+
+                if (droppedCount > 0) {
+                    Write(Log::WARNING, "Log: " + to_string(droppedCount) + " records were dropped because the log buffer was full.\n");
+                    written[Log::WARNING] = true;
+                }
+
+                for (int channel = 0; channel < Log::NUMBER_OF_CHANNELS; ++channel) {
+                    if (written[channel] && streams[channel] != nullptr)
+                        streams[channel]->flush();
+                }
+            }
+
+            std::thread thread;
+
+            mutex buffersMutex;
+            vector<ThreadBuffer*> buffers;
+            vector<Record> batch;
+
+            atomic<uint64_t> nextSequence{ 0 };
+            atomic<uint32_t> dropped{ 0 };
+
+            mutex wakeMutex;
+            condition_variable wake;
+            condition_variable flushed;
+            unsigned int flushRequests = 0;
+            unsigned int flushedRequests = 0;
+            bool stopping = false;
+    };
+
+    Backend& GetBackend() {
+        static Backend backend;
+        return backend;
+    }
+
+    string Format(const char* format, const double value) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), format, value);
+        return buffer;
+    }
+}
 
 Log::Log(const Channel channel) {
     currentChannel = channel;
+    enabled = channel >= minimumSeverity.load(memory_order_relaxed);
 }
 
 Log::~Log() {
-    streams[currentChannel]->flush();
+    if (!enabled || record.empty())
+        return;
+
+    if (stopped) {
+        Write(currentChannel, record);
+        if (streams[currentChannel] != nullptr)
+            streams[currentChannel]->flush();
+        return;
+    }
+
+    if (currentChannel == ERR)
+        GetBackend().PushError(record);
+    else
+        GetBackend().Push(currentChannel, record);
 }
 
 Log& Log::operator<<(const string& text) {
-    *streams[currentChannel] << text;
-
-#ifdef USINGDOUBLELOGGING
-    if (currentChannel != INFO)
-        std::cout << text;
-#endif
+    if (enabled)
+        record += text;
 
 #ifdef LOGTESTING
     if (currentChannel == ERR)
@@ -32,12 +279,8 @@ Log& Log::operator<<(const string& text) {
 }
 
 Log& Log::operator<<(const int value) {
-    *streams[currentChannel] << value;
-
-#ifdef USINGDOUBLELOGGING
-    if (currentChannel != INFO)
-        std::cout << value;
-#endif
+    if (enabled)
+        record += std::to_string(value);
 
 #ifdef LOGTESTING
     if (currentChannel == ERR)
@@ -48,12 +291,8 @@ Log& Log::operator<<(const int value) {
 }
 
 Log& Log::operator<<(const unsigned int value) {
-    *streams[currentChannel] << value;
-
-#ifdef USINGDOUBLELOGGING
-    if (currentChannel != INFO)
-        std::cout << value;
-#endif
+    if (enabled)
+        record += std::to_string(value);
 
 #ifdef LOGTESTING
     if (currentChannel == ERR)
@@ -64,12 +303,9 @@ Log& Log::operator<<(const unsigned int value) {
 }
 
 Log& Log::operator<<(const float value) {
-    *streams[currentChannel] << value;
-
-#ifdef USINGDOUBLELOGGING
-    if (currentChannel != INFO)
-        std::cout << value;
-#endif
+    // Same format as writing to a stream with the default precision.
+    if (enabled)
+        record += Format("%g", value);
 
 #ifdef LOGTESTING
     if (currentChannel == ERR)
@@ -80,12 +316,8 @@ Log& Log::operator<<(const float value) {
 }
 
 Log& Log::operator<<(const double value) {
-    *streams[currentChannel] << value;
-
-#ifdef USINGDOUBLELOGGING
-    if (currentChannel != INFO)
-        std::cout << value;
-#endif
+    if (enabled)
+        record += Format("%g", value);
 
 #ifdef LOGTESTING
     if (currentChannel == ERR)
@@ -109,22 +341,15 @@ Log& Log::operator<<(const time_t value) {
         throw ("Error: t " + outString);
 #endif
 
-    *streams[currentChannel] << outString;
-#ifdef USINGDOUBLELOGGING
-    if (currentChannel != INFO)
-        std::cout << outString;
-#endif
+    if (enabled)
+        record += outString;
+
     return *this;
 }
 
 Log& Log::operator<<(const glm::vec2& value) {
-    string outString = "(" + std::to_string(value.x) + "," + std::to_string(value.y) + ")";
-    *streams[currentChannel] << outString;
-
-#ifdef USINGDOUBLELOGGING
-    if (currentChannel != INFO)
-        std::cout << outString;
-#endif
+    if (enabled)
+        record += "(" + std::to_string(value.x) + "," + std::to_string(value.y) + ")";
 
 #ifdef LOGTESTING
     if (currentChannel == ERR)
@@ -135,13 +360,8 @@ Log& Log::operator<<(const glm::vec2& value) {
 }
 
 Log& Log::operator<<(const glm::vec3& value) {
-    string outString = "(" + std::to_string(value.x) + "," + std::to_string(value.y) + "," + std::to_string(value.z) + ")";
-    *streams[currentChannel] << outString;
-
-#ifdef USINGDOUBLELOGGING
-    if (currentChannel != INFO)
-        std::cout << outString;
-#endif
+    if (enabled)
+        record += "(" + std::to_string(value.x) + "," + std::to_string(value.y) + "," + std::to_string(value.z) + ")";
 
 #ifdef LOGTESTING
     if (currentChannel == ERR)
@@ -152,13 +372,8 @@ Log& Log::operator<<(const glm::vec3& value) {
 }
 
 Log& Log::operator<<(const glm::vec4& value) {
-    string outString = "(" + std::to_string(value.x) + "," + std::to_string(value.y) + "," + std::to_string(value.z) + "," + std::to_string(value.w) + ")";
-    *streams[currentChannel] << outString;
-
-#ifdef USINGDOUBLELOGGING
-    if (currentChannel != INFO)
-        std::cout << outString;
-#endif
+    if (enabled)
+        record += "(" + std::to_string(value.x) + "," + std::to_string(value.y) + "," + std::to_string(value.z) + "," + std::to_string(value.w) + ")";
 
 #ifdef LOGTESTING
     if (currentChannel == ERR)
@@ -175,8 +390,11 @@ bool Log::SetupStream(const Channel channel, std::ostream* stream) {
         return false;
     }
 
-    // Set the channel.
-    streams[static_cast<int>(channel)] = stream;
+    // Set the channel. Records logged before are written to the old stream.
+    Flush();
+    AccessStreams([channel, stream]() {
+        streams[static_cast<int>(channel)] = stream;
+    });
     return true;
 }
 
@@ -190,3 +408,26 @@ bool Log::SetupStreams(
            SetupStream(WARNING, warning) &&
            SetupStream(ERR, error);
 }
+
+void Log::SetMinimumSeverity(const Channel channel) {
+    minimumSeverity = channel;
+}
+
+Log::Channel Log::GetMinimumSeverity() {
+    return static_cast<Channel>(minimumSeverity.load());
+}
+
+void Log::Flush() {
+    if (!stopped)
+        GetBackend().Flush();
+}
+
+void Log::AccessStreams(const std::function<void()>& access) {
+    if (stopped) {
+        access();
+        return;
+    }
+
+    lock_guard<mutex> lock(GetBackend().streamMutex);
+    access();
+}
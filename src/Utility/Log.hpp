@@ -2,6 +2,7 @@
 
 #include <string>
 #include <ctime>
+#include <functional>
 #include <glm/glm.hpp>
 #include "linking.hpp"
 
@@ -11,6 +12,17 @@
  * @code{.cpp}
  * Log() << "Testing: " << 5 << "\n";
  * @endcode
+ *
+ * Each statement is formatted into a record which is handed to a background
+ * thread when the %Log instance is destroyed. Records are queued in a buffer
+ * owned by the logging thread, so logging never waits on a lock or a stream
+ * and statements from different threads aren't interleaved. If the buffer of
+ * a thread is full, its records are dropped until the background thread has
+ * caught up.
+ *
+ * Errors are the exception: since they often precede a crash or exit, an
+ * error statement waits until it (and everything logged before it) has been
+ * written to the streams, and is never dropped.
  */
 class Log {
     public:
@@ -110,7 +122,32 @@ class Log {
      */
     UTILITY_API static bool SetupStreams(std::ostream* defaultStream, std::ostream* info, std::ostream* warning, std::ostream* error);
 
+    /// Set the lowest channel that is logged.
+    /**
+     * Statements to channels below it are ignored before they are formatted.
+     * @param channel The lowest channel to log.
+     */
+    UTILITY_API static void SetMinimumSeverity(const Channel channel);
+
+    /// Get the lowest channel that is logged.
+    /**
+     * @return The lowest channel to log.
+     */
+    UTILITY_API static Channel GetMinimumSeverity();
+
+    /// Wait until everything logged by the calling thread has been written to the streams.
+    UTILITY_API static void Flush();
+
+    /// Access the streams without the logging thread writing to them.
+    /**
+     * Records that haven't been written yet stay queued; call Flush() first to include them.
+     * Errors must not be logged from the access function, since they wait for the streams.
+     * @param access Function that reads or modifies the streams.
+     */
+    UTILITY_API static void AccessStreams(const std::function<void()>& access);
+
     private:
     Channel currentChannel;
-    static std::ostream* streams[Channel::NUMBER_OF_CHANNELS];
+    bool enabled;
+    std::string record;
 };
@@ -0,0 +1,86 @@
+#include "MemoryTracker.hpp"
+
+#include <atomic>
+#include <cstdlib>
+
+using namespace Utility;
+
+namespace {
+    struct Counters {
+        std::atomic<uint64_t> liveBytes;
+        std::atomic<uint64_t> peakBytes;
+        std::atomic<uint64_t> liveAllocations;
+        std::atomic<uint64_t> totalAllocations;
+    };
+
+    Counters counters[MemoryTracker::TAG_COUNT];
+
+    const char* names[MemoryTracker::TAG_COUNT] = { "Meshes", "Textures", "Audio", "Scripts", "Physics", "Particles" };
+
+    // Size of the header TaggedMalloc stores the size in. Keeps the alignment malloc guarantees.
+    union Header {
+        std::size_t bytes;
+        long double alignLongDouble;
+        long long alignLongLong;
+        void* alignPointer;
+    };
+
+    void RaisePeak(Counters& tag, uint64_t bytes) {
+        uint64_t peak = tag.peakBytes.load(std::memory_order_relaxed);
+        while (bytes > peak && !tag.peakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed));
+    }
+}
+
+void MemoryTracker::Allocate(Tag tag, std::size_t bytes) {
+    Counters& tagCounters = counters[tag];
+    uint64_t live = tagCounters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    tagCounters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+    tagCounters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    RaisePeak(tagCounters, live);
+}
+
+void MemoryTracker::Free(Tag tag, std::size_t bytes) {
+    Counters& tagCounters = counters[tag];
+    tagCounters.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    tagCounters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void* MemoryTracker::TaggedMalloc(Tag tag, std::size_t bytes) {
+    Header* header = static_cast<Header*>(std::malloc(sizeof(Header) + bytes));
+    if (header == nullptr)
+        return nullptr;
+
+    header->bytes = bytes;
+    Allocate(tag, bytes);
+
+    return header + 1;
+}
+
+void MemoryTracker::TaggedFree(Tag tag, void* pointer) {
+    if (pointer == nullptr)
+        return;
+
+    Header* header = static_cast<Header*>(pointer) - 1;
+    Free(tag, header->bytes);
+    std::free(header);
+}
+
+MemoryTracker::Usage MemoryTracker::GetUsage(Tag tag) {
+    const Counters& tagCounters = counters[tag];
+    Usage usage;
+    usage.liveBytes = tagCounters.liveBytes.load(std::memory_order_relaxed);
+    usage.peakBytes = tagCounters.peakBytes.load(std::memory_order_relaxed);
+    usage.liveAllocations = tagCounters.liveAllocations.load(std::memory_order_relaxed);
+    usage.totalAllocations = tagCounters.totalAllocations.load(std::memory_order_relaxed);
+
+    return usage;
+}
+
+void MemoryTracker::ResetPeaks() {
+    for (Counters& tagCounters : counters)
+        tagCounters.peakBytes = tagCounters.liveBytes.load(std::memory_order_relaxed);
+}
+
+const char* MemoryTracker::GetName(Tag tag) {
+    return names[tag];
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "linking.hpp"
+
+namespace Utility {
+    /// Tracks how much memory each subsystem uses.
+    /**
+     * Subsystems report their own allocations, both on the CPU and the GPU,
+     * with Allocate() and Free(). Only atomic counters are updated, so it's
+     * safe and cheap to report from any thread.
+     */
+    class MemoryTracker {
+        public:
+            /// The subsystems that memory is tracked for.
+            enum Tag {
+                MESHES = 0, ///< Vertex and index data of models.
+                TEXTURES,   ///< Texture images.
+                AUDIO,      ///< Decoded and streamed sound data.
+                SCRIPTS,    ///< Memory allocated by the script engine.
+                PHYSICS,    ///< Memory allocated by the physics engine.
+                PARTICLES,  ///< Particle buffers.
+                TAG_COUNT   ///< Number of tags, ensure this is the last element of the enum if adding tags.
+            };
+
+            /// Memory usage of a tag.
+            struct Usage {
+                /// Bytes currently allocated.
+                uint64_t liveBytes;
+
+                /// Highest number of bytes allocated at once.
+                uint64_t peakBytes;
+
+                /// Number of allocations that haven't been freed.
+                uint64_t liveAllocations;
+
+                /// Number of allocations made in total.
+                uint64_t totalAllocations;
+            };
+
+            /// Report an allocation.
+            /**
+             * @param tag The subsystem that allocated the memory.
+             * @param bytes Size of the allocation.
+             */
+            UTILITY_API static void Allocate(Tag tag, std::size_t bytes);
+
+            /// Report that an allocation has been freed.
+            /**
+             * @param tag The subsystem that allocated the memory.
+             * @param bytes Size of the allocation.
+             */
+            UTILITY_API static void Free(Tag tag, std::size_t bytes);
+
+            /// Allocate memory and report it.
+            /**
+             * Used as the allocation function of libraries that don't pass the size when freeing.
+             * @param tag The subsystem to report the allocation for.
+             * @param bytes Size of the allocation.
+             * @return The allocated memory or nullptr if it couldn't be allocated.
+             */
+            UTILITY_API static void* TaggedMalloc(Tag tag, std::size_t bytes);
+
+            /// Free memory allocated with TaggedMalloc() and report it.
+            /**
+             * @param tag The subsystem the memory was allocated for.
+             * @param pointer Memory to free, may be nullptr.
+             */
+            UTILITY_API static void TaggedFree(Tag tag, void* pointer);
+
+            /// Get the memory usage of a tag.
+            /**
+             * @param tag The subsystem to get the memory usage of.
+             * @return The memory usage.
+             */
+            UTILITY_API static Usage GetUsage(Tag tag);
+
+            /// Reset the peak of each tag to its current usage.
+            UTILITY_API static void ResetPeaks();
+
+            /// Get the name of a tag.
+            /**
+             * @param tag The tag to get the name of.
+             * @return The name of the tag.
+             */
+            UTILITY_API static const char* GetName(Tag tag);
+    };
+}
@@ -0,0 +1,50 @@
+#include "Worker.hpp"
+
+namespace Utility {
+    Worker::Worker() {
+        thread = std::thread(&Worker::Run, this);
+    }
+
+    Worker::~Worker() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return !busy; });
+            stop = true;
+        }
+        condition.notify_all();
+        thread.join();
+    }
+
+    void Worker::Start(const std::function<void()>& job) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return !busy; });
+            this->job = job;
+            busy = true;
+        }
+        condition.notify_all();
+    }
+
+    void Worker::Wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] { return !busy; });
+    }
+
+    void Worker::Run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            condition.wait(lock, [this] { return busy || stop; });
+            if (stop)
+                return;
+
+            // Run the job without holding the lock, so Wait can be called meanwhile.
+            lock.unlock();
+            job();
+            lock.lock();
+
+            job = nullptr;
+            busy = false;
+            condition.notify_all();
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "linking.hpp"
+
+namespace Utility {
+    /// Runs jobs on a thread of its own, one at a time.
+    /**
+     * The thread is created once and kept waiting between jobs, so handing a
+     * job to it every frame doesn't pay for creating a thread.
+     */
+    class Worker {
+        public:
+            /// Create new worker and start its thread.
+            UTILITY_API Worker();
+
+            /// Wait for the current job to finish and stop the thread.
+            UTILITY_API ~Worker();
+
+            /// Start running a job on the worker's thread.
+            /**
+             * Waits for the previous job to finish first.
+             * @param job The job to run.
+             */
+            UTILITY_API void Start(const std::function<void()>& job);
+
+            /// Wait for the current job to finish.
+            /**
+             * Returns immediately if no job is running.
+             */
+            UTILITY_API void Wait();
+
+        private:
+            Worker(const Worker&) = delete;
+            void operator=(const Worker&) = delete;
+
+            void Run();
+
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::function<void()> job;
+            bool busy = false;
+            bool stop = false;
+            std::thread thread;
+    };
+}
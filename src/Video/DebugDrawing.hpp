@@ -5,11 +5,16 @@
 #include <vector>
 #include "linking.hpp"
 #include "Geometry/Geometry3D.hpp"
+#include "DebugDrawingBatch.hpp"
 
 namespace Video {
     class ShaderProgram;
     
     /// Draws debug primitives.
+    /**
+     * Points, lines and shapes are collected into a DebugDrawingBatch and drawn together
+     * in EndDebugDrawing, with one draw call per depth testing and line width combination.
+     */
     class DebugDrawing {
         public:
             /// A debug drawing point.
@@ -304,55 +309,29 @@ namespace Video {
             VIDEO_API void DeleteBuffers(Mesh& mesh);
             
             /// Stop debug drawing.
+            /**
+             * Draws the points, lines and shapes drawn since StartDebugDrawing.
+             */
             VIDEO_API void EndDebugDrawing();
             
         private:
             DebugDrawing(const DebugDrawing & other) = delete;
             
-            static void CreateVertexArray(const glm::vec3* positions, unsigned int positionCount, GLuint& vertexBuffer, GLuint& vertexArray);
-            void BindVertexArray(GLuint vertexArray);
-            void CreateCircle(glm::vec3*& positions, unsigned int& vertexCount, unsigned int detail);
-            void CreateSphere(glm::vec3*& positions, unsigned int& vertexCount, unsigned int detail);
-            void CreateCylinder(glm::vec3*& positions, unsigned int& vertexCount, unsigned int detail);
-            void CreateCone(glm::vec3*& positions, unsigned int& vertexCount, unsigned int detail);
+            void DrawBatch();
             
             Video::ShaderProgram* shaderProgram;
             
             // Uniform locations.
             GLuint viewProjectionLocation;
             GLuint modelLocation;
-            GLuint colorLocation;
             GLuint sizeLocation;
             
-            // Geometry.
-            GLuint pointVertexBuffer;
-            GLuint pointVertexArray;
-            
-            GLuint lineVertexBuffer;
-            GLuint lineVertexArray;
-            
-            GLuint cuboidVertexBuffer;
-            GLuint cuboidVertexArray;
-            
-            GLuint planeVertexBuffer;
-            GLuint planeVertexArray;
+            // Primitives waiting to be drawn.
+            DebugDrawingBatch batch;
             
-            GLuint sphereVertexBuffer;
-            GLuint sphereVertexArray;
-            unsigned int sphereVertexCount;
-            
-            GLuint circleVertexBuffer;
-            GLuint circleVertexArray;
-            unsigned int circleVertexCount;
-            
-            GLuint cylinderVertexBuffer;
-            GLuint cylinderVertexArray;
-            unsigned int cylinderVertexCount;
-            
-            GLuint coneVertexBuffer;
-            GLuint coneVertexArray;
-            unsigned int coneVertexCount;
-            
-            GLuint boundVertexArray = 0;
+            // Geometry.
+            GLuint vertexBuffer;
+            GLuint vertexArray;
+            std::size_t vertexBufferCapacity = 0;
     };
 }
@@ -0,0 +1,258 @@
+#include "DebugDrawingBatch.hpp"
+
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
+
+#ifdef USINGMEMTRACK
+#include <MemTrackInclude.hpp>
+#endif
+
+using namespace Video;
+
+DebugDrawingBatch::DebugDrawingBatch() {
+    CreateCuboid(cuboid);
+    CreatePlane(plane);
+    CreateCircle(circle, 25);
+    CreateSphere(sphere, 14);
+    CreateCylinder(cylinder, 14);
+    CreateCone(cone, 14);
+}
+
+void DebugDrawingBatch::AddPoint(const glm::vec3& position, const glm::vec3& color, float size, bool depthTesting) {
+    Vertex vertex;
+    vertex.position = position;
+    vertex.color = color;
+    GetBucket(true, depthTesting, size).push_back(vertex);
+}
+
+void DebugDrawingBatch::AddLine(const glm::vec3& startPosition, const glm::vec3& endPosition, const glm::vec3& color, float width, bool depthTesting) {
+    std::vector<Vertex>& bucket = GetBucket(false, depthTesting, width);
+
+    Vertex vertex;
+    vertex.color = color;
+    vertex.position = startPosition;
+    bucket.push_back(vertex);
+    vertex.position = endPosition;
+    bucket.push_back(vertex);
+}
+
+void DebugDrawingBatch::AddCuboid(const glm::vec3& dimensions, const glm::mat4& matrix, const glm::vec3& color, float lineWidth, bool depthTesting) {
+    AddShape(cuboid, matrix * glm::scale(glm::mat4(), dimensions), color, lineWidth, depthTesting);
+}
+
+void DebugDrawingBatch::AddPlane(const glm::vec3& position, const glm::vec3& normal, const glm::vec2& size, const glm::vec3& color, float lineWidth, bool depthTesting) {
+    AddShape(plane, OrientToNormal(position, normal, glm::vec3(size * 0.5f, 1.f)), color, lineWidth, depthTesting);
+}
+
+void DebugDrawingBatch::AddCircle(const glm::vec3& position, const glm::vec3& normal, float radius, const glm::vec3& color, float lineWidth, bool depthTesting) {
+    AddShape(circle, OrientToNormal(position, normal, glm::vec3(radius, radius, radius)), color, lineWidth, depthTesting);
+}
+
+void DebugDrawingBatch::AddSphere(const glm::vec3& position, float radius, const glm::vec3& color, float lineWidth, bool depthTesting) {
+    glm::mat4 model(glm::translate(glm::mat4(), position) * glm::scale(glm::mat4(), glm::vec3(radius, radius, radius)));
+    AddShape(sphere, model, color, lineWidth, depthTesting);
+}
+
+void DebugDrawingBatch::AddCylinder(float radius, float length, const glm::mat4& matrix, const glm::vec3& color, float lineWidth, bool depthTesting) {
+    AddShape(cylinder, matrix * glm::scale(glm::mat4(), glm::vec3(radius, length, radius)), color, lineWidth, depthTesting);
+}
+
+void DebugDrawingBatch::AddCone(float radius, float height, const glm::mat4& matrix, const glm::vec3& color, float lineWidth, bool depthTesting) {
+    AddShape(cone, matrix * glm::scale(glm::mat4(), glm::vec3(radius, height, radius)), color, lineWidth, depthTesting);
+}
+
+void DebugDrawingBatch::Build() {
+    std::size_t vertexCount = 0;
+    for (const Bucket& bucket : buckets)
+        vertexCount += bucket.vertices.size();
+
+    vertices.clear();
+    vertices.reserve(vertexCount);
+    groups.clear();
+
+    for (const Bucket& bucket : buckets) {
+        if (bucket.vertices.empty())
+            continue;
+
+        Group group;
+        group.points = bucket.points;
+        group.depthTesting = bucket.depthTesting;
+        group.size = bucket.size;
+        group.first = static_cast<unsigned int>(vertices.size());
+        group.count = static_cast<unsigned int>(bucket.vertices.size());
+        groups.push_back(group);
+
+        vertices.insert(vertices.end(), bucket.vertices.begin(), bucket.vertices.end());
+    }
+}
+
+const std::vector<DebugDrawingBatch::Vertex>& DebugDrawingBatch::GetVertices() const {
+    return vertices;
+}
+
+const std::vector<DebugDrawingBatch::Group>& DebugDrawingBatch::GetGroups() const {
+    return groups;
+}
+
+void DebugDrawingBatch::Clear() {
+    for (Bucket& bucket : buckets)
+        bucket.vertices.clear();
+
+    vertices.clear();
+    groups.clear();
+}
+
+std::vector<DebugDrawingBatch::Vertex>& DebugDrawingBatch::GetBucket(bool points, bool depthTesting, float size) {
+    // Primitives tend to come in runs with the same state, so check the last bucket first.
+    if (lastBucket < buckets.size()) {
+        const Bucket& bucket = buckets[lastBucket];
+        if (bucket.points == points && bucket.depthTesting == depthTesting && bucket.size == size)
+            return buckets[lastBucket].vertices;
+    }
+
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        if (buckets[i].points == points && buckets[i].depthTesting == depthTesting && buckets[i].size == size) {
+            lastBucket = i;
+            return buckets[i].vertices;
+        }
+    }
+
+    Bucket bucket;
+    bucket.points = points;
+    bucket.depthTesting = depthTesting;
+    bucket.size = size;
+    buckets.push_back(bucket);
+    lastBucket = buckets.size() - 1;
+
+    return buckets.back().vertices;
+}
+
+void DebugDrawingBatch::AddShape(const std::vector<glm::vec3>& shape, const glm::mat4& model, const glm::vec3& color, float lineWidth, bool depthTesting) {
+    std::vector<Vertex>& bucket = GetBucket(false, depthTesting, lineWidth);
+
+    Vertex vertex;
+    vertex.color = color;
+    for (const glm::vec3& position : shape) {
+        vertex.position = glm::vec3(model * glm::vec4(position, 1.f));
+        bucket.push_back(vertex);
+    }
+}
+
+glm::mat4 DebugDrawingBatch::OrientToNormal(const glm::vec3& position, const glm::vec3& normal, const glm::vec3& scale) {
+    glm::mat4 model(glm::scale(glm::mat4(), scale));
+    float yaw = atan2(normal.x, normal.z);
+    float pitch = atan2(normal.y, sqrt(normal.x * normal.x + normal.z * normal.z));
+    model = glm::rotate(glm::mat4(), yaw, glm::vec3(0.f, 1.f, 0.f)) * model;
+    model = glm::rotate(glm::mat4(), pitch, glm::vec3(1.f, 0.f, 0.f)) * model;
+    model = glm::translate(glm::mat4(), position) * model;
+
+    return model;
+}
+
+void DebugDrawingBatch::CreateCuboid(std::vector<glm::vec3>& positions) {
+    positions = {
+        glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3(0.5f, -0.5f, -0.5f),
+        glm::vec3(0.5f, -0.5f, -0.5f), glm::vec3(0.5f, 0.5f, -0.5f),
+        glm::vec3(0.5f, 0.5f, -0.5f), glm::vec3(-0.5f, 0.5f, -0.5f),
+        glm::vec3(0.5f, 0.5f, -0.5f), glm::vec3(0.5f, 0.5f, 0.5f),
+        glm::vec3(0.5f, 0.5f, 0.5f), glm::vec3(0.5f, -0.5f, 0.5f),
+        glm::vec3(0.5f, -0.5f, 0.5f), glm::vec3(0.5f, -0.5f, -0.5f),
+        glm::vec3(-0.5f, 0.5f, -0.5f), glm::vec3(-0.5f, 0.5f, 0.5f),
+        glm::vec3(-0.5f, 0.5f, 0.5f), glm::vec3(-0.5f, -0.5f, 0.5f),
+        glm::vec3(-0.5f, 0.5f, -0.5f), glm::vec3(-0.5f, -0.5f, -0.5f),
+        glm::vec3(-0.5f, -0.5f, 0.5f), glm::vec3(-0.5f, -0.5f, -0.5f),
+        glm::vec3(-0.5f, 0.5f, 0.5f), glm::vec3(0.5f, 0.5f, 0.5f),
+        glm::vec3(-0.5f, -0.5f, 0.5f), glm::vec3(0.5f, -0.5f, 0.5f)
+    };
+}
+
+void DebugDrawingBatch::CreatePlane(std::vector<glm::vec3>& positions) {
+    positions = {
+        glm::vec3(-1.f, -1.f, 0.f), glm::vec3(1.f, -1.f, 0.f),
+        glm::vec3(1.f, -1.f, 0.f), glm::vec3(1.f, 1.f, 0.f),
+        glm::vec3(1.f, 1.f, 0.f), glm::vec3(-1.f, 1.f, 0.f),
+        glm::vec3(-1.f, 1.f, 0.f), glm::vec3(-1.f, -1.f, 0.f)
+    };
+}
+
+void DebugDrawingBatch::CreateCircle(std::vector<glm::vec3>& positions, unsigned int detail) {
+    positions.clear();
+    positions.reserve(detail * 2);
+
+    for (unsigned int j = 0; j <= detail; ++j) {
+        float angle = static_cast<float>(j) / detail * 2.0f * glm::pi<float>();
+        positions.push_back(glm::vec3(cos(angle), sin(angle), 0.0f));
+        if (j > 0 && j < detail)
+            positions.push_back(glm::vec3(cos(angle), sin(angle), 0.0f));
+    }
+}
+
+// Create UV-sphere with given number of parallel and meridian lines.
+void DebugDrawingBatch::CreateSphere(std::vector<glm::vec3>& positions, unsigned int detail) {
+    positions.clear();
+    positions.reserve(detail * (4 * detail - 2));
+
+    // Horizontal lines (meridians).
+    for (unsigned int m = 1; m < detail; ++m) {
+        float meridian = glm::pi<float>() * m / detail;
+        for (unsigned int p = 0; p <= detail; ++p) {
+            float parallel = 2.0f * glm::pi<float>() * p / detail;
+            float angle = glm::pi<float>() * 0.5f - meridian;
+            float y = sin(angle);
+            float x = cos(angle);
+            positions.push_back(glm::vec3(x * cos(parallel), y, x * sin(parallel)));
+            if (p > 0 && p < detail)
+                positions.push_back(glm::vec3(x * cos(parallel), y, x * sin(parallel)));
+        }
+    }
+
+    // Vertical lines (parallels).
+    for (unsigned int p = 0; p < detail; ++p) {
+        float parallel = 2.0f * glm::pi<float>() * p / detail;
+        for (unsigned int m = 0; m <= detail; ++m) {
+            float meridian = glm::pi<float>() * m / detail;
+            float angle = glm::pi<float>() * 0.5f - meridian;
+            float y = sin(angle);
+            float x = cos(angle);
+            positions.push_back(glm::vec3(x * cos(parallel), y, x * sin(parallel)));
+            if (m > 0 && m < detail)
+                positions.push_back(glm::vec3(x * cos(parallel), y, x * sin(parallel)));
+        }
+    }
+}
+
+void DebugDrawingBatch::CreateCylinder(std::vector<glm::vec3>& positions, unsigned int detail) {
+    positions.clear();
+    positions.reserve(detail * 6);
+
+    for (unsigned int j = 0; j < detail; ++j) {
+        float angle1 = static_cast<float>(j) / detail * 2.0f * glm::pi<float>();
+        float angle2 = static_cast<float>(j + 1) / detail * 2.0f * glm::pi<float>();
+
+        positions.push_back(glm::vec3(cos(angle1), 0.5f, sin(angle1)));
+        positions.push_back(glm::vec3(cos(angle1), -0.5f, sin(angle1)));
+
+        positions.push_back(glm::vec3(cos(angle1), 0.5f, sin(angle1)));
+        positions.push_back(glm::vec3(cos(angle2), 0.5f, sin(angle2)));
+
+        positions.push_back(glm::vec3(cos(angle1), -0.5f, sin(angle1)));
+        positions.push_back(glm::vec3(cos(angle2), -0.5f, sin(angle2)));
+    }
+}
+
+void DebugDrawingBatch::CreateCone(std::vector<glm::vec3>& positions, unsigned int detail) {
+    positions.clear();
+    positions.reserve(detail * 4);
+
+    for (unsigned int j = 0; j < detail; ++j) {
+        float angle = 2.0f * glm::pi<float>() * static_cast<float>(j) / detail;
+
+        positions.push_back(glm::vec3(0.0f, 0.5f, 0.0f));
+        positions.push_back(glm::vec3(cos(angle), -0.5f, sin(angle)));
+        positions.push_back(glm::vec3(cos(angle), -0.5f, sin(angle)));
+
+        angle = 2.0f * glm::pi<float>() * static_cast<float>(j + 1) / detail;
+        positions.push_back(glm::vec3(cos(angle), -0.5f, sin(angle)));
+    }
+}
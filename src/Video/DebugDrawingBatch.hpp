@@ -0,0 +1,182 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include "linking.hpp"
+
+namespace Video {
+    /// Expands debug primitives into vertices that can be drawn in a few draw calls.
+    /**
+     * Primitives are transformed on the CPU and appended to one group per combination of
+     * primitive type, depth testing and line width (or point size). Doesn't use OpenGL.
+     */
+    class DebugDrawingBatch {
+        public:
+            /// A vertex of a debug primitive.
+            struct Vertex {
+                /// World position.
+                glm::vec3 position;
+
+                /// Color.
+                glm::vec3 color;
+            };
+
+            /// A range of vertices drawn with the same state.
+            struct Group {
+                /// Whether the vertices are points. Otherwise each pair of vertices is a line segment.
+                bool points;
+
+                /// Whether to enable depth testing.
+                bool depthTesting;
+
+                /// Line width or point size.
+                float size;
+
+                /// Index of the first vertex in the group.
+                unsigned int first;
+
+                /// Number of vertices in the group.
+                unsigned int count;
+            };
+
+            /// Create new batch.
+            VIDEO_API DebugDrawingBatch();
+
+            /// Add a point.
+            /**
+             * @param position World position.
+             * @param color Color.
+             * @param size Point size.
+             * @param depthTesting Whether to enable depth testing.
+             */
+            VIDEO_API void AddPoint(const glm::vec3& position, const glm::vec3& color, float size, bool depthTesting);
+
+            /// Add a line.
+            /**
+             * @param startPosition Starting position of the line.
+             * @param endPosition End position of the line.
+             * @param color Color.
+             * @param width Line width.
+             * @param depthTesting Whether to enable depth testing.
+             */
+            VIDEO_API void AddLine(const glm::vec3& startPosition, const glm::vec3& endPosition, const glm::vec3& color, float width, bool depthTesting);
+
+            /// Add a cuboid.
+            /**
+             * @param dimensions The dimensions of the cuboid.
+             * @param matrix The matrix used to transform the cuboid.
+             * @param color Color.
+             * @param lineWidth Line width.
+             * @param depthTesting Whether to enable depth testing.
+             */
+            VIDEO_API void AddCuboid(const glm::vec3& dimensions, const glm::mat4& matrix, const glm::vec3& color, float lineWidth, bool depthTesting);
+
+            /// Add a plane.
+            /**
+             * @param position The center position of the plane.
+             * @param normal The plane normal.
+             * @param size Size.
+             * @param color Color.
+             * @param lineWidth Line width.
+             * @param depthTesting Whether to enable depth testing.
+             */
+            VIDEO_API void AddPlane(const glm::vec3& position, const glm::vec3& normal, const glm::vec2& size, const glm::vec3& color, float lineWidth, bool depthTesting);
+
+            /// Add a circle.
+            /**
+             * @param position The center position of the circle.
+             * @param normal The circle normal.
+             * @param radius Radius.
+             * @param color Color.
+             * @param lineWidth Line width.
+             * @param depthTesting Whether to enable depth testing.
+             */
+            VIDEO_API void AddCircle(const glm::vec3& position, const glm::vec3& normal, float radius, const glm::vec3& color, float lineWidth, bool depthTesting);
+
+            /// Add a sphere.
+            /**
+             * @param position The center position of the sphere.
+             * @param radius Radius.
+             * @param color Color.
+             * @param lineWidth Line width.
+             * @param depthTesting Whether to enable depth testing.
+             */
+            VIDEO_API void AddSphere(const glm::vec3& position, float radius, const glm::vec3& color, float lineWidth, bool depthTesting);
+
+            /// Add a cylinder.
+            /**
+             * @param radius Radius.
+             * @param length Length.
+             * @param matrix The matrix used to transform the cylinder.
+             * @param color Color.
+             * @param lineWidth Line width.
+             * @param depthTesting Whether to enable depth testing.
+             */
+            VIDEO_API void AddCylinder(float radius, float length, const glm::mat4& matrix, const glm::vec3& color, float lineWidth, bool depthTesting);
+
+            /// Add a cone.
+            /**
+             * @param radius Radius.
+             * @param height Height.
+             * @param matrix The matrix used to transform the cone.
+             * @param color Color.
+             * @param lineWidth Line width.
+             * @param depthTesting Whether to enable depth testing.
+             */
+            VIDEO_API void AddCone(float radius, float height, const glm::mat4& matrix, const glm::vec3& color, float lineWidth, bool depthTesting);
+
+            /// Gather the vertices of all groups into one vertex stream.
+            /**
+             * Needs to be called before GetVertices and GetGroups.
+             */
+            VIDEO_API void Build();
+
+            /// Get the vertex stream.
+            /**
+             * @return The vertices of all groups, one group after the other.
+             */
+            VIDEO_API const std::vector<Vertex>& GetVertices() const;
+
+            /// Get the groups.
+            /**
+             * @return The groups that have vertices.
+             */
+            VIDEO_API const std::vector<Group>& GetGroups() const;
+
+            /// Remove all primitives. Allocated memory is kept for the next frame.
+            VIDEO_API void Clear();
+
+        private:
+            struct Bucket {
+                bool points;
+                bool depthTesting;
+                float size;
+                std::vector<Vertex> vertices;
+            };
+
+            std::vector<Vertex>& GetBucket(bool points, bool depthTesting, float size);
+            void AddShape(const std::vector<glm::vec3>& shape, const glm::mat4& model, const glm::vec3& color, float lineWidth, bool depthTesting);
+            static glm::mat4 OrientToNormal(const glm::vec3& position, const glm::vec3& normal, const glm::vec3& scale);
+
+            static void CreateCuboid(std::vector<glm::vec3>& positions);
+            static void CreatePlane(std::vector<glm::vec3>& positions);
+            static void CreateCircle(std::vector<glm::vec3>& positions, unsigned int detail);
+            static void CreateSphere(std::vector<glm::vec3>& positions, unsigned int detail);
+            static void CreateCylinder(std::vector<glm::vec3>& positions, unsigned int detail);
+            static void CreateCone(std::vector<glm::vec3>& positions, unsigned int detail);
+
+            std::vector<Bucket> buckets;
+            std::size_t lastBucket = 0;
+
+            std::vector<Vertex> vertices;
+            std::vector<Group> groups;
+
+            // Unit geometry of each primitive, as line segments.
+            std::vector<glm::vec3> cuboid;
+            std::vector<glm::vec3> plane;
+            std::vector<glm::vec3> circle;
+            std::vector<glm::vec3> sphere;
+            std::vector<glm::vec3> cylinder;
+            std::vector<glm::vec3> cone;
+    };
+}
@@ -8,8 +8,11 @@ Geometry3D::Geometry3D() {
 }
 
 Geometry3D::~Geometry3D() {
-    glDeleteBuffers(1, &vertexBuffer);
-    glDeleteBuffers(1, &indexBuffer);
+    // Geometry loaded without a graphics context has no buffers.
+    if (vertexBuffer != 0)
+        glDeleteBuffers(1, &vertexBuffer);
+    if (indexBuffer != 0)
+        glDeleteBuffers(1, &indexBuffer);
 }
 
 GLuint Geometry3D::GetVertexArray() const {
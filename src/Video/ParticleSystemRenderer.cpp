@@ -5,75 +5,53 @@
 #include "DefaultParticleShader.geom.hpp"
 #include "DefaultParticleShader.frag.hpp"
 #include "Texture/Texture2D.hpp"
-#include <time.h>
+#include "Culling/Frustum.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <Utility/Log.hpp>
+#include <Utility/MemoryTracker.hpp>
 
 using namespace Video;
 
-ParticleSystemRenderer::ParticleSystemRenderer() {
-    points = new Particles::ParticlePos[nr_particles];
-    vels = new Particles::ParticleVelocity[nr_particles];
-    col = new Particles::ParticleColor[nr_particles];
-    rots = new ParticleModelMatrix[nr_particles];
-    srand(time(NULL));
-
-    // Temporary rotation matrix for future rotation of particles.
-    rotMat[0][0] = cosf(1);
-    rotMat[0][1] = -sinf(1);
-    rotMat[0][2] = 0;
-    rotMat[0][3] = 1;
-    rotMat[1][0] = sinf(1);
-    rotMat[1][1] = cosf(1);
-    rotMat[1][2] = 0;
-    rotMat[1][3] = 1;
-    rotMat[2][0] = 0;
-    rotMat[2][1] = 0;
-    rotMat[2][2] = 0;
-    rotMat[2][3] = 1;
-    rotMat[3][0] = 0;
-    rotMat[3][1] = 0;
-    rotMat[3][2] = 0;
-    rotMat[3][3] = 1;
-}
-
-ParticleSystemRenderer::ParticleSystemRenderer(int count) {
-    points = new Particles::ParticlePos[count];
-    vels = new Particles::ParticleVelocity[count];
-    col = new Particles::ParticleColor[count];
-    rots = new ParticleModelMatrix[count];
-    srand(time(NULL));
-
-    // Temporary rotation matrix for future rotation of particles.
-    rotMat[0][0] = cosf(10);
-    rotMat[0][1] = -sinf(10);
-    rotMat[0][2] = 0;
-    rotMat[0][3] = 1;
-    rotMat[1][0] = sinf(10);
-    rotMat[1][1] = cosf(10);
-    rotMat[1][2] = 0;
-    rotMat[1][3] = 1;
-    rotMat[2][0] = 0;
-    rotMat[2][1] = 0;
-    rotMat[2][2] = 0;
-    rotMat[2][3] = 1;
-    rotMat[3][0] = 0;
-    rotMat[3][1] = 0;
-    rotMat[3][2] = 0;
-    rotMat[3][3] = 1;
-}
+// Emitter index of particles that don't belong to any emitter.
+static const unsigned int NO_EMITTER = 0xFFFFFFFFu;
 
-ParticleSystemRenderer::~ParticleSystemRenderer() {
+// Time step of the compute shader.
+static const float SIMULATION_STEP = 0.1f;
 
-    delete shaderProgram;
-    delete computeShaderProgram;
+// Number of bytes of the particle buffers for a capacity.
+static std::size_t PoolSize(unsigned int capacity) {
+    return static_cast<std::size_t>(capacity) * (sizeof(Particles::ParticlePos) + sizeof(Particles::ParticleVelocity) + sizeof(Particles::ParticleColor) + sizeof(unsigned int));
+}
 
-    glDeleteBuffers(1, &posSSbo);
-    glDeleteBuffers(1, &velSSbo);
-    glDeleteBuffers(1, &colSSbo);
-    glDeleteVertexArrays(1, &m_glDrawVAO);
+// Get the smallest and largest offset along one axis of a particle with initial velocity |velocity| and constant
+// acceleration |acceleration| during |steps| simulation steps.
+static glm::vec2 GetOffsetRange(float velocity, float acceleration, float steps) {
+    // offset(k) = step * (k * velocity + acceleration * k * (k + 1) / 2)
+    auto offset = [velocity, acceleration](float k) {
+        return SIMULATION_STEP * (k * velocity + acceleration * k * (k + 1.0f) * 0.5f);
+    };
+
+    float end = offset(steps);
+    glm::vec2 range(std::min(0.0f, end), std::max(0.0f, end));
+
+    // The offset turns around where its derivative is zero.
+    if (acceleration != 0.0f) {
+        float turn = -(velocity + acceleration * 0.5f) / acceleration;
+        if (turn > 0.0f && turn < steps) {
+            range.x = std::min(range.x, offset(turn));
+            range.y = std::max(range.y, offset(turn));
+        }
+    }
+
+    return range;
 }
 
-void ParticleSystemRenderer::Init() {
+ParticleSystemRenderer::ParticleSystemRenderer(unsigned int capacity) {
+    std::random_device randomDevice;
+    randomEngine.seed(randomDevice());
+
     // Load shaders.
     Video::Shader* vertexShader = new Video::Shader(DEFAULTPARTICLESHADER_VERT, DEFAULTPARTICLESHADER_VERT_LENGTH, GL_VERTEX_SHADER);
     Video::Shader* geometryShader = new Video::Shader(DEFAULTPARTICLESHADER_GEOM, DEFAULTPARTICLESHADER_GEOM_LENGTH, GL_GEOMETRY_SHADER);
@@ -86,133 +64,176 @@ void ParticleSystemRenderer::Init() {
     Video::Shader* computeShader = new Video::Shader(COMPUTEPARTICLESHADER_COMP, COMPUTEPARTICLESHADER_COMP_LENGTH, GL_COMPUTE_SHADER);
     computeShaderProgram = new Video::ShaderProgram({ computeShader });
     delete computeShader;
-}
 
-void ParticleSystemRenderer::CreateStorageBuffers() {
-    // Positions.
-    for (unsigned int i = 0; i < this->nr_particles; ++i) {
-        points[i].x = 0.0f;
-        points[i].y = 0.0f;
-        points[i].z = 0.0f;
-        points[i].w = 0.0f;
-    }
+    particleCountLocation = computeShaderProgram->GetUniformLocation("particleCount");
+    emitterCountLocation = computeShaderProgram->GetUniformLocation("emitterCount");
 
-    glGenBuffers(1, &posSSbo);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, posSSbo);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(Particles::ParticlePos) * nr_particles, &points[0], GL_STATIC_DRAW);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, posSSbo);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0); // unbind
+    viewMatrixLocation = shaderProgram->GetUniformLocation("viewMatrix");
+    projectionMatrixLocation = shaderProgram->GetUniformLocation("projMatrix");
+    baseImageLocation = shaderProgram->GetUniformLocation("baseImage");
+    textureIndexLocation = shaderProgram->GetUniformLocation("textureIndex");
+    scaleLocation = shaderProgram->GetUniformLocation("scale");
+    textureAtlasRowsLocation = shaderProgram->GetUniformLocation("textureAtlasRows");
 
-    // Binding vertex array to get position in vertexshader.
+    glGenBuffers(1, &emitterSSbo);
     glGenVertexArrays(1, &m_glDrawVAO);
-    glBindVertexArray(m_glDrawVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, posSSbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(Particles::ParticlePos) * nr_particles, &points[0], GL_STATIC_DRAW);
 
-    glEnableVertexAttribArray(0);
+    Grow(capacity < WORK_GROUP_SIZE ? WORK_GROUP_SIZE : capacity);
+}
 
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(Particles::ParticlePos), 0);
+ParticleSystemRenderer::~ParticleSystemRenderer() {
+    delete shaderProgram;
+    delete computeShaderProgram;
 
-    glBindVertexArray(0);
+    glDeleteBuffers(1, &posSSbo);
+    glDeleteBuffers(1, &velSSbo);
+    glDeleteBuffers(1, &colSSbo);
+    glDeleteBuffers(1, &emitterIndexSSbo);
+    glDeleteBuffers(1, &emitterSSbo);
+    glDeleteVertexArrays(1, &m_glDrawVAO);
 
-    // Velocity.
-    for (unsigned int i = 0; i < this->nr_particles; ++i) {
-        vels[i].vx = 0.0f;
-        vels[i].vy = 0.0f;
-        vels[i].vz = 0.0f;
-        vels[i].life = 0.0f;
-    }
+    Utility::MemoryTracker::Free(Utility::MemoryTracker::PARTICLES, PoolSize(capacity));
+    if (emitterBufferSize > 0)
+        Utility::MemoryTracker::Free(Utility::MemoryTracker::PARTICLES, emitterBufferSize);
+}
 
-    glGenBuffers(1, &velSSbo);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, velSSbo);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(Particles::ParticlePos) * nr_particles, &vels[0], GL_STATIC_DRAW);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, velSSbo);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0); // unbind
-
-    // Color.
-    for (unsigned int i = 0; i < this->nr_particles; ++i) {
-        col[i].cx = 0.0f;
-        col[i].cy = 0.0f;
-        col[i].cz = 0.0f;
-        col[i].ca = 0.0f;
+unsigned int ParticleSystemRenderer::AddEmitter(unsigned int particleCount) {
+    unsigned int emitter;
+    if (freeEmitters.empty()) {
+        emitter = static_cast<unsigned int>(emitters.size());
+        emitters.emplace_back();
+        emitterData.emplace_back();
+    } else {
+        emitter = freeEmitters.back();
+        freeEmitters.pop_back();
+        emitters[emitter] = Emitter();
     }
 
-    glGenBuffers(1, &colSSbo);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, colSSbo);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(Particles::ParticlePos) * nr_particles, &col[0], GL_STATIC_DRAW);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, colSSbo);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0); // unbind
-
-    // Binding vertex array to get color in fragmentshader.
-    glBindVertexArray(m_glDrawVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, colSSbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(Particles::ParticlePos) * nr_particles, &col[0], GL_STATIC_DRAW);
+    Emitter& e = emitters[emitter];
+    e.count = particleCount;
+    e.offset = Allocate(particleCount);
+    AssignRange(e.offset, e.count, emitter);
 
-    glEnableVertexAttribArray(1);
+    emitterData[emitter] = EmitterData();
+    emitterData[emitter].range = glm::uvec4(e.offset, e.count, 0, 0);
 
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Particles::ParticleColor), 0);
+    return emitter;
+}
 
-    glBindVertexArray(0);
+void ParticleSystemRenderer::RemoveEmitter(unsigned int emitter) {
+    Emitter& e = emitters[emitter];
+    AssignRange(e.offset, e.count, NO_EMITTER);
+    Free(e.offset, e.count);
+    e = Emitter();
+    emitterData[emitter].range = glm::uvec4(0, 0, 0, 0);
+    freeEmitters.push_back(emitter);
 
-    delete[] points;
-    delete[] vels;
-    delete[] col;
-    delete[] rots;
+    queuedEmitters.erase(std::remove(queuedEmitters.begin(), queuedEmitters.end(), emitter), queuedEmitters.end());
+    simulatedEmitters.erase(std::remove(simulatedEmitters.begin(), simulatedEmitters.end(), emitter), simulatedEmitters.end());
 }
 
-void ParticleSystemRenderer::Update(float dt, ParticleSystemRenderer::EmitterSettings settings) {
-    timer += dt;
+void ParticleSystemRenderer::Update(unsigned int emitter, float dt, const EmitterSettings& settings, float lod) {
+    Emitter& e = emitters[emitter];
+
+    // Move the emitter to a new range if its number of particles has changed.
+    unsigned int count = static_cast<unsigned int>(std::max(settings.nr_particles, 0));
+    if (count != e.count) {
+        AssignRange(e.offset, e.count, NO_EMITTER);
+        Free(e.offset, e.count);
+        e.count = count;
+        e.offset = Allocate(count);
+        AssignRange(e.offset, e.count, emitter);
+        e.shootIndex = glm::vec2(0, 30);
+    }
 
-    nr_particles = settings.nr_particles;
+    // Only simulate part of the range at lower levels of detail.
+    lod = glm::clamp(lod, 0.0f, 1.0f);
+    unsigned int activeCount = std::min(static_cast<unsigned int>(std::ceil(e.count * lod)), e.count);
+    if (activeCount != e.activeCount) {
+        e.activeCount = activeCount;
+        if (e.shootIndex.x >= activeCount)
+            e.shootIndex = glm::vec2(0, 30);
+    }
 
-    computeShaderProgram->Use();
+    e.timer += dt;
+    e.textureIndex = settings.textureIndex;
+    e.scale = settings.scale;
+    e.bounds = GetBounds(settings);
+
+    EmitterData& data = emitterData[emitter];
+    data.worldPosition = glm::vec4(settings.worldPos, settings.lifetime);
+    data.velocity = glm::vec4(settings.velocity, settings.velocityMultiplier);
+    data.shootIndex = glm::vec4(e.shootIndex, settings.mass, settings.alpha_control);
+    data.range = glm::uvec4(e.offset, e.activeCount, 1, 0);
+
+    glm::vec3 randomDirections[32];
+    GenerateRandomDirections(settings, randomEngine, randomDirections);
+    for (unsigned int i = 0; i < 32; i++)
+        data.randomVec[i] = glm::vec4(randomDirections[i], 0.0f);
+
+    int nr_new_particles = settings.nr_new_particles;
+    e.shootIndex.y = nr_new_particles - 1.f;
+
+    if (lod > 0.0f && e.timer >= settings.rate / lod) {
+        e.shootIndex.x += nr_new_particles;
+        e.shootIndex.y = e.shootIndex.x + nr_new_particles;
+        if (e.shootIndex.y > e.activeCount) {
+            e.shootIndex.y = static_cast<float>(nr_new_particles);
+            e.shootIndex.x = 0;
+        }
+        e.timer = 0.0f;
+    }
 
-    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, posSSbo, 0, nr_particles * sizeof(Particles::ParticlePos));
-    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 1, velSSbo, 0, nr_particles * sizeof(Particles::ParticleVelocity));
-    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 2, colSSbo, 0, nr_particles * sizeof(Particles::ParticleColor));
+    queuedEmitters.push_back(emitter);
+}
 
-    glUniform3fv(computeShaderProgram->GetUniformLocation("Velocity"), 1, &glm::vec3(settings.velocity.x, settings.velocity.y, settings.velocity.z)[0]);
-    glUniform1f(computeShaderProgram->GetUniformLocation("rate"), settings.rate);
-    glUniform2fv(computeShaderProgram->GetUniformLocation("ShootIndex"), 1, &particleShootIndex[0]);
-    glUniform1f(computeShaderProgram->GetUniformLocation("timer"), timer);
-    glUniform1f(computeShaderProgram->GetUniformLocation("lifetime"), settings.lifetime);
-    glUniform1f(computeShaderProgram->GetUniformLocation("speed"), settings.velocityMultiplier);
-    glUniform1f(computeShaderProgram->GetUniformLocation("mass"), settings.mass);
-    glUniform3fv(computeShaderProgram->GetUniformLocation("modColor"), 1, &settings.color[0]);
-    glUniform3fv(computeShaderProgram->GetUniformLocation("worldPosition"), 1, &glm::vec3(settings.worldPos)[0]);
-    glUniform1i(computeShaderProgram->GetUniformLocation("nr_particles"), nr_particles);
+void ParticleSystemRenderer::Simulate() {
+    simulatedEmitters.swap(queuedEmitters);
+    queuedEmitters.clear();
+
+    if (simulatedEmitters.empty())
+        return;
+
+    // Upload the parameters of all emitters.
+    unsigned int size = static_cast<unsigned int>(emitterData.size() * sizeof(EmitterData));
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, emitterSSbo);
+    if (size > emitterBufferSize) {
+        if (emitterBufferSize > 0)
+            Utility::MemoryTracker::Free(Utility::MemoryTracker::PARTICLES, emitterBufferSize);
+        emitterBufferSize = std::max(size, emitterBufferSize * 2);
+        Utility::MemoryTracker::Allocate(Utility::MemoryTracker::PARTICLES, emitterBufferSize);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, emitterBufferSize, nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size, emitterData.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
-    nr_new_particles = settings.nr_new_particles;
-    particleShootIndex.y = settings.nr_new_particles - 1.f;
+    // Emitters that aren't updated next frame shouldn't be simulated.
+    for (unsigned int emitter : simulatedEmitters)
+        emitterData[emitter].range.z = 0;
 
-    glm::vec3 randomVec[32];
+    unsigned int particleCount = GetUsedEnd();
 
-    for (unsigned int i = 0; i < 32; i++) {
-        randomVec[i] = glm::normalize(glm::vec3(settings.randomVec.x + (rand() % settings.spread) - (settings.spread / 2),
-            settings.randomVec.y + ((rand() % settings.spread) - (settings.spread / 2)), settings.randomVec.z + (rand() % settings.spread) - (settings.spread / 2)));
-    }
+    computeShaderProgram->Use();
 
-    glUniform3fv(computeShaderProgram->GetUniformLocation("randomVec"), 32, &randomVec[0].x);
-    glUniform1f(computeShaderProgram->GetUniformLocation("alphaControl"), settings.alpha_control);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, posSSbo);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, velSSbo);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, colSSbo);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, emitterIndexSSbo);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, emitterSSbo);
+
+    glUniform1ui(particleCountLocation, particleCount);
+    glUniform1ui(emitterCountLocation, static_cast<GLuint>(emitterData.size()));
 
-    glDispatchCompute(static_cast<int>(std::ceil((float)nr_particles / 128)), 1, 1);
+    glDispatchCompute((particleCount + WORK_GROUP_SIZE - 1) / WORK_GROUP_SIZE, 1, 1);
     glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
     glUseProgram(0);
-
-    if (timer >= settings.rate) {
-        particleShootIndex.x += nr_new_particles;
-        particleShootIndex.y = particleShootIndex.x + nr_new_particles;
-        if (particleShootIndex.y > nr_particles) {
-            particleShootIndex.y = static_cast<float>(nr_new_particles);
-            particleShootIndex.x = 0;
-        }
-        timer = 0.0f;
-    }
 }
 
-void ParticleSystemRenderer::Draw(Texture2D* textureAtlas, unsigned int textureAtlasRows, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, ParticleSystemRenderer::EmitterSettings settings) {
+void ParticleSystemRenderer::Draw(Texture2D* textureAtlas, unsigned int textureAtlasRows, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
+    if (simulatedEmitters.empty())
+        return;
 
     // Blending.
     glDisable(GL_CULL_FACE);
@@ -224,20 +245,27 @@ void ParticleSystemRenderer::Draw(Texture2D* textureAtlas, unsigned int textureA
     shaderProgram->Use();
     glBindVertexArray(m_glDrawVAO);
 
-    glUniformMatrix4fv(shaderProgram->GetUniformLocation("viewMatrix"), 1, GL_FALSE, &viewMatrix[0][0]);
-    glUniformMatrix4fv(shaderProgram->GetUniformLocation("projMatrix"), 1, GL_FALSE, &projectionMatrix[0][0]);
-    glUniform1i(shaderProgram->GetUniformLocation("baseImage"), 0);
-    glUniform1i(shaderProgram->GetUniformLocation("textureIndex"), settings.textureIndex);
-    glUniform1f(shaderProgram->GetUniformLocation("scale"), settings.scale);
+    glUniformMatrix4fv(viewMatrixLocation, 1, GL_FALSE, &viewMatrix[0][0]);
+    glUniformMatrix4fv(projectionMatrixLocation, 1, GL_FALSE, &projectionMatrix[0][0]);
+    glUniform1i(baseImageLocation, 0);
 
     // Base image texture.
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, textureAtlas->GetTextureID());
 
     // Send the texture to shader.
-    glUniform1f(shaderProgram->GetUniformLocation("textureAtlasRows"), static_cast<GLfloat>(textureAtlasRows));
+    glUniform1f(textureAtlasRowsLocation, static_cast<GLfloat>(textureAtlasRows));
+
+    const Frustum frustum(projectionMatrix * viewMatrix);
+    for (unsigned int emitter : simulatedEmitters) {
+        const Emitter& e = emitters[emitter];
+        if (e.activeCount == 0 || !frustum.Collide(e.bounds))
+            continue;
 
-    glDrawArrays(GL_POINTS, 0, nr_particles);
+        glUniform1i(textureIndexLocation, e.textureIndex);
+        glUniform1f(scaleLocation, e.scale);
+        glDrawArrays(GL_POINTS, e.offset, e.activeCount);
+    }
 
     glDisablei(GL_BLEND, 0);
     glDisablei(GL_BLEND, 1);
@@ -248,3 +276,198 @@ void ParticleSystemRenderer::Draw(Texture2D* textureAtlas, unsigned int textureA
     glEnable(GL_DEPTH_TEST);
     glDepthMask(GL_TRUE);
 }
+
+void ParticleSystemRenderer::SetSeed(uint32_t seed) {
+    randomEngine.seed(seed);
+}
+
+void ParticleSystemRenderer::GenerateRandomDirections(const EmitterSettings& settings, std::mt19937& randomEngine, glm::vec3 (&directions)[32]) {
+    // Draw raw values from the engine, the standard distributions aren't the same on all platforms.
+    int spread = std::max(settings.spread, 1);
+    for (unsigned int i = 0; i < 32; i++) {
+        int x = static_cast<int>(randomEngine() % spread) - spread / 2;
+        int y = static_cast<int>(randomEngine() % spread) - spread / 2;
+        int z = static_cast<int>(randomEngine() % spread) - spread / 2;
+        glm::vec3 direction(settings.randomVec.x + x, settings.randomVec.y + y, settings.randomVec.z + z);
+
+        // Normalizing a zero vector would give NaN.
+        float length = glm::length(direction);
+        directions[i] = length > 0.0f ? direction * (1.0f / length) : direction;
+    }
+}
+
+AxisAlignedBoundingBox ParticleSystemRenderer::GetBounds(const EmitterSettings& settings) {
+    // Particles live for at most this many steps before they are reset to the emitter.
+    float steps = std::max(std::ceil(settings.lifetime / SIMULATION_STEP) + 1.0f, 0.0f);
+
+    // Emitted particles get a random direction of unit length, unless there is no spread.
+    glm::vec3 directionMin(-1.0f);
+    glm::vec3 directionMax(1.0f);
+    if (settings.spread <= 1) {
+        float length = glm::length(settings.randomVec);
+        directionMin = directionMax = length > 0.0f ? settings.randomVec * (1.0f / length) : glm::vec3(0.0f);
+    }
+
+    const glm::vec3 acceleration = settings.velocity + settings.mass * glm::vec3(0.0f, -9.8f, 0.0f) * SIMULATION_STEP;
+
+    glm::vec3 minVertex;
+    glm::vec3 maxVertex;
+    for (int axis = 0; axis < 3; ++axis) {
+        float velocityMin = settings.velocityMultiplier * (directionMin[axis] + settings.velocity[axis]);
+        float velocityMax = settings.velocityMultiplier * (directionMax[axis] + settings.velocity[axis]);
+        if (velocityMin > velocityMax)
+            std::swap(velocityMin, velocityMax);
+
+        minVertex[axis] = GetOffsetRange(velocityMin, acceleration[axis], steps).x;
+        maxVertex[axis] = GetOffsetRange(velocityMax, acceleration[axis], steps).y;
+    }
+
+    // Billboards extend up to scale * sqrt(2) from the particle.
+    const glm::vec3 padding(settings.scale * 1.4143f);
+    minVertex += settings.worldPos - padding;
+    maxVertex += settings.worldPos + padding;
+
+    return AxisAlignedBoundingBox(maxVertex - minVertex, (minVertex + maxVertex) * 0.5f, minVertex, maxVertex);
+}
+
+unsigned int ParticleSystemRenderer::GetCapacity() const {
+    return capacity;
+}
+
+std::vector<unsigned int> ParticleSystemRenderer::ReadEmitterIndices(unsigned int offset, unsigned int count) const {
+    if (count == 0 || offset + count > capacity)
+        return std::vector<unsigned int>();
+
+    std::vector<unsigned int> indices(count);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, emitterIndexSSbo);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, offset * sizeof(unsigned int), count * sizeof(unsigned int), indices.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    return indices;
+}
+
+unsigned int ParticleSystemRenderer::Allocate(unsigned int count) {
+    if (count == 0)
+        return 0;
+
+    // First fit.
+    for (std::size_t i = 0; i < freeRanges.size(); ++i) {
+        Range& range = freeRanges[i];
+        if (range.count >= count) {
+            unsigned int offset = range.offset;
+            range.offset += count;
+            range.count -= count;
+            if (range.count == 0)
+                freeRanges.erase(freeRanges.begin() + i);
+            return offset;
+        }
+    }
+
+    // No free range is large enough, grow the pool and try again.
+    unsigned int trailing = GetUsedEnd() < capacity ? capacity - GetUsedEnd() : 0;
+    Grow(capacity - trailing + count);
+    return Allocate(count);
+}
+
+void ParticleSystemRenderer::Free(unsigned int offset, unsigned int count) {
+    if (count == 0)
+        return;
+
+    // Keep the free ranges sorted and merge neighbours.
+    auto it = std::lower_bound(freeRanges.begin(), freeRanges.end(), offset, [](const Range& range, unsigned int value) {
+        return range.offset < value;
+    });
+    it = freeRanges.insert(it, Range{ offset, count });
+
+    auto next = it + 1;
+    if (next != freeRanges.end() && it->offset + it->count == next->offset) {
+        it->count += next->count;
+        freeRanges.erase(next);
+    }
+
+    if (it != freeRanges.begin()) {
+        auto previous = it - 1;
+        if (previous->offset + previous->count == it->offset) {
+            previous->count += it->count;
+            freeRanges.erase(it);
+        }
+    }
+}
+
+void ParticleSystemRenderer::Grow(unsigned int minimumCapacity) {
+    unsigned int oldCapacity = capacity;
+    unsigned int newCapacity = std::max(minimumCapacity, capacity * 2);
+
+    // Create new buffers and copy the old particles over.
+    GLuint* buffers[4] = { &posSSbo, &velSSbo, &colSSbo, &emitterIndexSSbo };
+    GLsizeiptr elementSizes[4] = { sizeof(Particles::ParticlePos), sizeof(Particles::ParticleVelocity), sizeof(Particles::ParticleColor), sizeof(unsigned int) };
+    for (int i = 0; i < 4; ++i) {
+        GLuint buffer;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, elementSizes[i] * newCapacity, nullptr, GL_DYNAMIC_DRAW);
+
+        if (*buffers[i] != 0) {
+            glBindBuffer(GL_COPY_READ_BUFFER, *buffers[i]);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_SHADER_STORAGE_BUFFER, 0, 0, elementSizes[i] * oldCapacity);
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            glDeleteBuffers(1, buffers[i]);
+        }
+
+        *buffers[i] = buffer;
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    if (oldCapacity > 0)
+        Utility::MemoryTracker::Free(Utility::MemoryTracker::PARTICLES, PoolSize(oldCapacity));
+    Utility::MemoryTracker::Allocate(Utility::MemoryTracker::PARTICLES, PoolSize(newCapacity));
+
+    capacity = newCapacity;
+    AssignRange(oldCapacity, newCapacity - oldCapacity, NO_EMITTER);
+    Free(oldCapacity, newCapacity - oldCapacity);
+
+    // Binding vertex array to get position in vertexshader and color in fragmentshader.
+    glBindVertexArray(m_glDrawVAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, posSSbo);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(Particles::ParticlePos), 0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, colSSbo);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Particles::ParticleColor), 0);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void ParticleSystemRenderer::AssignRange(unsigned int offset, unsigned int count, unsigned int emitter) {
+    if (count == 0)
+        return;
+
+    // Reset the particles so old particles from another emitter aren't drawn.
+    std::vector<glm::vec4> zeros(count, glm::vec4(0.0f));
+    std::vector<unsigned int> indices(count, emitter);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, posSSbo);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset * sizeof(Particles::ParticlePos), count * sizeof(Particles::ParticlePos), zeros.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, velSSbo);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset * sizeof(Particles::ParticleVelocity), count * sizeof(Particles::ParticleVelocity), zeros.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, colSSbo);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset * sizeof(Particles::ParticleColor), count * sizeof(Particles::ParticleColor), zeros.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, emitterIndexSSbo);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset * sizeof(unsigned int), count * sizeof(unsigned int), indices.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+#ifdef USINGPARTICLEBUFFERCHECKS
+    // The compute shader reads the indices as a tightly packed array.
+    assert(ReadEmitterIndices(offset, count) == indices);
+#endif
+}
+
+unsigned int ParticleSystemRenderer::GetUsedEnd() const {
+    // Particles after the last allocated range don't need to be simulated.
+    if (!freeRanges.empty() && freeRanges.back().offset + freeRanges.back().count == capacity)
+        return freeRanges.back().offset;
+    return capacity;
+}
@@ -1,7 +1,11 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
 #include <Video/Shader/Shader.hpp>
 #include <Video/Shader/ShaderProgram.hpp>
+#include <Video/Culling/AxisAlignedBoundingBox.hpp>
 
 #include "linking.hpp"
 
@@ -28,15 +32,15 @@ namespace Particles {
     };
 }
 
-
-struct ParticleModelMatrix {
-    glm::mat4 m = glm::mat4(1);
-};
-
 namespace Video {
     class Texture2D;
 
-    /// Represents a particle system that can be simulated and rendered.
+    /// Simulates and renders the particles of all particle emitters.
+    /**
+     * The shader programs are compiled once and shared by all emitters. Each
+     * emitter's particles live in a range of one pooled set of storage
+     * buffers, so all emitters are simulated in a single compute dispatch.
+     */
     class ParticleSystemRenderer {
         public:
             struct EmitterSettings {
@@ -92,67 +96,166 @@ namespace Video {
                 int nr_new_particles = 31;
             };
 
-            EmitterSettings emitterSettings;
-
-            /// Constructor.
-            VIDEO_API ParticleSystemRenderer();
-
-            /// Construct a particle system with a given number of particles.
+            /// Create the shared particle shader programs and particle pool.
             /**
-             * @param count Number of particles.
+             * @param capacity Initial number of particles the pool can hold. The pool grows when emitters need more.
              */
-            VIDEO_API ParticleSystemRenderer(int count);
+            VIDEO_API explicit ParticleSystemRenderer(unsigned int capacity = 1024 * 64);
 
             /// Destructor.
             VIDEO_API ~ParticleSystemRenderer();
 
-            /// Initialize the particle system.
-            VIDEO_API void Init();
+            /// Add an emitter.
+            /**
+             * Allocates a range of the particle pool for the emitter's particles.
+             * @param particleCount Number of particles in the emitter.
+             * @return Handle of the emitter.
+             */
+            VIDEO_API unsigned int AddEmitter(unsigned int particleCount);
 
-            /// Creates storage buffers for particles.
-            VIDEO_API void CreateStorageBuffers();
+            /// Remove an emitter and return its particles to the pool.
+            /**
+             * @param emitter Handle of the emitter to remove.
+             */
+            VIDEO_API void RemoveEmitter(unsigned int emitter);
 
-            /// Particles are sent to the compute shader and we compute their the new positions/velocities.
+            /// Queue an emitter for simulation and drawing this frame.
             /**
+             * The emitter's particle range is reallocated if the number of particles has changed.
+             *
+             * A level of detail below 1 simulates and draws only that fraction of the particles and emits new particles
+             * at the same fraction of the rate. The rest of the range stays allocated, so changing the level of detail
+             * doesn't reset the emitter.
+             * @param emitter Handle of the emitter.
              * @param dt Deltatime.
              * @param settings Emitter settings.
+             * @param lod Level of detail, between 0 and 1.
              */
-            VIDEO_API void Update(float dt, EmitterSettings settings);
+            VIDEO_API void Update(unsigned int emitter, float dt, const EmitterSettings& settings, float lod = 1.0f);
 
-            ///Render the particles.
+            /// Simulate the particles of all emitters queued by Update in a single compute dispatch.
+            VIDEO_API void Simulate();
+
+            /// Render the particles of all emitters simulated by the last call to Simulate.
             /**
+             * Emitters whose bounds are outside the view frustum are skipped.
              * @param textureAtlas The texture atlas for the particles.
              * @param textureAtlasRows how many rows in texture atlas.
              * @param viewMatrix The camera's view matrix.
              * @param projectionMatrix The camera's projection matrix.
-             * @param settings Settings for the emitter.
              */
-            VIDEO_API void Draw(Texture2D* textureAtlas, unsigned int textureAtlasRows, const glm::mat4& viewMatrix, const glm::mat4& ProjectionMatrix, ParticleSystemRenderer::EmitterSettings settings);
+            VIDEO_API void Draw(Texture2D* textureAtlas, unsigned int textureAtlasRows, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
+
+            /// Seed the random number generator used to emit particles.
+            /**
+             * @param seed The seed.
+             */
+            VIDEO_API void SetSeed(uint32_t seed);
+
+            /// Generate the random directions given to newly emitted particles.
+            /**
+             * The result only depends on the settings and the state of the random engine, so emitters seeded with the same seed emit the same particles.
+             * @param settings Emitter settings.
+             * @param randomEngine Random engine to draw from.
+             * @param directions Array to store the directions in.
+             */
+            VIDEO_API static void GenerateRandomDirections(const EmitterSettings& settings, std::mt19937& randomEngine, glm::vec3 (&directions)[32]);
+
+            /// Get the bounds of all particles an emitter can emit.
+            /**
+             * Derived from the emitter's velocity, lifetime and spread, assuming the emitter doesn't move.
+             * @param settings Emitter settings.
+             * @return Axis-aligned bounding box containing the particles.
+             */
+            VIDEO_API static AxisAlignedBoundingBox GetBounds(const EmitterSettings& settings);
+
+            /// Get the number of particles the pool can currently hold.
+            /**
+             * @return The capacity of the particle pool.
+             */
+            VIDEO_API unsigned int GetCapacity() const;
+
+            /// Read back the emitter index of each particle from the GPU.
+            /**
+             * Stalls until the GPU is done with the buffer, only meant for checks.
+             * AssignRange uses it to check the assigned indices when the engine is
+             * configured with UseParticleBufferChecks.
+             * @param offset Offset of the first particle.
+             * @param count Number of particles.
+             * @return The emitter index of each particle, 0xFFFFFFFF for particles without an emitter.
+             */
+            VIDEO_API std::vector<unsigned int> ReadEmitterIndices(unsigned int offset, unsigned int count) const;
 
         private:
-            Video::ShaderProgram* computeShaderProgram;
+            ParticleSystemRenderer(const ParticleSystemRenderer& other) = delete;
+            void operator=(const ParticleSystemRenderer&) = delete;
+
+            // Per-emitter data read by the compute shader (std430 layout).
+            struct EmitterData {
+                glm::vec4 worldPosition; // w: lifetime
+                glm::vec4 velocity; // w: speed
+                glm::vec4 shootIndex; // xy: shoot range, z: mass, w: alpha control
+                glm::uvec4 range; // x: offset, y: count, z: active
+                glm::vec4 randomVec[32];
+            };
+
+            struct Emitter {
+                unsigned int offset = 0;
+                unsigned int count = 0;
+                unsigned int activeCount = 0;
+                float timer = 0.0f;
+                glm::vec2 shootIndex = glm::vec2(0, 30);
+                int textureIndex = 0;
+                float scale = 1.0f;
+                AxisAlignedBoundingBox bounds;
+            };
 
+            struct Range {
+                unsigned int offset;
+                unsigned int count;
+            };
+
+            unsigned int Allocate(unsigned int count);
+            void Free(unsigned int offset, unsigned int count);
+            void Grow(unsigned int minimumCapacity);
+            void AssignRange(unsigned int offset, unsigned int count, unsigned int emitter);
+            unsigned int GetUsedEnd() const;
+
+            Video::ShaderProgram* computeShaderProgram;
             Video::ShaderProgram* shaderProgram;
 
-            int WORK_GROUP_SIZE = 128;
-
-            unsigned int nr_particles = 1024 * 32;
-            glm::vec2 particleShootIndex = glm::vec2(0, 30);
-            int nr_new_particles = 31;
-            float rate = 1000.0f;
-            float delta_time = 0.0f;
-            Particles::ParticlePos* points;
-            Particles::ParticleVelocity* vels;
-            Particles::ParticleColor* col;
-            ParticleModelMatrix* rots;
-            glm::mat4 rotMat;
-
-            float timer = 0.0f;
-
-            GLuint posSSbo;
-            GLuint velSSbo;
-            GLuint colSSbo;
-            GLuint mmSSbo;
-            GLuint m_glDrawVAO;
+            // Compute shader uniform locations.
+            GLuint particleCountLocation;
+            GLuint emitterCountLocation;
+
+            // Draw shader uniform locations.
+            GLuint viewMatrixLocation;
+            GLuint projectionMatrixLocation;
+            GLuint baseImageLocation;
+            GLuint textureIndexLocation;
+            GLuint scaleLocation;
+            GLuint textureAtlasRowsLocation;
+
+            static const unsigned int WORK_GROUP_SIZE = 128;
+
+            unsigned int capacity = 0;
+            std::vector<Range> freeRanges;
+
+            std::vector<Emitter> emitters;
+            std::vector<EmitterData> emitterData;
+            std::vector<unsigned int> freeEmitters;
+            unsigned int emitterBufferSize = 0;
+
+            std::mt19937 randomEngine;
+
+            std::vector<unsigned int> queuedEmitters;
+            std::vector<unsigned int> simulatedEmitters;
+
+            GLuint posSSbo = 0;
+            GLuint velSSbo = 0;
+            GLuint colSSbo = 0;
+            GLuint emitterIndexSSbo = 0;
+            GLuint emitterSSbo = 0;
+            GLuint m_glDrawVAO = 0;
     };
 } // namespace Video
@@ -70,6 +70,16 @@ Query::Type Query::GetType() const {
     return type;
 }
 
+bool Query::IsAvailable() const {
+    if (active)
+        return false;
+
+    // Queries finish in the order they were issued, so only the last one needs to be checked.
+    GLuint available = GL_FALSE;
+    glGetQueryObjectuiv(queries[queryCount - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    return available != GL_FALSE;
+}
+
 std::uint64_t Query::Resolve() const {
     if (active) {
         Log() << "Query::Resolve warning: Can't resolve query while active.\n";
@@ -35,8 +35,16 @@ namespace Video {
              */
             VIDEO_API Type GetType() const;
 
+            /// Check whether the result of the query is available.
+            /**
+             * Doesn't wait for the GPU.
+             * @return Whether the result can be resolved without stalling.
+             */
+            VIDEO_API bool IsAvailable() const;
+
             /// Resolve query result.
             /**
+             * Waits for the GPU if the result isn't available yet, see IsAvailable().
              * @return The result of query.
              */
             VIDEO_API std::uint64_t Resolve() const;
@@ -2,6 +2,7 @@
 
 #include <fstream>
 #include <Utility/Log.hpp>
+#include <Utility/MemoryTracker.hpp>
 #include <cstring>
 #include <miniz.h>
 
@@ -102,13 +103,16 @@ TextureHCT::TextureHCT(const char* filename, uint16_t textureReduction) {
     uint32_t size = static_cast<uint32_t>(width) * height / 16 * blockSize;
     unsigned char* data = new unsigned char[size];
     unsigned int bufferLocation = 0;
+    std::size_t textureSize = 0;
     for (uint16_t mipLevel = 0; mipLevel < mipLevels; ++mipLevel) {
         size = static_cast<uint32_t>(width) * height / 16 * blockSize;
         memcpy(data, &buffer[bufferLocation], size);
         bufferLocation += size;
         
-        if (mipLevel >= textureReduction)
+        if (mipLevel >= textureReduction) {
             glCompressedTexSubImage2D(GL_TEXTURE_2D, mipLevel - textureReduction, 0, 0, width, height, format, size, data);
+            textureSize += size;
+        }
         width /= 2;
         height /= 2;
     }
@@ -116,6 +120,9 @@ TextureHCT::TextureHCT(const char* filename, uint16_t textureReduction) {
     delete[] buffer;
     delete[] data;
     
+    memoryUsage = textureSize;
+    Utility::MemoryTracker::Allocate(Utility::MemoryTracker::TEXTURES, memoryUsage);
+    
     // When MAGnifying the image (no bigger mipmap available), use LINEAR filtering.
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     
@@ -132,6 +139,9 @@ TextureHCT::TextureHCT(const char* filename, uint16_t textureReduction) {
 TextureHCT::~TextureHCT() {
     if (texID != 0)
         glDeleteTextures(1, &texID);
+    
+    if (memoryUsage > 0)
+        Utility::MemoryTracker::Free(Utility::MemoryTracker::TEXTURES, memoryUsage);
 }
 
 GLuint TextureHCT::GetTextureID() const {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Texture2D.hpp"
+#include <cstddef>
 #include <cstdint>
 
 namespace Video {
@@ -47,5 +48,6 @@ namespace Video {
         private:
         GLuint texID = 0;
         bool loaded = false;
+        std::size_t memoryUsage = 0;
     };
 }
@@ -5,6 +5,7 @@
 #include <stb_image.h>
 
 #include <Utility/Log.hpp>
+#include <Utility/MemoryTracker.hpp>
 
 #ifdef USINGMEMTRACK
 #include <MemTrackInclude.hpp>
@@ -26,6 +27,7 @@ TexturePNG::TexturePNG(const char* source, int sourceLength) {
     // Give the image to OpenGL.
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, Format(components), GL_UNSIGNED_BYTE, data);
     
+    bool loadedData = data != NULL;
     stbi_image_free(data);
     
     // When MAGnifying the image (no bigger mipmap available), use LINEAR filtering.
@@ -41,12 +43,21 @@ TexturePNG::TexturePNG(const char* source, int sourceLength) {
     // Generate mipmaps, by the way.
     glGenerateMipmap(GL_TEXTURE_2D);
     
+    // The mipmaps add a third to the size of the image.
+    if (loadedData) {
+        memoryUsage = static_cast<std::size_t>(width) * height * 4 * 4 / 3;
+        Utility::MemoryTracker::Allocate(Utility::MemoryTracker::TEXTURES, memoryUsage);
+    }
+    
     loaded = true;
 }
 
 TexturePNG::~TexturePNG() {
     if (texID != 0)
         glDeleteTextures(1, &texID);
+    
+    if (memoryUsage > 0)
+        Utility::MemoryTracker::Free(Utility::MemoryTracker::TEXTURES, memoryUsage);
 }
 
 GLuint TexturePNG::GetTextureID() const {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Texture2D.hpp"
+#include <cstddef>
 
 namespace Video {
     /// Texture loaded from a PNG file.
@@ -35,5 +36,6 @@ namespace Video {
         
         GLuint texID = 0;
         bool loaded = false;
+        std::size_t memoryUsage = 0;
     };
 }